@@ -23,6 +23,9 @@
 #include <QTimer>                // 定时器 - 时间管理大师
 
 #include "cad_ui/MainWindow.h"   // 我们的主窗口 - 用户界面的"指挥中心"
+#include "cad_core/Tracer.h"     // 性能追踪 - ANDERCAD_TRACE=<文件> 时退出时写出trace
+#include "cad_core/TaskScheduler.h" // 任务调度器 - 导入导出、预览共用的线程池
+#include "cad_core/TranslatorSetup.h" // 翻译器注册 - STEP/IGES控制器启动时注册一次
 
 // QRC资源初始化函数声明 - 手动初始化静态库中的资源
 extern int qInitResources_resources();
@@ -61,6 +64,15 @@ int main(int argc, char *argv[])
     Handle(Message_PrinterOStream) printer = new Message_PrinterOStream();
     Message::DefaultMessenger()->AddPrinter(printer);
     
+    // 性能追踪：设置了ANDERCAD_TRACE就从启动开始录制，方便附在bug报告里
+    cad_core::Tracer::InitFromEnvironment();
+    cad_core::Tracer::SetThreadName("UI");
+    
+    // 任务调度器要在任何OCCT并行算法之前创建，OCCT的默认线程池按它的线程数初始化
+    cad_core::TaskScheduler::Instance();
+    // STEP/IGES翻译控制器是全局状态，在后台导入导出之前注册一次
+    cad_core::InitializeTranslators();
+    
     // 创建启动画面（可选功能）- 给用户一个"正在加载"的安全感
     QSplashScreen* splash = nullptr;
     /*
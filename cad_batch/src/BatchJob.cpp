@@ -0,0 +1,550 @@
+#include "BatchJob.h"
+
+#include "cad_core/BooleanOperations.h"
+#include "cad_core/FilletChamferOperations.h"
+#include "cad_core/ExportParts.h"
+#include "cad_core/GltfExporter.h"
+#include "cad_core/IgesExporter.h"
+#include "cad_core/IgesImporter.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/ShapeFactory.h"
+#include "cad_core/StepImporter.h"
+#include "cad_core/StlExporter.h"
+#include "cad_core/TransformCommand.h"
+#include "cad_feature/CircularPatternFeature.h"
+#include "cad_feature/LinearPatternFeature.h"
+#include <Standard_Failure.hxx>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace cad_batch {
+
+namespace {
+
+std::string Extension(const std::string& filename) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return std::string();
+    }
+    std::string extension = filename.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+bool ParseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && end && *end == '\0';
+}
+
+// 解析从first开始的count个数值参数
+bool ParseNumbers(const std::vector<std::string>& args, size_t first, size_t count, std::vector<double>& values) {
+    values.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (first + i >= args.size() || !ParseNumber(args[first + i], values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool BatchScript::Load(const std::string& filename, std::string& error) {
+    std::ifstream file(filename);
+    if (!file) {
+        error = "Cannot open script " + filename;
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return Parse(text.str(), error);
+}
+
+bool BatchScript::Parse(const std::string& text, std::string& error) {
+    m_commands.clear();
+    std::istringstream lines(text);
+    std::string line;
+    int number = 0;
+    while (std::getline(lines, line)) {
+        ++number;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream words(line);
+        BatchCommand command;
+        command.line = number;
+        if (!(words >> command.name)) {
+            continue;
+        }
+        std::string arg;
+        while (words >> arg) {
+            command.args.push_back(arg);
+        }
+        m_commands.push_back(command);
+    }
+    if (m_commands.empty()) {
+        error = "Script has no commands";
+        return false;
+    }
+    return true;
+}
+
+const char* BatchScript::Usage() {
+    return
+        "  open <file> [lazy]                         open .acad/.cad document\n"
+        "  import <file> [name]                       STEP, IGES, STL or OBJ\n"
+        "  box <name> <dx> <dy> <dz>\n"
+        "  cylinder <name> <radius> <height>\n"
+        "  sphere <name> <radius>\n"
+        "  union|intersect <result> <shape> <shape>...\n"
+        "  cut <result> <target> <tool>...\n"
+        "  fillet|chamfer <result> <shape> <size> [edge count]\n"
+        "  translate <shape> <dx> <dy> <dz>\n"
+        "  rotate <shape> <ox> <oy> <oz> <ax> <ay> <az> <degrees>\n"
+        "  scale <shape> <factor>\n"
+        "  linear-pattern <result> <seed> <dx> <dy> <dz> <spacing> <count> [cut|union <target>]\n"
+        "  circular-pattern <result> <seed> <ax> <ay> <az> <count> <degrees> [cut|union <target>]\n"
+        "  rebuild                                    regenerate patterns from current seeds\n"
+        "  remove <shape>\n"
+        "  info [shape]...                            print volume and area\n"
+        "  save <file>                                .acad or .cad\n"
+        "  export <file> [shape]...                   .stl, .glb, .gltf, .igs\n"
+        "Arguments may use ${input}, ${stem}, ${dir} and ${output}.\n";
+}
+
+BatchJob::BatchJob(const BatchScript& script, const std::map<std::string, std::string>& variables)
+    : m_script(script), m_variables(variables), m_seconds(0.0) {
+    auto input = m_variables.find("input");
+    m_name = input != m_variables.end() ? input->second : "script";
+}
+
+bool BatchJob::Run() {
+    auto start = std::chrono::steady_clock::now();
+    bool succeeded = m_ocafManager.Initialize() && m_ocafManager.NewDocument();
+    if (!succeeded) {
+        m_lastError = "Failed to create document";
+    }
+    for (size_t i = 0; succeeded && i < m_script.GetCommands().size(); ++i) {
+        const BatchCommand& command = m_script.GetCommands()[i];
+        // 每条命令一个事务，失败时整条回滚
+        m_ocafManager.StartTransaction(command.name);
+        try {
+            succeeded = Execute(command);
+        } catch (const Standard_Failure& e) {
+            succeeded = Fail(e.GetMessageString() ? e.GetMessageString() : "Geometry kernel error");
+        }
+        if (succeeded) {
+            m_ocafManager.CommitTransaction();
+        } else {
+            m_ocafManager.AbortTransaction();
+            m_lastError = "line " + std::to_string(command.line) + " (" + command.name + "): " + m_lastError;
+        }
+    }
+    m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return succeeded;
+}
+
+bool BatchJob::Execute(const BatchCommand& command) {
+    std::vector<std::string> args;
+    args.reserve(command.args.size());
+    for (const std::string& arg : command.args) {
+        args.push_back(Expand(arg));
+    }
+
+    const std::string& name = command.name;
+    if (name == "open") {
+        return Open(args);
+    } else if (name == "import") {
+        return Import(args);
+    } else if (name == "box" || name == "cylinder" || name == "sphere") {
+        return Primitive(name, args);
+    } else if (name == "union" || name == "intersect" || name == "cut") {
+        return Boolean(name, args);
+    } else if (name == "fillet" || name == "chamfer") {
+        return Blend(name, args);
+    } else if (name == "translate" || name == "rotate" || name == "scale") {
+        return Transform(name, args);
+    } else if (name == "linear-pattern" || name == "circular-pattern") {
+        return Pattern(name, args);
+    } else if (name == "rebuild") {
+        return Rebuild();
+    } else if (name == "remove") {
+        if (args.size() != 1 || !m_ocafManager.RemoveShape(args[0])) {
+            return Fail("No shape named " + (args.empty() ? std::string() : args[0]));
+        }
+        return true;
+    } else if (name == "info") {
+        return Info(args);
+    } else if (name == "save") {
+        return Save(args);
+    } else if (name == "export") {
+        return Export(args);
+    }
+    return Fail("Unknown command");
+}
+
+std::string BatchJob::Expand(const std::string& text) const {
+    std::string result;
+    size_t position = 0;
+    while (position < text.size()) {
+        size_t open = text.find("${", position);
+        size_t close = open == std::string::npos ? std::string::npos : text.find('}', open);
+        if (close == std::string::npos) {
+            result += text.substr(position);
+            break;
+        }
+        result += text.substr(position, open - position);
+        auto variable = m_variables.find(text.substr(open + 2, close - open - 2));
+        if (variable != m_variables.end()) {
+            result += variable->second;
+        }
+        position = close + 1;
+    }
+    return result;
+}
+
+bool BatchJob::Open(const std::vector<std::string>& args) {
+    if (args.empty() || args.size() > 2) {
+        return Fail("Usage: open <file> [lazy]");
+    }
+    // 打开会替换整个文档，前面的阵列记录随之失效
+    m_featureOutputs.clear();
+    m_featureManager.ClearFeatures();
+    if (!m_ocafManager.OpenDocument(args[0], args.size() == 2 && args[1] == "lazy")) {
+        return Fail("Failed to open " + args[0]);
+    }
+    m_log << "opened " << args[0] << " (" << m_ocafManager.GetAllShapeNames().size() << " shapes)\n";
+    return true;
+}
+
+bool BatchJob::Import(const std::vector<std::string>& args) {
+    if (args.empty() || args.size() > 2) {
+        return Fail("Usage: import <file> [name]");
+    }
+    const std::string& path = args[0];
+    const std::string extension = Extension(path);
+    size_t count = 0;
+
+    if (extension == "step" || extension == "stp") {
+        cad_core::StepImporter importer;
+        if (!importer.Import(path, *m_ocafManager.GetDocument())) {
+            return Fail(importer.GetLastError());
+        }
+        for (const auto& part : importer.GetParts()) {
+            count += m_ocafManager.AddShape(part.shape, part.name) ? 1 : 0;
+        }
+    } else if (extension == "igs" || extension == "iges") {
+        cad_core::IgesImporter importer;
+        if (!importer.Import(path)) {
+            return Fail(importer.GetLastError());
+        }
+        for (const auto& part : importer.GetParts()) {
+            count += m_ocafManager.AddShape(part.shape, part.name) ? 1 : 0;
+        }
+        for (const auto& failure : importer.GetFailures()) {
+            m_log << "  IGES entity DE " << failure.entity << " (type " << failure.type
+                  << "): " << failure.message << "\n";
+        }
+    } else if (extension == "stl" || extension == "obj") {
+        cad_core::MeshImporter importer;
+        cad_core::ShapePtr shape = importer.Import(path);
+        if (!shape) {
+            return Fail(importer.GetLastError());
+        }
+        count += m_ocafManager.AddShape(shape, args.size() == 2 ? args[1] : std::string()) ? 1 : 0;
+    } else {
+        return Fail("Unsupported import format: " + path);
+    }
+    m_log << "imported " << count << " shapes from " << path << "\n";
+    return true;
+}
+
+bool BatchJob::Primitive(const std::string& kind, const std::vector<std::string>& args) {
+    std::vector<double> values;
+    cad_core::ShapePtr shape;
+    if (kind == "box" && args.size() == 4 && ParseNumbers(args, 1, 3, values)) {
+        shape = cad_core::ShapeFactory::CreateBox(values[0], values[1], values[2]);
+    } else if (kind == "cylinder" && args.size() == 3 && ParseNumbers(args, 1, 2, values)) {
+        shape = cad_core::ShapeFactory::CreateCylinder(values[0], values[1]);
+    } else if (kind == "sphere" && args.size() == 2 && ParseNumbers(args, 1, 1, values)) {
+        shape = cad_core::ShapeFactory::CreateSphere(values[0]);
+    } else {
+        return Fail("Invalid arguments");
+    }
+    if (!shape) {
+        return Fail("Failed to create " + kind);
+    }
+    return StoreShape(args[0], shape);
+}
+
+bool BatchJob::Boolean(const std::string& kind, const std::vector<std::string>& args) {
+    if (args.size() < 3) {
+        return Fail("Expected a result name and at least two shapes");
+    }
+    std::vector<cad_core::ShapePtr> inputs;
+    for (size_t i = 1; i < args.size(); ++i) {
+        cad_core::ShapePtr shape = FindShape(args[i]);
+        if (!shape) {
+            return false;
+        }
+        inputs.push_back(shape);
+    }
+
+    cad_core::ShapePtr result;
+    if (kind == "union") {
+        result = cad_core::BooleanOperations::Union(inputs);
+    } else if (kind == "intersect") {
+        result = cad_core::BooleanOperations::Intersection(inputs);
+    } else {
+        // 所有工具一次减去
+        std::vector<cad_core::ShapePtr> tools(inputs.begin() + 1, inputs.end());
+        result = cad_core::BooleanOperations::Difference(inputs[0], tools);
+    }
+    if (!result) {
+        return Fail("Boolean " + kind + " failed");
+    }
+    // 与界面一致：输入形状被结果替换
+    for (size_t i = 1; i < args.size(); ++i) {
+        m_ocafManager.RemoveShape(args[i]);
+    }
+    return StoreShape(args[0], result);
+}
+
+bool BatchJob::Blend(const std::string& kind, const std::vector<std::string>& args) {
+    double size = 0.0;
+    if ((args.size() != 3 && args.size() != 4) || !ParseNumber(args[2], size)) {
+        return Fail("Usage: " + kind + " <result> <shape> <size> [edge count]");
+    }
+    cad_core::ShapePtr shape = FindShape(args[1]);
+    if (!shape) {
+        return false;
+    }
+
+    // 不给数量时处理全部边，否则取前N条
+    std::vector<TopoDS_Edge> edges = cad_core::FilletChamferOperations::GetEdges(shape);
+    double count = 0.0;
+    if (args.size() == 4) {
+        if (!ParseNumber(args[3], count) || count < 1.0) {
+            return Fail("Invalid edge count " + args[3]);
+        }
+        edges.resize(std::min(edges.size(), static_cast<size_t>(count)));
+    }
+
+    cad_core::ShapePtr result = kind == "fillet"
+        ? cad_core::FilletChamferOperations::CreateFillet(shape, edges, size)
+        : cad_core::FilletChamferOperations::CreateChamfer(shape, edges, size);
+    if (!result) {
+        return Fail(kind + " failed on " + std::to_string(edges.size()) + " edges");
+    }
+    m_ocafManager.RemoveShape(args[1]);
+    return StoreShape(args[0], result);
+}
+
+bool BatchJob::Transform(const std::string& kind, const std::vector<std::string>& args) {
+    std::vector<double> values;
+    cad_core::ShapePtr shape = args.empty() ? nullptr : FindShape(args[0]);
+    if (!shape) {
+        return args.empty() ? Fail("Missing shape name") : false;
+    }
+
+    std::unique_ptr<cad_core::TransformCommand> command;
+    if (kind == "translate" && args.size() == 4 && ParseNumbers(args, 1, 3, values)) {
+        command.reset(new cad_core::TransformCommand({shape}, cad_core::TransformationType::Translate));
+        command->SetTranslation(values[0], values[1], values[2]);
+    } else if (kind == "rotate" && args.size() == 8 && ParseNumbers(args, 1, 7, values)) {
+        command.reset(new cad_core::TransformCommand({shape}, cad_core::TransformationType::Rotate));
+        command->SetRotationAxis(cad_core::Point(values[0], values[1], values[2]),
+                                 cad_core::Point(values[3], values[4], values[5]));
+        command->SetRotationAngleDegrees(values[6]);
+    } else if (kind == "scale" && args.size() == 2 && ParseNumbers(args, 1, 1, values)) {
+        command.reset(new cad_core::TransformCommand({shape}, cad_core::TransformationType::Scale));
+        command->SetUniformScale(values[0]);
+    } else {
+        return Fail("Invalid arguments");
+    }
+
+    if (!command->Execute() || command->GetTransformedShapes().empty()) {
+        return Fail(kind + " failed");
+    }
+    if (!m_ocafManager.ReplaceShape(shape, command->GetTransformedShapes().front())) {
+        return Fail("Failed to update " + args[0]);
+    }
+    return true;
+}
+
+bool BatchJob::Pattern(const std::string& kind, const std::vector<std::string>& args) {
+    const size_t fixed = 7;
+    std::vector<double> values;
+    if ((args.size() != fixed && args.size() != fixed + 2) || !ParseNumbers(args, 2, fixed - 2, values)) {
+        return Fail("Invalid arguments");
+    }
+
+    std::shared_ptr<cad_feature::PatternFeature> feature;
+    if (kind == "linear-pattern") {
+        auto linear = std::make_shared<cad_feature::LinearPatternFeature>(args[0]);
+        linear->SetDirection(values[0], values[1], values[2]);
+        linear->SetSpacing(values[3]);
+        linear->SetCount(static_cast<int>(values[4]));
+        feature = linear;
+    } else {
+        auto circular = std::make_shared<cad_feature::CircularPatternFeature>(args[0]);
+        circular->SetAxis(values[0], values[1], values[2]);
+        circular->SetCount(static_cast<int>(values[3]));
+        circular->SetAngle(values[4] * M_PI / 180.0);
+        feature = circular;
+    }
+
+    FeatureOutput output;
+    output.feature = feature;
+    output.seed = args[1];
+    output.output = args[0];
+    if (args.size() == fixed + 2) {
+        if (args[fixed] != "cut" && args[fixed] != "union") {
+            return Fail("Expected cut or union, got " + args[fixed]);
+        }
+        feature->SetOperation(args[fixed] == "cut" ? cad_feature::PatternOperation::Cut
+                                                   : cad_feature::PatternOperation::Union);
+        output.target = args[fixed + 1];
+    }
+    m_featureManager.AddFeature(feature);
+    m_featureOutputs.push_back(output);
+    return Rebuild();
+}
+
+bool BatchJob::Rebuild() {
+    // 按创建顺序重新生成，前一个阵列的结果可以是后一个的种子
+    for (const FeatureOutput& output : m_featureOutputs) {
+        auto pattern = std::static_pointer_cast<cad_feature::PatternFeature>(output.feature);
+        cad_core::ShapePtr seed = FindShape(output.seed);
+        if (!seed) {
+            return false;
+        }
+        pattern->SetSeedShape(seed);
+        if (!output.target.empty()) {
+            cad_core::ShapePtr target = FindShape(output.target);
+            if (!target) {
+                return false;
+            }
+            pattern->SetTargetShape(target);
+        }
+
+        cad_core::ShapePtr result;
+        {
+            cad_core::RegenerationProfiler::ScopedFeature profile(pattern->GetId(), pattern->GetName());
+            result = pattern->CreateShape();
+            profile.SetResult(result ? result->GetOCCTShape() : TopoDS_Shape(), result != nullptr);
+        }
+        if (!result) {
+            pattern->SetState(cad_feature::FeatureState::Failed);
+            return Fail("Pattern " + output.output + " failed");
+        }
+        pattern->SetState(cad_feature::FeatureState::Executed);
+        if (!StoreShape(output.output, result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchJob::Save(const std::vector<std::string>& args) {
+    if (args.size() != 1) {
+        return Fail("Usage: save <file>");
+    }
+    // 特征参数只有原生格式会写出
+    m_ocafManager.GetDocument()->SetFeatureRecords(m_featureManager.GetFeatureRecords());
+    if (!m_ocafManager.SaveDocument(args[0])) {
+        return Fail("Failed to save " + args[0]);
+    }
+    m_log << "saved " << args[0] << "\n";
+    return true;
+}
+
+bool BatchJob::Export(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        return Fail("Usage: export <file> [shape]...");
+    }
+    const std::string& path = args[0];
+    const std::string extension = Extension(path);
+
+    // 指定名称时只导出这些形状
+    std::vector<cad_core::ExportPart> parts = cad_core::CollectExportParts(*m_ocafManager.GetDocument());
+    if (args.size() > 1) {
+        std::vector<std::string> names(args.begin() + 1, args.end());
+        parts.erase(std::remove_if(parts.begin(), parts.end(), [&names](const cad_core::ExportPart& part) {
+            return std::find(names.begin(), names.end(), part.name) == names.end();
+        }), parts.end());
+    }
+    if (parts.empty()) {
+        return Fail("Nothing to export");
+    }
+
+    if (extension == "stl") {
+        cad_core::StlExporter exporter;
+        if (!exporter.Export(parts, path)) {
+            return Fail(exporter.GetLastError());
+        }
+    } else if (extension == "glb" || extension == "gltf") {
+        cad_core::GltfExportOptions options;
+        options.binary = (extension == "glb");
+        cad_core::GltfExporter exporter(options);
+        if (!exporter.Export(parts, path)) {
+            return Fail(exporter.GetLastError());
+        }
+    } else if (extension == "igs" || extension == "iges") {
+        cad_core::IgesExporter exporter;
+        if (!exporter.Export(parts, path)) {
+            return Fail(exporter.GetLastError());
+        }
+    } else {
+        return Fail("Unsupported export format: " + path);
+    }
+    m_log << "exported " << parts.size() << " shapes to " << path << "\n";
+    return true;
+}
+
+bool BatchJob::Info(const std::vector<std::string>& args) {
+    std::vector<std::string> names = args.empty() ? m_ocafManager.GetAllShapeNames() : args;
+    for (const std::string& name : names) {
+        cad_core::ShapePtr shape = FindShape(name);
+        if (!shape) {
+            return false;
+        }
+        m_log << "  " << name << ": volume " << shape->Volume() << ", area " << shape->Area()
+              << (shape->IsValid() ? "" : " (invalid)") << "\n";
+    }
+    return true;
+}
+
+cad_core::ShapePtr BatchJob::FindShape(const std::string& name) {
+    cad_core::ShapePtr shape = m_ocafManager.GetShape(name);
+    if (!shape) {
+        Fail("No shape named " + name);
+    }
+    return shape;
+}
+
+bool BatchJob::StoreShape(const std::string& name, const cad_core::ShapePtr& shape) {
+    if (m_ocafManager.GetShape(name)) {
+        m_ocafManager.RemoveShape(name);
+    }
+    if (!m_ocafManager.AddShape(shape, name)) {
+        return Fail("Failed to add " + name + " to document");
+    }
+    return true;
+}
+
+bool BatchJob::Fail(const std::string& message) {
+    m_lastError = message;
+    return false;
+}
+
+} // namespace cad_batch
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "cad_core/OCAFManager.h"
+#include "cad_core/Shape.h"
+#include "cad_feature/FeatureManager.h"
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cad_batch {
+
+// 脚本中的一条命令
+struct BatchCommand {
+    int line = 0;
+    std::string name;
+    std::vector<std::string> args;
+};
+
+/**
+ * @class BatchScript
+ * @brief 批处理脚本：每行一条命令，参数以空白分隔，#开始注释
+ *
+ * 参数里的${name}在执行时替换成任务变量（input、stem、dir、output），
+ * 同一个脚本可以依次套用到多个文件上。
+ */
+class BatchScript {
+public:
+    bool Load(const std::string& filename, std::string& error);
+    bool Parse(const std::string& text, std::string& error);
+
+    const std::vector<BatchCommand>& GetCommands() const { return m_commands; }
+
+    // 支持的命令及用法，供--help输出
+    static const char* Usage();
+
+private:
+    std::vector<BatchCommand> m_commands;
+};
+
+/**
+ * @class BatchJob
+ * @brief 在一个独立的文档上执行一遍脚本
+ *
+ * 每个任务有自己的OCAFManager（自己的TDocStd_Application）和FeatureManager，
+ * 不碰任何界面对象，多个任务可以在不同线程上同时运行。
+ * 布尔、圆角、倒角的输入形状与界面中一样被结果替换；阵列特征记下种子名称，
+ * rebuild时按文档中当前的种子形状重新生成。
+ */
+class BatchJob {
+public:
+    BatchJob(const BatchScript& script, const std::map<std::string, std::string>& variables);
+
+    // 遇到第一条失败的命令即停止，已经打开的事务回滚
+    bool Run();
+
+    const std::string& GetName() const { return m_name; }
+    std::string GetLog() const { return m_log.str(); }
+    const std::string& GetLastError() const { return m_lastError; }
+    double GetSeconds() const { return m_seconds; }
+
+private:
+    // 阵列特征及其在文档中的输入、输出名称
+    struct FeatureOutput {
+        cad_feature::FeaturePtr feature;
+        std::string seed;
+        std::string target;    // 为空时只生成实例
+        std::string output;
+    };
+
+    bool Execute(const BatchCommand& command);
+    std::string Expand(const std::string& text) const;
+
+    bool Open(const std::vector<std::string>& args);
+    bool Import(const std::vector<std::string>& args);
+    bool Primitive(const std::string& kind, const std::vector<std::string>& args);
+    bool Boolean(const std::string& kind, const std::vector<std::string>& args);
+    bool Blend(const std::string& kind, const std::vector<std::string>& args);
+    bool Transform(const std::string& kind, const std::vector<std::string>& args);
+    bool Pattern(const std::string& kind, const std::vector<std::string>& args);
+    bool Rebuild();
+    bool Save(const std::vector<std::string>& args);
+    bool Export(const std::vector<std::string>& args);
+    bool Info(const std::vector<std::string>& args);
+
+    cad_core::ShapePtr FindShape(const std::string& name);
+    // 写入结果：同名形状先移除
+    bool StoreShape(const std::string& name, const cad_core::ShapePtr& shape);
+    bool Fail(const std::string& message);
+
+    const BatchScript& m_script;
+    std::map<std::string, std::string> m_variables;
+    std::string m_name;
+
+    cad_core::OCAFManager m_ocafManager;
+    cad_feature::FeatureManager m_featureManager;
+    std::vector<FeatureOutput> m_featureOutputs;
+
+    std::ostringstream m_log;
+    std::string m_lastError;
+    double m_seconds;
+};
+
+} // namespace cad_batch
@@ -0,0 +1,135 @@
+/**
+ * @file main.cpp
+ * @brief cad_batch - 不带界面的批处理入口
+ *
+ * 对一组文件执行同一个脚本（打开、布尔、圆角、变换、阵列重建、保存、导出），
+ * 每个文件一个任务，多个任务并行运行。只链接cad_core、cad_sketch和cad_feature，
+ * 不创建QApplication，可以在没有显示器的CI机器上运行。
+ *
+ * 用法：cad_batch [-j N] [-o 输出目录] <脚本> [文件...]
+ */
+
+#include "BatchJob.h"
+#include "cad_core/Logger.h"
+#include "cad_core/TaskScheduler.h"
+#include "cad_core/TranslatorSetup.h"
+#include "cad_core/Tracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+void PrintUsage() {
+    std::cout << "Usage: cad_batch [-j jobs] [-o output-dir] <script> [file...]\n"
+                 "Runs the script once per file (in parallel), or once if no files are given.\n"
+                 "Script commands:\n"
+              << cad_batch::BatchScript::Usage();
+}
+
+// 任务变量：input为文件路径，stem为不带扩展名的文件名，dir为所在目录
+std::map<std::string, std::string> JobVariables(const std::string& input, const std::string& output) {
+    std::map<std::string, std::string> variables;
+    variables["output"] = output;
+    if (input.empty()) {
+        return variables;
+    }
+    size_t slash = input.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    variables["input"] = input;
+    variables["stem"] = dot == std::string::npos ? name : name.substr(0, dot);
+    variables["dir"] = slash == std::string::npos ? "." : input.substr(0, slash);
+    return variables;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // 0表示按任务调度器的线程数
+    unsigned int jobs = 0;
+    std::string output = ".";
+    std::string scriptFile;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else if ((arg == "-j" || arg == "--jobs") && i + 1 < argc) {
+            jobs = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (scriptFile.empty()) {
+            scriptFile = arg;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (scriptFile.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    // ANDERCAD_TRACE=<文件>：记录所有任务的zone，退出时写出trace
+    cad_core::Tracer::InitFromEnvironment();
+    // 任务调度器在任何OCCT并行算法之前创建，OCCT的默认线程池按它的线程数初始化
+    cad_core::TaskScheduler& scheduler = cad_core::TaskScheduler::Instance();
+    if (jobs == 0) {
+        jobs = static_cast<unsigned int>(scheduler.GetWorkerCount()) + 1;
+    }
+    // 翻译控制器是全局状态，在并行任务开始前注册一次
+    cad_core::InitializeTranslators();
+
+    cad_batch::BatchScript script;
+    std::string error;
+    if (!script.Load(scriptFile, error)) {
+        std::cerr << "cad_batch: " << error << std::endl;
+        return 2;
+    }
+    if (inputs.empty()) {
+        inputs.push_back(std::string());
+    }
+
+    // 调度器的工作线程依次领取文件，每个任务结束后整段输出日志，避免不同任务的行交错
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> failed(0);
+    std::mutex outputMutex;
+    auto worker = [&]() {
+        for (size_t index = next++; index < inputs.size(); index = next++) {
+            cad_batch::BatchJob job(script, JobVariables(inputs[index], output));
+            bool succeeded = job.Run();
+            if (!succeeded) {
+                ++failed;
+            }
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << (succeeded ? "[ok]   " : "[fail] ") << job.GetName()
+                      << " (" << job.GetSeconds() << " s)\n" << job.GetLog();
+            if (!succeeded) {
+                std::cerr << "  error: " << job.GetLastError() << "\n";
+            }
+            std::cout.flush();
+        }
+    };
+
+    // 任务里的导入、网格、阵列重建也在同一个调度器上并行，不再另开线程，
+    // 并发的文件数只决定同时领取文件的任务数，不会超额订阅
+    const size_t taskCount = std::min<size_t>(jobs, inputs.size());
+    cad_core::TaskGroup group;
+    for (size_t i = 1; i < taskCount; ++i) {
+        group.Run(worker);
+    }
+    worker();
+    group.Wait();
+
+    // 任务中的日志（导入统计等）先于汇总行输出
+    cad_core::Logger::Instance().Flush();
+    std::cout << inputs.size() - failed << " of " << inputs.size() << " jobs succeeded" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> g_liveBytes(0);
+std::atomic<std::size_t> g_allocations(0);
+
+// 每块前面留一个对齐的头记录大小，释放时减回去
+const std::size_t kHeader = alignof(std::max_align_t);
+
+void* CountedAllocate(std::size_t size) {
+    void* block = std::malloc(size + kHeader);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    g_liveBytes += size;
+    ++g_allocations;
+    return static_cast<char*>(block) + kHeader;
+}
+
+void CountedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    void* block = static_cast<char*>(pointer) - kHeader;
+    g_liveBytes -= *static_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return CountedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    CountedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    CountedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    CountedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    CountedFree(pointer);
+}
+
+namespace cad_bench {
+
+std::size_t AllocationCounter::LiveBytes() {
+    return g_liveBytes;
+}
+
+std::size_t AllocationCounter::AllocationCount() {
+    return g_allocations;
+}
+
+} // namespace cad_bench
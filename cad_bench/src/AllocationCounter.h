@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cad_bench {
+
+// 全局operator new/delete的计数（只链接进草图基准），用来估算每个草图实体占用的堆内存
+class AllocationCounter {
+public:
+    // 当前仍未释放的字节数
+    static std::size_t LiveBytes();
+    // 累计分配次数
+    static std::size_t AllocationCount();
+};
+
+} // namespace cad_bench
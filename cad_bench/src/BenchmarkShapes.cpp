@@ -0,0 +1,96 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/BooleanOperations.h"
+#include "cad_core/ShapeFactory.h"
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepBndLib.hxx>
+#include <Bnd_Box.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <algorithm>
+#include <cmath>
+
+namespace cad_bench {
+
+namespace {
+
+const double kHoleRadius = 2.0;
+const double kHolePitch = 10.0;
+const double kPlateThickness = 5.0;
+
+int GridSide(int holes) {
+    return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(holes)))));
+}
+
+} // namespace
+
+std::vector<cad_core::ShapePtr> OverlappingBoxes(int count) {
+    std::vector<cad_core::ShapePtr> boxes;
+    boxes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        // 相邻方块重叠一半，高度交错，避免共面
+        const double x = i * 5.0;
+        const double z = (i % 2) * 0.5;
+        boxes.push_back(cad_core::ShapeFactory::CreateBox(cad_core::Point(x, 0.0, z),
+                                                          cad_core::Point(x + 10.0, 10.0, z + 10.0)));
+    }
+    return boxes;
+}
+
+cad_core::ShapePtr Plate(int holes) {
+    const double side = GridSide(holes) * kHolePitch;
+    return cad_core::ShapeFactory::CreateBox(cad_core::Point(0.0, 0.0, 0.0),
+                                             cad_core::Point(side, side, kPlateThickness));
+}
+
+std::vector<cad_core::ShapePtr> HoleTools(int holes) {
+    const int side = GridSide(holes);
+    std::vector<cad_core::ShapePtr> tools;
+    tools.reserve(holes);
+    for (int i = 0; i < holes; ++i) {
+        cad_core::Point center((i % side + 0.5) * kHolePitch, (i / side + 0.5) * kHolePitch, -1.0);
+        tools.push_back(cad_core::ShapeFactory::CreateCylinder(center, kHoleRadius, kPlateThickness + 2.0));
+    }
+    return tools;
+}
+
+cad_core::ShapePtr PlateWithHoles(int holes) {
+    return cad_core::BooleanOperations::Difference(Plate(holes), HoleTools(holes));
+}
+
+std::vector<TopoDS_Edge> HoleRimEdges(const cad_core::ShapePtr& plate) {
+    std::vector<TopoDS_Edge> edges;
+    if (!plate) {
+        return edges;
+    }
+    for (TopExp_Explorer explorer(plate->GetOCCTShape(), TopAbs_EDGE); explorer.More(); explorer.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(explorer.Current());
+        BRepAdaptor_Curve curve(edge);
+        if (curve.GetType() != GeomAbs_Circle) {
+            continue;
+        }
+        Bnd_Box box;
+        BRepBndLib::Add(edge, box);
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        if (std::fabs(zmin - kPlateThickness) < 1e-3 && std::fabs(zmax - kPlateThickness) < 1e-3) {
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
+
+std::vector<cad_core::ShapePtr> SeparateBoxes(int count) {
+    std::vector<cad_core::ShapePtr> boxes;
+    boxes.reserve(count);
+    const int side = GridSide(count);
+    for (int i = 0; i < count; ++i) {
+        const double x = (i % side) * 20.0;
+        const double y = (i / side) * 20.0;
+        boxes.push_back(cad_core::ShapeFactory::CreateBox(cad_core::Point(x, y, 0.0),
+                                                          cad_core::Point(x + 10.0, y + 10.0, 10.0)));
+    }
+    return boxes;
+}
+
+} // namespace cad_bench
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "cad_core/Shape.h"
+#include <TopoDS_Edge.hxx>
+#include <vector>
+
+namespace cad_bench {
+
+// 基准用的合成模型，尺寸由问题规模决定，同样的参数每次生成同样的几何
+
+// n个沿X方向部分重叠的方块（N元并集的输入）
+std::vector<cad_core::ShapePtr> OverlappingBoxes(int count);
+
+// 边长随孔数增长的方板（多工具切除的目标）
+cad_core::ShapePtr Plate(int holes);
+
+// 与Plate(holes)配套的孔：holes个圆柱排成方阵
+std::vector<cad_core::ShapePtr> HoleTools(int holes);
+
+// 打好孔的方板
+cad_core::ShapePtr PlateWithHoles(int holes);
+
+// 方板顶面上孔口的圆边，圆角基准按数量取用
+std::vector<TopoDS_Edge> HoleRimEdges(const cad_core::ShapePtr& plate);
+
+// count个互不相交的方块（变换、OCAF基准用）
+std::vector<cad_core::ShapePtr> SeparateBoxes(int count);
+
+} // namespace cad_bench
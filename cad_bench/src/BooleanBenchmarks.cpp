@@ -0,0 +1,89 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/BooleanOperations.h"
+#include "cad_core/ShapeFactory.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// 两两运算：方块和穿过它的圆柱
+void BM_Boolean_PairwiseUnion(benchmark::State& state) {
+    cad_core::ShapePtr box = cad_core::ShapeFactory::CreateBox(20.0, 20.0, 20.0);
+    cad_core::ShapePtr cylinder = cad_core::ShapeFactory::CreateCylinder(cad_core::Point(10.0, 10.0, -5.0), 5.0, 30.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::BooleanOperations::Union(box, cylinder));
+    }
+}
+BENCHMARK(BM_Boolean_PairwiseUnion)->Unit(benchmark::kMillisecond);
+
+void BM_Boolean_PairwiseDifference(benchmark::State& state) {
+    cad_core::ShapePtr box = cad_core::ShapeFactory::CreateBox(20.0, 20.0, 20.0);
+    cad_core::ShapePtr cylinder = cad_core::ShapeFactory::CreateCylinder(cad_core::Point(10.0, 10.0, -5.0), 5.0, 30.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::BooleanOperations::Difference(box, cylinder));
+    }
+}
+BENCHMARK(BM_Boolean_PairwiseDifference)->Unit(benchmark::kMillisecond);
+
+void BM_Boolean_PairwiseIntersection(benchmark::State& state) {
+    cad_core::ShapePtr box = cad_core::ShapeFactory::CreateBox(20.0, 20.0, 20.0);
+    cad_core::ShapePtr sphere = cad_core::ShapeFactory::CreateSphere(cad_core::Point(10.0, 10.0, 10.0), 13.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::BooleanOperations::Intersection(box, sphere));
+    }
+}
+BENCHMARK(BM_Boolean_PairwiseIntersection)->Unit(benchmark::kMillisecond);
+
+// N元并集：一串部分重叠的方块
+void BM_Boolean_NaryUnion(benchmark::State& state) {
+    std::vector<cad_core::ShapePtr> boxes = cad_bench::OverlappingBoxes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        cad_core::ShapePtr result = cad_core::BooleanOperations::Union(boxes);
+        if (!result) {
+            state.SkipWithError("union failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Boolean_NaryUnion)->RangeMultiplier(2)->Range(2, 64)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 多工具切除：一次从方板上减去N个孔
+void BM_Boolean_MultiToolCut(benchmark::State& state) {
+    const int holes = static_cast<int>(state.range(0));
+    cad_core::ShapePtr plate = cad_bench::Plate(holes);
+    std::vector<cad_core::ShapePtr> tools = cad_bench::HoleTools(holes);
+    for (auto _ : state) {
+        cad_core::ShapePtr result = cad_core::BooleanOperations::Difference(plate, tools);
+        if (!result) {
+            state.SkipWithError("cut failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(holes);
+}
+BENCHMARK(BM_Boolean_MultiToolCut)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 对照组：同样的孔逐个减去
+void BM_Boolean_SequentialCut(benchmark::State& state) {
+    const int holes = static_cast<int>(state.range(0));
+    cad_core::ShapePtr plate = cad_bench::Plate(holes);
+    std::vector<cad_core::ShapePtr> tools = cad_bench::HoleTools(holes);
+    for (auto _ : state) {
+        cad_core::ShapePtr result = plate;
+        for (const cad_core::ShapePtr& tool : tools) {
+            result = result ? cad_core::BooleanOperations::Difference(result, tool) : nullptr;
+        }
+        if (!result) {
+            state.SkipWithError("cut failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(holes);
+}
+BENCHMARK(BM_Boolean_SequentialCut)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond)->Complexity();
+
+} // namespace
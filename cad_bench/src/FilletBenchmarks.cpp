@@ -0,0 +1,42 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/FilletChamferOperations.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+
+namespace {
+
+// 给方板上的前N个孔口倒圆角
+void BM_Fillet_HoleRims(benchmark::State& state) {
+    const int edgeCount = static_cast<int>(state.range(0));
+    cad_core::ShapePtr plate = cad_bench::PlateWithHoles(edgeCount);
+    std::vector<TopoDS_Edge> edges = cad_bench::HoleRimEdges(plate);
+    if (static_cast<int>(edges.size()) < edgeCount) {
+        state.SkipWithError("not enough hole rims");
+        return;
+    }
+    edges.resize(edgeCount);
+    for (auto _ : state) {
+        cad_core::ShapePtr result = cad_core::FilletChamferOperations::CreateFillet(plate, edges, 0.5);
+        if (!result) {
+            state.SkipWithError("fillet failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(edgeCount);
+}
+BENCHMARK(BM_Fillet_HoleRims)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 方板外轮廓：12条直边，相邻圆角在角点相交
+void BM_Fillet_BoxEdges(benchmark::State& state) {
+    cad_core::ShapePtr plate = cad_bench::Plate(1);
+    std::vector<TopoDS_Edge> edges = cad_core::FilletChamferOperations::GetEdges(plate);
+    edges.resize(std::min<size_t>(edges.size(), static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::FilletChamferOperations::CreateFillet(plate, edges, 1.0));
+    }
+}
+BENCHMARK(BM_Fillet_BoxEdges)->DenseRange(1, 12, 11)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,87 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/OCAFManager.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+namespace {
+
+// 新建一个文档，放入count个形状（名称为Part0、Part1……）
+std::unique_ptr<cad_core::OCAFManager> MakeDocument(const std::vector<cad_core::ShapePtr>& shapes) {
+    auto manager = std::make_unique<cad_core::OCAFManager>();
+    manager->Initialize();
+    manager->NewDocument();
+    manager->StartTransaction("Populate");
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        manager->AddShape(shapes[i], "Part" + std::to_string(i));
+    }
+    manager->CommitTransaction();
+    return manager;
+}
+
+// 一个事务里加入N个形状，包括名称查重
+void BM_Ocaf_AddShapes(benchmark::State& state) {
+    std::vector<cad_core::ShapePtr> shapes = cad_bench::SeparateBoxes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        cad_core::OCAFManager manager;
+        manager.Initialize();
+        manager.NewDocument();
+        state.ResumeTiming();
+
+        manager.StartTransaction("Add");
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            manager.AddShape(shapes[i], "Part" + std::to_string(i));
+        }
+        manager.CommitTransaction();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Ocaf_AddShapes)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 在N个形状的文档里按名称查找
+void BM_Ocaf_FindByName(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto manager = MakeDocument(cad_bench::SeparateBoxes(count));
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager->GetShape("Part" + std::to_string(index)));
+        index = (index + 7919) % count;
+    }
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_Ocaf_FindByName)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond)->Complexity();
+
+// 列出所有形状（文档树刷新、保存快照都要走一遍）
+void BM_Ocaf_GetAllShapes(benchmark::State& state) {
+    auto manager = MakeDocument(cad_bench::SeparateBoxes(static_cast<int>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager->GetAllShapes());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Ocaf_GetAllShapes)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond)->Complexity();
+
+// 逐个删除全部形状，每次删除一个事务
+void BM_Ocaf_RemoveShapes(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    std::vector<cad_core::ShapePtr> shapes = cad_bench::SeparateBoxes(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto manager = MakeDocument(shapes);
+        state.ResumeTiming();
+
+        for (int i = 0; i < count; ++i) {
+            manager->StartTransaction("Remove");
+            manager->RemoveShape("Part" + std::to_string(i));
+            manager->CommitTransaction();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_Ocaf_RemoveShapes)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond)->Complexity();
+
+} // namespace
@@ -0,0 +1,57 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/ShapeFactory.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// 基本体：构造本身很便宜，主要看ShapePtr包装和BRepPrimAPI的固定开销
+void BM_ShapeFactory_Box(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::ShapeFactory::CreateBox(10.0, 20.0, 30.0));
+    }
+}
+BENCHMARK(BM_ShapeFactory_Box);
+
+void BM_ShapeFactory_Cylinder(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::ShapeFactory::CreateCylinder(5.0, 20.0));
+    }
+}
+BENCHMARK(BM_ShapeFactory_Cylinder);
+
+void BM_ShapeFactory_Sphere(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cad_core::ShapeFactory::CreateSphere(10.0));
+    }
+}
+BENCHMARK(BM_ShapeFactory_Sphere);
+
+// 质量属性：面数随孔数增长，Volume/Area每次都重新积分
+void BM_Shape_Volume(benchmark::State& state) {
+    cad_core::ShapePtr plate = cad_bench::PlateWithHoles(static_cast<int>(state.range(0)));
+    if (!plate) {
+        state.SkipWithError("failed to build plate");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plate->Volume());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Shape_Volume)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond)->Complexity();
+
+void BM_Shape_Area(benchmark::State& state) {
+    cad_core::ShapePtr plate = cad_bench::PlateWithHoles(static_cast<int>(state.range(0)));
+    if (!plate) {
+        state.SkipWithError("failed to build plate");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(plate->Area());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Shape_Area)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond)->Complexity();
+
+} // namespace
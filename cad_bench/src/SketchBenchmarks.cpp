@@ -0,0 +1,134 @@
+#include "AllocationCounter.h"
+#include "SketchCorpus.h"
+
+#include "cad_sketch/SnappingManager.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 把第一个点挪开一点再求解，模拟一次编辑（原始语料本身满足约束，求解器会立即返回）
+void SolveAfterEdit(benchmark::State& state, const cad_sketch::SketchPtr& sketch) {
+    cad_sketch::SketchPointPtr point = cad_bench::FirstPoint(*sketch);
+    const double x = point->GetX();
+    const double y = point->GetY();
+    int converged = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        point->SetXY(x + 0.5, y + 0.5);
+        state.ResumeTiming();
+        converged += sketch->SolveConstraints() ? 1 : 0;
+    }
+    state.counters["elements"] = sketch->GetElementCount();
+    state.counters["constraints"] = sketch->GetConstraintCount();
+    state.counters["converged"] = benchmark::Counter(converged, benchmark::Counter::kAvgIterations);
+    state.SetComplexityN(sketch->GetConstraintCount());
+}
+
+void BM_Solve_RectangleGrid(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    SolveAfterEdit(state, cad_bench::ConstrainedRectangleGrid(side, side));
+}
+BENCHMARK(BM_Solve_RectangleGrid)->RangeMultiplier(2)->Range(4, 64)->Unit(benchmark::kMillisecond)->Complexity();
+
+void BM_Solve_RandomPolyline(benchmark::State& state) {
+    SolveAfterEdit(state, cad_bench::RandomPolyline(static_cast<int>(state.range(0)), 42));
+}
+BENCHMARK(BM_Solve_RandomPolyline)->RangeMultiplier(4)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+
+void BM_Solve_Gear(benchmark::State& state) {
+    SolveAfterEdit(state, cad_bench::GearProfile(static_cast<int>(state.range(0))));
+}
+BENCHMARK(BM_Solve_Gear)->RangeMultiplier(2)->Range(12, 192)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 拖动：每帧移动一个点、捕捉、求解，整个循环的耗时就是一帧的交互延迟
+void BM_Drag_RectangleGrid(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    cad_sketch::SketchPtr sketch = cad_bench::ConstrainedRectangleGrid(side, side);
+    cad_sketch::SketchPointPtr point = cad_bench::FirstPoint(*sketch);
+    cad_sketch::SnappingManager snapping;
+    snapping.SetSnapTolerance(0.5);
+    const double x = point->GetX();
+    const double y = point->GetY();
+    int frame = 0;
+    for (auto _ : state) {
+        const double offset = 0.01 * (frame++ % 100);
+        cad_sketch::SnapResult snap = snapping.FindSnapPoint(cad_core::Point(x + offset, y + offset, 0.0),
+                                                             sketch->GetElements());
+        if (snap.found) {
+            point->SetXY(snap.snapPoint.X(), snap.snapPoint.Y());
+        } else {
+            point->SetXY(x + offset, y + offset);
+        }
+        benchmark::DoNotOptimize(sketch->SolveConstraints());
+    }
+    state.counters["elements"] = sketch->GetElementCount();
+    state.SetComplexityN(sketch->GetElementCount());
+}
+BENCHMARK(BM_Drag_RectangleGrid)->RangeMultiplier(2)->Range(4, 64)->Unit(benchmark::kMicrosecond)->Complexity();
+
+// 捕捉查询：光标在导入的大图上随机移动
+void BM_Snap_DxfImport(benchmark::State& state) {
+    const int segments = static_cast<int>(state.range(0));
+    cad_sketch::SketchPtr sketch = cad_bench::DxfLikeImport(segments, 7);
+    cad_sketch::SnappingManager snapping;
+    snapping.SetSnapTolerance(0.25);
+    snapping.EnableSnapType(cad_sketch::SnapType::Center);
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<double> coordinate(0.0, 50.0 * std::sqrt(segments / 100.0 + 1.0));
+    std::vector<cad_core::Point> queries;
+    for (int i = 0; i < 1024; ++i) {
+        queries.emplace_back(coordinate(random), coordinate(random), 0.0);
+    }
+
+    size_t query = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snapping.FindSnapPoint(queries[query++ % queries.size()], sketch->GetElements()));
+    }
+    state.counters["elements"] = sketch->GetElementCount();
+    state.SetComplexityN(segments);
+}
+BENCHMARK(BM_Snap_DxfImport)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond)->Complexity();
+
+// 每个实体（元素和约束）占用的堆内存
+template <typename Generator>
+void MeasureMemory(benchmark::State& state, Generator generate) {
+    double bytesPerEntity = 0.0;
+    double allocationsPerEntity = 0.0;
+    for (auto _ : state) {
+        const size_t bytesBefore = cad_bench::AllocationCounter::LiveBytes();
+        const size_t allocationsBefore = cad_bench::AllocationCounter::AllocationCount();
+        cad_sketch::SketchPtr sketch = generate();
+        const double entities = sketch->GetElementCount() + sketch->GetConstraintCount();
+        bytesPerEntity = (cad_bench::AllocationCounter::LiveBytes() - bytesBefore) / entities;
+        allocationsPerEntity = (cad_bench::AllocationCounter::AllocationCount() - allocationsBefore) / entities;
+        state.PauseTiming();
+        sketch.reset();
+        state.ResumeTiming();
+    }
+    state.counters["bytes_per_entity"] = bytesPerEntity;
+    state.counters["allocations_per_entity"] = allocationsPerEntity;
+}
+
+void BM_Memory_RectangleGrid(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    MeasureMemory(state, [side]() { return cad_bench::ConstrainedRectangleGrid(side, side); });
+}
+BENCHMARK(BM_Memory_RectangleGrid)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+void BM_Memory_Gear(benchmark::State& state) {
+    const int teeth = static_cast<int>(state.range(0));
+    MeasureMemory(state, [teeth]() { return cad_bench::GearProfile(teeth); });
+}
+BENCHMARK(BM_Memory_Gear)->Arg(48)->Arg(192)->Unit(benchmark::kMillisecond);
+
+void BM_Memory_DxfImport(benchmark::State& state) {
+    const int segments = static_cast<int>(state.range(0));
+    MeasureMemory(state, [segments]() { return cad_bench::DxfLikeImport(segments, 7); });
+}
+BENCHMARK(BM_Memory_DxfImport)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,233 @@
+#include "SketchCorpus.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace cad_bench {
+
+using cad_sketch::ConstraintType;
+using cad_sketch::SketchArc;
+using cad_sketch::SketchLine;
+using cad_sketch::SketchPoint;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+cad_sketch::SketchPointPtr PointOf(const cad_sketch::SketchElementPtr& element) {
+    return std::dynamic_pointer_cast<SketchPoint>(element);
+}
+
+cad_sketch::SketchLinePtr LineOf(const cad_sketch::SketchElementPtr& element) {
+    return std::dynamic_pointer_cast<SketchLine>(element);
+}
+
+double LineLength(const cad_sketch::SketchElementPtr& element) {
+    auto line = LineOf(element);
+    return line ? line->GetLength() : 0.0;
+}
+
+// 线和它的两个端点都作为元素加入草图
+cad_sketch::SketchLinePtr AddLine(cad_sketch::Sketch& sketch, double x1, double y1, double x2, double y2) {
+    auto start = std::make_shared<SketchPoint>(x1, y1);
+    auto end = std::make_shared<SketchPoint>(x2, y2);
+    auto line = std::make_shared<SketchLine>(start, end);
+    sketch.AddElement(start);
+    sketch.AddElement(end);
+    sketch.AddElement(line);
+    return line;
+}
+
+void AddConstraint(cad_sketch::Sketch& sketch, ConstraintType type, double value,
+                   const cad_sketch::SketchElementPtr& first,
+                   const cad_sketch::SketchElementPtr& second = nullptr) {
+    auto constraint = std::make_shared<CorpusConstraint>(type, value);
+    constraint->AddElement(first);
+    if (second) {
+        constraint->AddElement(second);
+    }
+    sketch.AddConstraint(constraint);
+}
+
+void Coincident(cad_sketch::Sketch& sketch, const cad_sketch::SketchPointPtr& a, const cad_sketch::SketchPointPtr& b) {
+    AddConstraint(sketch, ConstraintType::Coincident, 0.0, a, b);
+}
+
+} // namespace
+
+CorpusConstraint::CorpusConstraint(ConstraintType type, double value)
+    : Constraint(type), m_value(value) {
+}
+
+bool CorpusConstraint::IsValid() const {
+    switch (m_type) {
+        case ConstraintType::Horizontal:
+        case ConstraintType::Vertical:
+            return m_elements.size() == 1 && LineOf(m_elements[0]) != nullptr;
+        case ConstraintType::Radius:
+            return m_elements.size() == 1;
+        default:
+            return m_elements.size() == 2;
+    }
+}
+
+std::string CorpusConstraint::GetDescription() const {
+    return "Corpus constraint " + std::to_string(m_id);
+}
+
+double CorpusConstraint::GetError() const {
+    switch (m_type) {
+        case ConstraintType::Horizontal: {
+            auto line = LineOf(m_elements[0]);
+            return line->GetEndPoint()->GetY() - line->GetStartPoint()->GetY();
+        }
+        case ConstraintType::Vertical: {
+            auto line = LineOf(m_elements[0]);
+            return line->GetEndPoint()->GetX() - line->GetStartPoint()->GetX();
+        }
+        case ConstraintType::Coincident:
+        case ConstraintType::Distance: {
+            auto a = PointOf(m_elements[0]);
+            auto b = PointOf(m_elements[1]);
+            if (!a || !b) {
+                return 0.0;
+            }
+            return a->GetPoint().Distance(b->GetPoint()) - m_value;
+        }
+        case ConstraintType::Radius: {
+            auto arc = std::dynamic_pointer_cast<SketchArc>(m_elements[0]);
+            return arc ? arc->GetRadius() - m_value : 0.0;
+        }
+        case ConstraintType::Equal:
+            return LineLength(m_elements[0]) - LineLength(m_elements[1]);
+        default:
+            return 0.0;
+    }
+}
+
+cad_sketch::SketchPtr ConstrainedRectangleGrid(int rows, int cols) {
+    auto sketch = std::make_shared<cad_sketch::Sketch>("Rectangle grid");
+    const double width = 8.0;
+    const double height = 5.0;
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            const double x = col * 10.0;
+            const double y = row * 10.0;
+            auto bottom = AddLine(*sketch, x, y, x + width, y);
+            auto right = AddLine(*sketch, x + width, y, x + width, y + height);
+            auto top = AddLine(*sketch, x + width, y + height, x, y + height);
+            auto left = AddLine(*sketch, x, y + height, x, y);
+
+            Coincident(*sketch, bottom->GetEndPoint(), right->GetStartPoint());
+            Coincident(*sketch, right->GetEndPoint(), top->GetStartPoint());
+            Coincident(*sketch, top->GetEndPoint(), left->GetStartPoint());
+            Coincident(*sketch, left->GetEndPoint(), bottom->GetStartPoint());
+            AddConstraint(*sketch, ConstraintType::Horizontal, 0.0, bottom);
+            AddConstraint(*sketch, ConstraintType::Horizontal, 0.0, top);
+            AddConstraint(*sketch, ConstraintType::Vertical, 0.0, left);
+            AddConstraint(*sketch, ConstraintType::Vertical, 0.0, right);
+            AddConstraint(*sketch, ConstraintType::Distance, width, bottom->GetStartPoint(), bottom->GetEndPoint());
+            AddConstraint(*sketch, ConstraintType::Distance, height, left->GetEndPoint(), left->GetStartPoint());
+        }
+    }
+    return sketch;
+}
+
+cad_sketch::SketchPtr RandomPolyline(int segments, std::uint32_t seed) {
+    auto sketch = std::make_shared<cad_sketch::Sketch>("Random polyline");
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> step(-5.0, 5.0);
+    double x = 0.0;
+    double y = 0.0;
+    cad_sketch::SketchLinePtr previous;
+    for (int i = 0; i < segments; ++i) {
+        const double nx = x + step(random);
+        const double ny = y + step(random);
+        auto line = AddLine(*sketch, x, y, nx, ny);
+        if (previous) {
+            Coincident(*sketch, previous->GetEndPoint(), line->GetStartPoint());
+        }
+        previous = line;
+        x = nx;
+        y = ny;
+    }
+    return sketch;
+}
+
+cad_sketch::SketchPtr GearProfile(int teeth) {
+    auto sketch = std::make_shared<cad_sketch::Sketch>("Gear profile");
+    const double rootRadius = teeth * 1.0;
+    const double tipRadius = rootRadius + 2.25;
+    const double pitch = 2.0 * kPi / teeth;
+    auto center = std::make_shared<SketchPoint>(0.0, 0.0);
+    sketch->AddElement(center);
+
+    cad_sketch::SketchLinePtr firstFlank;
+    cad_sketch::SketchLinePtr previousFlank;
+    for (int i = 0; i < teeth; ++i) {
+        // 一个齿距：齿根弧、上升齿廓、齿顶弧、下降齿廓
+        const double a0 = i * pitch;
+        const double a1 = a0 + pitch * 0.25;
+        const double a2 = a0 + pitch * 0.40;
+        const double a3 = a0 + pitch * 0.60;
+        const double a4 = a0 + pitch * 0.75;
+
+        auto root = std::make_shared<SketchArc>(center, rootRadius, a0, a1);
+        auto tip = std::make_shared<SketchArc>(center, tipRadius, a2, a3);
+        sketch->AddElement(root);
+        sketch->AddElement(tip);
+        auto rising = AddLine(*sketch, rootRadius * std::cos(a1), rootRadius * std::sin(a1),
+                              tipRadius * std::cos(a2), tipRadius * std::sin(a2));
+        auto falling = AddLine(*sketch, tipRadius * std::cos(a3), tipRadius * std::sin(a3),
+                               rootRadius * std::cos(a4), rootRadius * std::sin(a4));
+
+        AddConstraint(*sketch, ConstraintType::Radius, rootRadius, root);
+        AddConstraint(*sketch, ConstraintType::Radius, tipRadius, tip);
+        AddConstraint(*sketch, ConstraintType::Equal, 0.0, rising, falling);
+        if (previousFlank) {
+            Coincident(*sketch, previousFlank->GetEndPoint(), rising->GetStartPoint());
+        }
+        if (!firstFlank) {
+            firstFlank = rising;
+        } else {
+            AddConstraint(*sketch, ConstraintType::Equal, 0.0, firstFlank, rising);
+        }
+        previousFlank = falling;
+    }
+    return sketch;
+}
+
+cad_sketch::SketchPtr DxfLikeImport(int segments, std::uint32_t seed) {
+    auto sketch = std::make_shared<cad_sketch::Sketch>("DXF import");
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> jitter(-0.4, 0.4);
+    // 每条折线100段，折线起点按网格铺开，整体尺寸随段数增长
+    const int perPolyline = 100;
+    const int polylines = (segments + perPolyline - 1) / perPolyline;
+    const int side = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(polylines)))));
+    int created = 0;
+    for (int p = 0; p < polylines; ++p) {
+        double x = (p % side) * 50.0;
+        double y = (p / side) * 50.0;
+        for (int s = 0; s < perPolyline && created < segments; ++s, ++created) {
+            const double nx = x + 0.5 + jitter(random);
+            const double ny = y + jitter(random);
+            AddLine(*sketch, x, y, nx, ny);
+            x = nx;
+            y = ny;
+        }
+    }
+    return sketch;
+}
+
+cad_sketch::SketchPointPtr FirstPoint(const cad_sketch::Sketch& sketch) {
+    for (const auto& element : sketch.GetElements()) {
+        if (auto point = PointOf(element)) {
+            return point;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace cad_bench
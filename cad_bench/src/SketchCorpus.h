@@ -0,0 +1,42 @@
+#pragma once
+
+#include "cad_sketch/Constraint.h"
+#include "cad_sketch/Sketch.h"
+#include <cstdint>
+
+namespace cad_bench {
+
+/**
+ * 草图基准用的合成语料。同样的参数和种子每次生成同样的草图。
+ *
+ * cad_sketch里还只有Constraint基类，这里按ConstraintType补上最小的具体约束
+ * （误差即几何偏差），让求解器有真实规模的约束表可以遍历。
+ */
+class CorpusConstraint : public cad_sketch::Constraint {
+public:
+    CorpusConstraint(cad_sketch::ConstraintType type, double value = 0.0);
+
+    bool IsValid() const override;
+    std::string GetDescription() const override;
+    double GetError() const override;
+
+private:
+    double m_value;
+};
+
+// rows × cols个矩形：每个矩形4条线各自带端点，端点重合、水平/竖直、宽高尺寸约束
+cad_sketch::SketchPtr ConstrainedRectangleGrid(int rows, int cols);
+
+// segments段随机折线：相邻线段端点用重合约束串起来
+cad_sketch::SketchPtr RandomPolyline(int segments, std::uint32_t seed);
+
+// teeth个齿的齿轮轮廓：齿顶、齿根圆弧加两侧齿廓直线，带半径和等长约束
+cad_sketch::SketchPtr GearProfile(int teeth);
+
+// 类似DXF导入的大量线段（只有几何，没有约束），按网格分布的若干条折线
+cad_sketch::SketchPtr DxfLikeImport(int segments, std::uint32_t seed);
+
+// 草图中第一个点元素（拖动基准移动它）
+cad_sketch::SketchPointPtr FirstPoint(const cad_sketch::Sketch& sketch);
+
+} // namespace cad_bench
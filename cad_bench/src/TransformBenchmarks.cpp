@@ -0,0 +1,42 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/TransformCommand.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// 一条变换命令作用在N个形状上（对应框选一大片零件再移动）
+void BM_Transform_TranslateBatch(benchmark::State& state) {
+    std::vector<cad_core::ShapePtr> shapes = cad_bench::SeparateBoxes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        cad_core::TransformCommand command(shapes, cad_core::TransformationType::Translate);
+        command.SetTranslation(5.0, 0.0, 0.0);
+        if (!command.Execute()) {
+            state.SkipWithError("transform failed");
+            break;
+        }
+        benchmark::DoNotOptimize(command.GetTransformedShapes());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Transform_TranslateBatch)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond)->Complexity();
+
+void BM_Transform_RotateBatch(benchmark::State& state) {
+    std::vector<cad_core::ShapePtr> shapes = cad_bench::SeparateBoxes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        cad_core::TransformCommand command(shapes, cad_core::TransformationType::Rotate);
+        command.SetRotationAxis(cad_core::Point(0.0, 0.0, 0.0), cad_core::Point(0.0, 0.0, 1.0));
+        command.SetRotationAngleDegrees(30.0);
+        if (!command.Execute()) {
+            state.SkipWithError("transform failed");
+            break;
+        }
+        benchmark::DoNotOptimize(command.GetTransformedShapes());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Transform_RotateBatch)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond)->Complexity();
+
+} // namespace
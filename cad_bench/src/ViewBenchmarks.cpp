@@ -0,0 +1,216 @@
+#include "BenchmarkShapes.h"
+
+#include "cad_core/ShapeFactory.h"
+#include "cad_ui/QtOccView.h"
+#include <AIS_InteractiveContext.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+#include <QApplication>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// 离屏视图尺寸：与常见的主视图大小相当，帧时间才有可比性
+const int kViewWidth = 1280;
+const int kViewHeight = 800;
+
+// 所有视图基准共用一个QApplication；没有指定平台时用offscreen插件，
+// OpenGL上下文仍来自显示连接（CI上用xvfb-run + Mesa软件渲染）
+QApplication& SharedApplication() {
+    static int argc = 1;
+    static char name[] = "cad_view_bench";
+    static char* argv[] = { name, nullptr };
+    static std::unique_ptr<QApplication> application;
+    if (!application) {
+        if (std::getenv("QT_QPA_PLATFORM") == nullptr) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        application.reset(new QApplication(argc, argv));
+    }
+    return *application;
+}
+
+// 每个基准一个新的离屏视图，初始化失败（没有OpenGL）时跳过
+std::unique_ptr<cad_ui::QtOccView> CreateView(benchmark::State& state) {
+    SharedApplication();
+    std::unique_ptr<cad_ui::QtOccView> view(new cad_ui::QtOccView());
+    if (!view->InitOffscreen(kViewWidth, kViewHeight)) {
+        state.SkipWithError("offscreen OpenGL view is not available");
+        return nullptr;
+    }
+    return view;
+}
+
+// 等GPU执行完本帧的命令，否则只测到了命令提交的时间
+void FinishFrame(const cad_ui::QtOccView& view) {
+    Handle(OpenGl_GraphicDriver) driver =
+        Handle(OpenGl_GraphicDriver)::DownCast(view.GetView()->Viewer()->Driver());
+    if (!driver.IsNull() && !driver->GetSharedContext().IsNull()) {
+        driver->GetSharedContext()->core11fwd->glFinish();
+    }
+}
+
+// 方块与球交替排成方阵：平面和需要细分的曲面各占一半
+std::vector<cad_core::ShapePtr> Scene(int parts) {
+    std::vector<cad_core::ShapePtr> scene = cad_bench::SeparateBoxes(parts);
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(parts))));
+    for (int i = 1; i < parts; i += 2) {
+        const double x = (i % side) * 20.0 + 5.0;
+        const double y = (i / side) * 20.0 + 5.0;
+        scene[i] = cad_core::ShapeFactory::CreateSphere(cad_core::Point(x, y, 5.0), 5.0);
+    }
+    return scene;
+}
+
+// 显示一批零件的时间（包含着色模式下的三角化和选择结构）
+void BM_View_DisplayBatch(benchmark::State& state) {
+    std::unique_ptr<cad_ui::QtOccView> view = CreateView(state);
+    if (!view) {
+        return;
+    }
+    std::vector<cad_core::ShapePtr> scene = Scene(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        view->ClearShapes();
+        for (const cad_core::ShapePtr& shape : scene) {
+            BRepTools::Clean(shape->GetOCCTShape());
+        }
+        state.ResumeTiming();
+        view->DisplayShapes(scene);
+        FinishFrame(*view);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_View_DisplayBatch)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 对照组：逐个显示，每个零件各适配视图、重绘一次
+void BM_View_DisplayOneByOne(benchmark::State& state) {
+    std::unique_ptr<cad_ui::QtOccView> view = CreateView(state);
+    if (!view) {
+        return;
+    }
+    std::vector<cad_core::ShapePtr> scene = Scene(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        view->ClearShapes();
+        for (const cad_core::ShapePtr& shape : scene) {
+            BRepTools::Clean(shape->GetOCCTShape());
+        }
+        state.ResumeTiming();
+        for (const cad_core::ShapePtr& shape : scene) {
+            view->DisplayShape(shape);
+        }
+        FinishFrame(*view);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_View_DisplayOneByOne)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 单独的三角化时间，区分网格生成和显示对象、绘制的开销
+void BM_View_Tessellate(benchmark::State& state) {
+    cad_core::ShapePtr plate = cad_bench::PlateWithHoles(static_cast<int>(state.range(0)));
+    if (!plate) {
+        state.SkipWithError("plate construction failed");
+        return;
+    }
+    const TopoDS_Shape& shape = plate->GetOCCTShape();
+    for (auto _ : state) {
+        state.PauseTiming();
+        BRepTools::Clean(shape);
+        state.ResumeTiming();
+        BRepMesh_IncrementalMesh mesh(shape, 0.1, Standard_False, 0.5, Standard_True);
+        benchmark::DoNotOptimize(mesh.IsDone());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_View_Tessellate)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 脚本化的相机运动，每次迭代绘制一帧；每帧时间即迭代时间，帧率见fps计数器
+enum class CameraPath { Orbit, Pan, Zoom };
+
+void RenderFrames(benchmark::State& state, CameraPath path) {
+    std::unique_ptr<cad_ui::QtOccView> view = CreateView(state);
+    if (!view) {
+        return;
+    }
+    view->DisplayShapes(Scene(static_cast<int>(state.range(0))));
+    FinishFrame(*view);
+
+    Handle(V3d_View) occView = view->GetView();
+    const int centerX = kViewWidth / 2;
+    const int centerY = kViewHeight / 2;
+    occView->StartRotation(centerX, centerY);
+    int frame = 0;
+    for (auto _ : state) {
+        // 往返运动，相机不会漂出场景
+        const int step = (frame / 60) % 2 == 0 ? 1 : -1;
+        switch (path) {
+        case CameraPath::Orbit:
+            view->Rotate(centerX + 4 * step * (frame % 60), centerY + step * (frame % 60));
+            break;
+        case CameraPath::Pan:
+            view->Pan(3 * step, 2 * step);
+            break;
+        case CameraPath::Zoom:
+            occView->SetZoom(step > 0 ? 1.02 : 1.0 / 1.02);
+            break;
+        }
+        occView->Redraw();
+        FinishFrame(*view);
+        ++frame;
+    }
+    state.counters["fps"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.SetComplexityN(state.range(0));
+}
+
+void BM_View_OrbitFrame(benchmark::State& state) {
+    RenderFrames(state, CameraPath::Orbit);
+}
+BENCHMARK(BM_View_OrbitFrame)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+void BM_View_PanFrame(benchmark::State& state) {
+    RenderFrames(state, CameraPath::Pan);
+}
+BENCHMARK(BM_View_PanFrame)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+void BM_View_ZoomFrame(benchmark::State& state) {
+    RenderFrames(state, CameraPath::Zoom);
+}
+BENCHMARK(BM_View_ZoomFrame)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+// 拾取延迟：鼠标移动时的预选（MoveTo）加一次点击选择，沿对角线扫过视图
+void BM_View_Pick(benchmark::State& state) {
+    std::unique_ptr<cad_ui::QtOccView> view = CreateView(state);
+    if (!view) {
+        return;
+    }
+    view->DisplayShapes(Scene(static_cast<int>(state.range(0))));
+    FinishFrame(*view);
+
+    Handle(AIS_InteractiveContext) context = view->GetContext();
+    Handle(V3d_View) occView = view->GetView();
+    int frame = 0;
+    int hits = 0;
+    for (auto _ : state) {
+        const double t = (frame % 97) / 96.0;
+        const int x = static_cast<int>(kViewWidth * (0.1 + 0.8 * t));
+        const int y = static_cast<int>(kViewHeight * (0.1 + 0.8 * t));
+        context->MoveTo(x, y, occView, Standard_False);
+        hits += context->HasDetected() ? 1 : 0;
+        context->SelectDetected(AIS_SelectionScheme_Replace);
+        context->UpdateCurrentViewer();
+        FinishFrame(*view);
+        ++frame;
+    }
+    state.counters["hit_rate"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_View_Pick)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+} // namespace
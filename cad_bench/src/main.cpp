@@ -0,0 +1,49 @@
+/**
+ * @file main.cpp
+ * @brief 各个基准程序共用的入口
+ *
+ * 在Google Benchmark的默认入口上补两点：没有指定--benchmark_out时结果同时写到
+ * <程序名>.json（CAD_BENCH_OUTPUT），便于不同版本之间比较（tools/compare.py）；
+ * JSON的context里记下OCCT版本，换内核版本导致的变化一眼能看出来。
+ */
+
+#include "cad_core/TaskScheduler.h"
+#include <benchmark/benchmark.h>
+#include <Standard_Version.hxx>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef CAD_BENCH_OUTPUT
+#define CAD_BENCH_OUTPUT "cad_bench.json"
+#endif
+
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOutput = false;
+    bool hasFormat = false;
+    for (int i = 1; i < argc; ++i) {
+        hasOutput = hasOutput || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+        hasFormat = hasFormat || std::strncmp(argv[i], "--benchmark_out_format=", 23) == 0;
+    }
+    std::string output = std::string("--benchmark_out=") + CAD_BENCH_OUTPUT;
+    std::string format = "--benchmark_out_format=json";
+    if (!hasOutput) {
+        args.push_back(&output[0]);
+    }
+    if (!hasFormat) {
+        args.push_back(&format[0]);
+    }
+
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("occt_version", OCC_VERSION_COMPLETE);
+    // 和应用程序一样，先建调度器再跑任何OCCT并行算法
+    cad_core::TaskScheduler::Instance();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
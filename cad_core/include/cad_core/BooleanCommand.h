@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ICommand.h"
+#include "Shape.h"
+#include "BooleanOperations.h"
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class BooleanCommand
+ * @brief 布尔运算命令：只计算结果，文档（OCAF）的增删由界面在完成回调里处理
+ *
+ * 并集：所有目标和工具一次融合；交集：依次求交；差集：第一个目标减去全部工具。
+ */
+class BooleanCommand : public ICommand {
+public:
+    BooleanCommand(BooleanOperations::BooleanType type,
+                   const std::vector<ShapePtr>& targets,
+                   const std::vector<ShapePtr>& tools);
+    virtual ~BooleanCommand() = default;
+
+    bool Execute() override;
+    bool ExecuteWithProgress(const Message_ProgressRange& range) override;
+    bool Undo() override;
+    bool Redo() override;
+    const char* GetName() const override;
+
+    ShapePtr GetResult() const;
+
+private:
+    BooleanOperations::BooleanType m_type;
+    std::vector<ShapePtr> m_targets;
+    std::vector<ShapePtr> m_tools;
+    ShapePtr m_result;
+    bool m_executed;
+};
+
+} // namespace cad_core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cad_core/Shape.h"
+#include <Message_ProgressRange.hxx>
 #include <vector>
 
 namespace cad_core {
@@ -14,14 +15,18 @@ public:
         Difference    // 差集
     };
     
-    // 布尔运算
-    static ShapePtr Union(const ShapePtr& shape1, const ShapePtr& shape2);
-    static ShapePtr Union(const std::vector<ShapePtr>& shapes);
+    // 布尔运算；range用于报告进度，取消（UserBreak）时返回nullptr
+    static ShapePtr Union(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range = Message_ProgressRange());
+    static ShapePtr Union(const std::vector<ShapePtr>& shapes, const Message_ProgressRange& range = Message_ProgressRange());
     
-    static ShapePtr Intersection(const ShapePtr& shape1, const ShapePtr& shape2);
-    static ShapePtr Intersection(const std::vector<ShapePtr>& shapes);
+    static ShapePtr Intersection(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range = Message_ProgressRange());
+    static ShapePtr Intersection(const std::vector<ShapePtr>& shapes, const Message_ProgressRange& range = Message_ProgressRange());
     
-    static ShapePtr Difference(const ShapePtr& shape1, const ShapePtr& shape2);
+    static ShapePtr Difference(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range = Message_ProgressRange());
+    
+    // 多工具布尔：一个目标体对一组工具体，一次运算完成（阵列打孔等）
+    static ShapePtr Union(const ShapePtr& shape, const std::vector<ShapePtr>& tools, const Message_ProgressRange& range = Message_ProgressRange());
+    static ShapePtr Difference(const ShapePtr& shape, const std::vector<ShapePtr>& tools, const Message_ProgressRange& range = Message_ProgressRange());
     
     // 通用布尔运算
     static ShapePtr BooleanOperation(const ShapePtr& shape1, const ShapePtr& shape2, BooleanType type);
@@ -38,9 +43,11 @@ public:
     
 private:
     // 私有辅助方法
-    static ShapePtr PerformUnion(const ShapePtr& shape1, const ShapePtr& shape2);
-    static ShapePtr PerformIntersection(const ShapePtr& shape1, const ShapePtr& shape2);
-    static ShapePtr PerformDifference(const ShapePtr& shape1, const ShapePtr& shape2);
+    static ShapePtr PerformUnion(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range);
+    static ShapePtr PerformIntersection(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range);
+    static ShapePtr PerformDifference(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range);
+    static ShapePtr PerformMultiTool(const ShapePtr& shape, const std::vector<ShapePtr>& tools, bool cut,
+                                     const Message_ProgressRange& range);
     
     // 形状验证和修复
     static bool ValidateInputs(const ShapePtr& shape1, const ShapePtr& shape2);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace cad_core {
+
+// 原生文件格式和操作日志共用的二进制读写辅助
+
+// 按小端追加基本类型
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void Put(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        m_buffer.append(bytes, sizeof(T));
+    }
+    void PutString(const std::string& value) {
+        Put<std::uint32_t>(static_cast<std::uint32_t>(value.size()));
+        m_buffer.append(value);
+    }
+
+private:
+    std::string& m_buffer;
+};
+
+// 带越界检查的读取，越界后ok()为false，后续读取都返回零值
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t size) : m_pos(data), m_end(data + size), m_ok(true) {}
+
+    template <typename T>
+    T Get() {
+        T value = T();
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < sizeof(T)) {
+            m_ok = false;
+            return value;
+        }
+        std::memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+    std::string GetString() {
+        std::uint32_t length = Get<std::uint32_t>();
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < length) {
+            m_ok = false;
+            return std::string();
+        }
+        std::string value(m_pos, length);
+        m_pos += length;
+        return value;
+    }
+    // 原样取出一段数据（指向源缓冲区，不复制）
+    const char* GetBytes(size_t size) {
+        if (!m_ok || static_cast<size_t>(m_end - m_pos) < size) {
+            m_ok = false;
+            return nullptr;
+        }
+        const char* data = m_pos;
+        m_pos += size;
+        return data;
+    }
+    bool ok() const { return m_ok; }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+    bool m_ok;
+};
+
+} // namespace cad_core
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ICommand.h"
+#include "CommandProgress.h"
+#include "TaskScheduler.h"
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -8,10 +11,26 @@ namespace cad_core {
 
 class CommandManager {
 public:
+    // 把一个函数交给调用方的线程执行（界面用QMetaObject::invokeMethod排队）
+    using Dispatcher = std::function<void(std::function<void()>)>;
+    // 异步命令结束：succeeded表示执行成功且结果被接受，cancelled表示期间请求过取消
+    using CompletionCallback = std::function<void(bool succeeded, bool cancelled)>;
+
     CommandManager();
-    ~CommandManager() = default;
+    ~CommandManager();
 
     bool ExecuteCommand(CommandPtr command);
+    
+    // 在任务池上执行命令，progress可以为空；完成回调通过dispatch回到调用方的线程。
+    // 命令不进入历史记录：调用方在完成回调里把结果写入文档，撤销由文档的事务负责
+    void ExecuteCommandAsync(CommandPtr command, const Handle(CommandProgress)& progress,
+                             Dispatcher dispatch, CompletionCallback completion,
+                             TaskPriority priority = TaskPriority::Normal);
+    // 还有异步命令没有回到调用方线程
+    bool IsBusy() const { return m_pendingAsync > 0; }
+    // 等待工作线程上的命令执行完（完成回调仍由dispatch投递）
+    void WaitForAsyncCommands();
+    
     bool Undo();
     bool Redo();
     
@@ -23,8 +42,14 @@ public:
     const char* GetRedoCommandName() const;
 
 private:
+    void PushCommand(const CommandPtr& command);
+
     std::vector<CommandPtr> m_commands;
     int m_currentIndex;
+    int m_pendingAsync;
+    TaskGroup m_asyncTasks;
+    // 投递到调用方线程的完成回调持有它的weak_ptr，本对象析构后回调不再执行
+    std::shared_ptr<int> m_lifetime;
 };
 
-} // namespace cad_core
\ No newline at end of file
+} // namespace cad_core
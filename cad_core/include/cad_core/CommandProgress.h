@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Message_ProgressIndicator.hxx>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace cad_core {
+
+/**
+ * @class CommandProgress
+ * @brief 异步命令的进度和取消：OCCT算法通过Start()得到的Message_ProgressRange报告进度
+ *
+ * 回调在执行命令的工作线程上触发，只在百分比变化时调用；界面需要自己转回界面线程。
+ * Cancel()可以从任何线程调用，OCCT在下一次检查UserBreak()时停止运算。
+ */
+class CommandProgress : public Message_ProgressIndicator {
+public:
+    using Callback = std::function<void(int percent, const std::string& stage)>;
+
+    CommandProgress();
+
+    void SetCallback(Callback callback);
+
+    void Cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    bool IsCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+    int GetPercent() const { return m_percent.load(std::memory_order_relaxed); }
+
+    Standard_Boolean UserBreak() override;
+
+protected:
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) override;
+
+private:
+    std::atomic<bool> m_cancelled;
+    std::atomic<int> m_percent;
+    std::mutex m_callbackMutex;
+    Callback m_callback;
+};
+
+} // namespace cad_core
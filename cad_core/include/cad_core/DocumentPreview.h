@@ -0,0 +1,83 @@
+#pragma once
+
+#include "cad_core/NativeDocumentFile.h"
+#include <Bnd_Box.hxx>
+#include <TopoDS_Shape.hxx>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+class PreviewCache;
+
+/**
+ * @class DocumentPreview
+ * @brief 文档预览：缩略图、包围盒和粗网格
+ *
+ * 保存时生成，浏览文件时不用读B-rep就能显示。.acad文件把它写进PREV块，
+ * 其他格式放在PreviewCache里。缩略图是界面渲染好的PNG数据，这里只负责存取；
+ * 粗网格取自零件已有的三角网格，按网格点聚类简化，没有网格的零件用包围盒代替。
+ */
+class DocumentPreview {
+public:
+    DocumentPreview();
+
+    // 由零件生成包围盒和粗网格；只读形状，可以在后台线程调用
+    void Build(const std::vector<NativeDocumentFile::PartData>& parts,
+               size_t maxTriangles = kDefaultTriangles);
+
+    bool IsEmpty() const { return m_box.IsVoid() && m_image.empty(); }
+
+    void SetImage(const std::string& png, int width, int height);
+    const std::string& GetImage() const { return m_image; }
+    int GetImageWidth() const { return m_imageWidth; }
+    int GetImageHeight() const { return m_imageHeight; }
+
+    const Bnd_Box& GetBoundingBox() const { return m_box; }
+    size_t GetPartCount() const { return m_partCount; }
+    // 顶点坐标 x,y,z 依次排列；三角形每三个顶点序号一组
+    const std::vector<float>& GetVertices() const { return m_vertices; }
+    const std::vector<std::uint32_t>& GetTriangles() const { return m_triangles; }
+    // 粗网格做成只有三角网格的面（与导入的网格相同），用于显示
+    TopoDS_Shape CreateMeshShape() const;
+
+    std::string Encode() const;
+    bool Decode(const char* data, size_t size);
+
+    // 读取文件的预览：.acad读内嵌的块，其他格式（或没有内嵌预览的旧文件）查cache
+    static bool Load(const std::string& filename, const PreviewCache* cache, DocumentPreview& preview);
+
+    static const size_t kDefaultTriangles = 20000;
+
+private:
+    std::string m_image;
+    int m_imageWidth;
+    int m_imageHeight;
+    Bnd_Box m_box;
+    size_t m_partCount;
+    std::vector<float> m_vertices;
+    std::vector<std::uint32_t> m_triangles;
+};
+
+/**
+ * @class PreviewCache
+ * @brief 非原生格式文档的预览缓存
+ *
+ * 每个文档一个文件：<directory>/<key>.preview。键由文件大小和首尾各64KB内容
+ * 哈希得到：文件改动后自然失效，移动或复制后仍然命中，也不用读完整个文件。
+ */
+class PreviewCache {
+public:
+    explicit PreviewCache(const std::string& directory);
+
+    static std::string FileKey(const std::string& filename);
+
+    bool Load(const std::string& filename, DocumentPreview& preview) const;
+    bool Store(const std::string& filename, const DocumentPreview& preview) const;
+
+private:
+    std::string m_directory;
+};
+
+} // namespace cad_core
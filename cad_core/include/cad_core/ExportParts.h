@@ -0,0 +1,26 @@
+#pragma once
+
+#include "cad_core/OCAFDocument.h"
+#include "cad_core/Shape.h"
+#include <Quantity_Color.hxx>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+// 一个要导出的零件（STL/glTF/IGES导出共用）
+struct ExportPart {
+    ShapePtr shape;
+    std::string name;
+    bool hasColor = false;
+    Quantity_Color color;
+};
+
+// 文档中所有活动形状及其名称；STEP导入的颜色从XCAF颜色表中取。
+// 读文档，需要在主线程调用，得到的列表可以交给后台导出
+std::vector<ExportPart> CollectExportParts(OCAFDocument& document);
+
+// 导出文件里的零件名，空名按序号补成"Part N"
+std::string ExportPartName(const ExportPart& part, size_t index);
+
+} // namespace cad_core
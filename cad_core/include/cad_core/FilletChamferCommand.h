@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ICommand.h"
+#include "Shape.h"
+#include <TopoDS_Edge.hxx>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class FilletChamferCommand
+ * @brief 圆角/倒角命令：对每个形状上选中的边各做一次，只计算结果
+ *
+ * 文档（OCAF）的增删由界面在完成回调里处理；某个形状失败时跳过它，
+ * 至少有一个形状成功就算执行成功。
+ */
+class FilletChamferCommand : public ICommand {
+public:
+    enum class Type {
+        Fillet,
+        Chamfer
+    };
+
+    // (原形状, 结果形状)
+    using Result = std::pair<ShapePtr, ShapePtr>;
+
+    FilletChamferCommand(Type type, const std::map<ShapePtr, std::vector<TopoDS_Edge>>& edgesByShape, double size);
+    virtual ~FilletChamferCommand() = default;
+
+    bool Execute() override;
+    bool ExecuteWithProgress(const Message_ProgressRange& range) override;
+    bool Undo() override;
+    bool Redo() override;
+    const char* GetName() const override;
+
+    const std::vector<Result>& GetResults() const;
+
+private:
+    Type m_type;
+    std::map<ShapePtr, std::vector<TopoDS_Edge>> m_edgesByShape;
+    double m_size;
+    std::vector<Result> m_results;
+    bool m_executed;
+};
+
+} // namespace cad_core
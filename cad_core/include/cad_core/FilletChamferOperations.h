@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cad_core/Shape.h"
+#include <Message_ProgressRange.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <vector>
@@ -9,13 +10,15 @@ namespace cad_core {
 
 class FilletChamferOperations {
 public:
-    // 圆角操作
-    static ShapePtr CreateFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius);
+    // 圆角操作；range用于报告进度，取消（UserBreak）时返回nullptr
+    static ShapePtr CreateFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius,
+                                 const Message_ProgressRange& range = Message_ProgressRange());
     static ShapePtr CreateFillet(const ShapePtr& shape, const TopoDS_Edge& edge, double radius);
     static ShapePtr CreateVariableFillet(const ShapePtr& shape, const TopoDS_Edge& edge, double radius1, double radius2);
     
     // 倒角操作
-    static ShapePtr CreateChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance);
+    static ShapePtr CreateChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance,
+                                  const Message_ProgressRange& range = Message_ProgressRange());
     static ShapePtr CreateChamfer(const ShapePtr& shape, const TopoDS_Edge& edge, double distance);
     static ShapePtr CreateAsymmetricChamfer(const ShapePtr& shape, const TopoDS_Edge& edge, double distance1, double distance2);
     static ShapePtr CreateChamferByAngle(const ShapePtr& shape, const TopoDS_Edge& edge, double distance, double angle);
@@ -40,8 +43,10 @@ public:
     
 private:
     // 私有辅助方法
-    static ShapePtr PerformFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius);
-    static ShapePtr PerformChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance);
+    static ShapePtr PerformFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius,
+                                  const Message_ProgressRange& range = Message_ProgressRange());
+    static ShapePtr PerformChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance,
+                                   const Message_ProgressRange& range = Message_ProgressRange());
     static ShapePtr PostProcessResult(const TopoDS_Shape& result);
     
     // 边分析
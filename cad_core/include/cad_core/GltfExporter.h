@@ -0,0 +1,84 @@
+#pragma once
+
+#include "cad_core/ExportParts.h"
+#include <Quantity_Color.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Shape.hxx>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+// glTF导出参数
+struct GltfExportOptions {
+    double linearDeflection = 0.1;    // 最细一级的弦高误差（模型单位，毫米）
+    double angularDeflection = 0.5;   // 角度误差（弧度）
+    bool binary = true;               // GLB；false时写.gltf + .bin
+    int lodLevels = 0;                // 额外的粗糙级数，0表示不导出LOD
+    double lodFactor = 4.0;           // 每一级弦高误差放大的倍数
+};
+
+/**
+ * @class GltfExporter
+ * @brief glTF 2.0 / GLB导出（RWGltf_CafWriter）
+ *
+ * 零件先整理成一个临时XCAF文档：共享TShape的实例（阵列、装配里重复的零件）
+ * 只登记一个原型，其余作为带位置的组件引用，glTF里对应多个节点共用一个mesh。
+ * 网格化在形状的副本上进行，文档里的形状和视图的三角网格不受影响；导入的纯网格原样输出。
+ *
+ * 开启LOD时，原型复制一份拓扑按更粗的误差重新网格化，写成同目录下的
+ * <名称>_lod<N>.glb，不改动原形状上的网格。缓冲区不压缩（不使用Draco）。
+ *
+ * 只依赖cad_core，可以在没有界面的环境下运行。
+ */
+class GltfExporter {
+public:
+    using ProgressCallback = std::function<void(int percent)>;
+
+    explicit GltfExporter(const GltfExportOptions& options = GltfExportOptions());
+
+    void SetProgressCallback(ProgressCallback callback);
+
+    bool Export(const std::vector<ExportPart>& parts, const std::string& filename);
+
+    // 实际写出的文件（主文件在前，后面是各级LOD）
+    const std::vector<std::string>& GetWrittenFiles() const { return m_writtenFiles; }
+    size_t GetMeshCount() const { return m_prototypes.size(); }
+    size_t GetNodeCount() const { return m_instances.size(); }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 由进度指示器调用
+    void ReportProgress(int percent);
+
+    static std::string LodFileName(const std::string& filename, int level);
+
+private:
+    struct Prototype {
+        TopoDS_Shape shape;    // 不带位置
+        std::string name;
+        bool hasColor = false;
+        Quantity_Color color;
+    };
+    struct Instance {
+        int prototype = -1;
+        TopLoc_Location location;
+        std::string name;
+    };
+
+    void CollectPrototypes(const std::vector<ExportPart>& parts);
+    bool Tessellate(std::vector<TopoDS_Shape>& shapes, double deflection, int progressFrom, int progressTo);
+    Handle(TDocStd_Document) BuildDocument(const std::vector<TopoDS_Shape>& shapes);
+    bool Write(const Handle(TDocStd_Document)& document, const std::string& filename,
+               int progressFrom, int progressTo);
+
+    GltfExportOptions m_options;
+    ProgressCallback m_progressCallback;
+    std::vector<Prototype> m_prototypes;
+    std::vector<Instance> m_instances;
+    std::vector<std::string> m_writtenFiles;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
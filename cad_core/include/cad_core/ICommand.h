@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <Message_ProgressRange.hxx>
 #include <memory>
 
 namespace cad_core {
@@ -42,6 +43,16 @@ public:
      */
     virtual bool Execute() = 0;
     
+    /**
+     * 带进度的执行 - 异步执行时在任务池线程上调用
+     * 耗时的命令把range交给OCCT算法，就能报告进度并响应取消；默认直接调用Execute()
+     * @return true表示执行成功，取消或失败返回false
+     */
+    virtual bool ExecuteWithProgress(const Message_ProgressRange& range) {
+        (void)range;
+        return Execute();
+    }
+    
     /** 
      * 撤销命令 - "我后悔了，让我回到过去吧"
      * @return true表示撤销成功，false表示时光机坏了
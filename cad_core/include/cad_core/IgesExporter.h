@@ -0,0 +1,43 @@
+#pragma once
+
+#include "cad_core/ExportParts.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class IgesExporter
+ * @brief IGES导出（IGESCAFControl_Writer）
+ *
+ * 零件整理成一个临时XCAF文档后写出，保留名称和颜色。默认按曲面（类型144修剪曲面）
+ * 输出，兼容只读曲面的下游系统；需要时可以改为MSBO实体（类型186）。
+ * 一个IGES模型只能由一个线程翻译，整个Export()在后台线程运行，不阻塞界面。
+ */
+class IgesExporter {
+public:
+    using ProgressCallback = std::function<void(int percent)>;
+
+    IgesExporter();
+
+    void SetProgressCallback(ProgressCallback callback);
+    // true时写MSBO实体（write.iges.brep.mode = BRep）
+    void SetBRepMode(bool brep) { m_brepMode = brep; }
+
+    bool Export(const std::vector<ExportPart>& parts, const std::string& filename);
+
+    size_t GetEntityCount() const { return m_entityCount; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 由进度指示器调用
+    void ReportProgress(int percent);
+
+private:
+    ProgressCallback m_progressCallback;
+    bool m_brepMode;
+    size_t m_entityCount;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
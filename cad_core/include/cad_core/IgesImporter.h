@@ -0,0 +1,86 @@
+#pragma once
+
+#include "cad_core/Shape.h"
+#include <Quantity_Color.hxx>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class IgesImporter
+ * @brief IGES导入（IGESCAFControl_Reader解析，实体并行翻译）
+ *
+ * 解析文件后把根实体分批交给多个线程翻译：每个线程有自己的
+ * IGESToBRep_CurveAndSurface和Transfer_TransientProcess，模型只读共享。
+ * 子图、组这类结构实体仍由读取器串行翻译。每个翻译失败的实体都记录下来。
+ *
+ * 实体里的实体（MSBO）直接成为零件；只有曲面的模型（供应商常见的旧IGES）
+ * 把所有散面交给BRepBuilderAPI_Sewing并行缝合，封闭的壳做成实体，
+ * 其余的面合成一个零件。只依赖cad_core，整个Import()可以在后台线程运行。
+ */
+class IgesImporter {
+public:
+    // 导入结果中的一个零件
+    struct Part {
+        std::string name;
+        ShapePtr shape;
+        bool hasColor = false;
+        Quantity_Color color;
+    };
+
+    // 翻译失败的根实体
+    struct EntityFailure {
+        int entity = 0;   // 目录段序号（IGES文件中的DE号）
+        int type = 0;
+        int form = 0;
+        std::string message;
+    };
+
+    using ProgressCallback = std::function<void(int percent, const std::string& stage)>;
+
+    IgesImporter();
+
+    void SetProgressCallback(ProgressCallback callback);
+    // 缝合容差（模型单位，毫米）
+    void SetSewingTolerance(double tolerance) { m_sewingTolerance = tolerance; }
+
+    // 取消或失败返回false；部分实体失败不算失败，见GetFailures()
+    bool Import(const std::string& filename);
+
+    void Cancel();
+    bool IsCancelled() const;
+
+    const std::vector<Part>& GetParts() const { return m_parts; }
+    const std::vector<EntityFailure>& GetFailures() const { return m_failures; }
+    size_t GetEntityCount() const { return m_entityCount; }
+    size_t GetSewnFaceCount() const { return m_sewnFaceCount; }
+    size_t GetFreeEdgeCount() const { return m_freeEdgeCount; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 由进度指示器和翻译线程调用
+    void ReportProgress(int percent, const std::string& stage);
+
+    // 每个线程一次取走的根实体数
+    static const size_t kBatchSize = 256;
+
+private:
+    ProgressCallback m_progressCallback;
+    double m_sewingTolerance;
+
+    std::vector<Part> m_parts;
+    std::vector<EntityFailure> m_failures;
+    size_t m_entityCount;
+    size_t m_sewnFaceCount;
+    size_t m_freeEdgeCount;
+
+    std::atomic<bool> m_cancelled;
+    std::mutex m_progressMutex;
+    int m_lastPercent;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
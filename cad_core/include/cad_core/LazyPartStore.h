@@ -0,0 +1,93 @@
+#pragma once
+
+#include "cad_core/Shape.h"
+#include <Bnd_Box.hxx>
+#include <TopoDS_Shape.hxx>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class LazyPartStore
+ * @brief 按需加载的零件几何缓存
+ *
+ * 大装配打开时只登记零件的名称和包围盒，几何在零件可见、被选中或被操作使用时
+ * 才通过加载函数取得。已加载几何的总量超过内存预算时，按最近最少使用的顺序
+ * 卸载冷零件（本帧用过的和固定的零件不卸载，所以预算是软上限）。
+ *
+ * 不加锁，只在主线程使用。
+ */
+class LazyPartStore {
+public:
+    using Loader = std::function<ShapePtr()>;
+    using Unloader = std::function<void()>;
+    using EvictCallback = std::function<void(int id, const ShapePtr& shape)>;
+
+    LazyPartStore();
+
+    // 登记零件，返回零件编号；unloader在卸载时调用，用来释放外部持有的几何
+    int AddPart(const std::string& name, const Bnd_Box& box, Loader loader, Unloader unloader = nullptr);
+    void RemovePart(int id);
+    void Clear();
+
+    // 取得几何：冷零件会先加载，然后按预算卸载其他冷零件
+    ShapePtr Materialize(int id);
+    // 重新加载一个已加载零件（外部几何被替换时使用）
+    ShapePtr Reload(int id);
+    void Evict(int id);
+
+    ShapePtr GetShape(int id) const;   // 未加载时返回nullptr
+    bool IsLoaded(int id) const;
+    bool IsValidPart(int id) const;
+    const Bnd_Box& GetBoundingBox(int id) const;
+    const std::string& GetName(int id) const;
+    size_t GetPartCount() const { return m_parts.size(); }
+    size_t GetLoadedCount() const { return m_lru.size(); }
+
+    // 标记最近使用；BeginFrame()之后Touch过的零件在本帧内不会被卸载
+    void Touch(int id);
+    void BeginFrame();
+    // 选中/正在操作的零件固定住，不参与卸载
+    void SetPinned(int id, bool pinned);
+
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget() const { return m_budget; }
+    size_t GetLoadedBytes() const { return m_loadedBytes; }
+
+    void SetEvictCallback(EvictCallback callback);
+
+    // 粗略估算一个形状占用的内存（拓扑 + 已有的三角网格）
+    static size_t EstimateShapeBytes(const TopoDS_Shape& shape);
+
+    static const size_t kDefaultBudgetBytes = 1024ull * 1024ull * 1024ull;
+
+private:
+    struct Part {
+        std::string name;
+        Bnd_Box box;
+        Loader loader;
+        Unloader unloader;
+        ShapePtr shape;
+        size_t bytes = 0;
+        unsigned long long lastUse = 0;
+        bool pinned = false;
+        bool removed = false;
+    };
+
+    void Unload(int id, bool notify);
+    void EnforceBudget();
+
+    std::vector<Part> m_parts;
+    std::set<std::pair<unsigned long long, int>> m_lru;   // 已加载零件，按最近使用时间排序
+    unsigned long long m_clock;
+    unsigned long long m_frameStart;
+    size_t m_loadedBytes;
+    size_t m_budget;
+    EvictCallback m_evictCallback;
+};
+
+} // namespace cad_core
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 编译期级别：低于CAD_LOG_MIN_LEVEL的CAD_LOG_*调用整个去掉（参数也不求值）。
+// Release（NDEBUG）默认去掉trace/debug，可用 -DCAD_LOG_MIN_LEVEL=N 覆盖
+#define CAD_LOG_LEVEL_TRACE   0
+#define CAD_LOG_LEVEL_DEBUG   1
+#define CAD_LOG_LEVEL_INFO    2
+#define CAD_LOG_LEVEL_WARNING 3
+#define CAD_LOG_LEVEL_ERROR   4
+
+#ifndef CAD_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define CAD_LOG_MIN_LEVEL CAD_LOG_LEVEL_INFO
+#else
+#define CAD_LOG_MIN_LEVEL CAD_LOG_LEVEL_TRACE
+#endif
+#endif
+
+namespace cad_core {
+
+enum class LogLevel {
+    Trace = CAD_LOG_LEVEL_TRACE,
+    Debug = CAD_LOG_LEVEL_DEBUG,
+    Info = CAD_LOG_LEVEL_INFO,
+    Warning = CAD_LOG_LEVEL_WARNING,
+    Error = CAD_LOG_LEVEL_ERROR,
+    Off
+};
+
+// 一条日志
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    const char* category = "";     // 字面量，比如"ocaf"、"selection"
+    std::string message;
+    std::chrono::system_clock::time_point time;
+    std::uint64_t threadId = 0;
+};
+
+/**
+ * @class Logger
+ * @brief 分级、分类别的异步日志
+ *
+ * 写日志的线程只把记录压进无锁队列（一次CAS），不格式化输出也不加锁；
+ * 后台线程定期整批取出交给各个输出端（sink），每批只写一次、刷新一次。
+ * 队列积压超过kMaxPending条时丢弃新记录，下一批开头报告丢了多少条。
+ *
+ * 运行期级别可以按类别设置；环境变量ANDERCAD_LOG形如"info,ocaf=debug,selection=trace"。
+ * 默认sink把记录写到stderr，界面可以再加一个sink接到控制台窗口。
+ */
+class Logger {
+public:
+    using Sink = std::function<void(const std::vector<LogRecord>& batch)>;
+
+    static Logger& Instance();
+
+    void SetLevel(LogLevel level);
+    LogLevel GetLevel() const { return static_cast<LogLevel>(m_level.load(std::memory_order_relaxed)); }
+    // 某个类别单独的级别（覆盖全局级别）
+    void SetCategoryLevel(const std::string& category, LogLevel level);
+    bool IsEnabled(LogLevel level, const char* category) const;
+
+    // 解析"info,ocaf=debug"形式的配置；无法识别的项忽略
+    void Configure(const std::string& spec);
+
+    void Write(LogLevel level, const char* category, std::string message);
+
+    // 返回的编号用于RemoveSink；sink在后台线程（或Flush的调用线程）上调用
+    int AddSink(Sink sink);
+    void RemoveSink(int id);
+    // 关掉默认的stderr输出（界面自己显示日志时）
+    void SetStderrEnabled(bool enabled) { m_stderrEnabled = enabled; }
+
+    // 把队列里已有的记录立即交给sink
+    void Flush();
+
+    static const char* LevelName(LogLevel level);
+
+    // 队列积压上限
+    static constexpr size_t kMaxPending = 1 << 16;
+    // 后台线程两次取队列之间的最长间隔
+    static constexpr int kFlushIntervalMs = 50;
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    struct Node {
+        LogRecord record;
+        Node* next = nullptr;
+    };
+
+    void Run();
+    void Drain();
+
+    std::atomic<int> m_level;
+    std::atomic<bool> m_hasCategoryLevels;
+    // 类别级别表只读共享：修改时复制一份再整体替换（std::atomic_store），读取方不加锁
+    using CategoryLevels = std::map<std::string, LogLevel, std::less<>>;
+    std::mutex m_categoryMutex;    // 只串行化修改
+    std::shared_ptr<const CategoryLevels> m_categoryLevels;
+
+    // 无锁的多生产者栈，消费者一次取走全部再反转成时间顺序
+    std::atomic<Node*> m_head;
+    std::atomic<size_t> m_pending;
+    std::atomic<size_t> m_dropped;
+
+    std::mutex m_drainMutex;       // 同一时刻只有一个线程取队列、调用sink
+    std::mutex m_sinkMutex;        // 只保护sink列表，调用sink时不持有
+    std::map<int, Sink> m_sinks;
+    int m_nextSinkId;
+    std::atomic<bool> m_stderrEnabled;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stopping;
+    std::thread m_thread;
+};
+
+} // namespace cad_core
+
+// 运行期过滤在前，没有启用的级别不会格式化消息
+#define CAD_LOG(level, category, expr)                                                  \
+    do {                                                                                \
+        if (::cad_core::Logger::Instance().IsEnabled(level, category)) {                \
+            std::ostringstream cadLogStream;                                            \
+            cadLogStream << expr;                                                       \
+            ::cad_core::Logger::Instance().Write(level, category, cadLogStream.str());  \
+        }                                                                               \
+    } while (0)
+
+#if CAD_LOG_MIN_LEVEL <= CAD_LOG_LEVEL_TRACE
+#define CAD_LOG_TRACE(category, expr) CAD_LOG(::cad_core::LogLevel::Trace, category, expr)
+#else
+#define CAD_LOG_TRACE(category, expr) do {} while (0)
+#endif
+
+#if CAD_LOG_MIN_LEVEL <= CAD_LOG_LEVEL_DEBUG
+#define CAD_LOG_DEBUG(category, expr) CAD_LOG(::cad_core::LogLevel::Debug, category, expr)
+#else
+#define CAD_LOG_DEBUG(category, expr) do {} while (0)
+#endif
+
+#if CAD_LOG_MIN_LEVEL <= CAD_LOG_LEVEL_INFO
+#define CAD_LOG_INFO(category, expr) CAD_LOG(::cad_core::LogLevel::Info, category, expr)
+#else
+#define CAD_LOG_INFO(category, expr) do {} while (0)
+#endif
+
+#define CAD_LOG_WARNING(category, expr) CAD_LOG(::cad_core::LogLevel::Warning, category, expr)
+#define CAD_LOG_ERROR(category, expr) CAD_LOG(::cad_core::LogLevel::Error, category, expr)
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+namespace cad_core {
+
+/**
+ * @class MappedFile
+ * @brief 只读内存映射文件，析构时解除映射
+ *
+ * 大文件不整体读进内存，由操作系统按页换入；多个线程可以同时读取不同区域。
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const char* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+    // 提示系统即将按顺序读取（解析整个文件时使用）
+    void AdviseSequential() const;
+
+private:
+#ifdef _WIN32
+    void* m_file;      // HANDLE
+    void* m_mapping;   // HANDLE
+#else
+    int m_fd;
+#endif
+    const char* m_data;
+    size_t m_size;
+};
+
+} // namespace cad_core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "cad_core/Shape.h"
+#include <Poly_Triangulation.hxx>
+#include <TopoDS_Shape.hxx>
+#include <functional>
+#include <string>
+
+namespace cad_core {
+
+/**
+ * @class MeshImporter
+ * @brief 并行STL/OBJ网格导入
+ *
+ * 文件内存映射后按块并行解析：
+ *  - 二进制STL：每块先在块内按哈希网格焊接顶点，再把各块的顶点按哈希分区并行合并，
+ *    得到全局编号；焊接后退化的三角形丢掉。
+ *  - OBJ：先并行统计每块的顶点/三角形数，再并行解析写入各自的位置（多边形按扇形拆分）。
+ *  - ASCII STL：交给RWStl读取（单线程）。
+ *
+ * 结果是只带Poly_Triangulation（单精度节点）的面，不做B-rep转换，可以直接显示和保存。
+ */
+class MeshImporter {
+public:
+    using ProgressCallback = std::function<void(int percent)>;
+
+    MeshImporter();
+
+    void SetProgressCallback(ProgressCallback callback);
+
+    // 按扩展名识别格式（.stl / .obj），失败返回nullptr
+    ShapePtr Import(const std::string& filename);
+
+    size_t GetTriangleCount() const { return m_triangleCount; }
+    size_t GetNodeCount() const { return m_nodeCount; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 只有三角网格、没有曲面的形状（显示时不能再让AIS重新网格化）
+    static bool IsMeshShape(const TopoDS_Shape& shape);
+
+    // 每个解析块的三角形数
+    static constexpr size_t kChunkTriangles = 1u << 20;
+
+private:
+    Handle(Poly_Triangulation) ReadBinaryStl(const char* data, size_t size);
+    Handle(Poly_Triangulation) ReadObj(const char* data, size_t size);
+    Handle(Poly_Triangulation) ReadAsciiStl(const std::string& filename);
+    void ReportProgress(int percent);
+
+    ProgressCallback m_progressCallback;
+    size_t m_triangleCount;
+    size_t m_nodeCount;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "cad_core/MappedFile.h"
+#include <Bnd_Box.hxx>
+#include <TopoDS_Shape.hxx>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class NativeDocumentFile
+ * @brief 项目自有的分块二进制文档格式（.acad）
+ *
+ * 文件布局（小端）：
+ *   文件头 32字节：魔数"ANDERCAD"、版本、块数、目录偏移
+ *   数据块：零件表（PART）、每个零件一个B-rep块（BREP，BinTools格式，带三角网格）、
+ *           特征参数表（FEAT）、可选的预览（PREV，见DocumentPreview）；每块按8字节对齐
+ *   目录：每块 {类型, 标志, 偏移, 大小}，写在文件末尾
+ *
+ * 打开时只映射文件并解析目录和零件表，几何在LoadShape()时才反序列化；
+ * LoadShape()只读映射内存，可以在多个线程上同时调用。
+ */
+class NativeDocumentFile {
+public:
+    // 目录中的一项
+    struct ChunkEntry {
+        std::uint32_t type = 0;
+        std::uint32_t flags = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    // 写入用的零件；几何三选一：沿用文件中已有的块 / 原样写出已编码的数据 / 重新编码shape
+    struct PartData {
+        std::string name;
+        bool active = true;
+        TopoDS_Shape shape;
+        const char* blob = nullptr;   // 已编码的BinTools数据（例如另一个文件的映射区）
+        size_t blobBytes = 0;
+        bool reuse = false;           // 只用于Append：几何块已经在目标文件里
+        ChunkEntry existing;
+        Bnd_Box box;                  // 没有shape时由调用方提供
+        std::string entry;            // OCAF标签条目，保存会话用来识别零件
+    };
+
+    // 写入结果：新目录、每个零件对应的目录序号、文件大小和有效数据量
+    struct WriteResult {
+        std::vector<ChunkEntry> chunks;
+        std::vector<int> partChunks;
+        std::uint64_t tocOffset = 0;
+        std::uint64_t fileSize = 0;
+        std::uint64_t liveBytes = 0;
+        std::uint64_t bytesWritten = 0;
+    };
+
+    // 打开后零件表中的一项
+    struct PartInfo {
+        std::string name;
+        bool active = true;
+        Bnd_Box box;
+        int brepChunk = -1;   // 目录序号，-1表示没有几何
+        size_t brepBytes = 0;
+    };
+
+    // 特征参数（只保存数值参数，由cad_feature填写）
+    struct FeatureRecord {
+        int id = 0;
+        int type = 0;
+        std::string name;
+        bool active = true;
+        std::vector<std::pair<std::string, double>> parameters;
+    };
+
+    NativeDocumentFile();
+    ~NativeDocumentFile();
+
+    // 文件开头是否是本格式的魔数
+    static bool IsNativeFile(const std::string& filename);
+    // 扩展名是否是.acad（保存时据此选择格式）
+    static bool IsNativeFileName(const std::string& filename);
+
+    // B-rep块的编解码（BinTools格式，带三角网格），操作日志也使用
+    static std::string EncodeShape(const TopoDS_Shape& shape);
+    static TopoDS_Shape DecodeShape(const char* data, size_t size);
+
+    // 完整写出：B-rep块并行编码、按顺序写出；先写临时文件再改名，失败不会破坏原文件
+    // preview为编码后的预览，空串表示不写
+    static bool Write(const std::string& filename, const std::vector<PartData>& parts,
+                      const std::vector<FeatureRecord>& features, const std::string& preview,
+                      std::string& error, WriteResult* result = nullptr);
+    // 增量写出：在fileSize处追加变化的块、新的零件表和目录，最后改写文件头
+    static bool Append(const std::string& filename, const std::vector<PartData>& parts,
+                       const std::vector<FeatureRecord>& features, const std::string& preview,
+                       std::uint64_t fileSize, std::string& error, WriteResult* result = nullptr);
+
+    bool Open(const std::string& filename);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    size_t GetPartCount() const { return m_parts.size(); }
+    const PartInfo& GetPart(size_t index) const { return m_parts[index]; }
+    const std::vector<FeatureRecord>& GetFeatures() const { return m_features; }
+    const std::vector<ChunkEntry>& GetChunks() const { return m_chunks; }
+    const char* GetChunkData(int index) const;
+    std::uint64_t GetFileSize() const { return m_fileSize; }
+    // 预览块的数据，没有时返回nullptr
+    const char* GetPreviewData(size_t& size) const;
+
+    // 反序列化一个零件的几何（线程安全）
+    TopoDS_Shape LoadShape(size_t index) const;
+    // 并行反序列化多个零件，结果与indices一一对应
+    std::vector<TopoDS_Shape> LoadShapes(const std::vector<size_t>& indices) const;
+
+    const std::string& GetLastError() const { return m_lastError; }
+
+    static const std::uint32_t kVersion = 1;
+
+private:
+    static bool WriteBody(std::fstream& file, const std::vector<PartData>& parts,
+                          const std::vector<FeatureRecord>& features, const std::string& preview,
+                          WriteResult& result, std::string& error);
+    static bool WriteHeader(std::fstream& file, const WriteResult& result);
+    // 用source替换target（target可能仍被映射）
+    static bool MoveFileOver(const std::string& source, const std::string& target);
+    bool ReadPartTable(const ChunkEntry& chunk);
+    bool ReadFeatureTable(const ChunkEntry& chunk);
+
+    std::unique_ptr<MappedFile> m_file;
+    std::vector<ChunkEntry> m_chunks;
+    std::vector<PartInfo> m_parts;
+    std::vector<FeatureRecord> m_features;
+    std::uint64_t m_fileSize;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "cad_core/DocumentPreview.h"
+#include "cad_core/NativeDocumentFile.h"
+#include <TopoDS_Shape.hxx>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class NativeSaveSession
+ * @brief .acad文件的增量保存
+ *
+ * 记住上一次写进文件的每个零件（标签条目 -> 形状和所在的块）。再次保存时，
+ * 形状没变的零件沿用文件里已有的块，只把变化的零件、零件表、特征表和新目录
+ * 追加到文件末尾，最后改写文件头。旧块成为无用数据，超过有效数据量时
+ * 整体重写一次（压缩），有效块原样复制，不重新编码。
+ *
+ * 快照只持有形状句柄：建模操作总是生成新的TShape，不修改已有的，
+ * 所以快照本身就是写时复制的，可以在后台线程上保存。
+ */
+class NativeSaveSession {
+public:
+    // 在界面线程上拍的快照，之后交给任意线程保存
+    struct Snapshot {
+        std::vector<NativeDocumentFile::PartData> parts;   // entry必须填写
+        std::vector<NativeDocumentFile::FeatureRecord> features;
+        std::shared_ptr<const NativeDocumentFile> source;  // parts里blob所在的映射，保存期间保持打开
+        std::shared_ptr<const DocumentPreview> preview;     // 可选，写进文件的预览
+    };
+
+    explicit NativeSaveSession(const std::string& filename);
+
+    const std::string& GetFileName() const { return m_fileName; }
+
+    // 刚打开的文件：登记其中的零件块（entries与零件表一一对应，空串表示跳过）
+    void Adopt(const NativeDocumentFile& file, const std::vector<std::string>& entries);
+    // 延迟打开后按需读出的几何与文件中的块一致
+    void NoteLoadedShape(const std::string& entry, const TopoDS_Shape& shape);
+
+    // 保存快照；同一会话的保存串行执行，可以在任意线程调用
+    bool Save(const Snapshot& snapshot, std::string& error);
+
+    // 上一次保存的统计
+    bool WasLastSaveDelta() const { return m_lastSaveDelta; }
+    std::uint64_t GetLastBytesWritten() const { return m_lastBytesWritten; }
+
+private:
+    // 文件中一个零件当前的内容
+    struct SavedPart {
+        TopoDS_Shape shape;   // 为空表示Adopt时登记、尚未读出的块
+        NativeDocumentFile::ChunkEntry chunk;
+    };
+
+    bool CanAppend() const;
+    bool WriteFull(std::vector<NativeDocumentFile::PartData> parts,
+                   const std::vector<NativeDocumentFile::FeatureRecord>& features,
+                   const std::string& preview,
+                   NativeDocumentFile::WriteResult& result, std::string& error);
+    void Remember(const std::vector<NativeDocumentFile::PartData>& parts,
+                  const NativeDocumentFile::WriteResult& result);
+
+    std::string m_fileName;
+    std::mutex m_saveMutex;    // 串行化保存
+    std::mutex m_stateMutex;   // 保护下面的登记信息，保存写文件期间不持有
+    std::map<std::string, SavedPart> m_saved;
+    std::uint64_t m_fileSize;    // 0表示还没有写过，下次保存完整写出
+    std::uint64_t m_liveBytes;
+    bool m_lastSaveDelta;
+    std::uint64_t m_lastBytesWritten;
+};
+
+} // namespace cad_core
@@ -12,12 +12,20 @@
 #include <TCollection_AsciiString.hxx>
 #include <XCAFDoc_ShapeTool.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
+#include <Bnd_Box.hxx>
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
 
 #include "cad_core/Shape.h"
+#include "cad_core/NativeDocumentFile.h"
+#include "cad_core/NativeSaveSession.h"
 
 namespace cad_core {
 
+class OperationJournal;
+
 class OCAFDocument {
 public:
     OCAFDocument();
@@ -28,15 +36,41 @@ public:
     
     // 文档操作
     bool NewDocument();
-    bool OpenDocument(const std::string& filename);
+    // lazy为true时只读取结构、名称和包围盒，形状几何按需从文件读取
+    // 文件是.acad原生格式时自动识别；保存时按扩展名选择格式
+    bool OpenDocument(const std::string& filename, bool lazy = false);
     bool SaveDocument(const std::string& filename);
     
+    // 特征参数随原生格式保存（OCAF格式不保存）
+    void SetFeatureRecords(const std::vector<NativeDocumentFile::FeatureRecord>& records) { m_featureRecords = records; }
+    const std::vector<NativeDocumentFile::FeatureRecord>& GetFeatureRecords() const { return m_featureRecords; }
+    
+    // 崩溃恢复日志：设置后每个已提交的修改都会记录（新建/打开文档时解除）
+    void SetJournal(const std::shared_ptr<OperationJournal>& journal) { m_journal = journal; }
+    std::shared_ptr<OperationJournal> GetJournal() const { return m_journal; }
+    
+    // 原生格式的增量保存：界面线程上拍快照（只复制句柄），再交给会话在后台线程写出
+    NativeSaveSession::Snapshot CreateSaveSnapshot() const;
+    // 同一文件沿用已有会话（打开.acad时建立），换文件时新建
+    std::shared_ptr<NativeSaveSession> GetSaveSession(const std::string& filename);
+    
     // 形状操作
     TDF_Label AddShape(const ShapePtr& shape, const std::string& name = "");
     bool RemoveShape(const TDF_Label& label);
     ShapePtr GetShape(const TDF_Label& label) const;
     std::vector<TDF_Label> GetAllShapes() const;
     
+    // 延迟加载
+    bool IsLazy() const { return m_isLazy; }
+    bool IsShapeLoaded(const TDF_Label& label) const;
+    ShapePtr GetLoadedShape(const TDF_Label& label) const;   // 只看内存，不读文件
+    void UnloadShape(const TDF_Label& label);                // 释放按需读取的几何
+    // 一次读入一批还没读的活动形状（一次过滤打开文件），之后GetShape直接从内存取；
+    // 显示多个零件前调用，避免每个零件都完整解析一遍文件
+    void PrefetchShapes(const std::vector<TDF_Label>& labels) const;
+    bool LoadAllShapes();                                     // 补齐全部几何，保存前调用
+    bool GetBoundingBox(const TDF_Label& label, Bnd_Box& box) const;
+    
     // 树操作
     TDF_Label CreateFolder(const std::string& name, const TDF_Label& parent = TDF_Label());
     bool MoveShape(const TDF_Label& shape, const TDF_Label& newParent);
@@ -57,15 +91,38 @@ public:
     void StartTransaction(const std::string& name = "Operation");
     void CommitTransaction();
     void AbortTransaction();
+    // 最近一次提交的事务名称和耗时（从开始到提交，毫秒）；还没有提交过返回false
+    bool GetLastTransaction(std::string& name, double& milliseconds) const;
+    
+    // 撤销栈按删除/替换掉的几何估算内存；超出预算时丢弃最早的撤销步骤（至少保留一步）
+    void SetUndoMemoryBudget(size_t bytes);
+    size_t GetUndoMemoryBudget() const { return m_undoMemoryBudget; }
+    // 撤销栈和重做栈保留的几何（估算）：删除的旧形状加上新增/替换的新形状
+    size_t GetUndoMemoryUsage() const;
+    // 因超出预算丢弃的撤销步数（新建/打开文档时清零）
+    size_t GetTrimmedUndoSteps() const { return m_trimmedUndoSteps; }
+    
+    // 撤销步数上限；内存预算通常先起作用
+    static constexpr int kMaxUndoSteps = 200;
+    static constexpr size_t kDefaultUndoMemoryBudgetBytes = 512ull * 1024ull * 1024ull;
     
     // 获取根标签
     TDF_Label GetRootLabel() const;
+    TDF_Label GetShapesLabel() const { return m_shapesLabel; }
+    
+    // 标签条目（"0:1:3"）与标签互查
+    TDF_Label FindLabel(const std::string& entry) const;
+    static std::string LabelEntry(const TDF_Label& label);
     
     // 获取文档
     Handle(TDocStd_Document) GetDocument() const { return m_document; }
     
+    // 获取XCAF形状工具（导入的装配结构存放在这里）
+    Handle(XCAFDoc_ShapeTool) GetShapeTool() const { return m_shapeTool; }
+    
 private:
     Handle(TDocStd_Application) m_application;
+    Handle(TDocStd_Application) m_partialApplication;   // 按需读取部分标签时使用的独立会话
     Handle(TDocStd_Document) m_document;
     Handle(XCAFDoc_ShapeTool) m_shapeTool;
     TDF_Label m_rootLabel;
@@ -73,11 +130,41 @@ private:
     
     bool m_isInitialized;
     bool m_inTransaction;
+    std::string m_transactionName;
+    std::chrono::steady_clock::time_point m_transactionStart;
+    std::string m_lastTransactionName;
+    double m_lastTransactionMs;
+    
+    // 每个撤销/重做步骤保留的几何字节数，与OCAF的撤销栈一一对应（最早的在前）
+    size_t m_undoMemoryBudget;
+    size_t m_transactionBytes;
+    size_t m_trimmedUndoSteps;
+    std::deque<size_t> m_undoBytes;
+    std::deque<size_t> m_redoBytes;
+    
+    // 延迟加载状态：文件名和已按需读取的几何（标签条目 -> 形状）
+    bool m_isLazy;
+    std::string m_lazyFileName;
+    mutable std::map<std::string, TopoDS_Shape> m_lazyShapes;
+    
+    // 原生格式：映射中的文件和标签条目 -> 零件序号
+    std::shared_ptr<NativeDocumentFile> m_nativeFile;
+    std::map<std::string, size_t> m_nativeParts;
+    std::vector<NativeDocumentFile::FeatureRecord> m_featureRecords;
+    std::shared_ptr<NativeSaveSession> m_saveSession;
+    std::shared_ptr<OperationJournal> m_journal;
     
     // 辅助方法
     void InitializeApplication();
     void InitializeDocument();
+    void TrimUndoHistory();
+    size_t EstimateCommittedShapeBytes() const;
     TDF_Label GetNextAvailableLabel(const TDF_Label& parent);
+    std::vector<TopoDS_Shape> ReadShapesFromFile(const std::vector<TDF_Label>& labels) const;
+    bool OpenNativeDocument(const std::string& filename, bool lazy);
+    bool SaveNativeDocument(const std::string& filename);
+    void NoteLoadedShape(const TDF_Label& label, const TopoDS_Shape& shape) const;
+    void SetBoundingBox(const TDF_Label& label, const Bnd_Box& box);
 };
 
 } // namespace cad_core
\ No newline at end of file
@@ -18,7 +18,7 @@ public:
     
     // 文档操作
     bool NewDocument();
-    bool OpenDocument(const std::string& filename);
+    bool OpenDocument(const std::string& filename, bool lazy = false);
     bool SaveDocument(const std::string& filename);
     
     // 形状操作
@@ -40,6 +40,13 @@ public:
     void StartTransaction(const std::string& name = "Operation");
     void CommitTransaction();
     void AbortTransaction();
+    // 最近一次提交的事务及其耗时（毫秒）
+    bool GetLastTransaction(std::string& name, double& milliseconds) const;
+    
+    // 撤销栈的内存预算和占用（字节）
+    void SetUndoMemoryBudget(size_t bytes);
+    size_t GetUndoMemoryUsage() const;
+    size_t GetTrimmedUndoSteps() const;
     
     // 获取文档
     std::shared_ptr<OCAFDocument> GetDocument() const { return m_document; }
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <TopoDS_Shape.hxx>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cad_core {
+
+class OCAFDocument;
+
+/**
+ * @class OperationJournal
+ * @brief 崩溃恢复用的操作日志（只追加）
+ *
+ * 记录每个已提交事务对文档做的修改（事务名、添加/删除/重命名的标签和形状），
+ * 以及撤销/重做。界面线程上只把形状句柄放进队列；后台线程编码几何、写文件，
+ * 短时间内的多次提交合并成一批，只做一次fsync。
+ *
+ * 日志分段：<path>.<N>。每段开头记录起点文件（上次保存或自动保存的文件）；
+ * 保存时切换到新段，保存成功后删除之前的段。恢复时打开最早一段的起点文件，
+ * 再依次重放所有段：几何按批并行解码，修改按原顺序应用，撤销栈也随之重建。
+ *
+ * 草图和特征参数不在日志中，恢复后只有文档里的形状。
+ */
+class OperationJournal {
+public:
+    struct ReplayStats {
+        size_t transactions = 0;
+        size_t undos = 0;
+        size_t shapes = 0;
+    };
+
+    explicit OperationJournal(const std::string& path);
+    // 写完队列后关闭，文件保留（正常关闭文档时调用Remove()）
+    ~OperationJournal();
+
+    OperationJournal(const OperationJournal&) = delete;
+    OperationJournal& operator=(const OperationJournal&) = delete;
+
+    const std::string& GetPath() const { return m_path; }
+
+    // 删除已有的段，从baseFile开始记录；entries是baseFile中各零件对应的标签条目
+    // （原生格式按零件顺序，OCAF格式和空文档不需要）
+    bool Start(const std::string& baseFile, const std::vector<std::string>& entries);
+    // 恢复之后接着已有的段继续记录，新段里的标签条目就是重放后的条目
+    bool Resume();
+    // 保存时调用：之后的修改写入以baseFile为起点的新段，返回新段号
+    int Rotate(const std::string& baseFile, const std::vector<std::string>& entries);
+    // 保存成功后删除segment之前的段
+    void DiscardSegmentsBefore(int segment);
+    // 正常关闭文档：停止写入并删除全部段
+    void Remove();
+    // 等待已提交的修改写入磁盘
+    void Flush();
+
+    // 由OCAFDocument在界面线程上调用
+    void BeginTransaction(const std::string& name);
+    void CommitTransaction();
+    void AbortTransaction();
+    void RecordAddShape(const std::string& entry, const std::string& name, const TopoDS_Shape& shape);
+    void RecordRemoveShape(const std::string& entry);
+    void RecordSetName(const std::string& entry, const std::string& name);
+    void RecordUndo();
+    void RecordRedo();
+
+    // path下是否有可以恢复的段
+    static bool HasRecoveryData(const std::string& path);
+    // 从日志重建文档；lazy与OCAFDocument::OpenDocument相同，作用于起点文件
+    static bool Replay(const std::string& path, OCAFDocument& document, bool lazy,
+                       ReplayStats& stats, std::string& error);
+
+private:
+    enum OperationType : std::uint8_t {
+        kAddShape = 1,
+        kRemoveShape = 2,
+        kSetName = 3
+    };
+    struct Operation {
+        OperationType type = kAddShape;
+        std::string entry;
+        std::string name;
+        TopoDS_Shape shape;
+    };
+
+    // 写线程的队列项
+    enum ItemKind {
+        kTransaction,
+        kUndo,
+        kRedo,
+        kRotate,
+        kDiscard
+    };
+    struct Item {
+        ItemKind kind = kTransaction;
+        std::string name;
+        std::vector<Operation> operations;
+        std::string baseFile;
+        std::vector<std::string> entries;
+        int segment = 0;
+    };
+
+    void Record(const Operation& operation);
+    void Enqueue(Item&& item);
+    void StartWriter();
+    void StopWriter();
+    void WriterLoop();
+    void WriteBatch(std::vector<Item>& batch);
+    bool OpenSegment(int segment, const std::string& baseFile,
+                     const std::vector<std::string>& entries, bool resumed);
+    void CloseSegment();
+
+    static std::string SegmentPath(const std::string& path, int segment);
+    static std::vector<int> ListSegments(const std::string& path);
+
+    std::string m_path;
+
+    // 界面线程：当前事务中还没提交的修改
+    bool m_inTransaction;
+    std::string m_transactionName;
+    std::vector<Operation> m_pending;
+    int m_lastSegment;
+
+    // 写线程
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_written;
+    std::vector<Item> m_queue;
+    std::uint64_t m_enqueuedCount;
+    std::uint64_t m_writtenCount;
+    bool m_stop;
+    std::FILE* m_file;
+};
+
+} // namespace cad_core
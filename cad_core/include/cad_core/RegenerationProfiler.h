@@ -0,0 +1,129 @@
+#pragma once
+
+#include "cad_core/Tracer.h"
+#include <TopoDS_Shape.hxx>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+// 一次特征重建的统计
+struct RegenerationRecord {
+    int featureId = -1;
+    std::string featureName;
+    std::string category;          // "feature" 或具体OCCT调用（"occt"）
+    double startUs = 0.0;          // 相对分析器启动时刻，微秒
+    double durationUs = 0.0;
+    long long memoryDeltaBytes = 0;
+    int facesIn = 0;
+    int facesOut = 0;
+    int cacheHits = 0;
+    int cacheMisses = 0;
+    std::uint64_t threadId = 0;
+    bool succeeded = false;
+};
+
+/**
+ * @class RegenerationProfiler
+ * @brief 特征重建分析器
+ *
+ * 记录每次特征重建（以及其中的OCCT调用）的耗时、内存变化、输入输出面数、
+ * 缓存命中情况和线程号，可以导出为Chrome trace（chrome://tracing / Perfetto）。
+ * 默认开启；关闭后作用域对象几乎不花时间。
+ */
+class RegenerationProfiler {
+public:
+    static RegenerationProfiler& Instance();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    // 特征级作用域：构造时开始计时，析构时写入一条记录
+    class ScopedFeature {
+    public:
+        ScopedFeature(int featureId, const std::string& featureName);
+        ~ScopedFeature();
+
+        void SetFacesIn(int faces);
+        void SetResult(const TopoDS_Shape& shape, bool succeeded);
+
+        const RegenerationRecord& GetRecord() const { return m_record; }
+
+    private:
+        RegenerationRecord m_record;
+        std::chrono::steady_clock::time_point m_start;
+        long long m_startMemory;
+        ScopedFeature* m_previous;
+        bool m_active;
+        // 特征内部的并行任务也会记缓存统计，析构时再写进记录
+        std::atomic<int> m_cacheHits;
+        std::atomic<int> m_cacheMisses;
+
+        friend class RegenerationProfiler;
+    };
+
+    // 特征内部单个OCCT调用的作用域；name须为字面量，同时记为Tracer的一个zone
+    class ScopedCall {
+    public:
+        explicit ScopedCall(const char* name);
+        ~ScopedCall();
+
+    private:
+        const char* m_name;
+        std::chrono::steady_clock::time_point m_start;
+        bool m_active;
+        Tracer::Zone m_zone;
+    };
+
+    // 缓存统计记到当前线程正在重建的特征上
+    static void RecordCacheHit();
+    static void RecordCacheMiss();
+
+    // 当前线程正在重建的特征，没有则为空
+    static ScopedFeature* CurrentFeature();
+
+    // 在任务线程上沿用提交线程的特征：作用域内的缓存统计和OCCT调用记到这个特征上。
+    // 提交线程要等任务结束（ParallelFor就是这样），特征作用域比任务活得久
+    class AdoptFeature {
+    public:
+        explicit AdoptFeature(ScopedFeature* feature);
+        ~AdoptFeature();
+
+    private:
+        ScopedFeature* m_previous;
+    };
+
+    static int CountFaces(const TopoDS_Shape& shape);
+
+    std::vector<RegenerationRecord> GetRecords() const;
+    // 某个特征最近一次重建的记录，没有则返回false
+    bool GetLastFeatureRecord(int featureId, RegenerationRecord& record) const;
+    void Clear();
+
+    bool ExportChromeTrace(const std::string& filename) const;
+
+    // 保留的记录上限，超出后丢掉最早的
+    static const size_t kMaxRecords = 100000;
+
+private:
+    RegenerationProfiler();
+    RegenerationProfiler(const RegenerationProfiler&) = delete;
+    RegenerationProfiler& operator=(const RegenerationProfiler&) = delete;
+
+    void AddRecord(const RegenerationRecord& record);
+    double ToMicroseconds(std::chrono::steady_clock::time_point time) const;
+
+    static long long CurrentMemoryUsage();
+    static std::uint64_t CurrentThreadId();
+
+    mutable std::mutex m_mutex;
+    std::vector<RegenerationRecord> m_records;
+    std::chrono::steady_clock::time_point m_epoch;
+    std::atomic<bool> m_enabled;
+};
+
+} // namespace cad_core
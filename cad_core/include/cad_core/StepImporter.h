@@ -0,0 +1,102 @@
+#pragma once
+
+#include "cad_core/OCAFDocument.h"
+#include "cad_core/Shape.h"
+#include <Bnd_Box.hxx>
+#include <Quantity_Color.hxx>
+#include <TDF_Label.hxx>
+#include <TDF_LabelIntegerMap.hxx>
+#include <TopLoc_Location.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+/**
+ * @class StepImporter
+ * @brief STEP装配导入器（STEPCAFControl_Reader）
+ *
+ * 分两步工作：
+ *  1. Import() - 解析文件并把产品结构、名称、颜色写入OCAFDocument的XCAF树，
+ *     翻译阶段关闭ShapeFix修复，大文件也能尽快出结果；每个零件实例通过回调逐个交出。
+ *  2. HealParts() - 后台对每个零件原型并行执行ShapeFix_Shape，修好一个就回调一次。
+ *
+ * 两步都可以用Cancel()中途取消。回调在调用Import()/HealParts()的线程上触发，
+ * 界面需要自己转到主线程处理。
+ */
+class StepImporter {
+public:
+    // 一个零件实例（装配里同一个零件可能出现多次，共享同一个原型）
+    struct Part {
+        std::string name;
+        ShapePtr shape;            // 已带上装配位置
+        TopLoc_Location location;  // 在装配中的位置
+        Bnd_Box box;               // 装配坐标下的包围盒（延迟显示时用）
+        bool hasColor = false;
+        Quantity_Color color;
+        TDF_Label label;           // XCAF中的零件原型标签
+        int prototype = -1;        // 原型序号
+    };
+
+    using ProgressCallback = std::function<void(int percent, const std::string& stage)>;
+    using PartCallback = std::function<void(int index, const Part& part)>;
+
+    StepImporter();
+    ~StepImporter();
+
+    void SetProgressCallback(ProgressCallback callback);
+    void SetPartCallback(PartCallback callback);
+    void SetPartHealedCallback(PartCallback callback);
+
+    // 导入到document的XCAF树；取消或失败返回false
+    bool Import(const std::string& filename, OCAFDocument& document);
+
+    // 并行修复已导入的零件，修复后的结果只通过回调给出
+    bool HealParts();
+
+    // 把修复后的原型写回XCAF树，需要和Import()用同一个文档，在主线程调用
+    void ApplyHealedShapes(OCAFDocument& document);
+
+    void Cancel();
+    bool IsCancelled() const;
+
+    const std::vector<Part>& GetParts() const { return m_parts; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 由进度指示器调用
+    void ReportProgress(int percent, const std::string& stage);
+
+private:
+    struct Prototype {
+        TDF_Label label;
+        TopoDS_Shape shape;
+        TopoDS_Shape healed;
+        Bnd_Box box;
+        std::vector<int> instances;
+    };
+
+    void CollectParts(const Handle(XCAFDoc_ShapeTool)& shapeTool,
+                      const Handle(XCAFDoc_ColorTool)& colorTool,
+                      const TDF_Label& label, const TopLoc_Location& location,
+                      const std::string& parentName);
+    int FindOrAddPrototype(const TDF_Label& label, const TopoDS_Shape& shape);
+
+    ProgressCallback m_progressCallback;
+    PartCallback m_partCallback;
+    PartCallback m_partHealedCallback;
+
+    std::vector<Part> m_parts;
+    std::vector<Prototype> m_prototypes;
+    TDF_LabelIntegerMap m_prototypeIndex;
+
+    std::atomic<bool> m_cancelled;
+    std::mutex m_callbackMutex;
+    int m_lastPercent;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
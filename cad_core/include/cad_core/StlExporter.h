@@ -0,0 +1,73 @@
+#pragma once
+
+#include "cad_core/ExportParts.h"
+#include "cad_core/Shape.h"
+#include <TopoDS_Face.hxx>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cad_core {
+
+// STL导出参数
+struct StlExportOptions {
+    double linearDeflection = 0.1;    // 弦高误差（模型单位）
+    double angularDeflection = 0.5;   // 角度误差（弧度）
+    bool ascii = false;               // 默认二进制
+};
+
+/**
+ * @class StlExporter
+ * @brief 高吞吐STL导出
+ *
+ * 1. 每个形状用BRepMesh并行网格化（面级并行）；
+ * 2. 先统计三角形总数写文件头，再按面分块，每一批块并行编码成二进制/文本，
+ *    按顺序写出。内存里同时只有一批块的编码结果，三角形不会整体复制一遍。
+ *
+ * 二进制STL按小端写出。
+ */
+class StlExporter {
+public:
+    using ProgressCallback = std::function<void(int percent)>;
+
+    explicit StlExporter(const StlExportOptions& options = StlExportOptions());
+
+    void SetProgressCallback(ProgressCallback callback);
+
+    bool Export(const std::vector<ShapePtr>& shapes, const std::string& filename);
+    // STL没有名称和颜色，只取零件的形状
+    bool Export(const std::vector<ExportPart>& parts, const std::string& filename);
+
+    size_t GetTriangleCount() const { return m_triangleCount; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // 一个编码块的目标大小（三角形数），一批块的个数是线程数的两倍
+    static const size_t kChunkTriangles = 65536;
+
+private:
+    struct FaceRange {
+        TopoDS_Face face;
+        size_t triangles = 0;
+    };
+    struct Chunk {
+        size_t firstFace = 0;
+        size_t lastFace = 0;   // 不含
+        size_t triangles = 0;
+    };
+
+    // 在形状的副本上网格化，副本放进meshed；文档里的形状不被修改
+    bool Tessellate(const std::vector<ShapePtr>& shapes, std::vector<TopoDS_Shape>& meshed);
+    void CollectFaces(const std::vector<TopoDS_Shape>& shapes);
+    void BuildChunks();
+    void EncodeChunk(const Chunk& chunk, std::string& buffer) const;
+    void ReportProgress(int percent);
+
+    StlExportOptions m_options;
+    ProgressCallback m_progressCallback;
+    std::vector<FaceRange> m_faces;
+    std::vector<Chunk> m_chunks;
+    size_t m_triangleCount;
+    std::string m_lastError;
+};
+
+} // namespace cad_core
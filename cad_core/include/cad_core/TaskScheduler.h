@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cad_core {
+
+// 任务优先级：交互（预览、拾取后的计算）先于普通（布尔、导入、特征重建），
+// 后台（三角化、导出、日志写盘）最后
+enum class TaskPriority {
+    Interactive = 0,
+    Normal = 1,
+    Background = 2
+};
+
+class TaskScheduler;
+
+/**
+ * @class TaskGroup
+ * @brief 一组一起等待、一起取消的任务
+ *
+ * Wait()在等待期间只帮忙执行本组还在排队的任务，所以在工作线程里嵌套使用不会死锁，
+ * 界面线程上等待也不会接手别人提交的长任务（布尔、STEP导入）而卡住界面。
+ * 取消后尚未开始的任务不再执行，正在执行的任务可以用IsCancelled()自己提前结束。
+ * 任务抛出的第一个异常由Wait()重新抛出；析构时等待但不抛出。
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::Normal);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> task);
+    // 单个任务使用不同于组的优先级
+    void Run(std::function<void()> task, TaskPriority priority);
+    void Wait();
+
+    void Cancel();
+    bool IsCancelled() const;
+
+    TaskPriority GetPriority() const { return m_priority; }
+
+    // 任务之间共享的状态；队列里的任务持有它，组对象先析构也安全
+    struct State {
+        std::atomic<int> pending{0};
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+private:
+    void WaitAll();
+
+    TaskPriority m_priority;
+    std::shared_ptr<State> m_state;
+};
+
+/**
+ * @class TaskScheduler
+ * @brief 全局的工作窃取线程池，导入、导出、网格和特征预览共用
+ *
+ * 工作线程数为硬件线程数减一（提交任务后等待的线程也参与执行）。每个工作线程
+ * 按优先级各有一个双端队列：自己从尾部取（后进先出，缓存友好），空闲线程从
+ * 别人的头部偷；其他线程提交的任务进入全局队列。任何时候都先取高优先级的任务。
+ *
+ * OCCT自己的线程池（OSD_ThreadPool::DefaultPool）按同样的线程数初始化，所以程序
+ * 启动时、任何OCCT并行算法之前就要调用一次Instance()；池里的任务很多时
+ * ShouldKernelRunParallel()返回false，内核算法改为串行，避免两个线程池叠加超额订阅。
+ */
+class TaskScheduler {
+public:
+    static TaskScheduler& Instance();
+
+    int GetWorkerCount() const { return m_workerCount; }
+
+    // 提交一个独立任务，不需要等待结果
+    void Submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+
+    // 并行执行 body(begin) ... body(end - 1)，调用线程也参与，全部完成后返回；
+    // 下标按需领取（和OSD_Parallel::For一样每次一个），耗时不均匀时也能均衡
+    void ParallelFor(int begin, int end, const std::function<void(int)>& body,
+                     TaskPriority priority = TaskPriority::Normal);
+
+    // 内核算法（布尔、缝合、网格）是否应该再开自己的并行
+    bool ShouldKernelRunParallel() const;
+
+    // 当前线程是否为调度器的工作线程
+    static bool IsWorkerThread();
+
+private:
+    friend class TaskGroup;
+
+    struct Task {
+        std::function<void()> function;
+        std::shared_ptr<TaskGroup::State> group;
+    };
+
+    static constexpr int kPriorityCount = 3;
+
+    struct WorkerQueues {
+        std::mutex mutex;
+        std::deque<Task> queues[kPriorityCount];
+    };
+
+    TaskScheduler();
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    void Push(Task task, TaskPriority priority);
+    // 取出并执行一个属于group的排队任务；没有则返回false
+    bool TryRunGroupTask(const std::shared_ptr<TaskGroup::State>& group);
+    bool Pop(Task& task);
+    void Execute(Task& task);
+    void WorkerLoop(int index);
+
+    const int m_workerCount;
+    std::vector<std::unique_ptr<WorkerQueues>> m_queues;
+    std::mutex m_globalMutex;
+    std::deque<Task> m_global[kPriorityCount];
+
+    std::atomic<int> m_queued;
+    std::atomic<int> m_running;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stopping;
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace cad_core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace cad_core {
+
+/**
+ * @class Tracer
+ * @brief 全局的作用域计时（zone）追踪，导出为Chrome trace JSON（chrome://tracing / Perfetto）
+ *
+ * 每个线程第一次记录时分配自己的环形缓冲区，写入不加锁，满了覆盖最早的事件；
+ * 导出时收集所有线程的缓冲区。关闭时（默认）一个zone只读一次原子标志。
+ * zone名称和类别必须是字符串字面量（只保存指针）。
+ *
+ * 环境变量ANDERCAD_TRACE=<文件>：启动时打开追踪，程序退出时写出trace。
+ */
+class Tracer {
+public:
+    static Tracer& Instance();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 作用域zone：构造时开始计时，析构时写入当前线程的缓冲区
+    class Zone {
+    public:
+        explicit Zone(const char* name, const char* category = "cad");
+        ~Zone();
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        std::int64_t m_startNs;
+        bool m_active;
+    };
+
+    // 给当前线程起名，trace里显示为线程名（比如"UI"）
+    static void SetThreadName(const char* name);
+
+    // 丢弃所有线程已记录的事件
+    void Clear();
+    bool ExportChromeTrace(const std::string& filename) const;
+
+    // 读取ANDERCAD_TRACE；设置了则打开追踪并在退出时写出
+    static void InitFromEnvironment();
+
+    // 每个线程保留的事件数
+    static constexpr size_t kEventsPerThread = 1 << 15;
+
+private:
+    Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    std::int64_t NowNs() const;
+
+    std::atomic<bool> m_enabled;
+    std::atomic<std::int64_t> m_epochNs;
+};
+
+} // namespace cad_core
+
+#define CAD_TRACE_CONCAT_INNER(a, b) a##b
+#define CAD_TRACE_CONCAT(a, b) CAD_TRACE_CONCAT_INNER(a, b)
+
+// 在当前作用域记录一个zone：CAD_TRACE_ZONE("BooleanOperations::Union");
+#define CAD_TRACE_ZONE(name) \
+    ::cad_core::Tracer::Zone CAD_TRACE_CONCAT(cadTraceZone, __LINE__)(name)
+#define CAD_TRACE_ZONE_CAT(name, category) \
+    ::cad_core::Tracer::Zone CAD_TRACE_CONCAT(cadTraceZone, __LINE__)(name, category)
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+
+namespace cad_core {
+
+// 注册STEP/IGES翻译控制器。控制器和Interface_Static参数表是进程级的全局状态，
+// 只注册一次：程序启动时、任何导入导出任务之前调用；重复调用直接返回
+void InitializeTranslators();
+
+/**
+ * @class ScopedTranslatorParameter
+ * @brief 翻译期间临时改写一个Interface_Static参数，析构时恢复
+ *
+ * 参数表是全局的，并行的导入导出（批处理）各自改写会互相覆盖，所以对象存在期间
+ * 持有一把全局锁：改写、翻译和恢复作为一个整体串行执行。对象要覆盖依赖这个参数的
+ * 整个翻译过程；同一线程不能同时持有两个。
+ */
+class ScopedTranslatorParameter {
+public:
+    ScopedTranslatorParameter(const char* name, const char* value);
+    ScopedTranslatorParameter(const char* name, int value);
+    ~ScopedTranslatorParameter();
+
+    ScopedTranslatorParameter(const ScopedTranslatorParameter&) = delete;
+    ScopedTranslatorParameter& operator=(const ScopedTranslatorParameter&) = delete;
+
+private:
+    std::unique_lock<std::mutex> m_lock;
+    const char* m_name;
+    bool m_integer;
+    std::string m_previousText;
+    int m_previousInteger;
+};
+
+} // namespace cad_core
@@ -0,0 +1,82 @@
+#include "cad_core/BooleanCommand.h"
+#include "cad_core/Tracer.h"
+
+namespace cad_core {
+
+BooleanCommand::BooleanCommand(BooleanOperations::BooleanType type,
+                               const std::vector<ShapePtr>& targets,
+                               const std::vector<ShapePtr>& tools)
+    : m_type(type), m_targets(targets), m_tools(tools), m_executed(false) {
+}
+
+bool BooleanCommand::Execute() {
+    return ExecuteWithProgress(Message_ProgressRange());
+}
+
+bool BooleanCommand::ExecuteWithProgress(const Message_ProgressRange& range) {
+    if (m_executed) {
+        return true;
+    }
+    if (m_targets.empty()) {
+        return false;
+    }
+    CAD_TRACE_ZONE("BooleanCommand::Execute");
+
+    switch (m_type) {
+        case BooleanOperations::BooleanType::Union: {
+            std::vector<ShapePtr> shapes = m_targets;
+            shapes.insert(shapes.end(), m_tools.begin(), m_tools.end());
+            m_result = BooleanOperations::Union(shapes, range);
+            break;
+        }
+        case BooleanOperations::BooleanType::Intersection: {
+            std::vector<ShapePtr> shapes = m_targets;
+            shapes.insert(shapes.end(), m_tools.begin(), m_tools.end());
+            m_result = BooleanOperations::Intersection(shapes, range);
+            break;
+        }
+        case BooleanOperations::BooleanType::Difference:
+            // A - B - C 与 A - (B, C) 相同，多工具一次运算
+            m_result = BooleanOperations::Difference(m_targets[0], m_tools, range);
+            break;
+    }
+
+    m_executed = (m_result != nullptr);
+    return m_executed;
+}
+
+bool BooleanCommand::Undo() {
+    if (!m_executed) {
+        return false;
+    }
+
+    m_result.reset();
+    m_executed = false;
+    return true;
+}
+
+bool BooleanCommand::Redo() {
+    if (m_executed) {
+        return true;
+    }
+
+    return Execute();
+}
+
+const char* BooleanCommand::GetName() const {
+    switch (m_type) {
+        case BooleanOperations::BooleanType::Union:
+            return "Boolean Union";
+        case BooleanOperations::BooleanType::Intersection:
+            return "Boolean Intersection";
+        case BooleanOperations::BooleanType::Difference:
+            return "Boolean Difference";
+    }
+    return "Boolean";
+}
+
+ShapePtr BooleanCommand::GetResult() const {
+    return m_result;
+}
+
+} // namespace cad_core
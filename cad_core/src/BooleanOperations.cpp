@@ -1,52 +1,62 @@
 #include "cad_core/BooleanOperations.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
 #include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepAlgoAPI_Common.hxx>
 #include <BRepAlgoAPI_Cut.hxx>
 #include <BRepCheck_Analyzer.hxx>
+#include <Message_ProgressScope.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <BRepBuilderAPI_MakeShape.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopTools_ListOfShape.hxx>
 #include <Standard_Failure.hxx>
 
 namespace cad_core {
 
-ShapePtr BooleanOperations::Union(const ShapePtr& shape1, const ShapePtr& shape2) {
-    return PerformUnion(shape1, shape2);
+ShapePtr BooleanOperations::Union(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
+    return PerformUnion(shape1, shape2, range);
 }
 
-ShapePtr BooleanOperations::Union(const std::vector<ShapePtr>& shapes) {
+ShapePtr BooleanOperations::Union(const std::vector<ShapePtr>& shapes, const Message_ProgressRange& range) {
     if (shapes.empty()) return nullptr;
     if (shapes.size() == 1) return shapes[0];
     
-    ShapePtr result = shapes[0];
-    for (size_t i = 1; i < shapes.size(); i++) {
-        result = Union(result, shapes[i]);
-        if (!result) return nullptr;
-    }
-    
-    return result;
+    // 其余形状作为一组工具，一次融合
+    std::vector<ShapePtr> tools(shapes.begin() + 1, shapes.end());
+    return Union(shapes[0], tools, range);
 }
 
-ShapePtr BooleanOperations::Intersection(const ShapePtr& shape1, const ShapePtr& shape2) {
-    return PerformIntersection(shape1, shape2);
+ShapePtr BooleanOperations::Intersection(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
+    return PerformIntersection(shape1, shape2, range);
 }
 
-ShapePtr BooleanOperations::Intersection(const std::vector<ShapePtr>& shapes) {
+ShapePtr BooleanOperations::Intersection(const std::vector<ShapePtr>& shapes, const Message_ProgressRange& range) {
     if (shapes.empty()) return nullptr;
     if (shapes.size() == 1) return shapes[0];
     
+    // 逐个求交，每一步占同样的进度
+    Message_ProgressScope scope(range, "Intersection", static_cast<Standard_Real>(shapes.size() - 1));
     ShapePtr result = shapes[0];
-    for (size_t i = 1; i < shapes.size(); i++) {
-        result = Intersection(result, shapes[i]);
+    for (size_t i = 1; i < shapes.size() && scope.More(); i++) {
+        result = Intersection(result, shapes[i], scope.Next());
         if (!result) return nullptr;
     }
     
-    return result;
+    return scope.UserBreak() ? nullptr : result;
+}
+
+ShapePtr BooleanOperations::Difference(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
+    return PerformDifference(shape1, shape2, range);
+}
+
+ShapePtr BooleanOperations::Union(const ShapePtr& shape, const std::vector<ShapePtr>& tools, const Message_ProgressRange& range) {
+    return PerformMultiTool(shape, tools, false, range);
 }
 
-ShapePtr BooleanOperations::Difference(const ShapePtr& shape1, const ShapePtr& shape2) {
-    return PerformDifference(shape1, shape2);
+ShapePtr BooleanOperations::Difference(const ShapePtr& shape, const std::vector<ShapePtr>& tools, const Message_ProgressRange& range) {
+    return PerformMultiTool(shape, tools, true, range);
 }
 
 ShapePtr BooleanOperations::BooleanOperation(const ShapePtr& shape1, const ShapePtr& shape2, BooleanType type) {
@@ -119,14 +129,15 @@ ShapePtr BooleanOperations::SimplifyShape(const ShapePtr& shape) {
     return shape;
 }
 
-ShapePtr BooleanOperations::PerformUnion(const ShapePtr& shape1, const ShapePtr& shape2) {
+ShapePtr BooleanOperations::PerformUnion(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
     if (!ValidateInputs(shape1, shape2)) {
         return nullptr;
     }
     
     try {
-        BRepAlgoAPI_Fuse fuseOp(shape1->GetOCCTShape(), shape2->GetOCCTShape());
-        fuseOp.Build();
+        RegenerationProfiler::ScopedCall call("BRepAlgoAPI_Fuse");
+        // 带参数的构造函数已经执行运算，不再调用Build()
+        BRepAlgoAPI_Fuse fuseOp(shape1->GetOCCTShape(), shape2->GetOCCTShape(), range);
         
         if (fuseOp.IsDone()) {
             TopoDS_Shape result = fuseOp.Shape();
@@ -139,14 +150,14 @@ ShapePtr BooleanOperations::PerformUnion(const ShapePtr& shape1, const ShapePtr&
     return nullptr;
 }
 
-ShapePtr BooleanOperations::PerformIntersection(const ShapePtr& shape1, const ShapePtr& shape2) {
+ShapePtr BooleanOperations::PerformIntersection(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
     if (!ValidateInputs(shape1, shape2)) {
         return nullptr;
     }
     
     try {
-        BRepAlgoAPI_Common commonOp(shape1->GetOCCTShape(), shape2->GetOCCTShape());
-        commonOp.Build();
+        RegenerationProfiler::ScopedCall call("BRepAlgoAPI_Common");
+        BRepAlgoAPI_Common commonOp(shape1->GetOCCTShape(), shape2->GetOCCTShape(), range);
         
         if (commonOp.IsDone()) {
             TopoDS_Shape result = commonOp.Shape();
@@ -159,14 +170,14 @@ ShapePtr BooleanOperations::PerformIntersection(const ShapePtr& shape1, const Sh
     return nullptr;
 }
 
-ShapePtr BooleanOperations::PerformDifference(const ShapePtr& shape1, const ShapePtr& shape2) {
+ShapePtr BooleanOperations::PerformDifference(const ShapePtr& shape1, const ShapePtr& shape2, const Message_ProgressRange& range) {
     if (!ValidateInputs(shape1, shape2)) {
         return nullptr;
     }
     
     try {
-        BRepAlgoAPI_Cut cutOp(shape1->GetOCCTShape(), shape2->GetOCCTShape());
-        cutOp.Build();
+        RegenerationProfiler::ScopedCall call("BRepAlgoAPI_Cut");
+        BRepAlgoAPI_Cut cutOp(shape1->GetOCCTShape(), shape2->GetOCCTShape(), range);
         
         if (cutOp.IsDone()) {
             TopoDS_Shape result = cutOp.Shape();
@@ -179,6 +190,55 @@ ShapePtr BooleanOperations::PerformDifference(const ShapePtr& shape1, const Shap
     return nullptr;
 }
 
+ShapePtr BooleanOperations::PerformMultiTool(const ShapePtr& shape, const std::vector<ShapePtr>& tools, bool cut,
+                                             const Message_ProgressRange& range) {
+    if (!shape || shape->GetOCCTShape().IsNull()) {
+        return nullptr;
+    }
+    
+    TopTools_ListOfShape arguments;
+    arguments.Append(shape->GetOCCTShape());
+    
+    TopTools_ListOfShape toolList;
+    for (const auto& tool : tools) {
+        if (tool && !tool->GetOCCTShape().IsNull()) {
+            toolList.Append(tool->GetOCCTShape());
+        }
+    }
+    if (toolList.IsEmpty()) {
+        return shape;
+    }
+    
+    try {
+        // 一次求交，工具之间也只算一遍；多线程交给OCCT内部并行（任务池忙时串行，避免超额订阅）
+        const bool runParallel = TaskScheduler::Instance().ShouldKernelRunParallel();
+        RegenerationProfiler::ScopedCall call(cut ? "BRepAlgoAPI_Cut (multi-tool)" : "BRepAlgoAPI_Fuse (multi-tool)");
+        if (cut) {
+            BRepAlgoAPI_Cut cutOp;
+            cutOp.SetArguments(arguments);
+            cutOp.SetTools(toolList);
+            cutOp.SetRunParallel(runParallel);
+            cutOp.Build(range);
+            if (cutOp.IsDone()) {
+                return PostProcessResult(cutOp.Shape());
+            }
+        } else {
+            BRepAlgoAPI_Fuse fuseOp;
+            fuseOp.SetArguments(arguments);
+            fuseOp.SetTools(toolList);
+            fuseOp.SetRunParallel(runParallel);
+            fuseOp.Build(range);
+            if (fuseOp.IsDone()) {
+                return PostProcessResult(fuseOp.Shape());
+            }
+        }
+    } catch (const Standard_Failure&) {
+        // 布尔运算失败
+    }
+    
+    return nullptr;
+}
+
 bool BooleanOperations::ValidateInputs(const ShapePtr& shape1, const ShapePtr& shape2) {
     if (!shape1 || !shape2) {
         return false;
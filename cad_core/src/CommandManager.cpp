@@ -1,8 +1,17 @@
 #include "cad_core/CommandManager.h"
+#include <Standard_Failure.hxx>
 
 namespace cad_core {
 
-CommandManager::CommandManager() : m_currentIndex(-1) {
+CommandManager::CommandManager()
+    : m_currentIndex(-1), m_pendingAsync(0), m_lifetime(std::make_shared<int>(0)) {
+}
+
+CommandManager::~CommandManager() {
+    // 等工作线程上的命令执行完；已经投递但还没执行的完成回调引用本对象，
+    // 释放m_lifetime之后它们检查到失效就直接返回
+    WaitForAsyncCommands();
+    m_lifetime.reset();
 }
 
 bool CommandManager::ExecuteCommand(CommandPtr command) {
@@ -10,6 +19,60 @@ bool CommandManager::ExecuteCommand(CommandPtr command) {
         return false;
     }
     
+    PushCommand(command);
+    return true;
+}
+
+void CommandManager::ExecuteCommandAsync(CommandPtr command, const Handle(CommandProgress)& progress,
+                                         Dispatcher dispatch, CompletionCallback completion,
+                                         TaskPriority priority) {
+    if (!command || !dispatch) {
+        if (completion) {
+            completion(false, false);
+        }
+        return;
+    }
+
+    ++m_pendingAsync;
+    std::weak_ptr<int> lifetime = m_lifetime;
+    m_asyncTasks.Run([this, lifetime, command, progress, dispatch, completion]() {
+        bool succeeded = false;
+        try {
+            succeeded = progress.IsNull()
+                ? command->ExecuteWithProgress(Message_ProgressRange())
+                : command->ExecuteWithProgress(progress->Start());
+        } catch (const Standard_Failure&) {
+            succeeded = false;
+        } catch (const std::exception&) {
+            succeeded = false;
+        }
+        const bool cancelled = !progress.IsNull() && progress->IsCancelled();
+
+        dispatch([this, lifetime, command, succeeded, cancelled, completion]() {
+            if (lifetime.expired()) {
+                return;
+            }
+            --m_pendingAsync;
+            if (succeeded && cancelled) {
+                // 运算已经完成但用户取消了：结果作废
+                command->Undo();
+            }
+            if (completion) {
+                completion(succeeded && !cancelled, cancelled);
+            }
+        });
+    }, priority);
+}
+
+void CommandManager::WaitForAsyncCommands() {
+    try {
+        m_asyncTasks.Wait();
+    } catch (...) {
+        // 任务内部已经捕获异常，这里不会发生
+    }
+}
+
+void CommandManager::PushCommand(const CommandPtr& command) {
     // Remove commands after current index (for redo functionality)
     if (m_currentIndex + 1 < static_cast<int>(m_commands.size())) {
         m_commands.erase(m_commands.begin() + m_currentIndex + 1, m_commands.end());
@@ -17,8 +80,6 @@ bool CommandManager::ExecuteCommand(CommandPtr command) {
     
     m_commands.push_back(command);
     m_currentIndex++;
-    
-    return true;
 }
 
 bool CommandManager::Undo() {
@@ -0,0 +1,32 @@
+#include "cad_core/CommandProgress.h"
+#include <Message_ProgressScope.hxx>
+
+namespace cad_core {
+
+CommandProgress::CommandProgress() : m_cancelled(false), m_percent(-1) {
+}
+
+void CommandProgress::SetCallback(Callback callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_callback = std::move(callback);
+}
+
+Standard_Boolean CommandProgress::UserBreak() {
+    return IsCancelled();
+}
+
+void CommandProgress::Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) {
+    // OCCT在自己的锁里调用Show()，并行算法的多个线程也不会同时进来
+    const int percent = static_cast<int>(GetPosition() * 100.0);
+    if (percent == m_percent.exchange(percent, std::memory_order_relaxed) && !isForce) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (m_callback) {
+        const char* name = scope.Name();
+        m_callback(percent, name ? name : "");
+    }
+}
+
+} // namespace cad_core
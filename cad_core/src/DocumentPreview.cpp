@@ -0,0 +1,416 @@
+#include "cad_core/DocumentPreview.h"
+#include "cad_core/ByteStream.h"
+#include "cad_core/RegenerationProfiler.h"
+#include <BRepBndLib.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cad_core {
+
+namespace {
+
+const std::uint32_t kPreviewVersion = 1;
+// 第一轮聚类沿包围盒最长边的格子数
+const int kInitialCells = 256;
+// 缓存键取文件首尾各这么多字节
+const size_t kKeySampleBytes = 64 * 1024;
+
+struct TriangleKey {
+    std::uint32_t a, b, c;
+    bool operator==(const TriangleKey& other) const {
+        return a == other.a && b == other.b && c == other.c;
+    }
+};
+
+struct TriangleKeyHash {
+    size_t operator()(const TriangleKey& key) const {
+        std::uint64_t hash = key.a;
+        hash = hash * 0x9E3779B97F4A7C15ull + key.b;
+        hash = hash * 0x9E3779B97F4A7C15ull + key.c;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+// 顶点聚类：落在同一格子的顶点合并为一个（取平均位置），去掉退化和重复的三角形
+class VertexClusterer {
+public:
+    VertexClusterer(const Bnd_Box& box, int cells) {
+        double xmax, ymax, zmax;
+        box.Get(m_min[0], m_min[1], m_min[2], xmax, ymax, zmax);
+        double extent = std::max(xmax - m_min[0], std::max(ymax - m_min[1], zmax - m_min[2]));
+        m_cellSize = extent > 0.0 ? extent / cells : 1.0;
+    }
+
+    std::uint32_t AddVertex(double x, double y, double z) {
+        const double point[3] = { x, y, z };
+        std::uint64_t key = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            double cell = std::floor((point[axis] - m_min[axis]) / m_cellSize);
+            std::uint64_t index = static_cast<std::uint64_t>(std::min(std::max(cell, 0.0), 2097151.0));
+            key |= index << (21 * axis);
+        }
+        auto inserted = m_cells.emplace(key, static_cast<std::uint32_t>(m_counts.size()));
+        if (inserted.second) {
+            m_sums.insert(m_sums.end(), { 0.0, 0.0, 0.0 });
+            m_counts.push_back(0);
+        }
+        std::uint32_t vertex = inserted.first->second;
+        m_sums[vertex * 3] += x;
+        m_sums[vertex * 3 + 1] += y;
+        m_sums[vertex * 3 + 2] += z;
+        ++m_counts[vertex];
+        return vertex;
+    }
+
+    void AddTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        if (a == b || b == c || a == c) {
+            return;
+        }
+        // 轮换到最小序号在前，朝向不变
+        if (b < a && b < c) {
+            std::uint32_t first = a;
+            a = b;
+            b = c;
+            c = first;
+        } else if (c < a && c < b) {
+            std::uint32_t last = c;
+            c = b;
+            b = a;
+            a = last;
+        }
+        if (m_seen.insert(TriangleKey{ a, b, c }).second) {
+            m_triangles.insert(m_triangles.end(), { a, b, c });
+        }
+    }
+
+    // 只输出被三角形用到的顶点
+    void Output(std::vector<float>& vertices, std::vector<std::uint32_t>& triangles) const {
+        const std::uint32_t unused = 0xFFFFFFFFu;
+        std::vector<std::uint32_t> remap(m_counts.size(), unused);
+        vertices.clear();
+        triangles.clear();
+        triangles.reserve(m_triangles.size());
+        for (std::uint32_t vertex : m_triangles) {
+            if (remap[vertex] == unused) {
+                remap[vertex] = static_cast<std::uint32_t>(vertices.size() / 3);
+                for (int axis = 0; axis < 3; ++axis) {
+                    vertices.push_back(static_cast<float>(m_sums[vertex * 3 + axis] / m_counts[vertex]));
+                }
+            }
+            triangles.push_back(remap[vertex]);
+        }
+    }
+
+private:
+    double m_min[3];
+    double m_cellSize;
+    std::unordered_map<std::uint64_t, std::uint32_t> m_cells;
+    std::vector<double> m_sums;
+    std::vector<std::uint32_t> m_counts;
+    std::unordered_set<TriangleKey, TriangleKeyHash> m_seen;
+    std::vector<std::uint32_t> m_triangles;
+};
+
+// 没有三角网格的零件用包围盒的12个三角形代替（法向朝外）
+void AddBox(VertexClusterer& clusterer, const Bnd_Box& box) {
+    double bounds[6];
+    box.Get(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]);
+    std::uint32_t corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = clusterer.AddVertex(bounds[(i & 1) ? 3 : 0], bounds[(i & 2) ? 4 : 1], bounds[(i & 4) ? 5 : 2]);
+    }
+    static const int kFaces[12][3] = {
+        { 0, 4, 6 }, { 0, 6, 2 }, { 1, 3, 7 }, { 1, 7, 5 },
+        { 0, 1, 5 }, { 0, 5, 4 }, { 2, 6, 7 }, { 2, 7, 3 },
+        { 0, 2, 3 }, { 0, 3, 1 }, { 4, 5, 7 }, { 4, 7, 6 }
+    };
+    for (const int* face : kFaces) {
+        clusterer.AddTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+    }
+}
+
+std::string HexString(std::uint64_t value) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
+
+} // namespace
+
+DocumentPreview::DocumentPreview()
+    : m_imageWidth(0), m_imageHeight(0), m_partCount(0) {
+}
+
+void DocumentPreview::Build(const std::vector<NativeDocumentFile::PartData>& parts, size_t maxTriangles) {
+    RegenerationProfiler::ScopedCall call("DocumentPreview::Build");
+
+    m_box.SetVoid();
+    m_vertices.clear();
+    m_triangles.clear();
+    m_partCount = parts.size();
+
+    // 先得到整体包围盒，聚类的格子以它为准
+    std::vector<Bnd_Box> boxes(parts.size());
+    for (size_t i = 0; i < parts.size(); ++i) {
+        boxes[i] = parts[i].box;
+        if (boxes[i].IsVoid() && !parts[i].shape.IsNull()) {
+            BRepBndLib::Add(parts[i].shape, boxes[i]);
+        }
+        if (!boxes[i].IsVoid()) {
+            m_box.Add(boxes[i]);
+        }
+    }
+    if (m_box.IsVoid()) {
+        return;
+    }
+
+    try {
+        VertexClusterer clusterer(m_box, kInitialCells);
+        for (size_t i = 0; i < parts.size(); ++i) {
+            bool meshed = false;
+            for (TopExp_Explorer explorer(parts[i].shape, TopAbs_FACE); explorer.More(); explorer.Next()) {
+                const TopoDS_Face& face = TopoDS::Face(explorer.Current());
+                TopLoc_Location location;
+                const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(face, location);
+                if (triangulation.IsNull() || triangulation->NbTriangles() == 0) {
+                    continue;
+                }
+                meshed = true;
+
+                const gp_Trsf& transform = location.Transformation();
+                std::vector<std::uint32_t> nodes(static_cast<size_t>(triangulation->NbNodes()) + 1);
+                for (Standard_Integer n = 1; n <= triangulation->NbNodes(); ++n) {
+                    gp_Pnt point = triangulation->Node(n).Transformed(transform);
+                    nodes[n] = clusterer.AddVertex(point.X(), point.Y(), point.Z());
+                }
+                const bool reversed = face.Orientation() == TopAbs_REVERSED;
+                for (Standard_Integer t = 1; t <= triangulation->NbTriangles(); ++t) {
+                    Standard_Integer a, b, c;
+                    triangulation->Triangle(t).Get(a, b, c);
+                    if (reversed) {
+                        std::swap(b, c);
+                    }
+                    clusterer.AddTriangle(nodes[a], nodes[b], nodes[c]);
+                }
+            }
+            if (!meshed && !boxes[i].IsVoid()) {
+                AddBox(clusterer, boxes[i]);
+            }
+        }
+        clusterer.Output(m_vertices, m_triangles);
+
+        // 还是太多：格子放大一倍，在上一轮的结果上再聚类
+        for (int cells = kInitialCells / 2; m_triangles.size() / 3 > maxTriangles && cells >= 2; cells /= 2) {
+            VertexClusterer coarser(m_box, cells);
+            std::vector<std::uint32_t> remap(m_vertices.size() / 3);
+            for (size_t v = 0; v < remap.size(); ++v) {
+                remap[v] = coarser.AddVertex(m_vertices[v * 3], m_vertices[v * 3 + 1], m_vertices[v * 3 + 2]);
+            }
+            for (size_t t = 0; t + 2 < m_triangles.size(); t += 3) {
+                coarser.AddTriangle(remap[m_triangles[t]], remap[m_triangles[t + 1]], remap[m_triangles[t + 2]]);
+            }
+            coarser.Output(m_vertices, m_triangles);
+        }
+    } catch (const Standard_Failure&) {
+        m_vertices.clear();
+        m_triangles.clear();
+    }
+}
+
+void DocumentPreview::SetImage(const std::string& png, int width, int height) {
+    m_image = png;
+    m_imageWidth = width;
+    m_imageHeight = height;
+}
+
+TopoDS_Shape DocumentPreview::CreateMeshShape() const {
+    const size_t vertexCount = m_vertices.size() / 3;
+    const size_t triangleCount = m_triangles.size() / 3;
+    if (triangleCount == 0) {
+        return TopoDS_Shape();
+    }
+
+    Handle(Poly_Triangulation) triangulation = new Poly_Triangulation(
+        static_cast<Standard_Integer>(vertexCount), static_cast<Standard_Integer>(triangleCount), Standard_False);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        triangulation->SetNode(static_cast<Standard_Integer>(v + 1),
+                               gp_Pnt(m_vertices[v * 3], m_vertices[v * 3 + 1], m_vertices[v * 3 + 2]));
+    }
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangulation->SetTriangle(static_cast<Standard_Integer>(t + 1),
+                                   Poly_Triangle(static_cast<Standard_Integer>(m_triangles[t * 3] + 1),
+                                                 static_cast<Standard_Integer>(m_triangles[t * 3 + 1] + 1),
+                                                 static_cast<Standard_Integer>(m_triangles[t * 3 + 2] + 1)));
+    }
+    triangulation->ComputeNormals();
+
+    TopoDS_Face face;
+    BRep_Builder builder;
+    builder.MakeFace(face, triangulation);
+    return face;
+}
+
+std::string DocumentPreview::Encode() const {
+    std::string data;
+    ByteWriter writer(data);
+    writer.Put<std::uint32_t>(kPreviewVersion);
+    writer.Put<std::uint32_t>(static_cast<std::uint32_t>(m_partCount));
+    writer.Put<std::uint8_t>(m_box.IsVoid() ? 0 : 1);
+    double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if (!m_box.IsVoid()) {
+        m_box.Get(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]);
+    }
+    for (double value : bounds) {
+        writer.Put<double>(value);
+    }
+    writer.Put<std::int32_t>(m_imageWidth);
+    writer.Put<std::int32_t>(m_imageHeight);
+    writer.PutString(m_image);
+    writer.Put<std::uint32_t>(static_cast<std::uint32_t>(m_vertices.size() / 3));
+    for (float value : m_vertices) {
+        writer.Put<float>(value);
+    }
+    writer.Put<std::uint32_t>(static_cast<std::uint32_t>(m_triangles.size() / 3));
+    for (std::uint32_t index : m_triangles) {
+        writer.Put<std::uint32_t>(index);
+    }
+    return data;
+}
+
+bool DocumentPreview::Decode(const char* data, size_t size) {
+    ByteReader reader(data, size);
+    if (reader.Get<std::uint32_t>() != kPreviewVersion) {
+        return false;
+    }
+    m_partCount = reader.Get<std::uint32_t>();
+    bool hasBox = reader.Get<std::uint8_t>() != 0;
+    double bounds[6];
+    for (double& value : bounds) {
+        value = reader.Get<double>();
+    }
+    m_box.SetVoid();
+    if (hasBox) {
+        m_box.Update(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]);
+    }
+    m_imageWidth = reader.Get<std::int32_t>();
+    m_imageHeight = reader.Get<std::int32_t>();
+    m_image = reader.GetString();
+
+    // 数组长度先和剩余数据核对，损坏的数据不会触发大块分配
+    std::uint32_t vertexCount = reader.Get<std::uint32_t>();
+    const char* vertices = reader.GetBytes(static_cast<size_t>(vertexCount) * 3 * sizeof(float));
+    std::uint32_t triangleCount = reader.Get<std::uint32_t>();
+    const char* triangles = reader.GetBytes(static_cast<size_t>(triangleCount) * 3 * sizeof(std::uint32_t));
+    if (!reader.ok()) {
+        return false;
+    }
+    m_vertices.resize(static_cast<size_t>(vertexCount) * 3);
+    std::memcpy(m_vertices.data(), vertices, m_vertices.size() * sizeof(float));
+    m_triangles.resize(static_cast<size_t>(triangleCount) * 3);
+    std::memcpy(m_triangles.data(), triangles, m_triangles.size() * sizeof(std::uint32_t));
+    for (std::uint32_t index : m_triangles) {
+        if (index >= vertexCount) {
+            m_vertices.clear();
+            m_triangles.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DocumentPreview::Load(const std::string& filename, const PreviewCache* cache, DocumentPreview& preview) {
+    if (NativeDocumentFile::IsNativeFile(filename)) {
+        // 只映射文件、解析目录，不读几何
+        NativeDocumentFile file;
+        size_t size = 0;
+        const char* data = file.Open(filename) ? file.GetPreviewData(size) : nullptr;
+        if (data) {
+            return preview.Decode(data, size);
+        }
+    }
+    return cache && cache->Load(filename, preview);
+}
+
+PreviewCache::PreviewCache(const std::string& directory)
+    : m_directory(directory) {
+}
+
+std::string PreviewCache::FileKey(const std::string& filename) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::string();
+    }
+    const std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+
+    // FNV-1a：文件大小、开头和结尾各一段
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(reinterpret_cast<const char*>(&size), sizeof(size));
+
+    std::string buffer(kKeySampleBytes, '\0');
+    file.seekg(0);
+    file.read(&buffer[0], static_cast<std::streamsize>(std::min<std::uint64_t>(size, kKeySampleBytes)));
+    mix(buffer.data(), static_cast<size_t>(file.gcount()));
+    if (size > kKeySampleBytes) {
+        const std::uint64_t tail = std::min<std::uint64_t>(size - kKeySampleBytes, kKeySampleBytes);
+        file.seekg(static_cast<std::streamoff>(size - tail));
+        file.read(&buffer[0], static_cast<std::streamsize>(tail));
+        mix(buffer.data(), static_cast<size_t>(file.gcount()));
+    }
+    return file ? HexString(hash) : std::string();
+}
+
+bool PreviewCache::Load(const std::string& filename, DocumentPreview& preview) const {
+    std::string key = FileKey(filename);
+    if (key.empty()) {
+        return false;
+    }
+    std::ifstream file(m_directory + "/" + key + ".preview", std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return preview.Decode(data.data(), data.size());
+}
+
+bool PreviewCache::Store(const std::string& filename, const DocumentPreview& preview) const {
+    std::string key = FileKey(filename);
+    if (key.empty()) {
+        return false;
+    }
+    // 先写临时文件再改名，读的一方不会看到写了一半的预览
+    const std::string path = m_directory + "/" + key + ".preview";
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        std::string data = preview.Encode();
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::remove(path.c_str());
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+} // namespace cad_core
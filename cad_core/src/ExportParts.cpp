@@ -0,0 +1,40 @@
+#include "cad_core/ExportParts.h"
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+namespace cad_core {
+
+std::vector<ExportPart> CollectExportParts(OCAFDocument& document) {
+    std::vector<ExportPart> parts;
+
+    Handle(XCAFDoc_ColorTool) colorTool;
+    if (!document.GetDocument().IsNull()) {
+        colorTool = XCAFDoc_DocumentTool::ColorTool(document.GetDocument()->Main());
+    }
+
+    for (const TDF_Label& label : document.GetAllShapes()) {
+        if (document.GetInteger(label) != 1) {
+            continue;
+        }
+        ShapePtr shape = document.GetShape(label);
+        if (!shape || shape->GetOCCTShape().IsNull()) {
+            continue;
+        }
+
+        ExportPart part;
+        part.shape = shape;
+        part.name = document.GetName(label);
+        if (!colorTool.IsNull()) {
+            part.hasColor = colorTool->GetColor(shape->GetOCCTShape(), XCAFDoc_ColorSurf, part.color) ||
+                            colorTool->GetColor(shape->GetOCCTShape(), XCAFDoc_ColorGen, part.color);
+        }
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+std::string ExportPartName(const ExportPart& part, size_t index) {
+    return part.name.empty() ? "Part " + std::to_string(index + 1) : part.name;
+}
+
+} // namespace cad_core
@@ -0,0 +1,76 @@
+#include "cad_core/FilletChamferCommand.h"
+#include "cad_core/FilletChamferOperations.h"
+#include "cad_core/Tracer.h"
+#include <Message_ProgressScope.hxx>
+
+namespace cad_core {
+
+FilletChamferCommand::FilletChamferCommand(Type type,
+                                           const std::map<ShapePtr, std::vector<TopoDS_Edge>>& edgesByShape,
+                                           double size)
+    : m_type(type), m_edgesByShape(edgesByShape), m_size(size), m_executed(false) {
+}
+
+bool FilletChamferCommand::Execute() {
+    return ExecuteWithProgress(Message_ProgressRange());
+}
+
+bool FilletChamferCommand::ExecuteWithProgress(const Message_ProgressRange& range) {
+    if (m_executed) {
+        return true;
+    }
+    CAD_TRACE_ZONE("FilletChamferCommand::Execute");
+
+    m_results.clear();
+    Message_ProgressScope scope(range, GetName(), static_cast<Standard_Real>(m_edgesByShape.size()));
+    for (const auto& shapeEdges : m_edgesByShape) {
+        if (!scope.More()) {
+            break;
+        }
+        Message_ProgressRange step = scope.Next();
+        if (!shapeEdges.first || shapeEdges.second.empty()) {
+            continue;
+        }
+
+        ShapePtr result = (m_type == Type::Fillet)
+            ? FilletChamferOperations::CreateFillet(shapeEdges.first, shapeEdges.second, m_size, step)
+            : FilletChamferOperations::CreateChamfer(shapeEdges.first, shapeEdges.second, m_size, step);
+        if (result) {
+            m_results.emplace_back(shapeEdges.first, result);
+        }
+    }
+
+    m_executed = !m_results.empty() && !scope.UserBreak();
+    if (!m_executed) {
+        m_results.clear();
+    }
+    return m_executed;
+}
+
+bool FilletChamferCommand::Undo() {
+    if (!m_executed) {
+        return false;
+    }
+
+    m_results.clear();
+    m_executed = false;
+    return true;
+}
+
+bool FilletChamferCommand::Redo() {
+    if (m_executed) {
+        return true;
+    }
+
+    return Execute();
+}
+
+const char* FilletChamferCommand::GetName() const {
+    return m_type == Type::Fillet ? "Fillet" : "Chamfer";
+}
+
+const std::vector<FilletChamferCommand::Result>& FilletChamferCommand::GetResults() const {
+    return m_results;
+}
+
+} // namespace cad_core
@@ -1,4 +1,5 @@
 #include "cad_core/FilletChamferOperations.h"
+#include "cad_core/RegenerationProfiler.h"
 #include <BRepFilletAPI_MakeFillet.hxx>
 #include <BRepFilletAPI_MakeChamfer.hxx>
 #include <BRepCheck_Analyzer.hxx>
@@ -15,8 +16,9 @@
 
 namespace cad_core {
 
-ShapePtr FilletChamferOperations::CreateFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius) {
-    return PerformFillet(shape, edges, radius);
+ShapePtr FilletChamferOperations::CreateFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius,
+                                               const Message_ProgressRange& range) {
+    return PerformFillet(shape, edges, radius, range);
 }
 
 ShapePtr FilletChamferOperations::CreateFillet(const ShapePtr& shape, const TopoDS_Edge& edge, double radius) {
@@ -30,6 +32,7 @@ ShapePtr FilletChamferOperations::CreateVariableFillet(const ShapePtr& shape, co
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeFillet");
         BRepFilletAPI_MakeFillet fillet(shape->GetOCCTShape());
         fillet.Add(radius1, radius2, edge);
         fillet.Build();
@@ -45,8 +48,9 @@ ShapePtr FilletChamferOperations::CreateVariableFillet(const ShapePtr& shape, co
     return nullptr;
 }
 
-ShapePtr FilletChamferOperations::CreateChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance) {
-    return PerformChamfer(shape, edges, distance);
+ShapePtr FilletChamferOperations::CreateChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance,
+                                                const Message_ProgressRange& range) {
+    return PerformChamfer(shape, edges, distance, range);
 }
 
 ShapePtr FilletChamferOperations::CreateChamfer(const ShapePtr& shape, const TopoDS_Edge& edge, double distance) {
@@ -60,6 +64,7 @@ ShapePtr FilletChamferOperations::CreateAsymmetricChamfer(const ShapePtr& shape,
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeChamfer");
         BRepFilletAPI_MakeChamfer chamfer(shape->GetOCCTShape());
         
         // 获取相邻面
@@ -86,6 +91,7 @@ ShapePtr FilletChamferOperations::CreateChamferByAngle(const ShapePtr& shape, co
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeChamfer");
         BRepFilletAPI_MakeChamfer chamfer(shape->GetOCCTShape());
         
         // 获取相邻面
@@ -112,6 +118,7 @@ ShapePtr FilletChamferOperations::CreateFaceFillet(const ShapePtr& shape, const
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeFillet");
         BRepFilletAPI_MakeFillet fillet(shape->GetOCCTShape());
         
         // 面圆角需要使用不同的API
@@ -225,12 +232,14 @@ double FilletChamferOperations::GetSuggestedChamferDistance(const ShapePtr& shap
     return GetSuggestedFilletRadius(shape, edge); // 使用相同的逻辑
 }
 
-ShapePtr FilletChamferOperations::PerformFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius) {
+ShapePtr FilletChamferOperations::PerformFillet(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double radius,
+                                                const Message_ProgressRange& range) {
     if (!shape || shape->GetOCCTShape().IsNull() || edges.empty() || radius <= 0.0) {
         return nullptr;
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeFillet");
         BRepFilletAPI_MakeFillet fillet(shape->GetOCCTShape());
         
         for (const auto& edge : edges) {
@@ -239,7 +248,7 @@ ShapePtr FilletChamferOperations::PerformFillet(const ShapePtr& shape, const std
             }
         }
         
-        fillet.Build();
+        fillet.Build(range);
         
         if (fillet.IsDone()) {
             TopoDS_Shape result = fillet.Shape();
@@ -252,12 +261,14 @@ ShapePtr FilletChamferOperations::PerformFillet(const ShapePtr& shape, const std
     return nullptr;
 }
 
-ShapePtr FilletChamferOperations::PerformChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance) {
+ShapePtr FilletChamferOperations::PerformChamfer(const ShapePtr& shape, const std::vector<TopoDS_Edge>& edges, double distance,
+                                                 const Message_ProgressRange& range) {
     if (!shape || shape->GetOCCTShape().IsNull() || edges.empty() || distance <= 0.0) {
         return nullptr;
     }
     
     try {
+        RegenerationProfiler::ScopedCall call("BRepFilletAPI_MakeChamfer");
         BRepFilletAPI_MakeChamfer chamfer(shape->GetOCCTShape());
         
         for (const auto& edge : edges) {
@@ -269,7 +280,7 @@ ShapePtr FilletChamferOperations::PerformChamfer(const ShapePtr& shape, const st
             }
         }
         
-        chamfer.Build();
+        chamfer.Build(range);
         
         if (chamfer.IsDone()) {
             TopoDS_Shape result = chamfer.Shape();
@@ -0,0 +1,264 @@
+#include "cad_core/GltfExporter.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <RWGltf_CafWriter.hxx>
+#include <RWMesh_CoordinateSystem.hxx>
+#include <Standard_Failure.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDataStd_Name.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace cad_core {
+
+namespace {
+
+// 把写文件的进度转接到GltfExporter
+class ExportProgress : public Message_ProgressIndicator {
+public:
+    ExportProgress(GltfExporter* exporter, int offset, int span)
+        : m_exporter(exporter), m_offset(offset), m_span(span) {}
+
+protected:
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) override {
+        (void)scope;
+        (void)isForce;
+        m_exporter->ReportProgress(m_offset + static_cast<int>(GetPosition() * m_span));
+    }
+
+private:
+    GltfExporter* m_exporter;
+    int m_offset;
+    int m_span;
+};
+
+} // namespace
+
+GltfExporter::GltfExporter(const GltfExportOptions& options)
+    : m_options(options) {
+}
+
+void GltfExporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+bool GltfExporter::Export(const std::vector<ExportPart>& parts, const std::string& filename) {
+    m_writtenFiles.clear();
+    m_lastError.clear();
+
+    CollectPrototypes(parts);
+    if (m_prototypes.empty()) {
+        m_lastError = "Nothing to export";
+        return false;
+    }
+
+    RegenerationProfiler::ScopedCall call("GltfExporter::Export");
+    ReportProgress(0);
+
+    // 每一级：网格化占前40%，写文件占后60%
+    const int levels = 1 + std::max(0, m_options.lodLevels);
+    const int span = 100 / levels;
+
+    std::vector<TopoDS_Shape> shapes(m_prototypes.size());
+
+    for (int level = 0; level < levels; ++level) {
+        const int from = level * span;
+        const int middle = from + span * 2 / 5;
+        const int to = level + 1 == levels ? 100 : from + span;
+
+        // 每一级都在复制的拓扑（几何共享）上网格化：文档里的形状同时被视图和
+        // 自动保存使用，不能在工作线程里改它们的三角网格
+        for (size_t i = 0; i < m_prototypes.size(); ++i) {
+            if (MeshImporter::IsMeshShape(m_prototypes[i].shape)) {
+                shapes[i] = m_prototypes[i].shape;
+                continue;
+            }
+            try {
+                BRepBuilderAPI_Copy copier(m_prototypes[i].shape, Standard_False, Standard_False);
+                shapes[i] = copier.Shape();
+            } catch (const Standard_Failure& e) {
+                m_lastError = e.GetMessageString() ? e.GetMessageString() : "Failed to copy shape";
+                return false;
+            }
+        }
+
+        const double deflection = m_options.linearDeflection * std::pow(m_options.lodFactor, level);
+        if (!Tessellate(shapes, deflection, from, middle)) {
+            return false;
+        }
+
+        Handle(TDocStd_Document) document = BuildDocument(shapes);
+        if (document.IsNull()) {
+            return false;
+        }
+
+        const std::string path = level == 0 ? filename : LodFileName(filename, level);
+        bool written = Write(document, path, middle, to);
+        XCAFApp_Application::GetApplication()->Close(document);
+        if (!written) {
+            return false;
+        }
+        m_writtenFiles.push_back(path);
+    }
+
+    ReportProgress(100);
+    return true;
+}
+
+std::string GltfExporter::LodFileName(const std::string& filename, int level) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return filename + "_lod" + std::to_string(level);
+    }
+    return filename.substr(0, dot) + "_lod" + std::to_string(level) + filename.substr(dot);
+}
+
+void GltfExporter::CollectPrototypes(const std::vector<ExportPart>& parts) {
+    m_prototypes.clear();
+    m_instances.clear();
+
+    // 去掉位置后TShape相同的零件共用一个原型
+    std::map<const TopoDS_TShape*, std::vector<int>> byTShape;
+
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const ExportPart& part = parts[i];
+        if (!part.shape || part.shape->GetOCCTShape().IsNull()) {
+            continue;
+        }
+        const TopoDS_Shape& shape = part.shape->GetOCCTShape();
+        TopoDS_Shape prototypeShape = shape.Located(TopLoc_Location());
+
+        int prototype = -1;
+        for (int candidate : byTShape[shape.TShape().get()]) {
+            const Prototype& existing = m_prototypes[candidate];
+            if (existing.shape.IsEqual(prototypeShape) &&
+                existing.hasColor == part.hasColor &&
+                (!part.hasColor || existing.color.IsEqual(part.color))) {
+                prototype = candidate;
+                break;
+            }
+        }
+        if (prototype < 0) {
+            Prototype entry;
+            entry.shape = prototypeShape;
+            entry.name = ExportPartName(part, i);
+            entry.hasColor = part.hasColor;
+            entry.color = part.color;
+            prototype = static_cast<int>(m_prototypes.size());
+            m_prototypes.push_back(entry);
+            byTShape[shape.TShape().get()].push_back(prototype);
+        }
+
+        Instance instance;
+        instance.prototype = prototype;
+        instance.location = shape.Location();
+        instance.name = ExportPartName(part, i);
+        m_instances.push_back(instance);
+    }
+}
+
+bool GltfExporter::Tessellate(std::vector<TopoDS_Shape>& shapes, double deflection, int progressFrom, int progressTo) {
+    IMeshTools_Parameters parameters;
+    parameters.Deflection = deflection;
+    parameters.Angle = m_options.angularDeflection;
+    parameters.InParallel = TaskScheduler::Instance().ShouldKernelRunParallel();
+
+    // shapes都是副本（导入的网格除外，跳过）
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (MeshImporter::IsMeshShape(shapes[i])) {
+            continue;
+        }
+        try {
+            RegenerationProfiler::ScopedCall call("BRepMesh_IncrementalMesh");
+            BRepMesh_IncrementalMesh mesher(shapes[i], parameters);
+        } catch (const Standard_Failure& e) {
+            m_lastError = e.GetMessageString() ? e.GetMessageString() : "Tessellation failed";
+            return false;
+        }
+        ReportProgress(progressFrom + static_cast<int>((progressTo - progressFrom) * (i + 1) / shapes.size()));
+    }
+    return true;
+}
+
+Handle(TDocStd_Document) GltfExporter::BuildDocument(const std::vector<TopoDS_Shape>& shapes) {
+    Handle(TDocStd_Document) document;
+    try {
+        XCAFApp_Application::GetApplication()->NewDocument("BinXCAF", document);
+        Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+        Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+
+        std::vector<TDF_Label> prototypeLabels(shapes.size());
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            prototypeLabels[i] = shapeTool->AddShape(shapes[i], Standard_False, Standard_False);
+            TDataStd_Name::Set(prototypeLabels[i], TCollection_ExtendedString(m_prototypes[i].name.c_str(), Standard_True));
+            if (m_prototypes[i].hasColor) {
+                colorTool->SetColor(prototypeLabels[i], m_prototypes[i].color, XCAFDoc_ColorGen);
+            }
+        }
+
+        // 所有实例挂在一个根装配下，同一原型的实例共用mesh
+        TDF_Label root = shapeTool->NewShape();
+        TDataStd_Name::Set(root, "AnderCAD");
+        for (const Instance& instance : m_instances) {
+            TDF_Label component = shapeTool->AddComponent(root, prototypeLabels[instance.prototype], instance.location);
+            if (!component.IsNull()) {
+                TDataStd_Name::Set(component, TCollection_ExtendedString(instance.name.c_str(), Standard_True));
+            }
+        }
+        shapeTool->UpdateAssemblies();
+    } catch (const Standard_Failure& e) {
+        if (!document.IsNull()) {
+            XCAFApp_Application::GetApplication()->Close(document);
+        }
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "Failed to build export document";
+        return nullptr;
+    }
+    return document;
+}
+
+bool GltfExporter::Write(const Handle(TDocStd_Document)& document, const std::string& filename,
+                         int progressFrom, int progressTo) {
+    try {
+        RegenerationProfiler::ScopedCall call("RWGltf_CafWriter");
+
+        RWGltf_CafWriter writer(TCollection_AsciiString(filename.c_str()), m_options.binary);
+        // 模型是Z向上的毫米，glTF要求Y向上的米
+        writer.ChangeCoordinateSystemConverter().SetInputLengthUnit(0.001);
+        writer.ChangeCoordinateSystemConverter().SetInputCoordinateSystem(RWMesh_CoordinateSystem_Zup);
+        writer.SetTransformationFormat(RWGltf_WriterTrsfFormat_Compact);
+        // 一个零件的各个面合成一个图元，减少下游的绘制调用
+        writer.SetMergeFaces(Standard_True);
+
+        TColStd_IndexedDataMapOfStringString fileInfo;
+        Handle(ExportProgress) indicator = new ExportProgress(this, progressFrom, progressTo - progressFrom);
+        if (!writer.Perform(document, fileInfo, indicator->Start())) {
+            m_lastError = "Failed to write " + filename;
+            return false;
+        }
+    } catch (const Standard_Failure& e) {
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "glTF export failed";
+        return false;
+    }
+    return true;
+}
+
+void GltfExporter::ReportProgress(int percent) {
+    if (m_progressCallback) {
+        m_progressCallback(percent);
+    }
+}
+
+} // namespace cad_core
@@ -0,0 +1,124 @@
+#include "cad_core/IgesExporter.h"
+#include "cad_core/Logger.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TranslatorSetup.h"
+#include <IGESCAFControl_Writer.hxx>
+#include <IGESData_IGESModel.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <Standard_Failure.hxx>
+#include <TCollection_ExtendedString.hxx>
+#include <TDataStd_Name.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+namespace cad_core {
+
+namespace {
+
+// 把翻译进度转接到IgesExporter
+class ExportProgress : public Message_ProgressIndicator {
+public:
+    ExportProgress(IgesExporter* exporter, int offset, int span)
+        : m_exporter(exporter), m_offset(offset), m_span(span) {}
+
+protected:
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) override {
+        (void)scope;
+        (void)isForce;
+        m_exporter->ReportProgress(m_offset + static_cast<int>(GetPosition() * m_span));
+    }
+
+private:
+    IgesExporter* m_exporter;
+    int m_offset;
+    int m_span;
+};
+
+} // namespace
+
+IgesExporter::IgesExporter()
+    : m_brepMode(false), m_entityCount(0) {
+}
+
+void IgesExporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+bool IgesExporter::Export(const std::vector<ExportPart>& parts, const std::string& filename) {
+    m_entityCount = 0;
+    m_lastError.clear();
+
+    Handle(TDocStd_Document) document;
+    try {
+        RegenerationProfiler::ScopedCall call("IgesExporter::Export");
+        InitializeTranslators();
+        ReportProgress(0);
+
+        XCAFApp_Application::GetApplication()->NewDocument("BinXCAF", document);
+        Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(document->Main());
+        Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(document->Main());
+        int added = 0;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            const ExportPart& part = parts[i];
+            if (!part.shape || part.shape->GetOCCTShape().IsNull()) {
+                continue;
+            }
+            TDF_Label label = shapeTool->AddShape(part.shape->GetOCCTShape(), Standard_False);
+            const std::string name = ExportPartName(part, i);
+            TDataStd_Name::Set(label, TCollection_ExtendedString(name.c_str(), Standard_True));
+            if (part.hasColor) {
+                colorTool->SetColor(label, part.color, XCAFDoc_ColorGen);
+            }
+            ++added;
+        }
+        if (added == 0) {
+            XCAFApp_Application::GetApplication()->Close(document);
+            m_lastError = "Nothing to export";
+            return false;
+        }
+        ReportProgress(10);
+
+        // 0 = 修剪曲面（Faces），1 = MSBO实体（BRep）；参数是全局的，持有期间其他翻译排队等待
+        ScopedTranslatorParameter brepMode("write.iges.brep.mode", m_brepMode ? 1 : 0);
+        IGESCAFControl_Writer writer;
+        writer.SetColorMode(Standard_True);
+        writer.SetNameMode(Standard_True);
+        Handle(ExportProgress) indicator = new ExportProgress(this, 10, 80);
+        if (!writer.Transfer(document, indicator->Start())) {
+            XCAFApp_Application::GetApplication()->Close(document);
+            m_lastError = "Failed to translate shapes to IGES";
+            return false;
+        }
+        m_entityCount = static_cast<size_t>(writer.Model()->NbEntities());
+
+        ReportProgress(90);
+        bool written = writer.Write(filename.c_str());
+        XCAFApp_Application::GetApplication()->Close(document);
+        if (!written) {
+            m_lastError = "Failed to write IGES file";
+            return false;
+        }
+    } catch (const Standard_Failure& e) {
+        if (!document.IsNull()) {
+            XCAFApp_Application::GetApplication()->Close(document);
+        }
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "IGES export failed";
+        return false;
+    }
+
+    ReportProgress(100);
+    CAD_LOG_INFO("iges", "Exported " << parts.size() << " parts (" << m_entityCount
+                 << " entities) to " << filename);
+    return true;
+}
+
+void IgesExporter::ReportProgress(int percent) {
+    if (m_progressCallback) {
+        m_progressCallback(percent);
+    }
+}
+
+} // namespace cad_core
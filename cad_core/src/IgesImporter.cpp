@@ -0,0 +1,351 @@
+#include "cad_core/IgesImporter.h"
+#include "cad_core/Logger.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include "cad_core/TranslatorSetup.h"
+#include <BRepBuilderAPI_MakeSolid.hxx>
+#include <BRepBuilderAPI_Sewing.hxx>
+#include <BRepLib.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <IFSelect_ReturnStatus.hxx>
+#include <IGESCAFControl.hxx>
+#include <IGESCAFControl_Reader.hxx>
+#include <IGESData_IGESEntity.hxx>
+#include <IGESData_IGESModel.hxx>
+#include <IGESGraph_Color.hxx>
+#include <IGESToBRep.hxx>
+#include <IGESToBRep_CurveAndSurface.hxx>
+#include <Interface_Static.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <Standard_Failure.hxx>
+#include <TCollection_HAsciiString.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <Transfer_TransientProcess.hxx>
+#include <algorithm>
+
+namespace cad_core {
+
+namespace {
+
+// 缝合的进度和取消请求转接到IgesImporter
+class SewingProgress : public Message_ProgressIndicator {
+public:
+    SewingProgress(IgesImporter* importer, int offset, int span)
+        : m_importer(importer), m_offset(offset), m_span(span) {}
+
+    Standard_Boolean UserBreak() override {
+        return m_importer->IsCancelled();
+    }
+
+protected:
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) override {
+        (void)scope;
+        (void)isForce;
+        m_importer->ReportProgress(m_offset + static_cast<int>(GetPosition() * m_span), "Sewing");
+    }
+
+private:
+    IgesImporter* m_importer;
+    int m_offset;
+    int m_span;
+};
+
+std::string EntityName(const Handle(IGESData_IGESEntity)& entity) {
+    if (entity->HasName() && !entity->NameValue().IsNull()) {
+        return entity->NameValue()->ToCString();
+    }
+    if (entity->HasShortLabel() && !entity->ShortLabel().IsNull()) {
+        return entity->ShortLabel()->ToCString();
+    }
+    return std::string();
+}
+
+// 颜色定义：引用颜色实体（百分比RGB）或预定义的颜色序号
+bool EntityColor(const Handle(IGESData_IGESEntity)& entity, Quantity_Color& color) {
+    if (entity->DefColor() == IGESData_DefReference) {
+        Handle(IGESGraph_Color) reference = Handle(IGESGraph_Color)::DownCast(entity->Color());
+        if (reference.IsNull()) {
+            return false;
+        }
+        Standard_Real red, green, blue;
+        reference->RGBIntensity(red, green, blue);
+        color.SetValues(red / 100.0, green / 100.0, blue / 100.0, Quantity_TOC_sRGB);
+        return true;
+    }
+    if (entity->DefColor() == IGESData_DefValue) {
+        color = IGESCAFControl::DecodeColor(entity->RankColor());
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+IgesImporter::IgesImporter()
+    : m_sewingTolerance(0.01), m_entityCount(0), m_sewnFaceCount(0), m_freeEdgeCount(0),
+      m_cancelled(false), m_lastPercent(-1) {
+}
+
+void IgesImporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+bool IgesImporter::Import(const std::string& filename) {
+    m_parts.clear();
+    m_failures.clear();
+    m_entityCount = 0;
+    m_sewnFaceCount = 0;
+    m_freeEdgeCount = 0;
+    m_lastError.clear();
+    m_lastPercent = -1;
+
+    try {
+        InitializeTranslators();
+
+        ReportProgress(0, "Reading file");
+        IGESCAFControl_Reader reader;
+        IFSelect_ReturnStatus status;
+        {
+            RegenerationProfiler::ScopedCall call("IGESCAFControl_Reader::ReadFile");
+            status = reader.ReadFile(filename.c_str());
+        }
+        if (status != IFSelect_RetDone) {
+            m_lastError = "Failed to read IGES file";
+            return false;
+        }
+        if (IsCancelled()) {
+            return false;
+        }
+
+        Handle(IGESData_IGESModel) model = reader.IGESModel();
+        const int rootCount = reader.NbRootsForTransfer();
+        m_entityCount = static_cast<size_t>(std::max(rootCount, 0));
+
+        // 曲线、曲面和B-rep实体并行翻译，其余（子图、组等结构实体）交给读取器
+        std::vector<Handle(IGESData_IGESEntity)> roots(m_entityCount);
+        std::vector<size_t> geometric;
+        std::vector<size_t> structural;
+        for (size_t i = 0; i < m_entityCount; ++i) {
+            roots[i] = Handle(IGESData_IGESEntity)::DownCast(reader.RootForTransfer(static_cast<int>(i) + 1));
+            if (roots[i].IsNull()) {
+                continue;
+            }
+            if (IGESToBRep::IsCurveAndSurface(roots[i]) || IGESToBRep::IsBRepEntity(roots[i])) {
+                geometric.push_back(i);
+            } else {
+                structural.push_back(i);
+            }
+        }
+
+        std::vector<TopoDS_Shape> shapes(m_entityCount);
+        std::vector<std::string> errors(m_entityCount);
+        const double precision = Interface_Static::IVal("read.precision.mode") == 0
+            ? model->GlobalSection().Resolution()
+            : Interface_Static::RVal("read.precision.val");
+        const int continuity = Interface_Static::IVal("read.iges.bspline.continuity");
+        const int surfaceCurve = Interface_Static::IVal("read.surfacecurve.mode");
+
+        ReportProgress(30, "Translating");
+        {
+            RegenerationProfiler::ScopedCall call("IgesImporter::Translate");
+            std::atomic<size_t> next(0);
+            std::atomic<size_t> finished(0);
+            const int workers = TaskScheduler::Instance().GetWorkerCount() + 1;
+            TaskScheduler::Instance().ParallelFor(0, workers, [&](int) {
+                // 翻译状态每个线程一份，模型和实体只读
+                Handle(Transfer_TransientProcess) process = new Transfer_TransientProcess(model->NbEntities());
+                process->SetModel(model);
+                IGESToBRep_CurveAndSurface converter;
+                converter.SetModel(model);
+                converter.SetContinuity(continuity);
+                converter.SetTransferProcess(process);
+                converter.SetEpsilon(precision);
+                converter.SetSurfaceCurve(surfaceCurve);
+
+                while (!IsCancelled()) {
+                    const size_t first = next.fetch_add(kBatchSize);
+                    if (first >= geometric.size()) {
+                        break;
+                    }
+                    const size_t last = std::min(first + kBatchSize, geometric.size());
+                    for (size_t k = first; k < last; ++k) {
+                        const size_t index = geometric[k];
+                        try {
+                            shapes[index] = converter.TransferGeometry(roots[index]);
+                            if (shapes[index].IsNull()) {
+                                errors[index] = "No shape produced";
+                            }
+                        } catch (const Standard_Failure& e) {
+                            shapes[index].Nullify();
+                            errors[index] = e.GetMessageString() ? e.GetMessageString() : "Translation failed";
+                        }
+                    }
+                    const size_t done = finished += last - first;
+                    ReportProgress(30 + static_cast<int>(45 * done / geometric.size()), "Translating");
+                }
+            }, TaskPriority::Normal);
+        }
+        if (IsCancelled()) {
+            return false;
+        }
+
+        for (size_t index : structural) {
+            const int before = reader.NbShapes();
+            try {
+                if (reader.TransferEntity(roots[index]) && reader.NbShapes() > before) {
+                    shapes[index] = reader.Shape(reader.NbShapes());
+                } else {
+                    errors[index] = "No shape produced";
+                }
+            } catch (const Standard_Failure& e) {
+                errors[index] = e.GetMessageString() ? e.GetMessageString() : "Translation failed";
+            }
+        }
+
+        // 实体直接成为零件，实体以外的面收集起来缝合，曲线合成一个零件
+        ReportProgress(75, "Collecting shapes");
+        const std::string baseName = [&filename]() {
+            size_t slash = filename.find_last_of("/\\");
+            std::string name = slash == std::string::npos ? filename : filename.substr(slash + 1);
+            size_t dot = name.find_last_of('.');
+            return dot == std::string::npos ? name : name.substr(0, dot);
+        }();
+
+        std::vector<TopoDS_Face> faces;
+        BRep_Builder builder;
+        TopoDS_Compound curves;
+        builder.MakeCompound(curves);
+        bool hasCurves = false;
+        for (size_t i = 0; i < m_entityCount; ++i) {
+            if (!errors[i].empty() && !roots[i].IsNull()) {
+                EntityFailure failure;
+                failure.entity = 2 * model->Number(roots[i]) - 1;
+                failure.type = roots[i]->TypeNumber();
+                failure.form = roots[i]->FormNumber();
+                failure.message = errors[i];
+                m_failures.push_back(failure);
+            }
+            if (shapes[i].IsNull()) {
+                continue;
+            }
+
+            std::string name = EntityName(roots[i]);
+            Quantity_Color color;
+            bool hasColor = EntityColor(roots[i], color);
+            for (TopExp_Explorer solid(shapes[i], TopAbs_SOLID); solid.More(); solid.Next()) {
+                Part part;
+                part.name = name.empty() ? baseName + " solid " + std::to_string(m_parts.size() + 1) : name;
+                part.shape = std::make_shared<Shape>(solid.Current());
+                part.hasColor = hasColor;
+                part.color = color;
+                m_parts.push_back(part);
+            }
+            for (TopExp_Explorer face(shapes[i], TopAbs_FACE, TopAbs_SOLID); face.More(); face.Next()) {
+                faces.push_back(TopoDS::Face(face.Current()));
+            }
+            for (TopExp_Explorer edge(shapes[i], TopAbs_EDGE, TopAbs_FACE); edge.More(); edge.Next()) {
+                builder.Add(curves, edge.Current());
+                hasCurves = true;
+            }
+        }
+
+        if (!faces.empty()) {
+            // 并行缝合：散面连成壳，封闭的壳做成实体
+            RegenerationProfiler::ScopedCall call("BRepBuilderAPI_Sewing");
+            ReportProgress(80, "Sewing");
+            BRepBuilderAPI_Sewing sewing(m_sewingTolerance);
+            sewing.SetRunParallel(TaskScheduler::Instance().ShouldKernelRunParallel());
+            for (const TopoDS_Face& face : faces) {
+                sewing.Add(face);
+            }
+            Handle(SewingProgress) indicator = new SewingProgress(this, 80, 20);
+            sewing.Perform(indicator->Start());
+            if (IsCancelled()) {
+                return false;
+            }
+            m_sewnFaceCount = faces.size();
+            m_freeEdgeCount = static_cast<size_t>(sewing.NbFreeEdges());
+
+            TopoDS_Shape sewn = sewing.SewedShape();
+            TopoDS_Compound surfaces;
+            builder.MakeCompound(surfaces);
+            bool hasSurfaces = false;
+            for (TopExp_Explorer shell(sewn, TopAbs_SHELL); shell.More(); shell.Next()) {
+                TopoDS_Shape solid;
+                if (BRep_Tool::IsClosed(shell.Current())) {
+                    BRepBuilderAPI_MakeSolid maker(TopoDS::Shell(shell.Current()));
+                    if (maker.IsDone()) {
+                        solid = maker.Solid();
+                        BRepLib::OrientClosedSolid(TopoDS::Solid(solid));
+                    }
+                }
+                if (!solid.IsNull()) {
+                    Part part;
+                    part.name = baseName + " solid " + std::to_string(m_parts.size() + 1);
+                    part.shape = std::make_shared<Shape>(solid);
+                    m_parts.push_back(part);
+                } else {
+                    builder.Add(surfaces, shell.Current());
+                    hasSurfaces = true;
+                }
+            }
+            for (TopExp_Explorer face(sewn, TopAbs_FACE, TopAbs_SHELL); face.More(); face.Next()) {
+                builder.Add(surfaces, face.Current());
+                hasSurfaces = true;
+            }
+            if (hasSurfaces) {
+                Part part;
+                part.name = baseName + " surfaces";
+                part.shape = std::make_shared<Shape>(surfaces);
+                m_parts.push_back(part);
+            }
+        }
+
+        if (hasCurves) {
+            Part part;
+            part.name = baseName + " curves";
+            part.shape = std::make_shared<Shape>(curves);
+            m_parts.push_back(part);
+        }
+
+        ReportProgress(100, "Done");
+        CAD_LOG_INFO("iges", "Imported " << m_parts.size() << " parts from " << m_entityCount
+                     << " root entities (" << m_failures.size() << " failed, " << m_sewnFaceCount
+                     << " faces sewn) from " << filename);
+        if (m_parts.empty()) {
+            m_lastError = "No shapes could be translated";
+            return false;
+        }
+        return true;
+    } catch (const Standard_Failure& e) {
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "IGES import failed";
+        return false;
+    }
+}
+
+void IgesImporter::Cancel() {
+    m_cancelled = true;
+}
+
+bool IgesImporter::IsCancelled() const {
+    return m_cancelled;
+}
+
+void IgesImporter::ReportProgress(int percent, const std::string& stage) {
+    if (!m_progressCallback) {
+        return;
+    }
+    // 多个翻译线程都会上报，只在整数百分比变化时转发
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    if (percent == m_lastPercent && percent != 0) {
+        return;
+    }
+    m_lastPercent = percent;
+    m_progressCallback(percent, stage);
+}
+
+} // namespace cad_core
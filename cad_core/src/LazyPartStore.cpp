@@ -0,0 +1,233 @@
+#include "cad_core/LazyPartStore.h"
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+
+namespace cad_core {
+
+namespace {
+
+// 每个拓扑实体的大致开销（TShape + 几何 + 句柄）
+const size_t kFaceBytes = 512;
+const size_t kEdgeBytes = 256;
+const size_t kVertexBytes = 96;
+
+const Bnd_Box& EmptyBox() {
+    static const Bnd_Box box;
+    return box;
+}
+
+const std::string& EmptyName() {
+    static const std::string name;
+    return name;
+}
+
+} // namespace
+
+LazyPartStore::LazyPartStore()
+    : m_clock(0), m_frameStart(0), m_loadedBytes(0), m_budget(kDefaultBudgetBytes) {
+}
+
+int LazyPartStore::AddPart(const std::string& name, const Bnd_Box& box, Loader loader, Unloader unloader) {
+    Part part;
+    part.name = name;
+    part.box = box;
+    part.loader = std::move(loader);
+    part.unloader = std::move(unloader);
+    m_parts.push_back(std::move(part));
+    return static_cast<int>(m_parts.size()) - 1;
+}
+
+void LazyPartStore::RemovePart(int id) {
+    if (!IsValidPart(id)) {
+        return;
+    }
+    Unload(id, false);
+    Part& part = m_parts[id];
+    part.removed = true;
+    part.loader = nullptr;
+    part.unloader = nullptr;
+}
+
+void LazyPartStore::Clear() {
+    m_parts.clear();
+    m_lru.clear();
+    m_loadedBytes = 0;
+}
+
+ShapePtr LazyPartStore::Materialize(int id) {
+    if (!IsValidPart(id)) {
+        return nullptr;
+    }
+
+    Part& part = m_parts[id];
+    if (part.shape) {
+        Touch(id);
+        return part.shape;
+    }
+    if (!part.loader) {
+        return nullptr;
+    }
+
+    ShapePtr shape;
+    try {
+        shape = part.loader();
+    } catch (const Standard_Failure&) {
+        shape = nullptr;
+    }
+    if (!shape || shape->GetOCCTShape().IsNull()) {
+        return nullptr;
+    }
+
+    // 加载过程中可能触发了别的回调，重新取引用
+    Part& loaded = m_parts[id];
+    loaded.shape = shape;
+    loaded.bytes = EstimateShapeBytes(shape->GetOCCTShape());
+    loaded.lastUse = ++m_clock;
+    m_lru.insert(std::make_pair(loaded.lastUse, id));
+    m_loadedBytes += loaded.bytes;
+
+    EnforceBudget();
+    return shape;
+}
+
+ShapePtr LazyPartStore::Reload(int id) {
+    if (!IsLoaded(id)) {
+        return nullptr;
+    }
+    Part& part = m_parts[id];
+    m_lru.erase(std::make_pair(part.lastUse, id));
+    m_loadedBytes -= part.bytes;
+    part.shape.reset();
+    part.bytes = 0;
+    return Materialize(id);
+}
+
+void LazyPartStore::Evict(int id) {
+    Unload(id, true);
+}
+
+ShapePtr LazyPartStore::GetShape(int id) const {
+    return IsValidPart(id) ? m_parts[id].shape : nullptr;
+}
+
+bool LazyPartStore::IsLoaded(int id) const {
+    return IsValidPart(id) && m_parts[id].shape != nullptr;
+}
+
+bool LazyPartStore::IsValidPart(int id) const {
+    return id >= 0 && id < static_cast<int>(m_parts.size()) && !m_parts[id].removed;
+}
+
+const Bnd_Box& LazyPartStore::GetBoundingBox(int id) const {
+    return IsValidPart(id) ? m_parts[id].box : EmptyBox();
+}
+
+const std::string& LazyPartStore::GetName(int id) const {
+    return IsValidPart(id) ? m_parts[id].name : EmptyName();
+}
+
+void LazyPartStore::Touch(int id) {
+    if (!IsLoaded(id)) {
+        return;
+    }
+    Part& part = m_parts[id];
+    m_lru.erase(std::make_pair(part.lastUse, id));
+    part.lastUse = ++m_clock;
+    m_lru.insert(std::make_pair(part.lastUse, id));
+}
+
+void LazyPartStore::BeginFrame() {
+    m_frameStart = ++m_clock;
+}
+
+void LazyPartStore::SetPinned(int id, bool pinned) {
+    if (IsValidPart(id)) {
+        m_parts[id].pinned = pinned;
+    }
+}
+
+void LazyPartStore::SetMemoryBudget(size_t bytes) {
+    m_budget = bytes;
+    EnforceBudget();
+}
+
+void LazyPartStore::SetEvictCallback(EvictCallback callback) {
+    m_evictCallback = std::move(callback);
+}
+
+void LazyPartStore::Unload(int id, bool notify) {
+    if (!IsLoaded(id)) {
+        return;
+    }
+
+    Part& part = m_parts[id];
+    ShapePtr shape = part.shape;
+    m_lru.erase(std::make_pair(part.lastUse, id));
+    m_loadedBytes -= part.bytes;
+    part.shape.reset();
+    part.bytes = 0;
+
+    if (part.unloader) {
+        part.unloader();
+    }
+    if (notify && m_evictCallback) {
+        m_evictCallback(id, shape);
+    }
+}
+
+void LazyPartStore::EnforceBudget() {
+    auto it = m_lru.begin();
+    while (m_loadedBytes > m_budget && it != m_lru.end()) {
+        // 本帧用过的零件不卸载，否则可见零件超预算时会来回加载
+        if (it->first >= m_frameStart) {
+            break;
+        }
+        int id = it->second;
+        ++it;
+        if (m_parts[id].pinned) {
+            continue;
+        }
+        Unload(id, true);
+    }
+}
+
+size_t LazyPartStore::EstimateShapeBytes(const TopoDS_Shape& shape) {
+    if (shape.IsNull()) {
+        return 0;
+    }
+
+    size_t bytes = 0;
+    try {
+        TopTools_IndexedMapOfShape faces;
+        TopTools_IndexedMapOfShape edges;
+        TopTools_IndexedMapOfShape vertices;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertices);
+
+        bytes += faces.Extent() * kFaceBytes;
+        bytes += edges.Extent() * kEdgeBytes;
+        bytes += vertices.Extent() * kVertexBytes;
+
+        for (int i = 1; i <= faces.Extent(); ++i) {
+            TopLoc_Location location;
+            Handle(Poly_Triangulation) triangulation =
+                BRep_Tool::Triangulation(TopoDS::Face(faces(i)), location);
+            if (!triangulation.IsNull()) {
+                bytes += triangulation->NbNodes() * (sizeof(gp_Pnt) + sizeof(gp_Dir))
+                       + triangulation->NbTriangles() * 3 * sizeof(int);
+            }
+        }
+    } catch (const Standard_Failure&) {
+        // 估算失败就只按已经统计的部分算
+    }
+    return bytes;
+}
+
+} // namespace cad_core
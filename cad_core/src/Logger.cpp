@@ -0,0 +1,240 @@
+#include "cad_core/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+namespace cad_core {
+
+namespace {
+
+std::uint64_t CurrentThreadId() {
+    static std::atomic<std::uint64_t> s_nextThreadId(1);
+    thread_local std::uint64_t t_threadId = s_nextThreadId++;
+    return t_threadId;
+}
+
+bool ParseLevel(std::string text, LogLevel& level) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (text == "trace") level = LogLevel::Trace;
+    else if (text == "debug") level = LogLevel::Debug;
+    else if (text == "info") level = LogLevel::Info;
+    else if (text == "warning" || text == "warn") level = LogLevel::Warning;
+    else if (text == "error") level = LogLevel::Error;
+    else if (text == "off") level = LogLevel::Off;
+    else return false;
+    return true;
+}
+
+// 默认输出：整批拼成一个字符串，一次写入、一次刷新
+void WriteToStderr(const std::vector<LogRecord>& batch) {
+    std::string text;
+    char stamp[32];
+    for (const LogRecord& record : batch) {
+        std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+        std::tm local;
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+        std::strftime(stamp, sizeof(stamp), "%H:%M:%S", &local);
+        text += stamp;
+        text += " [";
+        text += Logger::LevelName(record.level);
+        text += "] [";
+        text += record.category;
+        text += "] ";
+        text += record.message;
+        text += '\n';
+    }
+    std::fwrite(text.data(), 1, text.size(), stderr);
+    std::fflush(stderr);
+}
+
+} // namespace
+
+Logger& Logger::Instance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : m_level(static_cast<int>(LogLevel::Info)),
+      m_hasCategoryLevels(false),
+      m_categoryLevels(std::make_shared<const CategoryLevels>()),
+      m_head(nullptr),
+      m_pending(0),
+      m_dropped(0),
+      m_nextSinkId(1),
+      m_stderrEnabled(true),
+      m_stopping(false) {
+    const char* spec = std::getenv("ANDERCAD_LOG");
+    if (spec != nullptr) {
+        Configure(spec);
+    }
+    m_thread = std::thread(&Logger::Run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    Drain();
+}
+
+void Logger::SetLevel(LogLevel level) {
+    m_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::SetCategoryLevel(const std::string& category, LogLevel level) {
+    std::lock_guard<std::mutex> lock(m_categoryMutex);
+    auto levels = std::make_shared<CategoryLevels>(*std::atomic_load(&m_categoryLevels));
+    (*levels)[category] = level;
+    std::atomic_store(&m_categoryLevels, std::shared_ptr<const CategoryLevels>(std::move(levels)));
+    m_hasCategoryLevels.store(true, std::memory_order_release);
+}
+
+bool Logger::IsEnabled(LogLevel level, const char* category) const {
+    // 常见情况（没有按类别设置）只读一个原子变量
+    if (m_hasCategoryLevels.load(std::memory_order_acquire)) {
+        const auto levels = std::atomic_load(&m_categoryLevels);
+        auto it = levels->find(category);
+        if (it != levels->end()) {
+            return level >= it->second && it->second != LogLevel::Off;
+        }
+    }
+    const LogLevel global = GetLevel();
+    return level >= global && global != LogLevel::Off;
+}
+
+void Logger::Configure(const std::string& spec) {
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        LogLevel level;
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            if (ParseLevel(item, level)) {
+                SetLevel(level);
+            }
+        } else if (ParseLevel(item.substr(equals + 1), level)) {
+            SetCategoryLevel(item.substr(0, equals), level);
+        }
+    }
+}
+
+void Logger::Write(LogLevel level, const char* category, std::string message) {
+    if (m_pending.fetch_add(1, std::memory_order_relaxed) >= kMaxPending) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Node* node = new Node();
+    node->record.level = level;
+    node->record.category = category;
+    node->record.message = std::move(message);
+    node->record.time = std::chrono::system_clock::now();
+    node->record.threadId = CurrentThreadId();
+
+    node->next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+}
+
+int Logger::AddSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    const int id = m_nextSinkId++;
+    m_sinks[id] = std::move(sink);
+    return id;
+}
+
+void Logger::RemoveSink(int id) {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_sinks.erase(id);
+}
+
+void Logger::Flush() {
+    Drain();
+}
+
+const char* Logger::LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:   return "TRACE";
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error:   return "ERROR";
+        default:                return "OFF";
+    }
+}
+
+void Logger::Run() {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (!m_stopping) {
+        m_wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs));
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+void Logger::Drain() {
+    // 消费一侧串行：同一时刻只有一个线程取队列，sink按时间顺序收到记录
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    const size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (node == nullptr && dropped == 0) {
+        return;
+    }
+
+    std::vector<LogRecord> batch;
+    if (dropped > 0) {
+        LogRecord record;
+        record.level = LogLevel::Warning;
+        record.category = "log";
+        record.message = std::to_string(dropped) + " messages dropped (queue full)";
+        record.time = std::chrono::system_clock::now();
+        batch.push_back(std::move(record));
+    }
+
+    // 栈是后进先出，反转成写入顺序
+    std::vector<Node*> nodes;
+    for (; node != nullptr; node = node->next) {
+        nodes.push_back(node);
+    }
+    m_pending.fetch_sub(nodes.size(), std::memory_order_relaxed);
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        batch.push_back(std::move((*it)->record));
+        delete *it;
+    }
+
+    // sink列表复制出来再调用：sink里可以增删sink，也不会挡住AddSink/RemoveSink
+    std::vector<Sink> sinks;
+    {
+        std::lock_guard<std::mutex> sinkLock(m_sinkMutex);
+        sinks.reserve(m_sinks.size());
+        for (const auto& sink : m_sinks) {
+            sinks.push_back(sink.second);
+        }
+    }
+
+    if (m_stderrEnabled) {
+        WriteToStderr(batch);
+    }
+    for (const auto& sink : sinks) {
+        sink(batch);
+    }
+}
+
+} // namespace cad_core
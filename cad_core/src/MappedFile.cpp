@@ -0,0 +1,87 @@
+#include "cad_core/MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cad_core {
+
+MappedFile::MappedFile(const std::string& filename)
+    : m_data(nullptr), m_size(0) {
+#ifdef _WIN32
+    m_mapping = nullptr;
+    // 映射期间文件仍可被追加写入或替换（增量保存），已映射的区域不受影响
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+        return;
+    }
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) {
+        return;
+    }
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data) {
+        m_size = static_cast<size_t>(size.QuadPart);
+    }
+#else
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(m_fd, &info) != 0 || info.st_size == 0) {
+        return;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+void MappedFile::AdviseSequential() const {
+#ifndef _WIN32
+    if (m_data) {
+        madvise(const_cast<char*>(m_data), m_size, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+} // namespace cad_core
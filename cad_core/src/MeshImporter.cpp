@@ -0,0 +1,641 @@
+#include "cad_core/MeshImporter.h"
+#include "cad_core/MappedFile.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangle.hxx>
+#include <RWStl.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace cad_core {
+
+namespace {
+
+const size_t kStlHeaderBytes = 80;
+const size_t kStlFacetBytes = 50;
+// 焊接网格每个轴21位，整个包围盒分成2^21格，格子尺寸接近float精度
+const int kGridBits = 21;
+const std::uint64_t kGridMax = (1ull << kGridBits) - 1;
+const std::uint64_t kEmptyKey = ~0ull;
+// OBJ按字节分块
+const size_t kObjChunkBytes = 16u << 20;
+
+inline std::uint64_t MixHash(std::uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+inline size_t TableCapacity(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// 开放寻址哈希表：网格键 -> 顶点编号
+class WeldTable {
+public:
+    explicit WeldTable(size_t expected)
+        : m_keys(TableCapacity(expected), kEmptyKey), m_values(m_keys.size()), m_mask(m_keys.size() - 1) {
+    }
+
+    // 返回已有编号，或者插入next并返回next
+    std::uint32_t FindOrInsert(std::uint64_t key, std::uint32_t next, bool& inserted) {
+        size_t slot = static_cast<size_t>(MixHash(key)) & m_mask;
+        while (true) {
+            if (m_keys[slot] == kEmptyKey) {
+                m_keys[slot] = key;
+                m_values[slot] = next;
+                inserted = true;
+                return next;
+            }
+            if (m_keys[slot] == key) {
+                inserted = false;
+                return m_values[slot];
+            }
+            slot = (slot + 1) & m_mask;
+        }
+    }
+
+private:
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint32_t> m_values;
+    size_t m_mask;
+};
+
+struct Bounds {
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    void Add(const float* p) {
+        for (int i = 0; i < 3; ++i) {
+            min[i] = std::min(min[i], p[i]);
+            max[i] = std::max(max[i], p[i]);
+        }
+    }
+    void Add(const Bounds& other) {
+        Add(other.min);
+        Add(other.max);
+    }
+};
+
+struct Grid {
+    double origin[3];
+    double inverseCell[3];
+
+    explicit Grid(const Bounds& bounds) {
+        for (int i = 0; i < 3; ++i) {
+            double extent = static_cast<double>(bounds.max[i]) - bounds.min[i];
+            origin[i] = bounds.min[i];
+            inverseCell[i] = extent > 0.0 ? static_cast<double>(kGridMax) / extent : 0.0;
+        }
+    }
+
+    std::uint64_t Key(const float* p) const {
+        std::uint64_t key = 0;
+        for (int i = 0; i < 3; ++i) {
+            double cell = std::floor((p[i] - origin[i]) * inverseCell[i] + 0.5);
+            std::uint64_t q = static_cast<std::uint64_t>(std::min<double>(std::max(cell, 0.0), kGridMax));
+            key = (key << kGridBits) | q;
+        }
+        return key;
+    }
+};
+
+// 二进制STL的一个解析块：块内焊接后的顶点和三角形
+struct StlChunk {
+    size_t firstFacet = 0;
+    size_t facetCount = 0;
+    std::vector<std::uint64_t> keys;        // 块内唯一顶点的网格键
+    std::vector<float> positions;           // 块内唯一顶点坐标（xyz）
+    std::vector<std::vector<std::uint32_t>> buckets;  // 合并分区 -> 属于该分区的块内顶点编号
+    std::vector<std::uint32_t> triangles;   // 块内编号，合并后改成全局编号
+    size_t firstTriangle = 0;               // 去掉退化三角形后的全局偏移
+    size_t validTriangles = 0;
+};
+
+inline const char* SkipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* NextLine(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+// 不依赖locale的浮点解析（OBJ里只有普通十进制和指数形式）
+double ParseDouble(const char*& p, const char* end) {
+    p = SkipSpaces(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    double value = 0.0;
+    while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+        value = value * 10.0 + (*p - '0');
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+            value += (*p - '0') * scale;
+            scale *= 0.1;
+            ++p;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        int exponent = 0;
+        while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+            exponent = exponent * 10 + (*p - '0');
+            ++p;
+        }
+        value *= std::pow(10.0, negativeExponent ? -exponent : exponent);
+    }
+    return negative ? -value : value;
+}
+
+// 解析面里的一个顶点引用（"v"、"v/vt"、"v//vn"、"v/vt/vn"），只取位置索引
+bool ParseFaceIndex(const char*& p, const char* end, long long& index) {
+    p = SkipSpaces(p, end);
+    if (p >= end || *p == '\r' || *p == '\n' || *p == '#') {
+        return false;
+    }
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        ++p;
+    }
+    long long value = 0;
+    bool digits = false;
+    while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+        value = value * 10 + (*p - '0');
+        digits = true;
+        ++p;
+    }
+    while (p < end && !std::isspace(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    index = negative ? -value : value;
+    return digits;
+}
+
+inline bool IsKeyword(const char* p, const char* end, char keyword) {
+    return p + 1 < end && p[0] == keyword && (p[1] == ' ' || p[1] == '\t');
+}
+
+// 统计一行面的顶点数
+int CountFaceVertices(const char* p, const char* end) {
+    int count = 0;
+    long long index = 0;
+    while (ParseFaceIndex(p, end, index)) {
+        ++count;
+    }
+    return count;
+}
+
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    size_t vertices = 0;
+    size_t triangles = 0;
+    size_t firstVertex = 0;
+    size_t firstTriangle = 0;
+};
+
+} // namespace
+
+MeshImporter::MeshImporter()
+    : m_triangleCount(0), m_nodeCount(0) {
+}
+
+void MeshImporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+ShapePtr MeshImporter::Import(const std::string& filename) {
+    m_triangleCount = 0;
+    m_nodeCount = 0;
+    m_lastError.clear();
+
+    std::string extension;
+    size_t dot = filename.find_last_of('.');
+    if (dot != std::string::npos) {
+        extension = filename.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
+    if (extension != "stl" && extension != "obj") {
+        m_lastError = "Unsupported mesh format: " + filename;
+        return nullptr;
+    }
+
+    ReportProgress(0);
+    Handle(Poly_Triangulation) triangulation;
+    try {
+        RegenerationProfiler::ScopedCall call("MeshImporter::Import");
+
+        MappedFile file(filename);
+        file.AdviseSequential();
+        if (!file.IsOpen()) {
+            m_lastError = "Cannot open " + filename;
+            return nullptr;
+        }
+
+        if (extension == "obj") {
+            triangulation = ReadObj(file.Data(), file.Size());
+        } else {
+            // "solid"开头且大小对不上二进制记录的是ASCII STL
+            bool binary = false;
+            if (file.Size() >= kStlHeaderBytes + 4) {
+                std::uint32_t count = 0;
+                std::memcpy(&count, file.Data() + kStlHeaderBytes, sizeof(count));
+                size_t expected = kStlHeaderBytes + 4 + static_cast<size_t>(count) * kStlFacetBytes;
+                bool solid = std::strncmp(file.Data(), "solid", 5) == 0;
+                binary = file.Size() >= expected && (!solid || file.Size() == expected);
+            }
+            if (binary) {
+                triangulation = ReadBinaryStl(file.Data(), file.Size());
+            }
+        }
+        if (triangulation.IsNull() && extension == "stl" && m_lastError.empty()) {
+            triangulation = ReadAsciiStl(filename);
+        }
+    } catch (const Standard_Failure& e) {
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "Mesh import failed";
+        return nullptr;
+    } catch (const std::bad_alloc&) {
+        m_lastError = "Out of memory while importing " + filename;
+        return nullptr;
+    }
+
+    if (triangulation.IsNull() || triangulation->NbTriangles() == 0) {
+        if (m_lastError.empty()) {
+            m_lastError = "No triangles in " + filename;
+        }
+        return nullptr;
+    }
+
+    m_triangleCount = static_cast<size_t>(triangulation->NbTriangles());
+    m_nodeCount = static_cast<size_t>(triangulation->NbNodes());
+
+    // 没有曲面的面，只挂三角网格
+    TopoDS_Face face;
+    BRep_Builder builder;
+    builder.MakeFace(face, triangulation);
+
+    ReportProgress(100);
+    return std::make_shared<Shape>(face);
+}
+
+Handle(Poly_Triangulation) MeshImporter::ReadBinaryStl(const char* data, size_t size) {
+    std::uint32_t facetCount = 0;
+    std::memcpy(&facetCount, data + kStlHeaderBytes, sizeof(facetCount));
+    if (facetCount == 0) {
+        m_lastError = "Empty STL file";
+        return nullptr;
+    }
+    if (facetCount > static_cast<std::uint32_t>(INT_MAX)) {
+        m_lastError = "Too many triangles in STL file";
+        return nullptr;
+    }
+    if (size < kStlHeaderBytes + 4 + static_cast<size_t>(facetCount) * kStlFacetBytes) {
+        m_lastError = "Truncated STL file";
+        return nullptr;
+    }
+    const char* facets = data + kStlHeaderBytes + 4;
+
+    auto corner = [facets](size_t facet, int vertex, float* out) {
+        // 跳过法向（3个float）
+        std::memcpy(out, facets + facet * kStlFacetBytes + (3 + vertex * 3) * sizeof(float), 3 * sizeof(float));
+    };
+
+    std::vector<StlChunk> chunks((facetCount + kChunkTriangles - 1) / kChunkTriangles);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].firstFacet = i * kChunkTriangles;
+        chunks[i].facetCount = std::min<size_t>(kChunkTriangles, facetCount - chunks[i].firstFacet);
+    }
+    const int chunkCount = static_cast<int>(chunks.size());
+
+    // 1. 包围盒，决定焊接网格
+    std::vector<Bounds> chunkBounds(chunks.size());
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        const StlChunk& chunk = chunks[index];
+        float p[3];
+        for (size_t f = chunk.firstFacet; f < chunk.firstFacet + chunk.facetCount; ++f) {
+            for (int v = 0; v < 3; ++v) {
+                corner(f, v, p);
+                chunkBounds[index].Add(p);
+            }
+        }
+    }, TaskPriority::Normal);
+    Bounds bounds;
+    for (const Bounds& chunkBound : chunkBounds) {
+        bounds.Add(chunkBound);
+    }
+    for (int i = 0; i < 3; ++i) {
+        if (!std::isfinite(bounds.min[i]) || !std::isfinite(bounds.max[i])) {
+            m_lastError = "STL file contains invalid coordinates";
+            return nullptr;
+        }
+    }
+    const Grid grid(bounds);
+    ReportProgress(15);
+
+    // 2. 块内焊接：同一格子里的顶点合并
+    const int partitionCount = std::max(1, (TaskScheduler::Instance().GetWorkerCount() + 1) * 2);
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        StlChunk& chunk = chunks[index];
+        WeldTable table(chunk.facetCount * 3);
+        chunk.triangles.resize(chunk.facetCount * 3);
+        chunk.buckets.resize(partitionCount);
+        float p[3];
+        for (size_t f = 0; f < chunk.facetCount; ++f) {
+            for (int v = 0; v < 3; ++v) {
+                corner(chunk.firstFacet + f, v, p);
+                std::uint64_t key = grid.Key(p);
+                bool inserted = false;
+                std::uint32_t local = table.FindOrInsert(key, static_cast<std::uint32_t>(chunk.keys.size()), inserted);
+                if (inserted) {
+                    chunk.keys.push_back(key);
+                    chunk.positions.insert(chunk.positions.end(), p, p + 3);
+                    chunk.buckets[MixHash(key ^ 0x9e3779b97f4a7c15ull) % partitionCount].push_back(local);
+                }
+                chunk.triangles[f * 3 + v] = local;
+            }
+        }
+    }, TaskPriority::Normal);
+    ReportProgress(45);
+
+    // 3. 按哈希分区并行合并各块顶点，每个分区各自编号；分区只读各块里属于自己的桶，
+    //    总工作量与顶点数成正比，不随分区数增长
+    std::vector<std::vector<float>> partitionPositions(partitionCount);
+    std::vector<std::vector<std::uint32_t>> localToGlobal(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        localToGlobal[i].resize(chunks[i].keys.size());
+    }
+    TaskScheduler::Instance().ParallelFor(0, partitionCount, [&](int partition) {
+        size_t expected = 0;
+        for (const StlChunk& chunk : chunks) {
+            expected += chunk.buckets[partition].size();
+        }
+        WeldTable table(expected);
+        std::vector<float>& positions = partitionPositions[partition];
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const StlChunk& chunk = chunks[c];
+            for (std::uint32_t v : chunk.buckets[partition]) {
+                bool inserted = false;
+                std::uint32_t id = table.FindOrInsert(chunk.keys[v], static_cast<std::uint32_t>(positions.size() / 3), inserted);
+                if (inserted) {
+                    positions.insert(positions.end(), &chunk.positions[v * 3], &chunk.positions[v * 3] + 3);
+                }
+                localToGlobal[c][v] = id;
+            }
+        }
+    }, TaskPriority::Normal);
+    ReportProgress(65);
+
+    std::vector<size_t> partitionOffsets(partitionCount + 1, 0);
+    for (int p = 0; p < partitionCount; ++p) {
+        partitionOffsets[p + 1] = partitionOffsets[p] + partitionPositions[p].size() / 3;
+    }
+    const size_t nodeCount = partitionOffsets[partitionCount];
+
+    // 4. 换成全局编号，数一下焊接后仍然有效的三角形
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        StlChunk& chunk = chunks[index];
+        std::vector<std::uint32_t>& mapping = localToGlobal[index];
+        for (int p = 0; p < partitionCount; ++p) {
+            const std::uint32_t offset = static_cast<std::uint32_t>(partitionOffsets[p]);
+            for (std::uint32_t v : chunk.buckets[p]) {
+                mapping[v] += offset;
+            }
+        }
+        size_t valid = 0;
+        for (size_t t = 0; t < chunk.triangles.size(); t += 3) {
+            std::uint32_t a = mapping[chunk.triangles[t]];
+            std::uint32_t b = mapping[chunk.triangles[t + 1]];
+            std::uint32_t c = mapping[chunk.triangles[t + 2]];
+            chunk.triangles[t] = a;
+            chunk.triangles[t + 1] = b;
+            chunk.triangles[t + 2] = c;
+            if (a != b && b != c && a != c) {
+                ++valid;
+            }
+        }
+        chunk.validTriangles = valid;
+        // 块内数据不再需要
+        std::vector<std::uint64_t>().swap(chunk.keys);
+        std::vector<float>().swap(chunk.positions);
+        std::vector<std::vector<std::uint32_t>>().swap(chunk.buckets);
+        std::vector<std::uint32_t>().swap(mapping);
+    }, TaskPriority::Normal);
+
+    size_t triangleCount = 0;
+    for (StlChunk& chunk : chunks) {
+        chunk.firstTriangle = triangleCount;
+        triangleCount += chunk.validTriangles;
+    }
+    if (triangleCount == 0) {
+        m_lastError = "All STL triangles are degenerate";
+        return nullptr;
+    }
+
+    // 5. 单精度节点，写入各自的区间
+    Handle(Poly_Triangulation) triangulation = new Poly_Triangulation();
+    triangulation->SetDoublePrecision(false);
+    triangulation->ResizeNodes(static_cast<Standard_Integer>(nodeCount), false);
+    triangulation->ResizeTriangles(static_cast<Standard_Integer>(triangleCount), false);
+
+    TaskScheduler::Instance().ParallelFor(0, partitionCount, [&](int partition) {
+        const std::vector<float>& positions = partitionPositions[partition];
+        const size_t offset = partitionOffsets[partition];
+        for (size_t v = 0; v < positions.size() / 3; ++v) {
+            triangulation->SetNode(static_cast<Standard_Integer>(offset + v + 1),
+                                   gp_Pnt(positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]));
+        }
+    }, TaskPriority::Normal);
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        StlChunk& chunk = chunks[index];
+        Standard_Integer out = static_cast<Standard_Integer>(chunk.firstTriangle) + 1;
+        for (size_t t = 0; t < chunk.triangles.size(); t += 3) {
+            std::uint32_t a = chunk.triangles[t];
+            std::uint32_t b = chunk.triangles[t + 1];
+            std::uint32_t c = chunk.triangles[t + 2];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            triangulation->SetTriangle(out++, Poly_Triangle(static_cast<Standard_Integer>(a) + 1,
+                                                            static_cast<Standard_Integer>(b) + 1,
+                                                            static_cast<Standard_Integer>(c) + 1));
+        }
+        std::vector<std::uint32_t>().swap(chunk.triangles);
+    }, TaskPriority::Normal);
+    ReportProgress(95);
+    return triangulation;
+}
+
+Handle(Poly_Triangulation) MeshImporter::ReadObj(const char* data, size_t size) {
+    const char* fileEnd = data + size;
+
+    // 1. 在换行处切块
+    std::vector<ObjChunk> chunks;
+    const char* begin = data;
+    while (begin < fileEnd) {
+        const char* end = begin + std::min(kObjChunkBytes, static_cast<size_t>(fileEnd - begin));
+        if (end < fileEnd) {
+            end = NextLine(end, fileEnd);
+        }
+        ObjChunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(chunk);
+        begin = end;
+    }
+    const int chunkCount = static_cast<int>(chunks.size());
+
+    // 2. 每块统计顶点数和拆分后的三角形数
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        ObjChunk& chunk = chunks[index];
+        for (const char* line = chunk.begin; line < chunk.end; line = NextLine(line, chunk.end)) {
+            const char* p = SkipSpaces(line, chunk.end);
+            if (IsKeyword(p, chunk.end, 'v')) {
+                ++chunk.vertices;
+            } else if (IsKeyword(p, chunk.end, 'f')) {
+                int count = CountFaceVertices(p + 2, chunk.end);
+                if (count >= 3) {
+                    chunk.triangles += static_cast<size_t>(count - 2);
+                }
+            }
+        }
+    }, TaskPriority::Normal);
+
+    size_t vertexCount = 0;
+    size_t triangleCount = 0;
+    for (ObjChunk& chunk : chunks) {
+        chunk.firstVertex = vertexCount;
+        chunk.firstTriangle = triangleCount;
+        vertexCount += chunk.vertices;
+        triangleCount += chunk.triangles;
+    }
+    ReportProgress(30);
+
+    if (vertexCount == 0 || triangleCount == 0) {
+        m_lastError = "No faces in OBJ file";
+        return nullptr;
+    }
+    if (vertexCount > static_cast<size_t>(INT_MAX) || triangleCount > static_cast<size_t>(INT_MAX)) {
+        m_lastError = "Too many elements in OBJ file";
+        return nullptr;
+    }
+
+    Handle(Poly_Triangulation) triangulation = new Poly_Triangulation();
+    triangulation->SetDoublePrecision(false);
+    triangulation->ResizeNodes(static_cast<Standard_Integer>(vertexCount), false);
+    triangulation->ResizeTriangles(static_cast<Standard_Integer>(triangleCount), false);
+
+    // 3. 各块写入自己的区间；负索引相对当前已读到的顶点数
+    std::atomic<size_t> badIndices(0);
+    TaskScheduler::Instance().ParallelFor(0, chunkCount, [&](int index) {
+        const ObjChunk& chunk = chunks[index];
+        size_t vertex = chunk.firstVertex;
+        Standard_Integer triangle = static_cast<Standard_Integer>(chunk.firstTriangle) + 1;
+        std::vector<Standard_Integer> polygon;
+        size_t bad = 0;
+
+        for (const char* line = chunk.begin; line < chunk.end; line = NextLine(line, chunk.end)) {
+            const char* p = SkipSpaces(line, chunk.end);
+            if (IsKeyword(p, chunk.end, 'v')) {
+                p += 2;
+                double x = ParseDouble(p, chunk.end);
+                double y = ParseDouble(p, chunk.end);
+                double z = ParseDouble(p, chunk.end);
+                triangulation->SetNode(static_cast<Standard_Integer>(++vertex), gp_Pnt(x, y, z));
+            } else if (IsKeyword(p, chunk.end, 'f')) {
+                p += 2;
+                polygon.clear();
+                long long value = 0;
+                while (ParseFaceIndex(p, chunk.end, value)) {
+                    long long absolute = value > 0 ? value : static_cast<long long>(vertex) + value + 1;
+                    if (absolute < 1 || absolute > static_cast<long long>(vertexCount)) {
+                        ++bad;
+                        absolute = 1;
+                    }
+                    polygon.push_back(static_cast<Standard_Integer>(absolute));
+                }
+                // 扇形拆分，个数和统计时一致
+                for (size_t k = 2; k < polygon.size(); ++k) {
+                    triangulation->SetTriangle(triangle++, Poly_Triangle(polygon[0], polygon[k - 1], polygon[k]));
+                }
+            }
+        }
+        badIndices += bad;
+    }, TaskPriority::Normal);
+
+    if (badIndices > 0) {
+        m_lastError = "OBJ file references missing vertices";
+        return nullptr;
+    }
+
+    ReportProgress(95);
+    return triangulation;
+}
+
+Handle(Poly_Triangulation) MeshImporter::ReadAsciiStl(const std::string& filename) {
+    // ASCII STL体积大、很少用于扫描数据，直接用OCCT的读取（自带顶点合并）
+    Handle(Poly_Triangulation) triangulation = RWStl::ReadFile(filename.c_str());
+    if (triangulation.IsNull()) {
+        m_lastError = "Failed to read STL file " + filename;
+    }
+    return triangulation;
+}
+
+bool MeshImporter::IsMeshShape(const TopoDS_Shape& shape) {
+    if (shape.IsNull()) {
+        return false;
+    }
+    TopExp_Explorer exp(shape, TopAbs_FACE);
+    if (!exp.More()) {
+        return false;
+    }
+    const TopoDS_Face& face = TopoDS::Face(exp.Current());
+    TopLoc_Location location;
+    return BRep_Tool::Surface(face, location).IsNull() && !BRep_Tool::Triangulation(face, location).IsNull();
+}
+
+void MeshImporter::ReportProgress(int percent) {
+    if (m_progressCallback) {
+        m_progressCallback(percent);
+    }
+}
+
+} // namespace cad_core
@@ -0,0 +1,525 @@
+#include "cad_core/NativeDocumentFile.h"
+#include "cad_core/ByteStream.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include <BRepBndLib.hxx>
+#include <BinTools.hxx>
+#include <Standard_Failure.hxx>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace cad_core {
+
+namespace {
+
+const char kMagic[8] = { 'A', 'N', 'D', 'E', 'R', 'C', 'A', 'D' };
+const size_t kHeaderBytes = 32;
+const size_t kChunkEntryBytes = 24;
+const size_t kAlignment = 8;
+const std::uint32_t kNoChunk = 0xFFFFFFFFu;
+
+constexpr std::uint32_t FourCC(char a, char b, char c, char d) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+}
+
+const std::uint32_t kChunkParts = FourCC('P', 'A', 'R', 'T');
+const std::uint32_t kChunkBrep = FourCC('B', 'R', 'E', 'P');
+const std::uint32_t kChunkFeatures = FourCC('F', 'E', 'A', 'T');
+const std::uint32_t kChunkPreview = FourCC('P', 'R', 'E', 'V');
+
+// 块标志：预留压缩位，当前版本不压缩（BinTools本身已经很紧凑）
+const std::uint32_t kChunkFlagCompressed = 1u << 0;
+
+// 把映射内存包装成istream，BinTools直接从映射区读取，不复制
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+        char* target = nullptr;
+        if (dir == std::ios_base::beg) {
+            target = eback() + offset;
+        } else if (dir == std::ios_base::cur) {
+            target = gptr() + offset;
+        } else {
+            target = egptr() + offset;
+        }
+        if (target < eback() || target > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), target, egptr());
+        return pos_type(target - eback());
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode mode) override {
+        return seekoff(off_type(position), std::ios_base::beg, mode);
+    }
+};
+
+void PadTo(std::fstream& file, std::uint64_t& offset) {
+    static const char zeros[kAlignment] = {};
+    size_t padding = static_cast<size_t>((kAlignment - offset % kAlignment) % kAlignment);
+    if (padding > 0) {
+        file.write(zeros, static_cast<std::streamsize>(padding));
+        offset += padding;
+    }
+}
+
+} // namespace
+
+NativeDocumentFile::NativeDocumentFile()
+    : m_fileSize(0) {
+}
+
+NativeDocumentFile::~NativeDocumentFile() {
+}
+
+std::string NativeDocumentFile::EncodeShape(const TopoDS_Shape& shape) {
+    std::ostringstream stream(std::ios::out | std::ios::binary);
+    // 三角网格一起保存，打开后显示不用重新网格化
+    BinTools::Write(shape, stream, Standard_True, Standard_False, BinTools_FormatVersion_CURRENT);
+    return stream.str();
+}
+
+TopoDS_Shape NativeDocumentFile::DecodeShape(const char* data, size_t size) {
+    try {
+        MemoryStreamBuf buffer(data, size);
+        std::istream stream(&buffer);
+        TopoDS_Shape shape;
+        BinTools::Read(shape, stream);
+        return shape;
+    } catch (const Standard_Failure&) {
+        return TopoDS_Shape();
+    }
+}
+
+bool NativeDocumentFile::IsNativeFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(kMagic)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool NativeDocumentFile::IsNativeFileName(const std::string& filename) {
+    const std::string extension = ".acad";
+    if (filename.size() < extension.size()) {
+        return false;
+    }
+    std::string tail = filename.substr(filename.size() - extension.size());
+    std::transform(tail.begin(), tail.end(), tail.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return tail == extension;
+}
+
+bool NativeDocumentFile::Write(const std::string& filename, const std::vector<PartData>& parts,
+                               const std::vector<FeatureRecord>& features, const std::string& preview,
+                               std::string& error, WriteResult* result) {
+    RegenerationProfiler::ScopedCall call("NativeDocumentFile::Write");
+
+    const std::string temporary = filename + ".tmp";
+    {
+        std::fstream file(temporary, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error = "Cannot open " + temporary + " for writing";
+            return false;
+        }
+
+        // 文件头先占位，目录写完后回填
+        std::string header(kHeaderBytes, '\0');
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        WriteResult written;
+        written.fileSize = kHeaderBytes;
+        if (!WriteBody(file, parts, features, preview, written, error) || !WriteHeader(file, written)) {
+            if (error.empty()) {
+                error = "Failed to write " + temporary;
+            }
+            file.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+        file.close();
+        if (!file) {
+            error = "Failed to write " + temporary;
+            std::remove(temporary.c_str());
+            return false;
+        }
+        if (result) {
+            *result = written;
+        }
+    }
+
+    if (!MoveFileOver(temporary, filename)) {
+        error = "Cannot replace " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool NativeDocumentFile::Append(const std::string& filename, const std::vector<PartData>& parts,
+                                const std::vector<FeatureRecord>& features, const std::string& preview,
+                                std::uint64_t fileSize, std::string& error, WriteResult* result) {
+    RegenerationProfiler::ScopedCall call("NativeDocumentFile::Append");
+
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        error = "Cannot open " + filename + " for writing";
+        return false;
+    }
+
+    // 旧的目录和表都留在原处，新块写在文件末尾；最后才改文件头，
+    // 中途失败时文件头仍指向上一次完整的目录
+    file.seekp(static_cast<std::streamoff>(fileSize));
+    WriteResult written;
+    written.fileSize = fileSize;
+    if (!WriteBody(file, parts, features, preview, written, error)) {
+        if (error.empty()) {
+            error = "Failed to append to " + filename;
+        }
+        return false;
+    }
+    file.flush();
+    if (!file || !WriteHeader(file, written)) {
+        error = "Failed to append to " + filename;
+        return false;
+    }
+    file.close();
+    if (!file) {
+        error = "Failed to append to " + filename;
+        return false;
+    }
+
+    if (result) {
+        *result = written;
+    }
+    return true;
+}
+
+bool NativeDocumentFile::MoveFileOver(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+    // 原文件可能仍被映射（延迟打开），直接替换，不能先删除再改名
+    return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+bool NativeDocumentFile::WriteBody(std::fstream& file, const std::vector<PartData>& parts,
+                                   const std::vector<FeatureRecord>& features, const std::string& preview,
+                                   WriteResult& result, std::string& error) {
+    std::uint64_t& offset = result.fileSize;
+    std::vector<ChunkEntry>& chunks = result.chunks;
+    chunks.clear();
+    result.partChunks.assign(parts.size(), -1);
+    result.bytesWritten = 0;
+
+    auto writeChunk = [&](std::uint32_t type, const char* data, size_t size) {
+        std::uint64_t start = offset;
+        PadTo(file, offset);
+        ChunkEntry entry;
+        entry.type = type;
+        entry.offset = offset;
+        entry.size = size;
+        file.write(data, static_cast<std::streamsize>(size));
+        offset += size;
+        result.bytesWritten += offset - start;
+        chunks.push_back(entry);
+        return static_cast<int>(chunks.size() - 1);
+    };
+
+    // 几何块：沿用的块只登记到目录；其余一批零件并行编码，按顺序写出
+    std::vector<Bnd_Box> boxes(parts.size());
+    const size_t batchSize = std::max(1, (TaskScheduler::Instance().GetWorkerCount() + 1) * 2);
+    std::vector<std::string> buffers(batchSize);
+    try {
+        for (size_t first = 0; first < parts.size(); first += batchSize) {
+            const size_t count = std::min(batchSize, parts.size() - first);
+            TaskScheduler::Instance().ParallelFor(0, static_cast<int>(count), [&](int index) {
+                const PartData& part = parts[first + index];
+                buffers[index].clear();
+                boxes[first + index] = part.box;
+                if (!part.reuse && !part.blob && !part.shape.IsNull()) {
+                    // 重新编码的零件包围盒也重新计算，调用方给的可能已经过时
+                    buffers[index] = EncodeShape(part.shape);
+                    boxes[first + index].SetVoid();
+                    BRepBndLib::Add(part.shape, boxes[first + index]);
+                }
+            }, TaskPriority::Normal);
+            for (size_t i = 0; i < count; ++i) {
+                const PartData& part = parts[first + i];
+                if (part.reuse) {
+                    chunks.push_back(part.existing);
+                    result.partChunks[first + i] = static_cast<int>(chunks.size() - 1);
+                } else if (part.blob) {
+                    result.partChunks[first + i] = writeChunk(kChunkBrep, part.blob, part.blobBytes);
+                } else if (!buffers[i].empty()) {
+                    result.partChunks[first + i] = writeChunk(kChunkBrep, buffers[i].data(), buffers[i].size());
+                }
+            }
+            if (!file) {
+                return false;
+            }
+        }
+    } catch (const Standard_Failure& e) {
+        error = e.GetMessageString() ? e.GetMessageString() : "Failed to encode shapes";
+        return false;
+    }
+    buffers.clear();
+
+    // 零件表
+    std::string partTable;
+    ByteWriter partWriter(partTable);
+    partWriter.Put<std::uint32_t>(static_cast<std::uint32_t>(parts.size()));
+    for (size_t i = 0; i < parts.size(); ++i) {
+        partWriter.PutString(parts[i].name);
+        partWriter.Put<std::uint8_t>(parts[i].active ? 1 : 0);
+        partWriter.Put<std::uint8_t>(boxes[i].IsVoid() ? 0 : 1);
+        double values[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+        if (!boxes[i].IsVoid()) {
+            boxes[i].Get(values[0], values[1], values[2], values[3], values[4], values[5]);
+        }
+        for (double value : values) {
+            partWriter.Put<double>(value);
+        }
+        partWriter.Put<std::uint32_t>(result.partChunks[i] >= 0 ? static_cast<std::uint32_t>(result.partChunks[i]) : kNoChunk);
+    }
+    writeChunk(kChunkParts, partTable.data(), partTable.size());
+
+    // 特征参数表
+    std::string featureTable;
+    ByteWriter featureWriter(featureTable);
+    featureWriter.Put<std::uint32_t>(static_cast<std::uint32_t>(features.size()));
+    for (const FeatureRecord& feature : features) {
+        featureWriter.Put<std::int32_t>(feature.id);
+        featureWriter.Put<std::int32_t>(feature.type);
+        featureWriter.Put<std::uint8_t>(feature.active ? 1 : 0);
+        featureWriter.PutString(feature.name);
+        featureWriter.Put<std::uint32_t>(static_cast<std::uint32_t>(feature.parameters.size()));
+        for (const auto& parameter : feature.parameters) {
+            featureWriter.PutString(parameter.first);
+            featureWriter.Put<double>(parameter.second);
+        }
+    }
+    writeChunk(kChunkFeatures, featureTable.data(), featureTable.size());
+
+    // 预览很小，每次都重新写出
+    if (!preview.empty()) {
+        writeChunk(kChunkPreview, preview.data(), preview.size());
+    }
+
+    // 目录
+    std::uint64_t start = offset;
+    PadTo(file, offset);
+    result.tocOffset = offset;
+    std::string toc;
+    ByteWriter tocWriter(toc);
+    for (const ChunkEntry& entry : chunks) {
+        tocWriter.Put<std::uint32_t>(entry.type);
+        tocWriter.Put<std::uint32_t>(entry.flags);
+        tocWriter.Put<std::uint64_t>(entry.offset);
+        tocWriter.Put<std::uint64_t>(entry.size);
+    }
+    file.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+    offset += toc.size();
+    result.bytesWritten += offset - start;
+
+    // 目录里的块都是有效数据，其余都是历次追加留下的旧块
+    result.liveBytes = kHeaderBytes + toc.size();
+    for (const ChunkEntry& entry : chunks) {
+        result.liveBytes += entry.size;
+    }
+    return static_cast<bool>(file);
+}
+
+bool NativeDocumentFile::WriteHeader(std::fstream& file, const WriteResult& result) {
+    std::string header(kMagic, sizeof(kMagic));
+    ByteWriter headerWriter(header);
+    headerWriter.Put<std::uint32_t>(kVersion);
+    headerWriter.Put<std::uint32_t>(static_cast<std::uint32_t>(result.chunks.size()));
+    headerWriter.Put<std::uint64_t>(result.tocOffset);
+    header.resize(kHeaderBytes, '\0');
+    file.seekp(0);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+bool NativeDocumentFile::Open(const std::string& filename) {
+    Close();
+
+    std::unique_ptr<MappedFile> file(new MappedFile(filename));
+    if (!file->IsOpen() || file->Size() < kHeaderBytes) {
+        m_lastError = "Cannot open " + filename;
+        return false;
+    }
+    if (std::memcmp(file->Data(), kMagic, sizeof(kMagic)) != 0) {
+        m_lastError = filename + " is not an AnderCAD document";
+        return false;
+    }
+
+    ByteReader header(file->Data() + sizeof(kMagic), kHeaderBytes - sizeof(kMagic));
+    std::uint32_t version = header.Get<std::uint32_t>();
+    std::uint32_t chunkCount = header.Get<std::uint32_t>();
+    std::uint64_t tocOffset = header.Get<std::uint64_t>();
+    if (version > kVersion) {
+        m_lastError = "Document was written by a newer version";
+        return false;
+    }
+    if (tocOffset > file->Size() || (file->Size() - tocOffset) / kChunkEntryBytes < chunkCount) {
+        m_lastError = "Corrupted document table of contents";
+        return false;
+    }
+
+    ByteReader toc(file->Data() + tocOffset, static_cast<size_t>(chunkCount) * kChunkEntryBytes);
+    m_chunks.resize(chunkCount);
+    for (ChunkEntry& entry : m_chunks) {
+        entry.type = toc.Get<std::uint32_t>();
+        entry.flags = toc.Get<std::uint32_t>();
+        entry.offset = toc.Get<std::uint64_t>();
+        entry.size = toc.Get<std::uint64_t>();
+        if (entry.offset > file->Size() || entry.size > file->Size() - entry.offset) {
+            m_lastError = "Corrupted document chunk";
+            m_chunks.clear();
+            return false;
+        }
+    }
+
+    m_file = std::move(file);
+    m_fileSize = m_file->Size();
+    for (const ChunkEntry& entry : m_chunks) {
+        bool ok = true;
+        if (entry.type == kChunkParts) {
+            ok = ReadPartTable(entry);
+        } else if (entry.type == kChunkFeatures) {
+            ok = ReadFeatureTable(entry);
+        }
+        if (!ok) {
+            Close();
+            m_lastError = "Corrupted document tables";
+            return false;
+        }
+    }
+    return true;
+}
+
+void NativeDocumentFile::Close() {
+    m_file.reset();
+    m_fileSize = 0;
+    m_chunks.clear();
+    m_parts.clear();
+    m_features.clear();
+    m_lastError.clear();
+}
+
+bool NativeDocumentFile::ReadPartTable(const ChunkEntry& chunk) {
+    ByteReader reader(m_file->Data() + chunk.offset, static_cast<size_t>(chunk.size));
+    std::uint32_t count = reader.Get<std::uint32_t>();
+    m_parts.clear();
+    m_parts.reserve(std::min<std::uint32_t>(count, static_cast<std::uint32_t>(chunk.size / 4)));
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        PartInfo part;
+        part.name = reader.GetString();
+        part.active = reader.Get<std::uint8_t>() != 0;
+        bool hasBox = reader.Get<std::uint8_t>() != 0;
+        double values[6];
+        for (double& value : values) {
+            value = reader.Get<double>();
+        }
+        if (hasBox) {
+            part.box.Update(values[0], values[1], values[2], values[3], values[4], values[5]);
+        }
+        std::uint32_t brepChunk = reader.Get<std::uint32_t>();
+        if (brepChunk != kNoChunk) {
+            if (brepChunk >= m_chunks.size() || m_chunks[brepChunk].type != kChunkBrep) {
+                return false;
+            }
+            part.brepChunk = static_cast<int>(brepChunk);
+            part.brepBytes = static_cast<size_t>(m_chunks[brepChunk].size);
+        }
+        m_parts.push_back(part);
+    }
+    return reader.ok();
+}
+
+bool NativeDocumentFile::ReadFeatureTable(const ChunkEntry& chunk) {
+    ByteReader reader(m_file->Data() + chunk.offset, static_cast<size_t>(chunk.size));
+    std::uint32_t count = reader.Get<std::uint32_t>();
+    m_features.clear();
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        FeatureRecord feature;
+        feature.id = reader.Get<std::int32_t>();
+        feature.type = reader.Get<std::int32_t>();
+        feature.active = reader.Get<std::uint8_t>() != 0;
+        feature.name = reader.GetString();
+        std::uint32_t parameterCount = reader.Get<std::uint32_t>();
+        for (std::uint32_t p = 0; p < parameterCount && reader.ok(); ++p) {
+            std::string name = reader.GetString();
+            double value = reader.Get<double>();
+            feature.parameters.emplace_back(name, value);
+        }
+        m_features.push_back(feature);
+    }
+    return reader.ok();
+}
+
+const char* NativeDocumentFile::GetChunkData(int index) const {
+    if (!m_file || index < 0 || index >= static_cast<int>(m_chunks.size())) {
+        return nullptr;
+    }
+    return m_file->Data() + m_chunks[index].offset;
+}
+
+const char* NativeDocumentFile::GetPreviewData(size_t& size) const {
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        if (m_chunks[i].type == kChunkPreview) {
+            size = static_cast<size_t>(m_chunks[i].size);
+            return GetChunkData(static_cast<int>(i));
+        }
+    }
+    return nullptr;
+}
+
+TopoDS_Shape NativeDocumentFile::LoadShape(size_t index) const {
+    if (!m_file || index >= m_parts.size() || m_parts[index].brepChunk < 0) {
+        return TopoDS_Shape();
+    }
+
+    const ChunkEntry& chunk = m_chunks[m_parts[index].brepChunk];
+    if (chunk.flags & kChunkFlagCompressed) {
+        // 本版本不会写出压缩块
+        return TopoDS_Shape();
+    }
+
+    return DecodeShape(m_file->Data() + chunk.offset, static_cast<size_t>(chunk.size));
+}
+
+std::vector<TopoDS_Shape> NativeDocumentFile::LoadShapes(const std::vector<size_t>& indices) const {
+    RegenerationProfiler::ScopedCall call("NativeDocumentFile::LoadShapes");
+
+    std::vector<TopoDS_Shape> shapes(indices.size());
+    TaskScheduler::Instance().ParallelFor(0, static_cast<int>(indices.size()), [this, &indices, &shapes](int i) {
+        shapes[i] = LoadShape(indices[i]);
+    }, TaskPriority::Normal);
+    return shapes;
+}
+
+} // namespace cad_core
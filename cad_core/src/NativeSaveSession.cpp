@@ -0,0 +1,150 @@
+#include "cad_core/NativeSaveSession.h"
+#include "cad_core/MappedFile.h"
+#include "cad_core/RegenerationProfiler.h"
+#include <fstream>
+
+namespace cad_core {
+
+namespace {
+
+// 文件头和目录项的大小，与NativeDocumentFile一致
+const std::uint64_t kHeaderBytes = 32;
+const std::uint64_t kChunkEntryBytes = 24;
+
+} // namespace
+
+NativeSaveSession::NativeSaveSession(const std::string& filename)
+    : m_fileName(filename), m_fileSize(0), m_liveBytes(0),
+      m_lastSaveDelta(false), m_lastBytesWritten(0) {
+}
+
+void NativeSaveSession::Adopt(const NativeDocumentFile& file, const std::vector<std::string>& entries) {
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_saved.clear();
+    for (size_t i = 0; i < entries.size() && i < file.GetPartCount(); ++i) {
+        const NativeDocumentFile::PartInfo& part = file.GetPart(i);
+        if (entries[i].empty() || part.brepChunk < 0) {
+            continue;
+        }
+        SavedPart saved;
+        saved.chunk = file.GetChunks()[part.brepChunk];
+        m_saved[entries[i]] = saved;
+    }
+
+    m_fileSize = file.GetFileSize();
+    m_liveBytes = kHeaderBytes + file.GetChunks().size() * kChunkEntryBytes;
+    for (const NativeDocumentFile::ChunkEntry& chunk : file.GetChunks()) {
+        m_liveBytes += chunk.size;
+    }
+}
+
+void NativeSaveSession::NoteLoadedShape(const std::string& entry, const TopoDS_Shape& shape) {
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    auto it = m_saved.find(entry);
+    if (it != m_saved.end() && it->second.shape.IsNull()) {
+        it->second.shape = shape;
+    }
+}
+
+bool NativeSaveSession::Save(const Snapshot& snapshot, std::string& error) {
+    std::lock_guard<std::mutex> saveLock(m_saveMutex);
+    RegenerationProfiler::ScopedCall call("NativeSaveSession::Save");
+
+    // 形状没变的零件沿用文件中的块（未读出的零件两边都是空形状）
+    std::vector<NativeDocumentFile::PartData> parts = snapshot.parts;
+    bool append = false;
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        if (CanAppend()) {
+            for (NativeDocumentFile::PartData& part : parts) {
+                auto saved = m_saved.find(part.entry);
+                if (saved != m_saved.end() && saved->second.shape.IsEqual(part.shape)) {
+                    part.reuse = true;
+                    part.existing = saved->second.chunk;
+                }
+            }
+            // 无用数据不超过有效数据时追加，否则这次整体重写
+            append = m_fileSize - m_liveBytes <= m_liveBytes;
+        }
+    }
+
+    const std::string preview = snapshot.preview ? snapshot.preview->Encode() : std::string();
+    NativeDocumentFile::WriteResult result;
+    bool saved = append
+        ? NativeDocumentFile::Append(m_fileName, parts, snapshot.features, preview, m_fileSize, error, &result)
+        : WriteFull(parts, snapshot.features, preview, result, error);
+    if (!saved) {
+        // 文件状态不确定，下次完整写出
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_fileSize = 0;
+        m_saved.clear();
+        return false;
+    }
+
+    Remember(parts, result);
+    m_lastSaveDelta = append;
+    m_lastBytesWritten = result.bytesWritten;
+    return true;
+}
+
+bool NativeSaveSession::CanAppend() const {
+    if (m_fileSize == 0) {
+        return false;
+    }
+    // 文件被外部改动过就不能接着追加
+    std::ifstream file(m_fileName, std::ios::in | std::ios::binary | std::ios::ate);
+    return file.is_open() && static_cast<std::uint64_t>(file.tellg()) == m_fileSize;
+}
+
+bool NativeSaveSession::WriteFull(std::vector<NativeDocumentFile::PartData> parts,
+                                  const std::vector<NativeDocumentFile::FeatureRecord>& features,
+                                  const std::string& preview,
+                                  NativeDocumentFile::WriteResult& result, std::string& error) {
+    // 压缩：沿用的块从当前文件的映射里原样复制
+    std::unique_ptr<MappedFile> current;
+    for (NativeDocumentFile::PartData& part : parts) {
+        if (!part.reuse) {
+            continue;
+        }
+        if (!current) {
+            current.reset(new MappedFile(m_fileName));
+            if (!current->IsOpen()) {
+                error = "Cannot open " + m_fileName;
+                return false;
+            }
+        }
+        if (part.existing.offset + part.existing.size > current->Size()) {
+            error = "Corrupted document chunk";
+            return false;
+        }
+        part.reuse = false;
+        part.blob = current->Data() + part.existing.offset;
+        part.blobBytes = static_cast<size_t>(part.existing.size);
+    }
+    return NativeDocumentFile::Write(m_fileName, parts, features, preview, error, &result);
+}
+
+void NativeSaveSession::Remember(const std::vector<NativeDocumentFile::PartData>& parts,
+                                 const NativeDocumentFile::WriteResult& result) {
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    std::map<std::string, SavedPart> saved;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (parts[i].entry.empty() || result.partChunks[i] < 0) {
+            continue;
+        }
+        SavedPart& part = saved[parts[i].entry];
+        part.shape = parts[i].shape;
+        part.chunk = result.chunks[result.partChunks[i]];
+
+        // 保存期间按需读出的几何（NoteLoadedShape）不丢
+        auto previous = m_saved.find(parts[i].entry);
+        if (part.shape.IsNull() && parts[i].reuse && previous != m_saved.end()) {
+            part.shape = previous->second.shape;
+        }
+    }
+    m_saved.swap(saved);
+    m_fileSize = result.fileSize;
+    m_liveBytes = result.liveBytes;
+}
+
+} // namespace cad_core
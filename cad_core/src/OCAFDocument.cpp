@@ -1,24 +1,40 @@
 #include "cad_core/OCAFDocument.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/LazyPartStore.h"
+#include "cad_core/Logger.h"
+#include "cad_core/OperationJournal.h"
+#include "cad_core/Tracer.h"
 #include <TDocStd_Application.hxx>
 #include <TDocStd_Document.hxx>
 #include <TDF_ChildIterator.hxx>
 #include <TDF_Tool.hxx>
+#include <TDF_Delta.hxx>
+#include <TDF_AttributeDelta.hxx>
 #include <TDataStd_Name.hxx>
 #include <TDataStd_Integer.hxx>
 #include <TNaming_Builder.hxx>
 #include <TNaming_NamedShape.hxx>
+#include <TDataStd_RealArray.hxx>
+#include <PCDM_ReaderFilter.hxx>
+#include <BRepBndLib.hxx>
+#include <BRep_Builder.hxx>
+#include <TopoDS_Compound.hxx>
 #include <BinDrivers.hxx>
+#include <BinDrivers_DocumentStorageDriver.hxx>
+#include <Message.hxx>
 #include <BinXCAFDrivers.hxx>
 #include <XmlDrivers.hxx>
 #include <XmlXCAFDrivers.hxx>
 #include <Standard_GUID.hxx>
 #include <TCollection_ExtendedString.hxx>
-#include <iostream>
+#include <numeric>
 
 namespace cad_core {
 
 OCAFDocument::OCAFDocument() 
-    : m_isInitialized(false), m_inTransaction(false) {
+    : m_isInitialized(false), m_inTransaction(false), m_lastTransactionMs(-1.0),
+      m_undoMemoryBudget(kDefaultUndoMemoryBudgetBytes), m_transactionBytes(0),
+      m_trimmedUndoSteps(0), m_isLazy(false) {
 }
 
 OCAFDocument::~OCAFDocument() {
@@ -52,6 +68,13 @@ void OCAFDocument::InitializeApplication() {
     XmlDrivers::DefineFormat(m_application);
     BinXCAFDrivers::DefineFormat(m_application);
     XmlXCAFDrivers::DefineFormat(m_application);
+    
+    // 延迟加载时单独读取某个标签，不能和主文档共用一个会话
+    m_partialApplication = new TDocStd_Application();
+    BinDrivers::DefineFormat(m_partialApplication);
+    XmlDrivers::DefineFormat(m_partialApplication);
+    BinXCAFDrivers::DefineFormat(m_partialApplication);
+    XmlXCAFDrivers::DefineFormat(m_partialApplication);
 }
 
 bool OCAFDocument::NewDocument() {
@@ -63,6 +86,14 @@ bool OCAFDocument::NewDocument() {
             return false;
         }
         
+        m_isLazy = false;
+        m_lazyFileName.clear();
+        m_lazyShapes.clear();
+        m_nativeFile.reset();
+        m_nativeParts.clear();
+        m_featureRecords.clear();
+        m_saveSession.reset();
+        m_journal.reset();
         InitializeDocument();
         return true;
     } catch (const Standard_Failure& e) {
@@ -75,25 +106,47 @@ void OCAFDocument::InitializeDocument() {
     m_rootLabel = m_document->GetData()->Root();
     
     // Enable undo/redo for this document - this is crucial!
-    m_document->SetUndoLimit(50); // Allow up to 50 undo operations
+    // 步数上限放宽，实际保留多少步由内存预算决定（见TrimUndoHistory）
+    m_document->SetUndoLimit(kMaxUndoSteps);
+    m_undoBytes.clear();
+    m_redoBytes.clear();
+    m_trimmedUndoSteps = 0;
     
     // Create shapes folder
     m_shapesLabel = m_rootLabel.FindChild(1);
     TDataStd_Name::Set(m_shapesLabel, TCollection_ExtendedString("Shapes"));
     
-    std::cout << "[OCAF] Document initialized with undo limit: " << m_document->GetUndoLimit() << std::endl;
+    CAD_LOG_DEBUG("ocaf", "Document initialized with undo limit: " << m_document->GetUndoLimit());
     
     // Initialize XCAFDoc tools
     m_shapeTool = XCAFDoc_DocumentTool::ShapeTool(m_document->Main());
 }
 
-bool OCAFDocument::OpenDocument(const std::string& filename) {
+bool OCAFDocument::OpenDocument(const std::string& filename, bool lazy) {
+    if (NativeDocumentFile::IsNativeFile(filename)) {
+        return OpenNativeDocument(filename, lazy);
+    }
+    
     try {
         TCollection_ExtendedString path(filename.c_str());
         
+        // 延迟模式下跳过所有形状属性，名称、标记和包围盒照常读取
+        Handle(PCDM_ReaderFilter) filter;
+        if (lazy) {
+            filter = new PCDM_ReaderFilter(STANDARD_TYPE(TNaming_NamedShape));
+        }
+        
         // Use the correct method for opening documents
-        m_application->Open(path, m_document);
+        m_application->Open(path, m_document, filter);
         if (!m_document.IsNull()) {
+            m_isLazy = lazy;
+            m_lazyFileName = lazy ? filename : std::string();
+            m_lazyShapes.clear();
+            m_nativeFile.reset();
+            m_nativeParts.clear();
+            m_featureRecords.clear();
+            m_saveSession.reset();
+            m_journal.reset();
             InitializeDocument();
             return true;
         }
@@ -109,6 +162,32 @@ bool OCAFDocument::SaveDocument(const std::string& filename) {
             return false;
         }
         
+        // 原生格式直接引用未读取零件在原文件中的数据，不需要补齐几何
+        if (NativeDocumentFile::IsNativeFileName(filename)) {
+            return SaveNativeDocument(filename);
+        }
+        
+        // 延迟打开的文档缺少未读取的几何，先补齐再保存
+        if (m_isLazy && !LoadAllShapes()) {
+            return false;
+        }
+        
+        // 导入的网格只有三角网格，二进制格式默认不写三角网格，有网格时才打开
+        bool hasMesh = false;
+        for (const TDF_Label& label : GetAllShapes()) {
+            Handle(TNaming_NamedShape) namedShape;
+            if (label.FindAttribute(TNaming_NamedShape::GetID(), namedShape) &&
+                MeshImporter::IsMeshShape(namedShape->Get())) {
+                hasMesh = true;
+                break;
+            }
+        }
+        Handle(BinDrivers_DocumentStorageDriver) binDriver =
+            Handle(BinDrivers_DocumentStorageDriver)::DownCast(m_application->WriterFromFormat(m_document->StorageFormat()));
+        if (!binDriver.IsNull()) {
+            binDriver->SetWithTriangles(Message::DefaultMessenger(), hasMesh);
+        }
+        
         TCollection_ExtendedString path(filename.c_str());
         // Use the correct method for saving documents
         m_application->SaveAs(m_document, path);
@@ -134,6 +213,10 @@ TDF_Label OCAFDocument::AddShape(const ShapePtr& shape, const std::string& name)
         // Also create a backup using TDataStd to ensure the transaction is recognized
         TDataStd_Integer::Set(shapeLabel, 1); // Mark as active shape
         
+        Bnd_Box box;
+        BRepBndLib::Add(shape->GetOCCTShape(), box);
+        SetBoundingBox(shapeLabel, box);
+        
         // Set name if provided
         if (!name.empty()) {
             SetName(shapeLabel, name);
@@ -141,6 +224,9 @@ TDF_Label OCAFDocument::AddShape(const ShapePtr& shape, const std::string& name)
             SetName(shapeLabel, "Shape");
         }
         
+        if (m_journal) {
+            m_journal->RecordAddShape(LabelEntry(shapeLabel), GetName(shapeLabel), shape->GetOCCTShape());
+        }
         return shapeLabel;
     } catch (const Standard_Failure& e) {
         return TDF_Label();
@@ -154,18 +240,22 @@ bool OCAFDocument::RemoveShape(const TDF_Label& label) {
     
     try {
         // Use TNaming_Builder to properly record the deletion for undo/redo
+        // 延迟模式下形状可能还没读进来，先取到再记录删除
+        ShapePtr existing = GetShape(label);
         TNaming_Builder builder(label);
-        Handle(TNaming_NamedShape) namedShape;
-        if (label.FindAttribute(TNaming_NamedShape::GetID(), namedShape)) {
-            TopoDS_Shape shape = namedShape->Get();
-            if (!shape.IsNull()) {
-                builder.Delete(shape);
-            }
+        if (existing && !existing->GetOCCTShape().IsNull()) {
+            builder.Delete(existing->GetOCCTShape());
+            // 删除后几何只由撤销记录持有
+            m_transactionBytes += LazyPartStore::EstimateShapeBytes(existing->GetOCCTShape());
         }
+        m_lazyShapes.erase(LabelEntry(label));
         
         // Mark as deleted but keep TNaming for undo/redo
         TDataStd_Integer::Set(label, 0); // Mark as deleted
         
+        if (m_journal) {
+            m_journal->RecordRemoveShape(LabelEntry(label));
+        }
         return true;
     } catch (const Standard_Failure& e) {
         return false;
@@ -178,19 +268,393 @@ ShapePtr OCAFDocument::GetShape(const TDF_Label& label) const {
     }
     
     try {
+        ShapePtr loaded = GetLoadedShape(label);
+        if (loaded || !m_isLazy) {
+            return loaded;
+        }
+        
+        // 延迟模式：活动形状的几何还没读，按需从文件读取
         Handle(TNaming_NamedShape) namedShape;
-        if (label.FindAttribute(TNaming_NamedShape::GetID(), namedShape)) {
-            TopoDS_Shape shape = namedShape->Get();
-            if (!shape.IsNull()) {
-                return std::make_shared<Shape>(shape);
-            }
+        if (label.FindAttribute(TNaming_NamedShape::GetID(), namedShape) || GetInteger(label) != 1) {
+            return nullptr;
         }
-        return nullptr;
+        TopoDS_Shape shape = ReadShapesFromFile({ label }).front();
+        if (shape.IsNull()) {
+            return nullptr;
+        }
+        m_lazyShapes[LabelEntry(label)] = shape;
+        NoteLoadedShape(label, shape);
+        return std::make_shared<Shape>(shape);
     } catch (const Standard_Failure& e) {
         return nullptr;
     }
 }
 
+ShapePtr OCAFDocument::GetLoadedShape(const TDF_Label& label) const {
+    if (label.IsNull()) {
+        return nullptr;
+    }
+    
+    Handle(TNaming_NamedShape) namedShape;
+    if (label.FindAttribute(TNaming_NamedShape::GetID(), namedShape)) {
+        TopoDS_Shape shape = namedShape->Get();
+        return shape.IsNull() ? nullptr : std::make_shared<Shape>(shape);
+    }
+    
+    auto it = m_lazyShapes.find(LabelEntry(label));
+    if (it != m_lazyShapes.end()) {
+        return std::make_shared<Shape>(it->second);
+    }
+    return nullptr;
+}
+
+bool OCAFDocument::IsShapeLoaded(const TDF_Label& label) const {
+    if (label.IsNull()) {
+        return false;
+    }
+    if (label.IsAttribute(TNaming_NamedShape::GetID())) {
+        return true;
+    }
+    return m_lazyShapes.find(LabelEntry(label)) != m_lazyShapes.end();
+}
+
+void OCAFDocument::UnloadShape(const TDF_Label& label) {
+    if (!label.IsNull()) {
+        m_lazyShapes.erase(LabelEntry(label));
+    }
+}
+
+void OCAFDocument::PrefetchShapes(const std::vector<TDF_Label>& labels) const {
+    if (!m_isLazy) {
+        return;
+    }
+    
+    try {
+        // 只读还不在内存里的活动形状；已删除（非活动）的标签保持不读
+        std::vector<TDF_Label> missing;
+        for (const TDF_Label& label : labels) {
+            if (!label.IsNull() && !IsShapeLoaded(label) && GetInteger(label) == 1) {
+                missing.push_back(label);
+            }
+        }
+        if (missing.empty()) {
+            return;
+        }
+        
+        std::vector<TopoDS_Shape> shapes = ReadShapesFromFile(missing);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            if (!shapes[i].IsNull()) {
+                m_lazyShapes[LabelEntry(missing[i])] = shapes[i];
+                NoteLoadedShape(missing[i], shapes[i]);
+            }
+        }
+    } catch (const Standard_Failure&) {
+        // 预读失败不影响之后逐个读取
+    }
+}
+
+bool OCAFDocument::LoadAllShapes() {
+    if (!m_isLazy) {
+        return true;
+    }
+    
+    if (m_nativeFile) {
+        // 原生格式：还没读的活动零件并行反序列化，再挂到各自的标签上
+        std::vector<TDF_Label> labels;
+        std::vector<size_t> indices;
+        for (const auto& entry : m_nativeParts) {
+            TDF_Label label;
+            TDF_Tool::Label(m_document->GetData(), TCollection_AsciiString(entry.first.c_str()), label, Standard_False);
+            if (label.IsNull() || label.IsAttribute(TNaming_NamedShape::GetID()) || GetInteger(label) != 1) {
+                continue;
+            }
+            labels.push_back(label);
+            indices.push_back(entry.second);
+        }
+        
+        std::vector<TopoDS_Shape> shapes(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            auto cached = m_lazyShapes.find(LabelEntry(labels[i]));
+            if (cached != m_lazyShapes.end()) {
+                shapes[i] = cached->second;
+            }
+        }
+        std::vector<size_t> missing;
+        std::vector<size_t> missingSlots;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (shapes[i].IsNull()) {
+                missing.push_back(indices[i]);
+                missingSlots.push_back(i);
+            }
+        }
+        std::vector<TopoDS_Shape> loaded = m_nativeFile->LoadShapes(missing);
+        for (size_t i = 0; i < missing.size(); ++i) {
+            shapes[missingSlots[i]] = loaded[i];
+        }
+        
+        try {
+            for (size_t i = 0; i < labels.size(); ++i) {
+                if (shapes[i].IsNull()) {
+                    return false;
+                }
+                TNaming_Builder builder(labels[i]);
+                builder.Generated(shapes[i]);
+                NoteLoadedShape(labels[i], shapes[i]);
+            }
+        } catch (const Standard_Failure&) {
+            return false;
+        }
+        
+        m_isLazy = false;
+        m_lazyShapes.clear();
+        m_nativeFile.reset();
+        m_nativeParts.clear();
+        return true;
+    }
+    
+    try {
+        // 追加模式：只补读形状属性，已经存在的属性（包括删除记录）保持不变
+        Handle(PCDM_ReaderFilter) filter = new PCDM_ReaderFilter(PCDM_ReaderFilter::AppendMode_Protect);
+        filter->AddRead("TNaming_NamedShape");
+        
+        TCollection_ExtendedString path(m_lazyFileName.c_str());
+        if (m_application->Open(path, m_document, filter) != PCDM_RS_OK) {
+            return false;
+        }
+        
+        m_isLazy = false;
+        m_lazyFileName.clear();
+        m_lazyShapes.clear();
+        return true;
+    } catch (const Standard_Failure&) {
+        return false;
+    }
+}
+
+bool OCAFDocument::GetBoundingBox(const TDF_Label& label, Bnd_Box& box) const {
+    Handle(TDataStd_RealArray) boxArray;
+    if (label.IsNull() || !label.FindAttribute(TDataStd_RealArray::GetID(), boxArray)
+        || boxArray->Length() != 6) {
+        return false;
+    }
+    
+    box.SetVoid();
+    box.Update(boxArray->Value(0), boxArray->Value(1), boxArray->Value(2),
+               boxArray->Value(3), boxArray->Value(4), boxArray->Value(5));
+    return true;
+}
+
+std::vector<TopoDS_Shape> OCAFDocument::ReadShapesFromFile(const std::vector<TDF_Label>& labels) const {
+    std::vector<TopoDS_Shape> shapes(labels.size());
+    if (labels.empty()) {
+        return shapes;
+    }
+    
+    if (m_nativeFile) {
+        // 原生格式：按零件序号并行反序列化
+        std::vector<size_t> indices;
+        std::vector<size_t> slots;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            auto part = m_nativeParts.find(LabelEntry(labels[i]));
+            if (part != m_nativeParts.end()) {
+                indices.push_back(part->second);
+                slots.push_back(i);
+            }
+        }
+        std::vector<TopoDS_Shape> loaded = m_nativeFile->LoadShapes(indices);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            shapes[slots[i]] = loaded[i];
+        }
+        return shapes;
+    }
+    
+    if (m_lazyFileName.empty() || m_partialApplication.IsNull()) {
+        return shapes;
+    }
+    
+    try {
+        // 过滤打开只读这些标签的子树；整批只解析一次文件
+        std::vector<TCollection_AsciiString> entries;
+        entries.reserve(labels.size());
+        for (const TDF_Label& label : labels) {
+            entries.emplace_back(LabelEntry(label).c_str());
+        }
+        Handle(PCDM_ReaderFilter) filter = new PCDM_ReaderFilter(entries.front());
+        for (size_t i = 1; i < entries.size(); ++i) {
+            filter->AddPath(entries[i]);
+        }
+        
+        Handle(TDocStd_Document) partial;
+        TCollection_ExtendedString path(m_lazyFileName.c_str());
+        if (m_partialApplication->Open(path, partial, filter) != PCDM_RS_OK || partial.IsNull()) {
+            return shapes;
+        }
+        
+        for (size_t i = 0; i < entries.size(); ++i) {
+            TDF_Label partialLabel;
+            TDF_Tool::Label(partial->GetData(), entries[i], partialLabel, Standard_False);
+            Handle(TNaming_NamedShape) namedShape;
+            if (!partialLabel.IsNull() && partialLabel.FindAttribute(TNaming_NamedShape::GetID(), namedShape)) {
+                shapes[i] = namedShape->Get();
+            }
+        }
+        
+        m_partialApplication->Close(partial);
+        return shapes;
+    } catch (const Standard_Failure&) {
+        return std::vector<TopoDS_Shape>(labels.size());
+    }
+}
+
+bool OCAFDocument::OpenNativeDocument(const std::string& filename, bool lazy) {
+    auto file = std::make_shared<NativeDocumentFile>();
+    if (!file->Open(filename) || !NewDocument()) {
+        return false;
+    }
+    
+    try {
+        // 打开时只建立标签：名称、活动标记和包围盒都在零件表里，不碰几何
+        std::vector<TDF_Label> labels;
+        std::vector<size_t> activeParts;
+        for (size_t i = 0; i < file->GetPartCount(); ++i) {
+            const NativeDocumentFile::PartInfo& part = file->GetPart(i);
+            TDF_Label label = GetNextAvailableLabel(m_shapesLabel);
+            SetName(label, part.name.empty() ? "Shape" : part.name);
+            TDataStd_Integer::Set(label, part.active ? 1 : 0);
+            SetBoundingBox(label, part.box);
+            m_nativeParts[LabelEntry(label)] = i;
+            if (part.active) {
+                labels.push_back(label);
+                activeParts.push_back(i);
+            }
+        }
+        m_featureRecords = file->GetFeatures();
+        
+        // 保存会话从这个文件开始：没改动的零件以后保存时沿用原来的块
+        std::vector<std::string> entries(file->GetPartCount());
+        for (const auto& part : m_nativeParts) {
+            entries[part.second] = part.first;
+        }
+        m_saveSession = std::make_shared<NativeSaveSession>(filename);
+        m_saveSession->Adopt(*file, entries);
+        
+        if (lazy) {
+            m_isLazy = true;
+            m_nativeFile = file;
+            return true;
+        }
+        
+        // 非延迟：全部零件并行反序列化
+        std::vector<TopoDS_Shape> shapes = file->LoadShapes(activeParts);
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (!shapes[i].IsNull()) {
+                TNaming_Builder builder(labels[i]);
+                builder.Generated(shapes[i]);
+                NoteLoadedShape(labels[i], shapes[i]);
+            }
+        }
+        m_nativeParts.clear();
+        return true;
+    } catch (const Standard_Failure&) {
+        NewDocument();
+        return false;
+    }
+}
+
+bool OCAFDocument::SaveNativeDocument(const std::string& filename) {
+    std::string error;
+    if (!GetSaveSession(filename)->Save(CreateSaveSnapshot(), error)) {
+        CAD_LOG_ERROR("ocaf", "Failed to save " << filename << ": " << error);
+        return false;
+    }
+    return true;
+}
+
+NativeSaveSession::Snapshot OCAFDocument::CreateSaveSnapshot() const {
+    NativeSaveSession::Snapshot snapshot;
+    snapshot.features = m_featureRecords;
+    snapshot.source = m_nativeFile;
+    
+    for (const TDF_Label& label : GetAllShapes()) {
+        if (GetInteger(label) != 1) {
+            continue;
+        }
+        NativeDocumentFile::PartData part;
+        part.entry = LabelEntry(label);
+        part.name = GetName(label);
+        GetBoundingBox(label, part.box);
+        
+        ShapePtr shape = GetLoadedShape(label);
+        if (shape) {
+            part.shape = shape->GetOCCTShape();
+        } else if (m_nativeFile) {
+            // 未读取的原生零件：引用映射中已编码的数据，保存时原样复制或沿用
+            auto index = m_nativeParts.find(part.entry);
+            if (index == m_nativeParts.end()) {
+                continue;
+            }
+            const NativeDocumentFile::PartInfo& info = m_nativeFile->GetPart(index->second);
+            part.blob = m_nativeFile->GetChunkData(info.brepChunk);
+            part.blobBytes = info.brepBytes;
+            if (!part.blob) {
+                continue;
+            }
+        } else {
+            // 延迟打开的OCAF文档只能把几何读出来
+            shape = GetShape(label);
+            if (!shape) {
+                continue;
+            }
+            part.shape = shape->GetOCCTShape();
+        }
+        snapshot.parts.push_back(part);
+    }
+    return snapshot;
+}
+
+std::shared_ptr<NativeSaveSession> OCAFDocument::GetSaveSession(const std::string& filename) {
+    if (!m_saveSession || m_saveSession->GetFileName() != filename) {
+        m_saveSession = std::make_shared<NativeSaveSession>(filename);
+    }
+    return m_saveSession;
+}
+
+void OCAFDocument::NoteLoadedShape(const TDF_Label& label, const TopoDS_Shape& shape) const {
+    if (m_saveSession) {
+        m_saveSession->NoteLoadedShape(LabelEntry(label), shape);
+    }
+}
+
+void OCAFDocument::SetBoundingBox(const TDF_Label& label, const Bnd_Box& box) {
+    // 包围盒随文档保存，延迟打开时不读几何也能做可见性判断
+    if (box.IsVoid()) {
+        return;
+    }
+    double xmin, ymin, zmin, xmax, ymax, zmax;
+    box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+    Handle(TDataStd_RealArray) boxArray = TDataStd_RealArray::Set(label, 0, 5);
+    boxArray->SetValue(0, xmin);
+    boxArray->SetValue(1, ymin);
+    boxArray->SetValue(2, zmin);
+    boxArray->SetValue(3, xmax);
+    boxArray->SetValue(4, ymax);
+    boxArray->SetValue(5, zmax);
+}
+
+TDF_Label OCAFDocument::FindLabel(const std::string& entry) const {
+    TDF_Label label;
+    if (!m_document.IsNull() && !entry.empty()) {
+        TDF_Tool::Label(m_document->GetData(), TCollection_AsciiString(entry.c_str()), label, Standard_False);
+    }
+    return label;
+}
+
+std::string OCAFDocument::LabelEntry(const TDF_Label& label) {
+    TCollection_AsciiString entry;
+    TDF_Tool::Entry(label, entry);
+    return entry.ToCString();
+}
+
 std::vector<TDF_Label> OCAFDocument::GetAllShapes() const {
     std::vector<TDF_Label> shapes;
     
@@ -201,6 +665,9 @@ std::vector<TDF_Label> OCAFDocument::GetAllShapes() const {
             Handle(TNaming_NamedShape) namedShape;
             if (child.FindAttribute(TNaming_NamedShape::GetID(), namedShape)) {
                 shapes.push_back(child);
+            } else if (m_isLazy && GetInteger(child) == 1) {
+                // 延迟模式下几何还没读，靠活动标记识别
+                shapes.push_back(child);
             }
         }
     } catch (const Standard_Failure& e) {
@@ -249,7 +716,12 @@ bool OCAFDocument::SetName(const TDF_Label& label, const std::string& name) {
     }
     
     try {
+        // 只有重命名才记日志，新建形状时的名称随添加一起记录
+        bool rename = m_journal && label.IsAttribute(TDataStd_Name::GetID());
         TDataStd_Name::Set(label, TCollection_ExtendedString(name.c_str()));
+        if (rename) {
+            m_journal->RecordSetName(LabelEntry(label), name);
+        }
         return true;
     } catch (const Standard_Failure& e) {
         return false;
@@ -335,9 +807,17 @@ bool OCAFDocument::Undo() {
     if (!CanUndo()) {
         return false;
     }
+    CAD_TRACE_ZONE_CAT("OCAFDocument::Undo", "ocaf");
     
     try {
         m_document->Undo();
+        if (!m_undoBytes.empty()) {
+            m_redoBytes.push_back(m_undoBytes.back());
+            m_undoBytes.pop_back();
+        }
+        if (m_journal) {
+            m_journal->RecordUndo();
+        }
         return true;
     } catch (const Standard_Failure& e) {
         return false;
@@ -348,9 +828,17 @@ bool OCAFDocument::Redo() {
     if (!CanRedo()) {
         return false;
     }
+    CAD_TRACE_ZONE_CAT("OCAFDocument::Redo", "ocaf");
     
     try {
         m_document->Redo();
+        if (!m_redoBytes.empty()) {
+            m_undoBytes.push_back(m_redoBytes.back());
+            m_redoBytes.pop_back();
+        }
+        if (m_journal) {
+            m_journal->RecordRedo();
+        }
         return true;
     } catch (const Standard_Failure& e) {
         return false;
@@ -377,38 +865,148 @@ void OCAFDocument::StartTransaction(const std::string& name) {
     if (m_document.IsNull() || m_inTransaction) {
         return;
     }
+    CAD_TRACE_ZONE_CAT("OCAFDocument::StartTransaction", "ocaf");
     
     try {
         m_document->NewCommand();
         m_inTransaction = true;
-        std::cout << "[OCAF] Transaction started: " << name << std::endl;
+        m_transactionBytes = 0;
+        m_transactionName = name;
+        m_transactionStart = std::chrono::steady_clock::now();
+        if (m_journal) {
+            m_journal->BeginTransaction(name);
+        }
+        CAD_LOG_DEBUG("ocaf", "Transaction started: " << name);
     } catch (const Standard_Failure& e) {
         m_inTransaction = false;
-        std::cout << "[OCAF] Failed to start transaction: " << name << std::endl;
+        CAD_LOG_WARNING("ocaf", "Failed to start transaction: " << name);
     }
 }
 
 void OCAFDocument::CommitTransaction() {
     if (m_document.IsNull() || !m_inTransaction) {
-        std::cout << "[OCAF] Cannot commit: document null or no transaction" << std::endl;
+        CAD_LOG_WARNING("ocaf", "Cannot commit: document null or no transaction");
         return;
     }
+    CAD_TRACE_ZONE_CAT("OCAFDocument::CommitTransaction", "ocaf");
     
     try {
-        m_document->CommitCommand();
+        const bool recorded = m_document->CommitCommand();
         m_inTransaction = false;
-        std::cout << "[OCAF] Transaction committed. Available undos: " << m_document->GetAvailableUndos() << std::endl;
+        if (recorded) {
+            // 新的修改使重做栈失效
+            m_undoBytes.push_back(m_transactionBytes + EstimateCommittedShapeBytes());
+            m_redoBytes.clear();
+            TrimUndoHistory();
+        }
+        m_lastTransactionName = m_transactionName;
+        m_lastTransactionMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - m_transactionStart).count();
+        if (m_journal) {
+            m_journal->CommitTransaction();
+        }
+        CAD_LOG_DEBUG("ocaf", "Transaction committed. Available undos: " << m_document->GetAvailableUndos());
     } catch (const Standard_Failure& e) {
         m_inTransaction = false;
-        std::cout << "[OCAF] Failed to commit transaction" << std::endl;
+        CAD_LOG_WARNING("ocaf", "Failed to commit transaction");
     }
 }
 
+size_t OCAFDocument::EstimateCommittedShapeBytes() const {
+    // 新增/替换的形状在撤销后由重做记录持有，按刚提交的增量逐个统计；
+    // 合并成一个复合体估算，同一步里共享的子形状只算一次
+    const TDF_DeltaList& undos = m_document->GetUndos();
+    if (undos.IsEmpty()) {
+        return 0;
+    }
+    
+    try {
+        BRep_Builder builder;
+        TopoDS_Compound compound;
+        builder.MakeCompound(compound);
+        bool any = false;
+        for (TDF_ListIteratorOfAttributeDeltaList it(undos.Last()->AttributeDeltas()); it.More(); it.Next()) {
+            const Handle(TDF_AttributeDelta)& delta = it.Value();
+            if (delta->ID() != TNaming_NamedShape::GetID()) {
+                continue;
+            }
+            // 删除留下的是空形状，其旧几何已在RemoveShape中计入
+            Handle(TNaming_NamedShape) namedShape;
+            if (delta->Label().FindAttribute(TNaming_NamedShape::GetID(), namedShape) &&
+                !namedShape->Get().IsNull()) {
+                builder.Add(compound, namedShape->Get());
+                any = true;
+            }
+        }
+        return any ? LazyPartStore::EstimateShapeBytes(compound) : 0;
+    } catch (const Standard_Failure&) {
+        return 0;
+    }
+}
+
+void OCAFDocument::SetUndoMemoryBudget(size_t bytes) {
+    m_undoMemoryBudget = bytes;
+    if (!m_document.IsNull() && !m_inTransaction) {
+        TrimUndoHistory();
+    }
+}
+
+size_t OCAFDocument::GetUndoMemoryUsage() const {
+    return std::accumulate(m_undoBytes.begin(), m_undoBytes.end(), size_t(0))
+         + std::accumulate(m_redoBytes.begin(), m_redoBytes.end(), size_t(0));
+}
+
+void OCAFDocument::TrimUndoHistory() {
+    // OCAF在提交时已经按步数上限丢弃了最早的步骤
+    while (static_cast<int>(m_undoBytes.size()) > m_document->GetAvailableUndos()) {
+        m_undoBytes.pop_front();
+    }
+    
+    // 从最新的步骤往回累加，超出预算的更早步骤丢弃
+    size_t total = 0;
+    size_t keep = 0;
+    for (auto it = m_undoBytes.rbegin(); it != m_undoBytes.rend(); ++it) {
+        if (keep > 0 && total + *it > m_undoMemoryBudget) {
+            break;
+        }
+        total += *it;
+        ++keep;
+    }
+    if (keep == m_undoBytes.size()) {
+        return;
+    }
+    
+    try {
+        // 调小上限会从最早的一端删除撤销记录，再恢复上限
+        m_document->SetUndoLimit(static_cast<Standard_Integer>(keep));
+        m_document->SetUndoLimit(kMaxUndoSteps);
+        CAD_LOG_DEBUG("ocaf", "Undo history trimmed to " << keep << " steps ("
+                      << total / (1024 * 1024) << " MB retained)");
+        m_trimmedUndoSteps += m_undoBytes.size() - keep;
+        m_undoBytes.erase(m_undoBytes.begin(), m_undoBytes.begin() + (m_undoBytes.size() - keep));
+    } catch (const Standard_Failure&) {
+        CAD_LOG_WARNING("ocaf", "Failed to trim undo history");
+    }
+}
+
+bool OCAFDocument::GetLastTransaction(std::string& name, double& milliseconds) const {
+    if (m_lastTransactionMs < 0.0) {
+        return false;
+    }
+    name = m_lastTransactionName;
+    milliseconds = m_lastTransactionMs;
+    return true;
+}
+
 void OCAFDocument::AbortTransaction() {
     if (m_document.IsNull() || !m_inTransaction) {
         return;
     }
+    CAD_TRACE_ZONE_CAT("OCAFDocument::AbortTransaction", "ocaf");
     
+    if (m_journal) {
+        m_journal->AbortTransaction();
+    }
     try {
         m_document->AbortCommand();
         m_inTransaction = false;
@@ -35,12 +35,12 @@ bool OCAFManager::NewDocument() {
     return m_document->NewDocument();
 }
 
-bool OCAFManager::OpenDocument(const std::string& filename) {
+bool OCAFManager::OpenDocument(const std::string& filename, bool lazy) {
     if (!m_document) {
         return false;
     }
     
-    return m_document->OpenDocument(filename);
+    return m_document->OpenDocument(filename, lazy);
 }
 
 bool OCAFManager::SaveDocument(const std::string& filename) {
@@ -88,7 +88,8 @@ bool OCAFManager::RemoveShape(const ShapePtr& shape) {
     // 查找对应此形状的标签
     std::vector<TDF_Label> labels = m_document->GetAllShapes();
     for (const auto& label : labels) {
-        ShapePtr labelShape = m_document->GetShape(label);
+        // 调用方手里的形状一定已经加载过，未加载的标签不用读文件比较
+        ShapePtr labelShape = m_document->GetLoadedShape(label);
         if (labelShape && labelShape->GetOCCTShape().IsSame(shape->GetOCCTShape())) {
             return m_document->RemoveShape(label);
         }
@@ -105,7 +106,8 @@ bool OCAFManager::ReplaceShape(const ShapePtr& oldShape, const ShapePtr& newShap
     // 查找对应旧形状的标签
     std::vector<TDF_Label> labels = m_document->GetAllShapes();
     for (const auto& label : labels) {
-        ShapePtr labelShape = m_document->GetShape(label);
+        // 调用方手里的形状一定已经加载过，未加载的标签不用读文件比较
+        ShapePtr labelShape = m_document->GetLoadedShape(label);
         if (labelShape && labelShape->GetOCCTShape().IsSame(oldShape->GetOCCTShape())) {
             // 获取原有的名称
             std::string name = m_document->GetName(label);
@@ -228,6 +230,38 @@ void OCAFManager::AbortTransaction() {
     m_document->AbortTransaction();
 }
 
+bool OCAFManager::GetLastTransaction(std::string& name, double& milliseconds) const {
+    if (!m_document) {
+        return false;
+    }
+    
+    return m_document->GetLastTransaction(name, milliseconds);
+}
+
+void OCAFManager::SetUndoMemoryBudget(size_t bytes) {
+    if (!m_document) {
+        return;
+    }
+    
+    m_document->SetUndoMemoryBudget(bytes);
+}
+
+size_t OCAFManager::GetUndoMemoryUsage() const {
+    if (!m_document) {
+        return 0;
+    }
+    
+    return m_document->GetUndoMemoryUsage();
+}
+
+size_t OCAFManager::GetTrimmedUndoSteps() const {
+    if (!m_document) {
+        return 0;
+    }
+    
+    return m_document->GetTrimmedUndoSteps();
+}
+
 TDF_Label OCAFManager::FindShapeByName(const std::string& name) const {
     if (!m_document || name.empty()) {
         return TDF_Label();
@@ -0,0 +1,607 @@
+#include "cad_core/OperationJournal.h"
+#include "cad_core/ByteStream.h"
+#include "cad_core/MappedFile.h"
+#include "cad_core/NativeDocumentFile.h"
+#include "cad_core/OCAFDocument.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include <Standard_Failure.hxx>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace cad_core {
+
+namespace {
+
+const char kMagic[8] = { 'A', 'C', 'A', 'D', 'J', 'R', 'N', 'L' };
+const std::uint32_t kVersion = 1;
+const std::uint32_t kSegmentResumed = 1u << 0;
+
+// 记录：{u32 长度, u32 校验, 内容}；内容第一个字节是记录类型
+const std::uint8_t kRecordTransaction = 1;
+const std::uint8_t kRecordUndo = 2;
+const std::uint8_t kRecordRedo = 3;
+
+// 合并提交的等待时间：这段时间内的提交一起写、一起fsync
+const std::chrono::milliseconds kBatchWindow(20);
+
+// 重放时每批解码的几何数据上限
+const size_t kReplayBatchBytes = 256u * 1024 * 1024;
+
+std::uint32_t Checksum(const char* data, size_t size) {
+    // FNV-1a，只用来发现写了一半的记录
+    std::uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void SyncFile(std::FILE* file) {
+    std::fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+// 重放时解析出的一个修改，几何指向映射中的数据
+struct ReplayOperation {
+    std::uint8_t type = 0;
+    std::string entry;
+    std::string name;
+    const char* blob = nullptr;
+    size_t blobBytes = 0;
+};
+
+struct ReplayRecord {
+    std::uint8_t type = 0;
+    std::string name;
+    std::vector<ReplayOperation> operations;
+    bool resumed = false;   // 这一条是续写段的第一条，从这里起标签条目不再需要映射
+};
+
+struct SegmentHeader {
+    std::string baseFile;
+    std::vector<std::string> entries;
+    std::uint32_t flags = 0;
+};
+
+bool ReadSegment(const MappedFile& file, SegmentHeader& header, std::vector<ReplayRecord>& records) {
+    if (!file.IsOpen() || file.Size() < sizeof(kMagic) ||
+        std::memcmp(file.Data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    ByteReader reader(file.Data() + sizeof(kMagic), file.Size() - sizeof(kMagic));
+    std::uint32_t version = reader.Get<std::uint32_t>();
+    header.flags = reader.Get<std::uint32_t>();
+    header.baseFile = reader.GetString();
+    std::uint32_t entryCount = reader.Get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < entryCount && reader.ok(); ++i) {
+        header.entries.push_back(reader.GetString());
+    }
+    if (!reader.ok() || version > kVersion) {
+        return false;
+    }
+
+    size_t first = records.size();
+    // 写到一半的记录（长度不够或校验不对）及其后的内容都丢弃
+    while (true) {
+        std::uint32_t size = reader.Get<std::uint32_t>();
+        std::uint32_t checksum = reader.Get<std::uint32_t>();
+        const char* payload = reader.GetBytes(size);
+        if (!reader.ok() || Checksum(payload, size) != checksum) {
+            break;
+        }
+
+        ByteReader record(payload, size);
+        ReplayRecord parsed;
+        parsed.type = record.Get<std::uint8_t>();
+        if (parsed.type == kRecordTransaction) {
+            parsed.name = record.GetString();
+            std::uint32_t count = record.Get<std::uint32_t>();
+            for (std::uint32_t i = 0; i < count && record.ok(); ++i) {
+                ReplayOperation operation;
+                operation.type = record.Get<std::uint8_t>();
+                operation.entry = record.GetString();
+                operation.name = record.GetString();
+                std::uint64_t blobBytes = record.Get<std::uint64_t>();
+                operation.blob = record.GetBytes(static_cast<size_t>(blobBytes));
+                operation.blobBytes = static_cast<size_t>(blobBytes);
+                parsed.operations.push_back(operation);
+            }
+        }
+        if (!record.ok()) {
+            break;
+        }
+        records.push_back(parsed);
+    }
+    if ((header.flags & kSegmentResumed) && records.size() > first) {
+        records[first].resumed = true;
+    }
+    return true;
+}
+
+} // namespace
+
+OperationJournal::OperationJournal(const std::string& path)
+    : m_path(path), m_inTransaction(false), m_lastSegment(-1),
+      m_enqueuedCount(0), m_writtenCount(0), m_stop(false), m_file(nullptr) {
+}
+
+OperationJournal::~OperationJournal() {
+    StopWriter();
+    CloseSegment();
+}
+
+bool OperationJournal::Start(const std::string& baseFile, const std::vector<std::string>& entries) {
+    StopWriter();
+    CloseSegment();
+    for (int segment : ListSegments(m_path)) {
+        std::remove(SegmentPath(m_path, segment).c_str());
+    }
+
+    m_lastSegment = 0;
+    if (!OpenSegment(0, baseFile, entries, false)) {
+        return false;
+    }
+    StartWriter();
+    return true;
+}
+
+bool OperationJournal::Resume() {
+    StopWriter();
+    CloseSegment();
+    std::vector<int> segments = ListSegments(m_path);
+    m_lastSegment = segments.empty() ? 0 : segments.back() + 1;
+    if (!OpenSegment(m_lastSegment, std::string(), std::vector<std::string>(), true)) {
+        return false;
+    }
+    StartWriter();
+    return true;
+}
+
+int OperationJournal::Rotate(const std::string& baseFile, const std::vector<std::string>& entries) {
+    Item item;
+    item.kind = kRotate;
+    item.baseFile = baseFile;
+    item.entries = entries;
+    item.segment = ++m_lastSegment;
+    Enqueue(std::move(item));
+    return m_lastSegment;
+}
+
+void OperationJournal::DiscardSegmentsBefore(int segment) {
+    Item item;
+    item.kind = kDiscard;
+    item.segment = segment;
+    Enqueue(std::move(item));
+}
+
+void OperationJournal::Remove() {
+    StopWriter();
+    CloseSegment();
+    for (int segment : ListSegments(m_path)) {
+        std::remove(SegmentPath(m_path, segment).c_str());
+    }
+}
+
+void OperationJournal::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t target = m_enqueuedCount;
+    m_wake.notify_one();
+    m_written.wait(lock, [this, target]() { return m_writtenCount >= target || !m_writer.joinable(); });
+}
+
+void OperationJournal::BeginTransaction(const std::string& name) {
+    m_inTransaction = true;
+    m_transactionName = name;
+    m_pending.clear();
+}
+
+void OperationJournal::CommitTransaction() {
+    if (!m_inTransaction) {
+        return;
+    }
+    m_inTransaction = false;
+    if (m_pending.empty()) {
+        return;
+    }
+    Item item;
+    item.kind = kTransaction;
+    item.name = m_transactionName;
+    item.operations.swap(m_pending);
+    Enqueue(std::move(item));
+}
+
+void OperationJournal::AbortTransaction() {
+    m_inTransaction = false;
+    m_pending.clear();
+}
+
+void OperationJournal::RecordAddShape(const std::string& entry, const std::string& name, const TopoDS_Shape& shape) {
+    Operation operation;
+    operation.type = kAddShape;
+    operation.entry = entry;
+    operation.name = name;
+    operation.shape = shape;
+    Record(operation);
+}
+
+void OperationJournal::RecordRemoveShape(const std::string& entry) {
+    Operation operation;
+    operation.type = kRemoveShape;
+    operation.entry = entry;
+    Record(operation);
+}
+
+void OperationJournal::RecordSetName(const std::string& entry, const std::string& name) {
+    Operation operation;
+    operation.type = kSetName;
+    operation.entry = entry;
+    operation.name = name;
+    Record(operation);
+}
+
+void OperationJournal::RecordUndo() {
+    Item item;
+    item.kind = kUndo;
+    Enqueue(std::move(item));
+}
+
+void OperationJournal::RecordRedo() {
+    Item item;
+    item.kind = kRedo;
+    Enqueue(std::move(item));
+}
+
+void OperationJournal::Record(const Operation& operation) {
+    if (m_inTransaction) {
+        m_pending.push_back(operation);
+        return;
+    }
+    // 事务之外的修改单独成一条，重放时不开事务
+    Item item;
+    item.kind = kTransaction;
+    item.operations.push_back(operation);
+    Enqueue(std::move(item));
+}
+
+void OperationJournal::Enqueue(Item&& item) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_writer.joinable()) {
+        return;
+    }
+    m_queue.push_back(std::move(item));
+    ++m_enqueuedCount;
+    m_wake.notify_one();
+}
+
+void OperationJournal::StartWriter() {
+    m_stop = false;
+    m_writer = std::thread(&OperationJournal::WriterLoop, this);
+}
+
+void OperationJournal::StopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_wake.notify_one();
+    }
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    m_written.notify_all();
+}
+
+void OperationJournal::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            break;
+        }
+        // 稍等片刻，把紧接着的提交合进同一批
+        if (!m_stop) {
+            m_wake.wait_for(lock, kBatchWindow, [this]() { return m_stop; });
+        }
+        std::vector<Item> batch;
+        batch.swap(m_queue);
+        lock.unlock();
+
+        WriteBatch(batch);
+
+        lock.lock();
+        m_writtenCount += batch.size();
+        m_written.notify_all();
+    }
+}
+
+void OperationJournal::WriteBatch(std::vector<Item>& batch) {
+    RegenerationProfiler::ScopedCall call("OperationJournal::WriteBatch");
+
+    // 这一批里的几何并行编码
+    std::vector<const Operation*> shaped;
+    for (const Item& item : batch) {
+        for (const Operation& operation : item.operations) {
+            if (operation.type == kAddShape && !operation.shape.IsNull()) {
+                shaped.push_back(&operation);
+            }
+        }
+    }
+    std::vector<std::string> blobs(shaped.size());
+    TaskScheduler::Instance().ParallelFor(0, static_cast<int>(shaped.size()), [&shaped, &blobs](int i) {
+        try {
+            blobs[i] = NativeDocumentFile::EncodeShape(shaped[i]->shape);
+        } catch (const Standard_Failure&) {
+            blobs[i].clear();
+        }
+    }, TaskPriority::Background);
+
+    size_t blobIndex = 0;
+    std::string payload;
+    std::string buffer;
+    for (Item& item : batch) {
+        payload.clear();
+        ByteWriter writer(payload);
+        switch (item.kind) {
+            case kTransaction:
+                writer.Put<std::uint8_t>(kRecordTransaction);
+                writer.PutString(item.name);
+                writer.Put<std::uint32_t>(static_cast<std::uint32_t>(item.operations.size()));
+                for (const Operation& operation : item.operations) {
+                    writer.Put<std::uint8_t>(operation.type);
+                    writer.PutString(operation.entry);
+                    writer.PutString(operation.name);
+                    if (operation.type == kAddShape && !operation.shape.IsNull()) {
+                        const std::string& blob = blobs[blobIndex++];
+                        writer.Put<std::uint64_t>(blob.size());
+                        payload.append(blob);
+                    } else {
+                        writer.Put<std::uint64_t>(0);
+                    }
+                }
+                break;
+            case kUndo:
+                writer.Put<std::uint8_t>(kRecordUndo);
+                break;
+            case kRedo:
+                writer.Put<std::uint8_t>(kRecordRedo);
+                break;
+            case kRotate:
+                // 切换前把当前段写完并落盘
+                if (m_file && !buffer.empty()) {
+                    std::fwrite(buffer.data(), 1, buffer.size(), m_file);
+                    buffer.clear();
+                }
+                CloseSegment();
+                OpenSegment(item.segment, item.baseFile, item.entries, false);
+                continue;
+            case kDiscard:
+                for (int segment : ListSegments(m_path)) {
+                    if (segment < item.segment) {
+                        std::remove(SegmentPath(m_path, segment).c_str());
+                    }
+                }
+                continue;
+        }
+
+        ByteWriter framing(buffer);
+        framing.Put<std::uint32_t>(static_cast<std::uint32_t>(payload.size()));
+        framing.Put<std::uint32_t>(Checksum(payload.data(), payload.size()));
+        buffer.append(payload);
+        item.operations.clear();   // 尽早释放形状句柄
+    }
+
+    if (m_file) {
+        if (!buffer.empty()) {
+            std::fwrite(buffer.data(), 1, buffer.size(), m_file);
+        }
+        SyncFile(m_file);
+    }
+}
+
+bool OperationJournal::OpenSegment(int segment, const std::string& baseFile,
+                                   const std::vector<std::string>& entries, bool resumed) {
+    m_file = std::fopen(SegmentPath(m_path, segment).c_str(), "wb");
+    if (!m_file) {
+        return false;
+    }
+
+    std::string header(kMagic, sizeof(kMagic));
+    ByteWriter writer(header);
+    writer.Put<std::uint32_t>(kVersion);
+    writer.Put<std::uint32_t>(resumed ? kSegmentResumed : 0);
+    writer.PutString(baseFile);
+    writer.Put<std::uint32_t>(static_cast<std::uint32_t>(entries.size()));
+    for (const std::string& entry : entries) {
+        writer.PutString(entry);
+    }
+    std::fwrite(header.data(), 1, header.size(), m_file);
+    SyncFile(m_file);
+    return true;
+}
+
+void OperationJournal::CloseSegment() {
+    if (m_file) {
+        SyncFile(m_file);
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+std::string OperationJournal::SegmentPath(const std::string& path, int segment) {
+    return path + "." + std::to_string(segment);
+}
+
+std::vector<int> OperationJournal::ListSegments(const std::string& path) {
+    std::vector<int> segments;
+    std::error_code error;
+    std::filesystem::path journal(path);
+    std::filesystem::path directory = journal.has_parent_path() ? journal.parent_path() : std::filesystem::path(".");
+    const std::string prefix = journal.filename().string() + ".";
+
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        const std::string number = name.substr(prefix.size());
+        if (number.size() > 9 || !std::all_of(number.begin(), number.end(),
+                                              [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            continue;
+        }
+        segments.push_back(std::stoi(number));
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool OperationJournal::HasRecoveryData(const std::string& path) {
+    // 只有文件头的段没有可恢复的内容
+    for (int segment : ListSegments(path)) {
+        MappedFile file(SegmentPath(path, segment));
+        SegmentHeader header;
+        std::vector<ReplayRecord> records;
+        if (ReadSegment(file, header, records) && !records.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OperationJournal::Replay(const std::string& path, OCAFDocument& document, bool lazy,
+                              ReplayStats& stats, std::string& error) {
+    RegenerationProfiler::ScopedCall call("OperationJournal::Replay");
+    stats = ReplayStats();
+
+    // 读出所有段；几何留在映射里，解码时才用
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<ReplayRecord> records;
+    SegmentHeader base;
+    bool first = true;
+    for (int segment : ListSegments(path)) {
+        std::unique_ptr<MappedFile> file(new MappedFile(SegmentPath(path, segment)));
+        SegmentHeader header;
+        if (!ReadSegment(*file, header, records)) {
+            continue;
+        }
+        if (first) {
+            base = header;
+            first = false;
+        }
+        files.push_back(std::move(file));
+    }
+    if (first) {
+        error = "No journal found";
+        return false;
+    }
+
+    // 起点：最早一段记录的文件（没有时从空文档开始）
+    bool opened = base.baseFile.empty() ? document.NewDocument() : document.OpenDocument(base.baseFile, lazy);
+    if (!opened) {
+        error = "Cannot open " + base.baseFile;
+        return false;
+    }
+
+    // 日志里的标签条目 -> 重建文档中的标签。原生格式按零件顺序重新建标签，
+    // 条目可能和记录时不同，用段头的列表对应；新加的形状记下各自的标签；
+    // 其余条目（OCAF格式的起点）原样使用
+    std::map<std::string, TDF_Label> labels;
+    if (NativeDocumentFile::IsNativeFile(base.baseFile)) {
+        for (size_t i = 0; i < base.entries.size(); ++i) {
+            labels[base.entries[i]] = document.GetShapesLabel().FindChild(static_cast<int>(i) + 1, Standard_False);
+        }
+    }
+    auto resolve = [&document, &labels](const std::string& entry) {
+        auto it = labels.find(entry);
+        return it != labels.end() ? it->second : document.FindLabel(entry);
+    };
+
+    size_t next = 0;
+    while (next < records.size()) {
+        // 一批：几何数据累计到上限为止，批内并行解码
+        size_t end = next;
+        size_t bytes = 0;
+        std::vector<const ReplayOperation*> shaped;
+        while (end < records.size() && (bytes < kReplayBatchBytes || end == next)) {
+            for (const ReplayOperation& operation : records[end].operations) {
+                if (operation.type == kAddShape && operation.blob) {
+                    shaped.push_back(&operation);
+                    bytes += operation.blobBytes;
+                }
+            }
+            ++end;
+        }
+        std::vector<TopoDS_Shape> shapes(shaped.size());
+        TaskScheduler::Instance().ParallelFor(0, static_cast<int>(shaped.size()), [&shaped, &shapes](int i) {
+            shapes[i] = NativeDocumentFile::DecodeShape(shaped[i]->blob, shaped[i]->blobBytes);
+        }, TaskPriority::Background);
+
+        // 按原顺序应用
+        size_t shapeIndex = 0;
+        for (; next < end; ++next) {
+            const ReplayRecord& record = records[next];
+            if (record.resumed) {
+                // 续写段记录的已经是重建后的条目
+                labels.clear();
+            }
+            if (record.type == kRecordUndo) {
+                document.Undo();
+                ++stats.undos;
+                continue;
+            }
+            if (record.type == kRecordRedo) {
+                document.Redo();
+                continue;
+            }
+
+            const bool transaction = !record.name.empty();
+            if (transaction) {
+                document.StartTransaction(record.name);
+            }
+            for (const ReplayOperation& operation : record.operations) {
+                if (operation.type == kAddShape) {
+                    if (!operation.blob) {
+                        continue;
+                    }
+                    const TopoDS_Shape& shape = shapes[shapeIndex++];
+                    if (shape.IsNull()) {
+                        continue;
+                    }
+                    labels[operation.entry] = document.AddShape(std::make_shared<Shape>(shape), operation.name);
+                    ++stats.shapes;
+                } else if (operation.type == kRemoveShape) {
+                    TDF_Label label = resolve(operation.entry);
+                    if (!label.IsNull()) {
+                        document.RemoveShape(label);
+                    }
+                } else if (operation.type == kSetName) {
+                    TDF_Label label = resolve(operation.entry);
+                    if (!label.IsNull()) {
+                        document.SetName(label, operation.name);
+                    }
+                }
+            }
+            if (transaction) {
+                document.CommitTransaction();
+            }
+            ++stats.transactions;
+        }
+    }
+    return true;
+}
+
+} // namespace cad_core
@@ -0,0 +1,259 @@
+#include "cad_core/RegenerationProfiler.h"
+#include <OSD_MemInfo.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <fstream>
+
+namespace cad_core {
+
+namespace {
+
+// 当前线程正在重建的特征（支持嵌套，比如阵列里再触发布尔）
+thread_local RegenerationProfiler::ScopedFeature* t_currentFeature = nullptr;
+
+std::string EscapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    escaped += ' ';
+                } else {
+                    escaped += c;
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+RegenerationProfiler& RegenerationProfiler::Instance() {
+    static RegenerationProfiler instance;
+    return instance;
+}
+
+RegenerationProfiler::RegenerationProfiler()
+    : m_epoch(std::chrono::steady_clock::now()), m_enabled(true) {
+}
+
+void RegenerationProfiler::SetEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+bool RegenerationProfiler::IsEnabled() const {
+    return m_enabled;
+}
+
+// ========== ScopedFeature ==========
+
+RegenerationProfiler::ScopedFeature::ScopedFeature(int featureId, const std::string& featureName)
+    : m_startMemory(0), m_previous(nullptr), m_active(RegenerationProfiler::Instance().IsEnabled()),
+      m_cacheHits(0), m_cacheMisses(0) {
+    if (!m_active) {
+        return;
+    }
+
+    m_record.featureId = featureId;
+    m_record.featureName = featureName;
+    m_record.category = "feature";
+    m_record.threadId = CurrentThreadId();
+    m_startMemory = CurrentMemoryUsage();
+    m_start = std::chrono::steady_clock::now();
+
+    m_previous = t_currentFeature;
+    t_currentFeature = this;
+}
+
+RegenerationProfiler::ScopedFeature::~ScopedFeature() {
+    if (!m_active) {
+        return;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    RegenerationProfiler& profiler = RegenerationProfiler::Instance();
+    m_record.startUs = profiler.ToMicroseconds(m_start);
+    m_record.durationUs = std::chrono::duration<double, std::micro>(end - m_start).count();
+    m_record.memoryDeltaBytes = CurrentMemoryUsage() - m_startMemory;
+    m_record.cacheHits = m_cacheHits.load();
+    m_record.cacheMisses = m_cacheMisses.load();
+
+    t_currentFeature = m_previous;
+    profiler.AddRecord(m_record);
+}
+
+void RegenerationProfiler::ScopedFeature::SetFacesIn(int faces) {
+    m_record.facesIn = faces;
+}
+
+void RegenerationProfiler::ScopedFeature::SetResult(const TopoDS_Shape& shape, bool succeeded) {
+    if (!m_active) {
+        return;
+    }
+    m_record.facesOut = CountFaces(shape);
+    m_record.succeeded = succeeded;
+}
+
+// ========== ScopedCall ==========
+
+RegenerationProfiler::ScopedCall::ScopedCall(const char* name)
+    : m_name(name), m_active(RegenerationProfiler::Instance().IsEnabled()), m_zone(name, "occt") {
+    if (m_active) {
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+RegenerationProfiler::ScopedCall::~ScopedCall() {
+    if (!m_active) {
+        return;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    RegenerationProfiler& profiler = RegenerationProfiler::Instance();
+
+    RegenerationRecord record;
+    record.featureId = t_currentFeature ? t_currentFeature->GetRecord().featureId : -1;
+    record.featureName = m_name;
+    record.category = "occt";
+    record.startUs = profiler.ToMicroseconds(m_start);
+    record.durationUs = std::chrono::duration<double, std::micro>(end - m_start).count();
+    record.threadId = CurrentThreadId();
+    record.succeeded = true;
+    profiler.AddRecord(record);
+}
+
+// ========== 统计 ==========
+
+void RegenerationProfiler::RecordCacheHit() {
+    if (t_currentFeature && t_currentFeature->m_active) {
+        t_currentFeature->m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RegenerationProfiler::RecordCacheMiss() {
+    if (t_currentFeature && t_currentFeature->m_active) {
+        t_currentFeature->m_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RegenerationProfiler::ScopedFeature* RegenerationProfiler::CurrentFeature() {
+    return t_currentFeature;
+}
+
+RegenerationProfiler::AdoptFeature::AdoptFeature(ScopedFeature* feature) : m_previous(t_currentFeature) {
+    t_currentFeature = feature;
+}
+
+RegenerationProfiler::AdoptFeature::~AdoptFeature() {
+    t_currentFeature = m_previous;
+}
+
+int RegenerationProfiler::CountFaces(const TopoDS_Shape& shape) {
+    if (shape.IsNull()) {
+        return 0;
+    }
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(shape, TopAbs_FACE, faces);
+    return faces.Extent();
+}
+
+std::vector<RegenerationRecord> RegenerationProfiler::GetRecords() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records;
+}
+
+bool RegenerationProfiler::GetLastFeatureRecord(int featureId, RegenerationRecord& record) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_records.rbegin(); it != m_records.rend(); ++it) {
+        if (it->featureId == featureId && it->category == "feature") {
+            record = *it;
+            return true;
+        }
+    }
+    return false;
+}
+
+void RegenerationProfiler::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+}
+
+bool RegenerationProfiler::ExportChromeTrace(const std::string& filename) const {
+    std::vector<RegenerationRecord> records = GetRecords();
+
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Chrome trace "complete" events（ph = X），时间单位微秒，保留到纳秒；
+    // 默认的6位有效数字在运行几秒后就把ts截成整毫秒
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto& r = records[i];
+        file << "{\"name\":\"" << EscapeJson(r.featureName) << "\","
+             << "\"cat\":\"" << r.category << "\","
+             << "\"ph\":\"X\","
+             << "\"ts\":" << r.startUs << ","
+             << "\"dur\":" << r.durationUs << ","
+             << "\"pid\":1,"
+             << "\"tid\":" << r.threadId << ","
+             << "\"args\":{"
+             << "\"feature_id\":" << r.featureId << ","
+             << "\"memory_delta_bytes\":" << r.memoryDeltaBytes << ","
+             << "\"faces_in\":" << r.facesIn << ","
+             << "\"faces_out\":" << r.facesOut << ","
+             << "\"cache_hits\":" << r.cacheHits << ","
+             << "\"cache_misses\":" << r.cacheMisses << ","
+             << "\"succeeded\":" << (r.succeeded ? "true" : "false")
+             << "}}";
+        file << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.good();
+}
+
+void RegenerationProfiler::AddRecord(const RegenerationRecord& record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_records.size() >= kMaxRecords) {
+        m_records.erase(m_records.begin(), m_records.begin() + kMaxRecords / 10);
+    }
+    m_records.push_back(record);
+}
+
+double RegenerationProfiler::ToMicroseconds(std::chrono::steady_clock::time_point time) const {
+    return std::chrono::duration<double, std::micro>(time - m_epoch).count();
+}
+
+long long RegenerationProfiler::CurrentMemoryUsage() {
+    // 只刷新需要的计数器，完整统计在Windows上很慢
+    OSD_MemInfo memInfo(Standard_False);
+    memInfo.SetActive(Standard_False);
+    memInfo.SetActive(OSD_MemInfo::MemPrivate, Standard_True);
+    memInfo.SetActive(OSD_MemInfo::MemWorkingSet, Standard_True);
+    memInfo.Update();
+
+    Standard_Size value = memInfo.Value(OSD_MemInfo::MemPrivate);
+    if (value == Standard_Size(-1)) {
+        value = memInfo.Value(OSD_MemInfo::MemWorkingSet);
+    }
+    return value == Standard_Size(-1) ? 0 : static_cast<long long>(value);
+}
+
+std::uint64_t RegenerationProfiler::CurrentThreadId() {
+    // 小的顺序编号比std::thread::id的哈希好读，trace里也不会丢精度
+    static std::atomic<std::uint64_t> s_nextThreadId(1);
+    thread_local std::uint64_t t_threadId = s_nextThreadId++;
+    return t_threadId;
+}
+
+} // namespace cad_core
@@ -0,0 +1,307 @@
+#include "cad_core/StepImporter.h"
+#include "cad_core/Logger.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include "cad_core/TranslatorSetup.h"
+#include <BRepBndLib.hxx>
+#include <IFSelect_ReturnStatus.hxx>
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+#include <STEPCAFControl_Reader.hxx>
+#include <ShapeFix_Shape.hxx>
+#include <Standard_Failure.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDataStd_Name.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+
+namespace cad_core {
+
+namespace {
+
+// 把OCCT的进度和取消请求转接到StepImporter
+class ImportProgress : public Message_ProgressIndicator {
+public:
+    ImportProgress(StepImporter* importer, int offset, int span)
+        : m_importer(importer), m_offset(offset), m_span(span) {}
+
+    Standard_Boolean UserBreak() override {
+        return m_importer->IsCancelled();
+    }
+
+protected:
+    void Show(const Message_ProgressScope& scope, const Standard_Boolean isForce) override {
+        (void)isForce;
+        const char* name = scope.Name();
+        m_importer->ReportProgress(m_offset + static_cast<int>(GetPosition() * m_span),
+                                   name ? name : "Translating");
+    }
+
+private:
+    StepImporter* m_importer;
+    int m_offset;
+    int m_span;
+};
+
+std::string LabelName(const TDF_Label& label) {
+    Handle(TDataStd_Name) name;
+    if (!label.IsNull() && label.FindAttribute(TDataStd_Name::GetID(), name)) {
+        TCollection_AsciiString ascii(name->Get());
+        return ascii.ToCString();
+    }
+    return std::string();
+}
+
+bool LabelColor(const Handle(XCAFDoc_ColorTool)& colorTool, const TDF_Label& label, Quantity_Color& color) {
+    if (colorTool.IsNull() || label.IsNull()) {
+        return false;
+    }
+    return colorTool->GetColor(label, XCAFDoc_ColorSurf, color)
+        || colorTool->GetColor(label, XCAFDoc_ColorGen, color);
+}
+
+} // namespace
+
+StepImporter::StepImporter() : m_cancelled(false), m_lastPercent(-1) {
+}
+
+StepImporter::~StepImporter() = default;
+
+void StepImporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+void StepImporter::SetPartCallback(PartCallback callback) {
+    m_partCallback = std::move(callback);
+}
+
+void StepImporter::SetPartHealedCallback(PartCallback callback) {
+    m_partHealedCallback = std::move(callback);
+}
+
+bool StepImporter::Import(const std::string& filename, OCAFDocument& document) {
+    m_parts.clear();
+    m_prototypes.clear();
+    m_prototypeIndex.Clear();
+    m_lastError.clear();
+    m_lastPercent = -1;
+
+    Handle(TDocStd_Document) doc = document.GetDocument();
+    if (doc.IsNull()) {
+        m_lastError = "No document";
+        return false;
+    }
+
+    try {
+        InitializeTranslators();
+
+        // 翻译时不做ShapeFix：指向一个不存在的处理序列，ShapeProcess直接跳过，
+        // 修复统一放到HealParts()里并行做。参数是全局的，持有期间其他翻译排队等待
+        ScopedTranslatorParameter skipHealing("read.step.sequence", "NoHealing");
+
+        ReportProgress(0, "Reading file");
+        STEPCAFControl_Reader reader;
+        reader.SetNameMode(Standard_True);
+        reader.SetColorMode(Standard_True);
+        reader.SetLayerMode(Standard_True);
+
+        IFSelect_ReturnStatus status;
+        {
+            RegenerationProfiler::ScopedCall call("STEPCAFControl_Reader::ReadFile");
+            status = reader.ReadFile(filename.c_str());
+        }
+        if (status != IFSelect_RetDone) {
+            m_lastError = "Failed to read STEP file";
+            return false;
+        }
+        if (IsCancelled()) {
+            return false;
+        }
+
+        // OCCT把所有根节点翻译进同一个文档时只能串行，这里只负责转发进度和取消
+        ReportProgress(30, "Translating");
+        Handle(ImportProgress) indicator = new ImportProgress(this, 30, 60);
+        Standard_Boolean transferred;
+        {
+            RegenerationProfiler::ScopedCall call("STEPCAFControl_Reader::Transfer");
+            transferred = reader.Transfer(doc, indicator->Start());
+        }
+        if (IsCancelled()) {
+            return false;
+        }
+        if (!transferred) {
+            m_lastError = "Failed to translate STEP file";
+            return false;
+        }
+
+        // 遍历产品结构，逐个交出零件实例
+        ReportProgress(90, "Collecting parts");
+        Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(doc->Main());
+        Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(doc->Main());
+
+        TDF_LabelSequence roots;
+        shapeTool->GetFreeShapes(roots);
+        for (int i = 1; i <= roots.Length() && !IsCancelled(); ++i) {
+            CollectParts(shapeTool, colorTool, roots.Value(i), TopLoc_Location(), std::string());
+        }
+        if (IsCancelled()) {
+            return false;
+        }
+
+        ReportProgress(100, "Done");
+        CAD_LOG_INFO("step", "Imported " << m_parts.size() << " parts ("
+                     << m_prototypes.size() << " unique) from " << filename);
+        return true;
+    } catch (const Standard_Failure& e) {
+        m_lastError = e.GetMessageString() ? e.GetMessageString() : "STEP import failed";
+        return false;
+    }
+}
+
+void StepImporter::CollectParts(const Handle(XCAFDoc_ShapeTool)& shapeTool,
+                                const Handle(XCAFDoc_ColorTool)& colorTool,
+                                const TDF_Label& label, const TopLoc_Location& location,
+                                const std::string& parentName) {
+    if (IsCancelled()) {
+        return;
+    }
+
+    if (XCAFDoc_ShapeTool::IsAssembly(label)) {
+        std::string assemblyName = LabelName(label);
+        TDF_LabelSequence components;
+        XCAFDoc_ShapeTool::GetComponents(label, components);
+        for (int i = 1; i <= components.Length(); ++i) {
+            TDF_Label component = components.Value(i);
+            TDF_Label referred;
+            if (!XCAFDoc_ShapeTool::GetReferredShape(component, referred)) {
+                continue;
+            }
+            TopLoc_Location componentLocation = location * XCAFDoc_ShapeTool::GetLocation(component);
+            std::string componentName = LabelName(component);
+            CollectParts(shapeTool, colorTool, referred, componentLocation,
+                         componentName.empty() ? assemblyName : componentName);
+        }
+        return;
+    }
+
+    TopoDS_Shape shape = XCAFDoc_ShapeTool::GetShape(label);
+    if (shape.IsNull()) {
+        return;
+    }
+
+    Part part;
+    part.label = label;
+    part.prototype = FindOrAddPrototype(label, shape);
+    part.location = location;
+    part.shape = std::make_shared<Shape>(shape.Moved(location));
+    part.box = m_prototypes[part.prototype].box.Transformed(location.Transformation());
+
+    std::string name = LabelName(label);
+    if (name.empty()) {
+        name = parentName;
+    }
+    part.name = name.empty() ? "Part" : name;
+    part.hasColor = LabelColor(colorTool, label, part.color);
+
+    int index = static_cast<int>(m_parts.size());
+    m_prototypes[part.prototype].instances.push_back(index);
+    m_parts.push_back(part);
+
+    if (m_partCallback) {
+        m_partCallback(index, m_parts.back());
+    }
+}
+
+int StepImporter::FindOrAddPrototype(const TDF_Label& label, const TopoDS_Shape& shape) {
+    if (m_prototypeIndex.IsBound(label)) {
+        return m_prototypeIndex.Find(label);
+    }
+    Prototype prototype;
+    prototype.label = label;
+    prototype.shape = shape;
+    // 包围盒每个原型只算一次，实例按位置变换
+    BRepBndLib::Add(shape, prototype.box);
+    m_prototypes.push_back(prototype);
+    int index = static_cast<int>(m_prototypes.size()) - 1;
+    m_prototypeIndex.Bind(label, index);
+    return index;
+}
+
+bool StepImporter::HealParts() {
+    if (m_prototypes.empty()) {
+        return false;
+    }
+
+    // 按原型修复：同一个零件的多个实例共享TShape，不能在不同线程里同时修
+    const int count = static_cast<int>(m_prototypes.size());
+    std::atomic<int> finished(0);
+    ReportProgress(0, "Healing");
+
+    RegenerationProfiler::ScopedCall call("ShapeFix_Shape");
+    TaskScheduler::Instance().ParallelFor(0, count, [this, &finished, count](int index) {
+        if (IsCancelled()) {
+            return;
+        }
+
+        Prototype& prototype = m_prototypes[index];
+        try {
+            Handle(ShapeFix_Shape) fixer = new ShapeFix_Shape(prototype.shape);
+            fixer->Perform();
+            prototype.healed = fixer->Shape();
+        } catch (const Standard_Failure&) {
+            prototype.healed.Nullify();
+        }
+
+        int done = ++finished;
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        if (!prototype.healed.IsNull() && m_partHealedCallback) {
+            for (int partIndex : prototype.instances) {
+                Part healedPart = m_parts[partIndex];
+                healedPart.shape = std::make_shared<Shape>(prototype.healed.Moved(healedPart.location));
+                m_partHealedCallback(partIndex, healedPart);
+            }
+        }
+        ReportProgress(done * 100 / count, "Healing");
+    }, TaskPriority::Normal);
+
+    return !IsCancelled();
+}
+
+void StepImporter::ApplyHealedShapes(OCAFDocument& document) {
+    Handle(XCAFDoc_ShapeTool) shapeTool = document.GetShapeTool();
+    if (shapeTool.IsNull()) {
+        return;
+    }
+
+    for (const auto& prototype : m_prototypes) {
+        if (prototype.healed.IsNull() || prototype.healed.IsSame(prototype.shape)) {
+            continue;
+        }
+        try {
+            shapeTool->SetShape(prototype.label, prototype.healed);
+        } catch (const Standard_Failure&) {
+            // 写不回去就保留未修复的形状
+        }
+    }
+}
+
+void StepImporter::Cancel() {
+    m_cancelled = true;
+}
+
+bool StepImporter::IsCancelled() const {
+    return m_cancelled;
+}
+
+void StepImporter::ReportProgress(int percent, const std::string& stage) {
+    if (!m_progressCallback) {
+        return;
+    }
+    // 进度只在整数百分比变化时上报，避免刷屏
+    if (percent == m_lastPercent && percent != 0) {
+        return;
+    }
+    m_lastPercent = percent;
+    m_progressCallback(percent, stage);
+}
+
+} // namespace cad_core
@@ -0,0 +1,271 @@
+#include "cad_core/StlExporter.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Tool.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <gp.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace cad_core {
+
+namespace {
+
+const size_t kBinaryHeaderBytes = 80;
+const size_t kBinaryFacetBytes = 50;      // 法向 + 3个顶点（12个float）+ 2字节属性
+const size_t kAsciiFacetBytesEstimate = 260;
+
+inline void PutFloat(char*& out, double value) {
+    float f = static_cast<float>(value);
+    std::memcpy(out, &f, sizeof(float));
+    out += sizeof(float);
+}
+
+} // namespace
+
+StlExporter::StlExporter(const StlExportOptions& options)
+    : m_options(options), m_triangleCount(0) {
+}
+
+void StlExporter::SetProgressCallback(ProgressCallback callback) {
+    m_progressCallback = std::move(callback);
+}
+
+bool StlExporter::Export(const std::vector<ExportPart>& parts, const std::string& filename) {
+    std::vector<ShapePtr> shapes;
+    shapes.reserve(parts.size());
+    for (const auto& part : parts) {
+        shapes.push_back(part.shape);
+    }
+    return Export(shapes, filename);
+}
+
+bool StlExporter::Export(const std::vector<ShapePtr>& shapes, const std::string& filename) {
+    m_faces.clear();
+    m_chunks.clear();
+    m_triangleCount = 0;
+    m_lastError.clear();
+
+    if (shapes.empty()) {
+        m_lastError = "Nothing to export";
+        return false;
+    }
+
+    ReportProgress(0);
+    std::vector<TopoDS_Shape> meshed;
+    if (!Tessellate(shapes, meshed)) {
+        return false;
+    }
+
+    CollectFaces(meshed);
+    BuildChunks();
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        m_lastError = "Cannot open " + filename + " for writing";
+        return false;
+    }
+
+    RegenerationProfiler::ScopedCall call("StlExporter::Write");
+
+    if (m_options.ascii) {
+        file << "solid AnderCAD\n";
+    } else {
+        // 文件头80字节 + 三角形个数（uint32，小端）
+        char header[kBinaryHeaderBytes];
+        std::memset(header, 0, sizeof(header));
+        std::snprintf(header, sizeof(header), "AnderCAD binary STL");
+        file.write(header, sizeof(header));
+
+        std::uint32_t count = static_cast<std::uint32_t>(std::min<size_t>(m_triangleCount, UINT32_MAX));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    // 一批块并行编码，然后按顺序写出；下一批复用同样的缓冲区
+    const size_t batchSize = std::max(1, (TaskScheduler::Instance().GetWorkerCount() + 1) * 2);
+    std::vector<std::string> buffers(batchSize);
+
+    for (size_t first = 0; first < m_chunks.size(); first += batchSize) {
+        const size_t count = std::min(batchSize, m_chunks.size() - first);
+        TaskScheduler::Instance().ParallelFor(0, static_cast<int>(count), [this, first, &buffers](int index) {
+            EncodeChunk(m_chunks[first + index], buffers[index]);
+        }, TaskPriority::Background);
+
+        for (size_t i = 0; i < count; ++i) {
+            file.write(buffers[i].data(), static_cast<std::streamsize>(buffers[i].size()));
+        }
+        if (!file) {
+            m_lastError = "Failed to write " + filename;
+            return false;
+        }
+
+        ReportProgress(50 + static_cast<int>(50 * (first + count) / m_chunks.size()));
+    }
+
+    if (m_options.ascii) {
+        file << "endsolid AnderCAD\n";
+    }
+    file.close();
+    if (!file) {
+        m_lastError = "Failed to write " + filename;
+        return false;
+    }
+
+    ReportProgress(100);
+    return true;
+}
+
+bool StlExporter::Tessellate(const std::vector<ShapePtr>& shapes, std::vector<TopoDS_Shape>& meshed) {
+    IMeshTools_Parameters parameters;
+    parameters.Deflection = m_options.linearDeflection;
+    parameters.Angle = m_options.angularDeflection;
+    parameters.InParallel = TaskScheduler::Instance().ShouldKernelRunParallel();
+
+    // 文档里的形状同时被视图和自动保存使用，不能在工作线程里改它们的三角网格：
+    // 复制拓扑（几何共享）后在副本上网格化。逐个形状处理，面级并行交给BRepMesh
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (!shapes[i] || shapes[i]->GetOCCTShape().IsNull()) {
+            continue;
+        }
+        const TopoDS_Shape& shape = shapes[i]->GetOCCTShape();
+        if (MeshImporter::IsMeshShape(shape)) {
+            // 导入的网格只有三角形，没有可重新网格化的曲面，直接读
+            meshed.push_back(shape);
+            continue;
+        }
+        try {
+            BRepBuilderAPI_Copy copier(shape, Standard_False, Standard_False);
+            meshed.push_back(copier.Shape());
+            RegenerationProfiler::ScopedCall call("BRepMesh_IncrementalMesh");
+            BRepMesh_IncrementalMesh mesher(meshed.back(), parameters);
+        } catch (const Standard_Failure& e) {
+            m_lastError = e.GetMessageString() ? e.GetMessageString() : "Tessellation failed";
+            return false;
+        }
+        ReportProgress(static_cast<int>(50 * (i + 1) / shapes.size()));
+    }
+    return true;
+}
+
+void StlExporter::CollectFaces(const std::vector<TopoDS_Shape>& shapes) {
+    for (const TopoDS_Shape& shape : shapes) {
+        for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next()) {
+            const TopoDS_Face& face = TopoDS::Face(exp.Current());
+            TopLoc_Location location;
+            Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+            if (triangulation.IsNull() || triangulation->NbTriangles() == 0) {
+                continue;
+            }
+
+            FaceRange range;
+            range.face = face;
+            range.triangles = static_cast<size_t>(triangulation->NbTriangles());
+            m_faces.push_back(range);
+            m_triangleCount += range.triangles;
+        }
+    }
+}
+
+void StlExporter::BuildChunks() {
+    Chunk chunk;
+    for (size_t i = 0; i < m_faces.size(); ++i) {
+        chunk.triangles += m_faces[i].triangles;
+        chunk.lastFace = i + 1;
+        if (chunk.triangles >= kChunkTriangles) {
+            m_chunks.push_back(chunk);
+            chunk = Chunk();
+            chunk.firstFace = i + 1;
+            chunk.lastFace = i + 1;
+        }
+    }
+    if (chunk.triangles > 0) {
+        m_chunks.push_back(chunk);
+    }
+}
+
+void StlExporter::EncodeChunk(const Chunk& chunk, std::string& buffer) const {
+    buffer.clear();
+    if (m_options.ascii) {
+        buffer.reserve(chunk.triangles * kAsciiFacetBytesEstimate);
+    } else {
+        buffer.resize(chunk.triangles * kBinaryFacetBytes);
+    }
+    char* out = m_options.ascii ? nullptr : &buffer[0];
+    char line[512];
+
+    for (size_t f = chunk.firstFace; f < chunk.lastFace; ++f) {
+        const TopoDS_Face& face = m_faces[f].face;
+        TopLoc_Location location;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) {
+            continue;
+        }
+
+        const bool transform = !location.IsIdentity();
+        const gp_Trsf trsf = location.Transformation();
+        const bool reversed = (face.Orientation() == TopAbs_REVERSED);
+
+        for (int t = 1; t <= triangulation->NbTriangles(); ++t) {
+            int n1, n2, n3;
+            triangulation->Triangle(t).Get(n1, n2, n3);
+            if (reversed) {
+                std::swap(n2, n3);
+            }
+
+            gp_Pnt p1 = triangulation->Node(n1);
+            gp_Pnt p2 = triangulation->Node(n2);
+            gp_Pnt p3 = triangulation->Node(n3);
+            if (transform) {
+                p1.Transform(trsf);
+                p2.Transform(trsf);
+                p3.Transform(trsf);
+            }
+
+            gp_Vec normal = gp_Vec(p1, p2).Crossed(gp_Vec(p1, p3));
+            double magnitude = normal.Magnitude();
+            if (magnitude > gp::Resolution()) {
+                normal.Divide(magnitude);
+            } else {
+                normal = gp_Vec(0.0, 0.0, 0.0);
+            }
+
+            if (m_options.ascii) {
+                int length = std::snprintf(line, sizeof(line),
+                    " facet normal %e %e %e\n  outer loop\n"
+                    "   vertex %e %e %e\n   vertex %e %e %e\n   vertex %e %e %e\n"
+                    "  endloop\n endfacet\n",
+                    normal.X(), normal.Y(), normal.Z(),
+                    p1.X(), p1.Y(), p1.Z(), p2.X(), p2.Y(), p2.Z(), p3.X(), p3.Y(), p3.Z());
+                buffer.append(line, static_cast<size_t>(std::max(0, length)));
+            } else {
+                PutFloat(out, normal.X()); PutFloat(out, normal.Y()); PutFloat(out, normal.Z());
+                PutFloat(out, p1.X()); PutFloat(out, p1.Y()); PutFloat(out, p1.Z());
+                PutFloat(out, p2.X()); PutFloat(out, p2.Y()); PutFloat(out, p2.Z());
+                PutFloat(out, p3.X()); PutFloat(out, p3.Y()); PutFloat(out, p3.Z());
+                *out++ = 0;
+                *out++ = 0;
+            }
+        }
+    }
+}
+
+void StlExporter::ReportProgress(int percent) {
+    if (m_progressCallback) {
+        m_progressCallback(percent);
+    }
+}
+
+} // namespace cad_core
@@ -0,0 +1,346 @@
+#include "cad_core/TaskScheduler.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/Tracer.h"
+#include <OSD_ThreadPool.hxx>
+#include <algorithm>
+
+namespace cad_core {
+
+namespace {
+
+// 工作线程的编号；其他线程为-1
+thread_local int t_workerIndex = -1;
+
+// 硬件线程数，至少按2个算（保证有一个工作线程）
+int HardwareThreads() {
+    return std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+} // namespace
+
+// ========== TaskGroup ==========
+
+TaskGroup::TaskGroup(TaskPriority priority)
+    : m_priority(priority), m_state(std::make_shared<State>()) {
+}
+
+TaskGroup::~TaskGroup() {
+    WaitAll();
+}
+
+void TaskGroup::Run(std::function<void()> task) {
+    Run(std::move(task), m_priority);
+}
+
+void TaskGroup::Run(std::function<void()> task, TaskPriority priority) {
+    m_state->pending.fetch_add(1, std::memory_order_relaxed);
+    TaskScheduler::Instance().Push({ std::move(task), m_state }, priority);
+}
+
+void TaskGroup::Wait() {
+    WaitAll();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        std::swap(error, m_state->error);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskGroup::WaitAll() {
+    TaskScheduler& scheduler = TaskScheduler::Instance();
+    while (m_state->pending.load(std::memory_order_acquire) > 0) {
+        // 只帮忙执行本组的任务；队列里没有了说明剩下的都在别的线程上执行，睡眠等待即可
+        if (scheduler.TryRunGroupTask(m_state)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->done.wait(lock, [this]() {
+            return m_state->pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+}
+
+void TaskGroup::Cancel() {
+    m_state->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool TaskGroup::IsCancelled() const {
+    return m_state->cancelled.load(std::memory_order_relaxed);
+}
+
+// ========== TaskScheduler ==========
+
+TaskScheduler& TaskScheduler::Instance() {
+    static TaskScheduler instance;
+    return instance;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_workerCount(HardwareThreads() - 1), m_queued(0), m_running(0), m_stopping(false) {
+    // OCCT的默认线程池只在第一次调用时按参数创建；已经被别的代码先创建了（线程数不同）
+    // 而且没有在用时重新初始化，否则保持原样
+    const Handle(OSD_ThreadPool)& kernelPool = OSD_ThreadPool::DefaultPool(m_workerCount + 1);
+    if (kernelPool->NbThreads() != m_workerCount + 1 && !kernelPool->IsInUse()) {
+        kernelPool->Init(m_workerCount + 1);
+    }
+
+    for (int i = 0; i < m_workerCount; ++i) {
+        m_queues.emplace_back(new WorkerQueues());
+    }
+    m_workers.reserve(m_workerCount);
+    for (int i = 0; i < m_workerCount; ++i) {
+        m_workers.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void TaskScheduler::Submit(std::function<void()> task, TaskPriority priority) {
+    Push({ std::move(task), nullptr }, priority);
+}
+
+void TaskScheduler::ParallelFor(int begin, int end, const std::function<void(int)>& body,
+                                TaskPriority priority) {
+    const int count = end - begin;
+    if (count <= 0) {
+        return;
+    }
+    if (count == 1 || m_workerCount == 0) {
+        for (int i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    // 出错后不再领取新的下标；next要比group活得久，先声明
+    std::atomic<int> next(begin);
+    auto claim = [&next, end, &body]() {
+        try {
+            for (int i = next.fetch_add(1, std::memory_order_relaxed); i < end;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                body(i);
+            }
+        } catch (...) {
+            next.store(end, std::memory_order_relaxed);
+            throw;
+        }
+    };
+
+    // 帮忙的任务沿用调用线程正在重建的特征，缓存统计不会因为换了线程而丢失
+    RegenerationProfiler::ScopedFeature* feature = RegenerationProfiler::CurrentFeature();
+    TaskGroup group(priority);
+    const int helpers = std::min(count - 1, GetWorkerCount());
+    for (int i = 0; i < helpers; ++i) {
+        group.Run([&claim, feature]() {
+            RegenerationProfiler::AdoptFeature adopt(feature);
+            claim();
+        });
+    }
+    try {
+        claim();
+    } catch (...) {
+        group.Cancel();
+        throw;
+    }
+    group.Wait();
+}
+
+bool TaskScheduler::ShouldKernelRunParallel() const {
+    // 有排队的任务，或者一半以上的工作线程在忙：空闲的核留给池里的任务
+    if (m_queued.load(std::memory_order_relaxed) > 0) {
+        return false;
+    }
+    const int idle = GetWorkerCount() - m_running.load(std::memory_order_relaxed);
+    return idle >= GetWorkerCount() / 2;
+}
+
+bool TaskScheduler::IsWorkerThread() {
+    return t_workerIndex >= 0;
+}
+
+void TaskScheduler::Push(Task task, TaskPriority priority) {
+    const int level = static_cast<int>(priority);
+    if (t_workerIndex >= 0) {
+        WorkerQueues& own = *m_queues[t_workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.queues[level].push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(m_globalMutex);
+        m_global[level].push_back(std::move(task));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // 在睡眠锁下通知：工作线程要么已经看到计数，要么正在等待
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+bool TaskScheduler::Pop(Task& task) {
+    const int self = t_workerIndex;
+    const int workerCount = GetWorkerCount();
+    auto take = [this, &task](std::deque<Task>& queue, bool fromBack) {
+        if (queue.empty()) {
+            return false;
+        }
+        if (fromBack) {
+            task = std::move(queue.back());
+            queue.pop_back();
+        } else {
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    for (int level = 0; level < kPriorityCount; ++level) {
+        // 自己的队列从尾部取
+        if (self >= 0) {
+            WorkerQueues& own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (take(own.queues[level], true)) {
+                return true;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_globalMutex);
+            if (take(m_global[level], false)) {
+                return true;
+            }
+        }
+        // 从其他工作线程的头部偷
+        for (int offset = 1; offset <= workerCount; ++offset) {
+            const int victim = (std::max(self, 0) + offset) % workerCount;
+            if (victim == self) {
+                continue;
+            }
+            WorkerQueues& other = *m_queues[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (take(other.queues[level], false)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::TryRunGroupTask(const std::shared_ptr<TaskGroup::State>& group) {
+    if (m_queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    Task task;
+    auto take = [this, &task, &group](std::deque<Task>& queue, bool fromBack) {
+        auto matches = [&group](const Task& candidate) { return candidate.group == group; };
+        if (fromBack) {
+            auto it = std::find_if(queue.rbegin(), queue.rend(), matches);
+            if (it == queue.rend()) {
+                return false;
+            }
+            task = std::move(*it);
+            queue.erase(std::next(it).base());
+        } else {
+            auto it = std::find_if(queue.begin(), queue.end(), matches);
+            if (it == queue.end()) {
+                return false;
+            }
+            task = std::move(*it);
+            queue.erase(it);
+        }
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    // 本组的任务在提交它的线程的队列里（工作线程）或全局队列里（其他线程），
+    // 也可能已经被偷到别的工作线程队列里
+    const int self = t_workerIndex;
+    bool found = false;
+    for (int level = 0; level < kPriorityCount && !found; ++level) {
+        if (self >= 0) {
+            WorkerQueues& own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            found = take(own.queues[level], true);
+        }
+        if (!found) {
+            std::lock_guard<std::mutex> lock(m_globalMutex);
+            found = take(m_global[level], false);
+        }
+        for (int victim = 0; victim < GetWorkerCount() && !found; ++victim) {
+            if (victim == self) {
+                continue;
+            }
+            WorkerQueues& other = *m_queues[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            found = take(other.queues[level], false);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    Execute(task);
+    return true;
+}
+
+void TaskScheduler::Execute(Task& task) {
+    const std::shared_ptr<TaskGroup::State> group = std::move(task.group);
+    m_running.fetch_add(1, std::memory_order_relaxed);
+    if (!group || !group->cancelled.load(std::memory_order_relaxed)) {
+        try {
+            task.function();
+        } catch (...) {
+            // 独立任务的异常没人接收，直接丢弃；组内的第一个异常留给Wait()，其余任务取消
+            if (group) {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                if (!group->error) {
+                    group->error = std::current_exception();
+                }
+                group->cancelled.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    task.function = nullptr;
+    m_running.fetch_sub(1, std::memory_order_relaxed);
+
+    if (group && group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->done.notify_all();
+    }
+}
+
+void TaskScheduler::WorkerLoop(int index) {
+    t_workerIndex = index;
+    Tracer::SetThreadName("Worker");
+
+    for (;;) {
+        Task task;
+        if (Pop(task)) {
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() {
+            return m_stopping || m_queued.load(std::memory_order_acquire) > 0;
+        });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace cad_core
@@ -0,0 +1,238 @@
+#include "cad_core/Tracer.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cad_core {
+
+namespace {
+
+struct TraceEvent {
+    const char* name = nullptr;
+    const char* category = nullptr;
+    std::int64_t startNs = 0;
+    std::int64_t durationNs = 0;
+};
+
+// 环形缓冲区的一个槽位，按seqlock读写：写入前序号变奇数、写完变偶数，
+// 读取方遇到奇数或前后序号不一致就说明读到了写了一半的事件
+struct TraceSlot {
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<std::int64_t> startNs{0};
+    std::atomic<std::int64_t> durationNs{0};
+};
+
+// 一个线程的环形缓冲区：只有所属线程写入，导出线程只读
+struct ThreadBuffer {
+    std::unique_ptr<TraceSlot[]> slots;
+    std::atomic<std::uint64_t> written{0};
+    std::uint64_t threadId = 0;
+    std::atomic<const char*> threadName{nullptr};
+};
+
+// 所有线程的缓冲区；线程退出后缓冲区仍保留，导出时还能看到它记录的事件
+struct BufferRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+BufferRegistry& Registry() {
+    static BufferRegistry registry;
+    return registry;
+}
+
+// 当前线程的缓冲区，第一次写入事件时才分配；线程名可以在分配之前设置
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local const char* t_threadName = nullptr;
+
+ThreadBuffer& CurrentBuffer() {
+    if (!t_buffer) {
+        static std::atomic<std::uint64_t> s_nextThreadId(1);
+        t_buffer = std::make_shared<ThreadBuffer>();
+        t_buffer->slots.reset(new TraceSlot[Tracer::kEventsPerThread]);
+        t_buffer->threadId = s_nextThreadId++;
+        t_buffer->threadName.store(t_threadName, std::memory_order_relaxed);
+        BufferRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.buffers.push_back(t_buffer);
+    }
+    return *t_buffer;
+}
+
+// 导出时复制出的一条事件
+struct ExportedEvent {
+    TraceEvent event;
+    std::uint64_t threadId;
+};
+
+std::string g_exitTraceFile;
+
+void WriteTraceAtExit() {
+    Tracer::Instance().ExportChromeTrace(g_exitTraceFile);
+}
+
+} // namespace
+
+Tracer& Tracer::Instance() {
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer() : m_enabled(false), m_epochNs(0) {
+    m_epochNs.store(NowNs(), std::memory_order_relaxed);
+}
+
+void Tracer::SetEnabled(bool enabled) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::int64_t Tracer::NowNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ========== Zone ==========
+
+Tracer::Zone::Zone(const char* name, const char* category)
+    : m_name(name), m_category(category), m_startNs(0), m_active(Tracer::Instance().IsEnabled()) {
+    if (m_active) {
+        m_startNs = Tracer::Instance().NowNs();
+    }
+}
+
+Tracer::Zone::~Zone() {
+    if (!m_active) {
+        return;
+    }
+
+    const std::int64_t end = Tracer::Instance().NowNs();
+    ThreadBuffer& buffer = CurrentBuffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceSlot& slot = buffer.slots[index % kEventsPerThread];
+    const std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(m_name, std::memory_order_relaxed);
+    slot.category.store(m_category, std::memory_order_relaxed);
+    slot.startNs.store(m_startNs, std::memory_order_relaxed);
+    slot.durationNs.store(end - m_startNs, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::SetThreadName(const char* name) {
+    t_threadName = name;
+    if (t_buffer) {
+        t_buffer->threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+// ========== 导出 ==========
+
+void Tracer::Clear() {
+    BufferRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // 写入位置只由所属线程修改，这里只丢掉已经结束的线程的缓冲区；
+    // 其余事件靠新的起点过滤掉
+    std::vector<std::shared_ptr<ThreadBuffer>> alive;
+    for (const auto& buffer : registry.buffers) {
+        if (buffer.use_count() > 1) {
+            alive.push_back(buffer);
+        }
+    }
+    registry.buffers.swap(alive);
+    m_epochNs.store(NowNs(), std::memory_order_relaxed);
+}
+
+bool Tracer::ExportChromeTrace(const std::string& filename) const {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        BufferRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    // 逐个槽位按seqlock复制：复制期间正被所属线程覆盖的槽位丢弃
+    std::vector<ExportedEvent> events;
+    for (const auto& buffer : buffers) {
+        const std::uint64_t end = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const TraceSlot& slot = buffer->slots[i % kEventsPerThread];
+            const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            ExportedEvent exported;
+            exported.event.name = slot.name.load(std::memory_order_relaxed);
+            exported.event.category = slot.category.load(std::memory_order_relaxed);
+            exported.event.startNs = slot.startNs.load(std::memory_order_relaxed);
+            exported.event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+            exported.threadId = buffer->threadId;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+            events.push_back(exported);
+        }
+    }
+
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    const std::int64_t epochNs = m_epochNs.load(std::memory_order_relaxed);
+
+    // Chrome trace "complete" events（ph = X），时间单位微秒；线程名用元数据事件（ph = M）
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        const char* threadName = buffer->threadName.load(std::memory_order_relaxed);
+        if (threadName == nullptr) {
+            continue;
+        }
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+             << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+        first = false;
+    }
+    for (const ExportedEvent& exported : events) {
+        const TraceEvent& e = exported.event;
+        if (e.name == nullptr || e.startNs < epochNs) {
+            continue;
+        }
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"" << e.name << "\","
+             << "\"cat\":\"" << e.category << "\","
+             << "\"ph\":\"X\","
+             << "\"ts\":" << (e.startNs - epochNs) / 1000.0 << ","
+             << "\"dur\":" << e.durationNs / 1000.0 << ","
+             << "\"pid\":1,"
+             << "\"tid\":" << exported.threadId << "}";
+        first = false;
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.good();
+}
+
+void Tracer::InitFromEnvironment() {
+    const char* file = std::getenv("ANDERCAD_TRACE");
+    if (file == nullptr || *file == '\0') {
+        return;
+    }
+    g_exitTraceFile = file;
+    // 先构造单例和缓冲区表，退出时它们在写出之后才析构
+    Registry();
+    Instance().SetEnabled(true);
+    std::atexit(WriteTraceAtExit);
+}
+
+} // namespace cad_core
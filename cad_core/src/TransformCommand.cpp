@@ -1,4 +1,5 @@
 #include "cad_core/TransformCommand.h"
+#include "cad_core/Tracer.h"
 #include <BRepBuilderAPI_Transform.hxx>
 #include <gp_Vec.hxx>
 #include <gp_Ax1.hxx>
@@ -21,6 +22,7 @@ bool TransformCommand::Execute() {
     if (m_executed) {
         return true;
     }
+    CAD_TRACE_ZONE("TransformCommand::Execute");
 
     try {
         // 创建变换矩阵
@@ -0,0 +1,45 @@
+#include "cad_core/TranslatorSetup.h"
+#include <IGESControl_Controller.hxx>
+#include <Interface_Static.hxx>
+#include <STEPCAFControl_Controller.hxx>
+
+namespace cad_core {
+
+namespace {
+
+std::mutex& ParameterMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+void InitializeTranslators() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        STEPCAFControl_Controller::Init();
+        IGESControl_Controller::Init();
+    });
+}
+
+ScopedTranslatorParameter::ScopedTranslatorParameter(const char* name, const char* value)
+    : m_lock(ParameterMutex()), m_name(name), m_integer(false), m_previousInteger(0) {
+    const char* previous = Interface_Static::CVal(name);
+    m_previousText = previous ? previous : "";
+    Interface_Static::SetCVal(name, value);
+}
+
+ScopedTranslatorParameter::ScopedTranslatorParameter(const char* name, int value)
+    : m_lock(ParameterMutex()), m_name(name), m_integer(true), m_previousInteger(Interface_Static::IVal(name)) {
+    Interface_Static::SetIVal(name, value);
+}
+
+ScopedTranslatorParameter::~ScopedTranslatorParameter() {
+    if (m_integer) {
+        Interface_Static::SetIVal(m_name, m_previousInteger);
+    } else {
+        Interface_Static::SetCVal(m_name, m_previousText.c_str());
+    }
+}
+
+} // namespace cad_core
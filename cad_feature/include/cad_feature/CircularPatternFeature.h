@@ -0,0 +1,38 @@
+#pragma once
+
+#include "PatternFeature.h"
+
+namespace cad_feature {
+
+class CircularPatternFeature : public PatternFeature {
+public:
+    CircularPatternFeature();
+    CircularPatternFeature(const std::string& name);
+    virtual ~CircularPatternFeature() = default;
+
+    void SetAxis(double x, double y, double z);
+    void GetAxis(double& x, double& y, double& z) const;
+
+    void SetAxisOrigin(double x, double y, double z);
+    void GetAxisOrigin(double& x, double& y, double& z) const;
+
+    void SetCount(int count);
+    int GetCount() const;
+
+    // Total angle in radians; a full turn spaces instances evenly without overlap at 2*pi
+    void SetAngle(double angle);
+    double GetAngle() const;
+
+    std::shared_ptr<Feature> Clone() const override;
+
+protected:
+    std::vector<gp_Trsf> ComputeTransforms() const override;
+    bool ValidatePattern() const override;
+
+private:
+    void InitializeParameters();
+};
+
+using CircularPatternFeaturePtr = std::shared_ptr<CircularPatternFeature>;
+
+} // namespace cad_feature
@@ -21,6 +21,8 @@
 #include <memory>              // 智能指针 - 现代C++的内存管家
 #include <string>              // 字符串 - 特征名称和参数的载体
 #include <map>                 // 映射容器 - 参数名到参数值的字典
+#include <vector>              // 动态数组 - 输入形状列表
+#include <atomic>              // 原子计数 - 批处理任务在多个线程上创建特征
 
 namespace cad_feature {
 
@@ -42,7 +44,10 @@ enum class FeatureType {
     Shell,        // 抽壳 - 把实体掏空，做个容器
     Cut,          // 切除 - 用一个几何体去"咬"另一个
     Union,        // 合并 - 把多个几何体合成一个
-    Intersection  // 相交 - 只保留重叠的部分
+    Intersection, // 相交 - 只保留重叠的部分
+    LinearPattern,   // 线性阵列 - 一排排复制，打孔阵列的好帮手
+    CircularPattern, // 圆周阵列 - 绕轴转着圈复制，法兰螺栓孔必备
+    TablePattern     // 表格阵列 - 坐标表说了算，想放哪就放哪
 };
 
 /**
@@ -59,6 +64,18 @@ enum class FeatureState {
     Failed       // 执行失败 - 出了点小意外，需要调试
 };
 
+/**
+ * @enum PreviewTier
+ * @brief 预览层级 - 先给个"草稿"，再交"正式稿"
+ *
+ * 拖动参数时先用粗略几何（折线轮廓、去掉拔模等）在一帧内顶上，
+ * 精确结果在后台算好后再替换掉。
+ */
+enum class PreviewTier {
+    Coarse,  // 粗略预览 - 快速近似，同步生成
+    Exact    // 精确预览 - 完整几何，异步生成
+};
+
 /**
  * @class Feature
  * @brief 特征基类 - 所有建模操作的"祖师爷"
@@ -158,6 +175,12 @@ public:
      */
     bool HasParameter(const std::string& name) const;
     
+    /** 
+     * 获取全部参数 - 保存文档时整体写出
+     * @return 参数名到参数值的映射
+     */
+    const std::map<std::string, double>& GetParameters() const;
+    
     // ========== 形状操作 - 特征的"表演时刻" ==========
     
     /** 
@@ -174,6 +197,28 @@ public:
      */
     virtual cad_core::ShapePtr CreatePreviewShape() const;
     
+    /** 
+     * 创建粗略预览形状 - 预览的"快速通道"
+     * 必须足够便宜，能在UI线程里一帧之内完成；
+     * 默认返回nullptr，表示这个特征没有快速通道，只显示精确预览
+     * @return 近似的几何形状
+     */
+    virtual cad_core::ShapePtr CreateCoarsePreviewShape() const;
+    
+    /** 
+     * 克隆特征 - 复制一份参数快照
+     * 精确预览在后台线程计算，用快照可以避免和UI线程抢同一个对象
+     * @return 特征的副本（草图等引用对象共享）
+     */
+    virtual std::shared_ptr<Feature> Clone() const = 0;
+    
+    /** 
+     * 获取输入形状 - 特征"吃进去"的实体（草图类特征没有）
+     * 重建分析器用它统计输入面数
+     * @return 输入形状列表
+     */
+    virtual std::vector<cad_core::ShapePtr> GetInputShapes() const;
+    
     /** 
      * 验证参数 - 检查参数设置是否合理
      * 避免用户设置奇葩参数导致程序崩溃
@@ -209,7 +254,7 @@ protected:
     std::map<std::string, double> m_parameters;
     
     /** 静态ID计数器 - 用来分配唯一ID的"号码机" */
-    static int s_nextId;
+    static std::atomic<int> s_nextId;
 };
 
 /** 特征智能指针类型别名 - 让特征管理更轻松 */
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Feature.h"
+#include "cad_core/ICommand.h"
+#include "cad_core/Shape.h"
+#include <string>
+
+namespace cad_feature {
+
+// 把特征包装成可撤销命令：执行时按特征快照生成形状
+class FeatureCommand : public cad_core::ICommand {
+public:
+    explicit FeatureCommand(const FeaturePtr& feature);
+    virtual ~FeatureCommand() = default;
+
+    bool Execute() override;
+    bool Undo() override;
+    bool Redo() override;
+    const char* GetName() const override;
+
+    cad_core::ShapePtr GetCreatedShape() const;
+    const FeaturePtr& GetFeature() const;
+
+private:
+    FeaturePtr m_feature;
+    std::string m_name;
+    cad_core::ShapePtr m_createdShape;
+    bool m_executed;
+};
+
+} // namespace cad_feature
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Feature.h"
+#include "cad_core/NativeDocumentFile.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -41,6 +42,9 @@ public:
     int GetFeatureCount() const;
     bool IsEmpty() const;
     
+    // 特征参数快照（随原生文档保存）
+    std::vector<cad_core::NativeDocumentFile::FeatureRecord> GetFeatureRecords() const;
+    
     // 事件（用于界面通知）
     void SetFeatureAddedCallback(std::function<void(const FeaturePtr&)> callback);
     void SetFeatureRemovedCallback(std::function<void(const FeaturePtr&)> callback);
@@ -55,6 +59,10 @@ private:
     std::function<void(const FeaturePtr&)> m_featureUpdatedCallback;
     
     int FindFeatureIndex(const FeaturePtr& feature) const;
+    // 生成形状并写入重建记录，不改状态也不发通知，可以在工作线程上执行
+    bool BuildFeature(const FeaturePtr& feature) const;
+    // 在调用线程上更新状态并通知界面
+    bool FinishFeature(const FeaturePtr& feature, bool succeeded);
     void NotifyFeatureAdded(const FeaturePtr& feature);
     void NotifyFeatureRemoved(const FeaturePtr& feature);
     void NotifyFeatureUpdated(const FeaturePtr& feature);
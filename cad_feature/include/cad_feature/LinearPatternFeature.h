@@ -0,0 +1,45 @@
+#pragma once
+
+#include "PatternFeature.h"
+
+namespace cad_feature {
+
+class LinearPatternFeature : public PatternFeature {
+public:
+    LinearPatternFeature();
+    LinearPatternFeature(const std::string& name);
+    virtual ~LinearPatternFeature() = default;
+
+    // First direction
+    void SetDirection(double x, double y, double z);
+    void GetDirection(double& x, double& y, double& z) const;
+
+    void SetSpacing(double spacing);
+    double GetSpacing() const;
+
+    void SetCount(int count);
+    int GetCount() const;
+
+    // Optional second direction (count2 = 1 disables it)
+    void SetDirection2(double x, double y, double z);
+    void GetDirection2(double& x, double& y, double& z) const;
+
+    void SetSpacing2(double spacing);
+    double GetSpacing2() const;
+
+    void SetCount2(int count);
+    int GetCount2() const;
+
+    std::shared_ptr<Feature> Clone() const override;
+
+protected:
+    std::vector<gp_Trsf> ComputeTransforms() const override;
+    bool ValidatePattern() const override;
+
+private:
+    void InitializeParameters();
+};
+
+using LinearPatternFeaturePtr = std::shared_ptr<LinearPatternFeature>;
+
+} // namespace cad_feature
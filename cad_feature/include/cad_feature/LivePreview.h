@@ -3,6 +3,7 @@
 #include "Feature.h"
 #include <QObject>
 #include <QTimer>
+#include <QFutureWatcher>
 #include <functional>
 
 namespace cad_feature {
@@ -12,7 +13,7 @@ class LivePreview : public QObject {
 
 public:
     explicit LivePreview(QObject* parent = nullptr);
-    ~LivePreview() = default;
+    ~LivePreview();
 
     void SetFeature(const FeaturePtr& feature);
     const FeaturePtr& GetFeature() const;
@@ -30,9 +31,15 @@ public:
     // Callbacks
     void SetPreviewUpdateCallback(std::function<void(const cad_core::ShapePtr&)> callback);
     void SetPreviewClearCallback(std::function<void()> callback);
+    
+    // Tiered callback: coarse shape immediately, exact shape once the worker finishes
+    void SetTieredPreviewCallback(std::function<void(const cad_core::ShapePtr&, PreviewTier)> callback);
+    
+    bool IsExactPreviewPending() const;
 
 private slots:
     void OnUpdateTimer();
+    void OnExactPreviewFinished();
 
 private:
     FeaturePtr m_feature;
@@ -40,10 +47,21 @@ private:
     bool m_previewActive;
     int m_updateDelay;
     
+    // Exact preview runs on a worker; stale results are dropped by generation
+    QFutureWatcher<cad_core::ShapePtr>* m_exactWatcher;
+    quint64 m_generation;
+    quint64 m_exactGeneration;
+    bool m_exactQueued;
+    bool m_coarseShown;
+    
     std::function<void(const cad_core::ShapePtr&)> m_previewUpdateCallback;
     std::function<void()> m_previewClearCallback;
+    std::function<void(const cad_core::ShapePtr&, PreviewTier)> m_tieredPreviewCallback;
     
+    void UpdateCoarsePreviewShape();
     void UpdatePreviewShape();
+    void StartExactPreview();
+    void DeliverPreviewShape(const cad_core::ShapePtr& shape, PreviewTier tier);
     void ClearPreviewShape();
 };
 
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "Feature.h"
+#include "ProfileBuilder.h"
 #include "cad_sketch/Sketch.h"
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Wire.hxx>
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace cad_feature {
@@ -21,6 +27,7 @@ public:
     int GetSectionCount() const;
     
     // Guide curve operations
+    // 目前只支持一条引导线（PipeShell只有一条辅助脊线），多于一条时ValidateParameters失败
     void AddGuideCurve(const cad_sketch::SketchPtr& guide);
     void RemoveGuideCurve(const cad_sketch::SketchPtr& guide);
     void ClearGuideCurves();
@@ -38,10 +45,18 @@ public:
     void SetClosed(bool closed);
     bool GetClosed() const;
     
+    // Sections are stacked along Z, one spacing apart.
+    // A closed loft returns to a copy of the first section one spacing past the last.
+    // Guide curves are drawn with sketch Y as the loft direction and rotated into XZ.
+    void SetSectionSpacing(double spacing);
+    double GetSectionSpacing() const;
+    
     // Feature interface
     cad_core::ShapePtr CreateShape() const override;
     bool ValidateParameters() const override;
     std::shared_ptr<cad_core::ICommand> CreateCommand() const override;
+    cad_core::ShapePtr CreateCoarsePreviewShape() const override;
+    std::shared_ptr<Feature> Clone() const override;
 
 private:
     std::vector<cad_sketch::SketchPtr> m_sections;
@@ -50,6 +65,30 @@ private:
     bool AreSectionsValid() const;
     bool AreGuideCurvesValid() const;
     cad_core::ShapePtr LoftSections() const;
+    TopoDS_Wire MakeSectionWire(int index, ProfileFidelity fidelity) const;
+    TopoDS_Wire MakeGuideWire(int index) const;
+    TopoDS_Shape LoftAlongGuide(const std::vector<TopoDS_Wire>& wires) const;
+    // 统一各截面边数、对齐闭合截面起点（代替ThruSections内部的串行兼容性检查）
+    void MakeSectionsCompatible(std::vector<TopoDS_Wire>& wires) const;
+    // 闭合放样的最后一个截面：第一个截面平移到最后一个之后
+    TopoDS_Wire MakeClosingWire(const TopoDS_Wire& first) const;
+    
+    // 放样结果缓存：截面/引导线修订号和参数都没变就直接复用；克隆体共享同一份。
+    // 草图用weak_ptr记录（和ProfileCache一样），草图释放后不会误命中
+    using InputRevision = std::pair<std::weak_ptr<cad_sketch::Sketch>, std::uint64_t>;
+    struct ResultCache {
+        std::mutex mutex;
+        std::vector<InputRevision> inputs;
+        std::map<std::string, double> parameters;
+        TopoDS_Shape shape;
+    };
+    std::shared_ptr<ResultCache> m_resultCache;
+    
+    std::vector<InputRevision> CollectInputRevisions() const;
+    static bool SameInputs(const std::vector<InputRevision>& lhs, const std::vector<InputRevision>& rhs);
+    
+    // Coarse preview lofts through at most this many sections
+    static constexpr int kCoarseMaxSections = 8;
 };
 
 using LoftFeaturePtr = std::shared_ptr<LoftFeature>;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Feature.h"
+#include <TopoDS_Shape.hxx>
+#include <gp_Trsf.hxx>
+#include <vector>
+
+namespace cad_feature {
+
+// 阵列结果与目标体的组合方式
+enum class PatternOperation {
+    None,   // 只生成实例
+    Union,  // 实例并入目标体
+    Cut     // 从目标体中减去实例（打孔阵列）
+};
+
+/**
+ * @class PatternFeature
+ * @brief 阵列特征基类
+ *
+ * 每个实例都是种子形状换一个TopLoc_Location，所有实例共享同一个TShape：
+ * 种子只网格化一次，和目标体的布尔运算作为一次多工具运算执行。
+ */
+class PatternFeature : public Feature {
+public:
+    PatternFeature(FeatureType type, const std::string& name);
+    virtual ~PatternFeature() = default;
+
+    // 种子和目标体
+    void SetSeedShape(const cad_core::ShapePtr& seed);
+    const cad_core::ShapePtr& GetSeedShape() const;
+
+    void SetTargetShape(const cad_core::ShapePtr& target);
+    const cad_core::ShapePtr& GetTargetShape() const;
+
+    void SetOperation(PatternOperation operation);
+    PatternOperation GetOperation() const;
+
+    // 各实例的变换，第一个总是恒等变换（种子本身）
+    std::vector<gp_Trsf> GetInstanceTransforms() const;
+    int GetInstanceCount() const;
+
+    // 带位置的种子实例组成的复合体，不做布尔
+    cad_core::ShapePtr CreateInstancesShape() const;
+
+    // 特征接口
+    cad_core::ShapePtr CreateShape() const override;
+    bool ValidateParameters() const override;
+    std::shared_ptr<cad_core::ICommand> CreateCommand() const override;
+    cad_core::ShapePtr CreateCoarsePreviewShape() const override;
+    std::vector<cad_core::ShapePtr> GetInputShapes() const override;
+
+protected:
+    virtual std::vector<gp_Trsf> ComputeTransforms() const = 0;
+    virtual bool ValidatePattern() const = 0;
+
+private:
+    cad_core::ShapePtr m_seed;
+    cad_core::ShapePtr m_target;
+
+    std::vector<TopoDS_Shape> MakeInstances() const;
+};
+
+using PatternFeaturePtr = std::shared_ptr<PatternFeature>;
+
+} // namespace cad_feature
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "cad_sketch/Sketch.h"
+#include <TopoDS_Wire.hxx>
+#include <TopoDS_Face.hxx>
+#include <vector>
+
+namespace cad_feature {
+
+// 草图转换精度
+enum class ProfileFidelity {
+    Exact,  // 精确几何 - 直线、圆弧、整圆保持解析曲线
+    Coarse  // 粗略几何 - 圆弧/整圆离散为折线，用于快速预览
+};
+
+/**
+ * @class ProfileBuilder
+ * @brief 把草图元素转换为OCCT线框/面，供拉伸、旋转、扫掠、放样等特征使用
+ *
+ * 草图位于XY平面（z = 0）。直线、圆弧首尾相连拼成线框，整圆单独成为闭合线框。
+ */
+class ProfileBuilder {
+public:
+    // 草图 -> 线框（可能有多条，按面积从大到小排列）
+    static std::vector<TopoDS_Wire> MakeWires(const cad_sketch::SketchPtr& sketch,
+                                              ProfileFidelity fidelity = ProfileFidelity::Exact);
+
+    // 草图 -> 平面（最大的闭合线框为外轮廓，其余闭合线框作为孔）
+    static TopoDS_Face MakeFace(const cad_sketch::SketchPtr& sketch,
+                                ProfileFidelity fidelity = ProfileFidelity::Exact);
+
+    // 草图 -> 路径线框（取最长的一条，可以不闭合）
+    static TopoDS_Wire MakePathWire(const cad_sketch::SketchPtr& sketch,
+                                    ProfileFidelity fidelity = ProfileFidelity::Exact);
+
+    // 粗略模式下整圆的离散段数，圆弧按扫角等比例折算
+    static const int kCoarseCircleSegments = 16;
+
+private:
+    ProfileBuilder() = default;
+};
+
+} // namespace cad_feature
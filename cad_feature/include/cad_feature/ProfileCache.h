@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ProfileBuilder.h"
+#include "cad_sketch/Sketch.h"
+#include <TopoDS_Wire.hxx>
+#include <TopoDS_Face.hxx>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cad_feature {
+
+/**
+ * @class ProfileCache
+ * @brief 草图 -> 线框/面的共享缓存
+ *
+ * 以草图修订号为键：同一个草图被多个特征（拉伸、旋转、扫掠……）引用时只转换一次，
+ * 草图一改修订号就变，旧结果自动作废。预览在后台线程也会访问，内部加锁。
+ */
+class ProfileCache {
+public:
+    static ProfileCache& Instance();
+
+    std::vector<TopoDS_Wire> GetWires(const cad_sketch::SketchPtr& sketch,
+                                      ProfileFidelity fidelity = ProfileFidelity::Exact);
+    TopoDS_Face GetFace(const cad_sketch::SketchPtr& sketch,
+                        ProfileFidelity fidelity = ProfileFidelity::Exact);
+    TopoDS_Wire GetPathWire(const cad_sketch::SketchPtr& sketch,
+                            ProfileFidelity fidelity = ProfileFidelity::Exact);
+
+    void Clear();
+
+    // Statistics
+    size_t GetHitCount() const;
+    size_t GetMissCount() const;
+    size_t GetEntryCount() const;
+
+private:
+    ProfileCache();
+    ProfileCache(const ProfileCache&) = delete;
+    ProfileCache& operator=(const ProfileCache&) = delete;
+
+    struct Entry {
+        std::weak_ptr<cad_sketch::Sketch> sketch;
+        std::uint64_t revision = 0;
+        bool hasWires = false;
+        bool hasFace = false;
+        bool hasPath = false;
+        std::vector<TopoDS_Wire> wires;
+        TopoDS_Face face;
+        TopoDS_Wire path;
+    };
+
+    using Key = std::pair<const cad_sketch::Sketch*, ProfileFidelity>;
+
+    // 找到（必要时重置）草图对应的缓存项，调用方需持有锁
+    Entry& Lookup(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity);
+    void PurgeExpired();
+
+    mutable std::mutex m_mutex;
+    std::map<Key, Entry> m_entries;
+    size_t m_hits;
+    size_t m_misses;
+};
+
+} // namespace cad_feature
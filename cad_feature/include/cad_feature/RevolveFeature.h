@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Feature.h"
+#include "ProfileBuilder.h"
 #include "cad_sketch/Sketch.h"
 
 namespace cad_feature {
@@ -32,12 +33,14 @@ public:
     cad_core::ShapePtr CreateShape() const override;
     bool ValidateParameters() const override;
     std::shared_ptr<cad_core::ICommand> CreateCommand() const override;
+    cad_core::ShapePtr CreateCoarsePreviewShape() const override;
+    std::shared_ptr<Feature> Clone() const override;
 
 private:
     cad_sketch::SketchPtr m_sketch;
     
     bool IsSketchValid() const;
-    cad_core::ShapePtr RevolveSketch() const;
+    cad_core::ShapePtr RevolveSketch(ProfileFidelity fidelity) const;
 };
 
 using RevolveFeaturePtr = std::shared_ptr<RevolveFeature>;
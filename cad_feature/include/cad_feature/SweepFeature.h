@@ -1,7 +1,11 @@
 #pragma once
 
 #include "Feature.h"
+#include "ProfileBuilder.h"
 #include "cad_sketch/Sketch.h"
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Wire.hxx>
+#include <gp_Pnt.hxx>
 #include <vector>
 
 namespace cad_feature {
@@ -33,6 +37,8 @@ public:
     cad_core::ShapePtr CreateShape() const override;
     bool ValidateParameters() const override;
     std::shared_ptr<cad_core::ICommand> CreateCommand() const override;
+    cad_core::ShapePtr CreateCoarsePreviewShape() const override;
+    std::shared_ptr<Feature> Clone() const override;
 
 private:
     cad_sketch::SketchPtr m_profile;
@@ -41,6 +47,10 @@ private:
     bool IsProfileValid() const;
     bool IsPathValid() const;
     cad_core::ShapePtr SweepProfile() const;
+    // withLaw为false时不做扭转和缩放（粗略预览），center不使用；
+    // 带扭转/缩放时闭合路径返回空形状
+    TopoDS_Shape SweepWire(const TopoDS_Wire& section, const TopoDS_Wire& path, const gp_Pnt& center,
+                           bool withLaw = true) const;
 };
 
 using SweepFeaturePtr = std::shared_ptr<SweepFeature>;
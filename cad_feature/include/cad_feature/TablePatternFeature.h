@@ -0,0 +1,32 @@
+#pragma once
+
+#include "PatternFeature.h"
+
+namespace cad_feature {
+
+// 坐标表阵列：每一行是一个实例相对种子的平移（可带绕Z旋转）
+class TablePatternFeature : public PatternFeature {
+public:
+    TablePatternFeature();
+    TablePatternFeature(const std::string& name);
+    virtual ~TablePatternFeature() = default;
+
+    void AddInstance(double x, double y, double z, double rotationZ = 0.0);
+    void AddInstance(const gp_Trsf& transform);
+    void ClearInstances();
+
+    const std::vector<gp_Trsf>& GetTable() const;
+
+    std::shared_ptr<Feature> Clone() const override;
+
+protected:
+    std::vector<gp_Trsf> ComputeTransforms() const override;
+    bool ValidatePattern() const override;
+
+private:
+    std::vector<gp_Trsf> m_table;
+};
+
+using TablePatternFeaturePtr = std::shared_ptr<TablePatternFeature>;
+
+} // namespace cad_feature
@@ -0,0 +1,110 @@
+#include "cad_feature/CircularPatternFeature.h"
+#include <gp_Ax1.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <cmath>
+
+namespace cad_feature {
+
+CircularPatternFeature::CircularPatternFeature() : PatternFeature(FeatureType::CircularPattern, "CircularPattern") {
+    InitializeParameters();
+}
+
+CircularPatternFeature::CircularPatternFeature(const std::string& name) : PatternFeature(FeatureType::CircularPattern, name) {
+    InitializeParameters();
+}
+
+void CircularPatternFeature::InitializeParameters() {
+    SetParameter("axis_x", 0.0);
+    SetParameter("axis_y", 0.0);
+    SetParameter("axis_z", 1.0);
+    SetParameter("axis_origin_x", 0.0);
+    SetParameter("axis_origin_y", 0.0);
+    SetParameter("axis_origin_z", 0.0);
+    SetParameter("count", 4.0);
+    SetParameter("angle", 2.0 * M_PI);
+}
+
+void CircularPatternFeature::SetAxis(double x, double y, double z) {
+    SetParameter("axis_x", x);
+    SetParameter("axis_y", y);
+    SetParameter("axis_z", z);
+}
+
+void CircularPatternFeature::GetAxis(double& x, double& y, double& z) const {
+    x = GetParameter("axis_x");
+    y = GetParameter("axis_y");
+    z = GetParameter("axis_z");
+}
+
+void CircularPatternFeature::SetAxisOrigin(double x, double y, double z) {
+    SetParameter("axis_origin_x", x);
+    SetParameter("axis_origin_y", y);
+    SetParameter("axis_origin_z", z);
+}
+
+void CircularPatternFeature::GetAxisOrigin(double& x, double& y, double& z) const {
+    x = GetParameter("axis_origin_x");
+    y = GetParameter("axis_origin_y");
+    z = GetParameter("axis_origin_z");
+}
+
+void CircularPatternFeature::SetCount(int count) {
+    SetParameter("count", static_cast<double>(count));
+}
+
+int CircularPatternFeature::GetCount() const {
+    return static_cast<int>(GetParameter("count"));
+}
+
+void CircularPatternFeature::SetAngle(double angle) {
+    SetParameter("angle", angle);
+}
+
+double CircularPatternFeature::GetAngle() const {
+    return GetParameter("angle");
+}
+
+std::shared_ptr<Feature> CircularPatternFeature::Clone() const {
+    return std::make_shared<CircularPatternFeature>(*this);
+}
+
+std::vector<gp_Trsf> CircularPatternFeature::ComputeTransforms() const {
+    double ax, ay, az, ox, oy, oz;
+    GetAxis(ax, ay, az);
+    GetAxisOrigin(ox, oy, oz);
+    gp_Ax1 axis(gp_Pnt(ox, oy, oz), gp_Dir(ax, ay, az));
+
+    int count = GetCount();
+    double angle = GetAngle();
+
+    // 整圈时首尾会重合，均分成count份；不满一圈则首尾都放实例
+    bool fullTurn = std::abs(angle - 2.0 * M_PI) < 1e-9;
+    double step = (fullTurn || count < 2) ? angle / count : angle / (count - 1);
+
+    std::vector<gp_Trsf> transforms;
+    transforms.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        gp_Trsf trsf;
+        trsf.SetRotation(axis, step * i);
+        transforms.push_back(trsf);
+    }
+    return transforms;
+}
+
+bool CircularPatternFeature::ValidatePattern() const {
+    if (GetCount() < 1) {
+        return false;
+    }
+
+    double angle = GetAngle();
+    if (angle <= 0.0 || angle > 2.0 * M_PI + 1e-9) {
+        return false;
+    }
+
+    double ax, ay, az;
+    GetAxis(ax, ay, az);
+    return std::sqrt(ax*ax + ay*ay + az*az) >= 1e-10;
+}
+
+} // namespace cad_feature
@@ -1,7 +1,14 @@
 #include "cad_feature/ExtrudeFeature.h"
-#include "cad_core/CreateBoxCommand.h"
+#include "cad_feature/FeatureCommand.h"
+#include "cad_feature/ProfileCache.h"
+#include "cad_core/RegenerationProfiler.h"
 #include <BRepPrimAPI_MakePrism.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <LocOpe_DPrism.hxx>
+#include <Standard_Failure.hxx>
+#include <gp_Trsf.hxx>
 #include <gp_Vec.hxx>
+#include <cmath>
 
 namespace cad_feature {
 
@@ -72,7 +79,19 @@ cad_core::ShapePtr ExtrudeFeature::CreateShape() const {
         return nullptr;
     }
     
-    return ExtrudeSketch();
+    return ExtrudeSketch(ProfileFidelity::Exact);
+}
+
+cad_core::ShapePtr ExtrudeFeature::CreateCoarsePreviewShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+    
+    return ExtrudeSketch(ProfileFidelity::Coarse);
+}
+
+std::shared_ptr<Feature> ExtrudeFeature::Clone() const {
+    return std::make_shared<ExtrudeFeature>(*this);
 }
 
 bool ExtrudeFeature::ValidateParameters() const {
@@ -96,33 +115,59 @@ bool ExtrudeFeature::ValidateParameters() const {
 }
 
 std::shared_ptr<cad_core::ICommand> ExtrudeFeature::CreateCommand() const {
-    // For now, return a simple box command as placeholder
-    return std::make_shared<cad_core::CreateBoxCommand>(GetDistance(), GetDistance(), GetDistance());
+    return std::make_shared<FeatureCommand>(Clone());
 }
 
 bool ExtrudeFeature::IsSketchValid() const {
     return m_sketch && !m_sketch->IsEmpty();
 }
 
-cad_core::ShapePtr ExtrudeFeature::ExtrudeSketch() const {
+cad_core::ShapePtr ExtrudeFeature::ExtrudeSketch(ProfileFidelity fidelity) const {
     if (!IsSketchValid()) {
         return nullptr;
     }
     
     try {
-        // In a real implementation, this would:
-        // 1. Convert sketch elements to OCCT wire/face
-        // 2. Create extrusion vector from direction and distance
-        // 3. Use BRepPrimAPI_MakePrism to create the solid
+        TopoDS_Face face = ProfileCache::Instance().GetFace(m_sketch, fidelity);
+        if (face.IsNull()) {
+            return nullptr;
+        }
         
-        // For now, return a simple box as placeholder
+        double dx, dy, dz;
+        GetDirection(dx, dy, dz);
+        gp_Vec direction(dx, dy, dz);
+        direction.Normalize();
         double distance = GetDistance();
-        auto shape = std::make_shared<cad_core::Shape>();
         
-        // Placeholder: create a simple box
-        // In real implementation, this would properly extrude the sketch
+        TopoDS_Shape solid;
+        double taper = GetTaperAngle();
+        if (fidelity == ProfileFidelity::Exact && std::abs(taper) > 1e-9) {
+            // 拔模拉伸只支持沿草图法向，粗略预览直接忽略拔模
+            cad_core::RegenerationProfiler::ScopedCall call("LocOpe_DPrism");
+            LocOpe_DPrism draftPrism(face, distance, taper);
+            if (!draftPrism.IsDone()) {
+                return nullptr;
+            }
+            solid = draftPrism.Shape();
+        } else {
+            cad_core::RegenerationProfiler::ScopedCall call("BRepPrimAPI_MakePrism");
+            BRepPrimAPI_MakePrism prism(face, direction * distance);
+            if (!prism.IsDone()) {
+                return nullptr;
+            }
+            solid = prism.Shape();
+        }
         
-        return shape;
+        if (GetMidplane()) {
+            // 对称拉伸：整体往回移一半
+            gp_Trsf shift;
+            shift.SetTranslation(direction * (-distance / 2.0));
+            solid = BRepBuilderAPI_Transform(solid, shift, Standard_True).Shape();
+        }
+        
+        return std::make_shared<cad_core::Shape>(solid);
+    } catch (const Standard_Failure&) {
+        return nullptr;
     } catch (...) {
         return nullptr;
     }
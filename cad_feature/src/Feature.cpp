@@ -2,7 +2,7 @@
 
 namespace cad_feature {
 
-int Feature::s_nextId = 1;
+std::atomic<int> Feature::s_nextId(1);
 
 Feature::Feature(FeatureType type, const std::string& name)
     : m_type(type), m_name(name), m_id(s_nextId++), m_state(FeatureState::Created), m_active(true) {
@@ -60,8 +60,20 @@ bool Feature::HasParameter(const std::string& name) const {
     return m_parameters.find(name) != m_parameters.end();
 }
 
+const std::map<std::string, double>& Feature::GetParameters() const {
+    return m_parameters;
+}
+
 cad_core::ShapePtr Feature::CreatePreviewShape() const {
     return CreateShape();
 }
 
+cad_core::ShapePtr Feature::CreateCoarsePreviewShape() const {
+    return nullptr;
+}
+
+std::vector<cad_core::ShapePtr> Feature::GetInputShapes() const {
+    return std::vector<cad_core::ShapePtr>();
+}
+
 } // namespace cad_feature
\ No newline at end of file
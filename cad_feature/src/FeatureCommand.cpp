@@ -0,0 +1,56 @@
+#include "cad_feature/FeatureCommand.h"
+
+namespace cad_feature {
+
+FeatureCommand::FeatureCommand(const FeaturePtr& feature)
+    : m_feature(feature), m_executed(false) {
+    m_name = "Create " + (feature ? feature->GetName() : std::string("Feature"));
+}
+
+bool FeatureCommand::Execute() {
+    if (m_executed) {
+        return true;
+    }
+
+    if (!m_feature) {
+        return false;
+    }
+
+    m_createdShape = m_feature->CreateShape();
+
+    m_executed = (m_createdShape != nullptr && m_createdShape->IsValid());
+    m_feature->SetState(m_executed ? FeatureState::Executed : FeatureState::Failed);
+    return m_executed;
+}
+
+bool FeatureCommand::Undo() {
+    if (!m_executed) {
+        return false;
+    }
+
+    m_createdShape.reset();
+    m_executed = false;
+    return true;
+}
+
+bool FeatureCommand::Redo() {
+    if (m_executed) {
+        return true;
+    }
+
+    return Execute();
+}
+
+const char* FeatureCommand::GetName() const {
+    return m_name.c_str();
+}
+
+cad_core::ShapePtr FeatureCommand::GetCreatedShape() const {
+    return m_createdShape;
+}
+
+const FeaturePtr& FeatureCommand::GetFeature() const {
+    return m_feature;
+}
+
+} // namespace cad_feature
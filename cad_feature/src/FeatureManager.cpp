@@ -1,4 +1,6 @@
 #include "cad_feature/FeatureManager.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
 #include <algorithm>
 
 namespace cad_feature {
@@ -50,27 +52,24 @@ bool FeatureManager::ExecuteFeature(const FeaturePtr& feature) {
         return false;
     }
     
-    if (!feature->ValidateParameters()) {
-        feature->SetState(FeatureState::Failed);
-        return false;
-    }
-    
-    auto shape = feature->CreateShape();
-    if (shape) {
-        feature->SetState(FeatureState::Executed);
-        NotifyFeatureUpdated(feature);
-        return true;
-    } else {
-        feature->SetState(FeatureState::Failed);
-        return false;
-    }
+    return FinishFeature(feature, BuildFeature(feature));
 }
 
 bool FeatureManager::ExecuteAllFeatures() {
-    bool allSucceeded = true;
+    // 每个特征只从自己的草图和输入形状生成，互不依赖，在任务池里并行生成；
+    // 状态和通知（回调会更新界面）回到调用线程按原顺序处理
+    std::vector<char> built(m_features.size(), 0);
+    cad_core::TaskScheduler::Instance().ParallelFor(0, static_cast<int>(m_features.size()), [&](int index) {
+        const FeaturePtr& feature = m_features[index];
+        if (feature && feature->IsActive()) {
+            built[index] = BuildFeature(feature) ? 1 : 0;
+        }
+    });
     
-    for (const auto& feature : m_features) {
-        if (!ExecuteFeature(feature)) {
+    bool allSucceeded = true;
+    for (size_t i = 0; i < m_features.size(); ++i) {
+        const FeaturePtr& feature = m_features[i];
+        if (!feature || !feature->IsActive() || !FinishFeature(feature, built[i] != 0)) {
             allSucceeded = false;
         }
     }
@@ -130,6 +129,21 @@ bool FeatureManager::IsEmpty() const {
     return m_features.empty();
 }
 
+std::vector<cad_core::NativeDocumentFile::FeatureRecord> FeatureManager::GetFeatureRecords() const {
+    std::vector<cad_core::NativeDocumentFile::FeatureRecord> records;
+    records.reserve(m_features.size());
+    for (const auto& feature : m_features) {
+        cad_core::NativeDocumentFile::FeatureRecord record;
+        record.id = feature->GetId();
+        record.type = static_cast<int>(feature->GetType());
+        record.name = feature->GetName();
+        record.active = feature->IsActive();
+        record.parameters.assign(feature->GetParameters().begin(), feature->GetParameters().end());
+        records.push_back(record);
+    }
+    return records;
+}
+
 void FeatureManager::SetFeatureAddedCallback(std::function<void(const FeaturePtr&)> callback) {
     m_featureAddedCallback = callback;
 }
@@ -142,6 +156,41 @@ void FeatureManager::SetFeatureUpdatedCallback(std::function<void(const FeatureP
     m_featureUpdatedCallback = callback;
 }
 
+bool FeatureManager::BuildFeature(const FeaturePtr& feature) const {
+    CAD_TRACE_ZONE_CAT("FeatureManager::ExecuteFeature", "feature");
+    // 作用域结束时写入重建记录，通知在FinishFeature里才能读到这次的数据
+    cad_core::RegenerationProfiler::ScopedFeature profile(feature->GetId(), feature->GetName());
+    
+    int facesIn = 0;
+    for (const auto& input : feature->GetInputShapes()) {
+        if (input) {
+            facesIn += cad_core::RegenerationProfiler::CountFaces(input->GetOCCTShape());
+        }
+    }
+    profile.SetFacesIn(facesIn);
+    
+    if (!feature->ValidateParameters()) {
+        profile.SetResult(TopoDS_Shape(), false);
+        return false;
+    }
+    
+    auto shape = feature->CreateShape();
+    bool succeeded = (shape != nullptr);
+    profile.SetResult(shape ? shape->GetOCCTShape() : TopoDS_Shape(), succeeded);
+    return succeeded;
+}
+
+bool FeatureManager::FinishFeature(const FeaturePtr& feature, bool succeeded) {
+    if (succeeded) {
+        feature->SetState(FeatureState::Executed);
+        NotifyFeatureUpdated(feature);
+        return true;
+    } else {
+        feature->SetState(FeatureState::Failed);
+        return false;
+    }
+}
+
 int FeatureManager::FindFeatureIndex(const FeaturePtr& feature) const {
     auto it = std::find(m_features.begin(), m_features.end(), feature);
     if (it != m_features.end()) {
@@ -0,0 +1,132 @@
+#include "cad_feature/LinearPatternFeature.h"
+#include <gp_Vec.hxx>
+#include <cmath>
+
+namespace cad_feature {
+
+LinearPatternFeature::LinearPatternFeature() : PatternFeature(FeatureType::LinearPattern, "LinearPattern") {
+    InitializeParameters();
+}
+
+LinearPatternFeature::LinearPatternFeature(const std::string& name) : PatternFeature(FeatureType::LinearPattern, name) {
+    InitializeParameters();
+}
+
+void LinearPatternFeature::InitializeParameters() {
+    SetParameter("direction_x", 1.0);
+    SetParameter("direction_y", 0.0);
+    SetParameter("direction_z", 0.0);
+    SetParameter("spacing", 10.0);
+    SetParameter("count", 2.0);
+    SetParameter("direction2_x", 0.0);
+    SetParameter("direction2_y", 1.0);
+    SetParameter("direction2_z", 0.0);
+    SetParameter("spacing2", 10.0);
+    SetParameter("count2", 1.0);
+}
+
+void LinearPatternFeature::SetDirection(double x, double y, double z) {
+    SetParameter("direction_x", x);
+    SetParameter("direction_y", y);
+    SetParameter("direction_z", z);
+}
+
+void LinearPatternFeature::GetDirection(double& x, double& y, double& z) const {
+    x = GetParameter("direction_x");
+    y = GetParameter("direction_y");
+    z = GetParameter("direction_z");
+}
+
+void LinearPatternFeature::SetSpacing(double spacing) {
+    SetParameter("spacing", spacing);
+}
+
+double LinearPatternFeature::GetSpacing() const {
+    return GetParameter("spacing");
+}
+
+void LinearPatternFeature::SetCount(int count) {
+    SetParameter("count", static_cast<double>(count));
+}
+
+int LinearPatternFeature::GetCount() const {
+    return static_cast<int>(GetParameter("count"));
+}
+
+void LinearPatternFeature::SetDirection2(double x, double y, double z) {
+    SetParameter("direction2_x", x);
+    SetParameter("direction2_y", y);
+    SetParameter("direction2_z", z);
+}
+
+void LinearPatternFeature::GetDirection2(double& x, double& y, double& z) const {
+    x = GetParameter("direction2_x");
+    y = GetParameter("direction2_y");
+    z = GetParameter("direction2_z");
+}
+
+void LinearPatternFeature::SetSpacing2(double spacing) {
+    SetParameter("spacing2", spacing);
+}
+
+double LinearPatternFeature::GetSpacing2() const {
+    return GetParameter("spacing2");
+}
+
+void LinearPatternFeature::SetCount2(int count) {
+    SetParameter("count2", static_cast<double>(count));
+}
+
+int LinearPatternFeature::GetCount2() const {
+    return static_cast<int>(GetParameter("count2"));
+}
+
+std::shared_ptr<Feature> LinearPatternFeature::Clone() const {
+    return std::make_shared<LinearPatternFeature>(*this);
+}
+
+std::vector<gp_Trsf> LinearPatternFeature::ComputeTransforms() const {
+    double dx, dy, dz;
+    GetDirection(dx, dy, dz);
+    gp_Vec step1 = gp_Vec(dx, dy, dz).Normalized() * GetSpacing();
+
+    int count2 = GetCount2();
+    gp_Vec step2;
+    if (count2 > 1) {
+        GetDirection2(dx, dy, dz);
+        step2 = gp_Vec(dx, dy, dz).Normalized() * GetSpacing2();
+    }
+
+    std::vector<gp_Trsf> transforms;
+    transforms.reserve(static_cast<size_t>(GetCount()) * count2);
+    for (int j = 0; j < count2; ++j) {
+        for (int i = 0; i < GetCount(); ++i) {
+            gp_Trsf trsf;
+            trsf.SetTranslation(step1 * i + step2 * j);
+            transforms.push_back(trsf);
+        }
+    }
+    return transforms;
+}
+
+bool LinearPatternFeature::ValidatePattern() const {
+    if (GetCount() < 1 || GetCount2() < 1) {
+        return false;
+    }
+
+    double dx, dy, dz;
+    GetDirection(dx, dy, dz);
+    if (std::sqrt(dx*dx + dy*dy + dz*dz) < 1e-10) {
+        return false;
+    }
+
+    if (GetCount2() > 1) {
+        GetDirection2(dx, dy, dz);
+        if (std::sqrt(dx*dx + dy*dy + dz*dz) < 1e-10) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace cad_feature
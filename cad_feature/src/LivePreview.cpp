@@ -1,12 +1,24 @@
 #include "cad_feature/LivePreview.h"
+#include "cad_core/TaskScheduler.h"
+#include <QFutureInterface>
 
 namespace cad_feature {
 
-LivePreview::LivePreview(QObject* parent) : QObject(parent), m_previewActive(false), m_updateDelay(500) {
+LivePreview::LivePreview(QObject* parent)
+    : QObject(parent), m_previewActive(false), m_updateDelay(500),
+      m_generation(0), m_exactGeneration(0), m_exactQueued(false), m_coarseShown(false) {
     m_updateTimer = new QTimer(this);
     m_updateTimer->setSingleShot(true);
     
+    m_exactWatcher = new QFutureWatcher<cad_core::ShapePtr>(this);
+    
     connect(m_updateTimer, &QTimer::timeout, this, &LivePreview::OnUpdateTimer);
+    connect(m_exactWatcher, &QFutureWatcher<cad_core::ShapePtr>::finished, this, &LivePreview::OnExactPreviewFinished);
+}
+
+LivePreview::~LivePreview() {
+    // 工作线程里还拿着特征快照，等它算完再走
+    m_exactWatcher->waitForFinished();
 }
 
 void LivePreview::SetFeature(const FeaturePtr& feature) {
@@ -29,6 +41,11 @@ void LivePreview::StartPreview() {
 void LivePreview::StopPreview() {
     m_previewActive = false;
     m_updateTimer->stop();
+    
+    // 正在计算的精确结果作废
+    ++m_generation;
+    m_exactQueued = false;
+    m_coarseShown = false;
     ClearPreviewShape();
 }
 
@@ -37,7 +54,12 @@ void LivePreview::UpdatePreview() {
         return;
     }
     
-    // Restart the timer to delay the update
+    ++m_generation;
+    
+    // 粗略结果同步给出，保证拖动时每一帧都有反馈
+    UpdateCoarsePreviewShape();
+    
+    // Restart the timer to delay the exact update
     m_updateTimer->start(m_updateDelay);
 }
 
@@ -69,12 +91,62 @@ void LivePreview::SetPreviewClearCallback(std::function<void()> callback) {
     m_previewClearCallback = callback;
 }
 
+void LivePreview::SetTieredPreviewCallback(std::function<void(const cad_core::ShapePtr&, PreviewTier)> callback) {
+    m_tieredPreviewCallback = callback;
+}
+
+bool LivePreview::IsExactPreviewPending() const {
+    return m_updateTimer->isActive() || m_exactWatcher->isRunning();
+}
+
 void LivePreview::OnUpdateTimer() {
     if (m_previewActive && m_feature) {
         UpdatePreviewShape();
     }
 }
 
+void LivePreview::OnExactPreviewFinished() {
+    if (!m_previewActive) {
+        return;
+    }
+    
+    // 计算期间参数又变了：直接用最新参数再算一遍
+    if (m_exactQueued) {
+        m_exactQueued = false;
+        StartExactPreview();
+        return;
+    }
+    
+    // 过期结果丢弃，等计时器触发新的计算
+    if (m_exactGeneration != m_generation) {
+        return;
+    }
+    
+    auto exactShape = m_exactWatcher->result();
+    
+    // 精确计算失败时保留粗略结果，不让预览闪没
+    if ((!exactShape || !exactShape->IsValid()) && m_coarseShown) {
+        return;
+    }
+    
+    DeliverPreviewShape(exactShape, PreviewTier::Exact);
+}
+
+void LivePreview::UpdateCoarsePreviewShape() {
+    if (!m_feature) {
+        return;
+    }
+    
+    // Set feature state to previewing
+    m_feature->SetState(FeatureState::Previewing);
+    
+    auto coarseShape = m_feature->CreateCoarsePreviewShape();
+    m_coarseShown = coarseShape && coarseShape->IsValid();
+    if (m_coarseShown) {
+        DeliverPreviewShape(coarseShape, PreviewTier::Coarse);
+    }
+}
+
 void LivePreview::UpdatePreviewShape() {
     if (!m_feature) {
         return;
@@ -83,12 +155,44 @@ void LivePreview::UpdatePreviewShape() {
     // Set feature state to previewing
     m_feature->SetState(FeatureState::Previewing);
     
-    // Create preview shape
-    auto previewShape = m_feature->CreatePreviewShape();
+    StartExactPreview();
+}
+
+void LivePreview::StartExactPreview() {
+    if (!m_feature) {
+        return;
+    }
     
-    // Notify callback
-    if (m_previewUpdateCallback) {
-        m_previewUpdateCallback(previewShape);
+    // 同一时间只跑一个后台计算，多余的请求合并成一次
+    if (m_exactWatcher->isRunning()) {
+        m_exactQueued = true;
+        return;
+    }
+    
+    // 后台线程使用参数快照；草图对象仍然共享，预览期间不应编辑草图。
+    // 在共享任务池里以交互优先级计算，排在后台的三角化、导出前面
+    FeaturePtr snapshot = m_feature->Clone();
+    m_exactGeneration = m_generation;
+    QFutureInterface<cad_core::ShapePtr> promise;
+    promise.reportStarted();
+    m_exactWatcher->setFuture(promise.future());
+    cad_core::TaskScheduler::Instance().Submit([promise, snapshot]() mutable {
+        cad_core::ShapePtr shape;
+        try {
+            shape = snapshot->CreatePreviewShape();
+        } catch (...) {
+            // 无论成败都要完成future，否则watcher永远等下去
+        }
+        promise.reportResult(shape);
+        promise.reportFinished();
+    }, cad_core::TaskPriority::Interactive);
+}
+
+void LivePreview::DeliverPreviewShape(const cad_core::ShapePtr& shape, PreviewTier tier) {
+    if (m_tieredPreviewCallback) {
+        m_tieredPreviewCallback(shape, tier);
+    } else if (m_previewUpdateCallback) {
+        m_previewUpdateCallback(shape);
     }
 }
 
@@ -1,20 +1,150 @@
 #include "cad_feature/LoftFeature.h"
-#include "cad_core/CreateSphereCommand.h"
+#include "cad_feature/FeatureCommand.h"
+#include "cad_feature/ProfileCache.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/TaskScheduler.h"
 #include <BRepOffsetAPI_ThruSections.hxx>
+#include <BRepOffsetAPI_MakePipeShell.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepTools_WireExplorer.hxx>
+#include <BRep_Tool.hxx>
+#include <GCPnts_AbscissaPoint.hxx>
+#include <Geom_Curve.hxx>
+#include <Geom_Plane.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <gp.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 #include <algorithm>
+#include <cmath>
 
 namespace cad_feature {
 
+namespace {
+
+// 所有截面统一成绕+Z逆时针，避免放样时面片扭成麻花
+TopoDS_Wire OrientCounterClockwise(const TopoDS_Wire& wire) {
+    if (!BRep_Tool::IsClosed(wire)) {
+        return wire;
+    }
+    BRepBuilderAPI_MakeFace faceMaker(wire, Standard_True);
+    if (!faceMaker.IsDone()) {
+        return wire;
+    }
+    TopoDS_Face face = faceMaker.Face();
+    Handle(Geom_Plane) plane = Handle(Geom_Plane)::DownCast(BRep_Tool::Surface(face));
+    if (plane.IsNull()) {
+        return wire;
+    }
+    gp_Dir normal = plane->Axis().Direction();
+    if (face.Orientation() == TopAbs_REVERSED) {
+        normal.Reverse();
+    }
+    return normal.Z() < 0.0 ? TopoDS::Wire(wire.Reversed()) : wire;
+}
+
+std::vector<TopoDS_Edge> OrderedEdges(const TopoDS_Wire& wire) {
+    std::vector<TopoDS_Edge> edges;
+    for (BRepTools_WireExplorer it(wire); it.More(); it.Next()) {
+        edges.push_back(it.Current());
+    }
+    return edges;
+}
+
+TopoDS_Wire RebuildWire(const std::vector<TopoDS_Edge>& edges, const TopoDS_Wire& fallback) {
+    BRepBuilderAPI_MakeWire maker;
+    for (const auto& edge : edges) {
+        maker.Add(edge);
+    }
+    return maker.IsDone() ? maker.Wire() : fallback;
+}
+
+// 边数补到target：每次把最长的边从参数中点一分为二
+TopoDS_Wire SplitToEdgeCount(const TopoDS_Wire& wire, int target) {
+    std::vector<TopoDS_Edge> edges = OrderedEdges(wire);
+    if (edges.empty() || static_cast<int>(edges.size()) >= target) {
+        return wire;
+    }
+    std::vector<double> lengths;
+    for (const auto& edge : edges) {
+        lengths.push_back(GCPnts_AbscissaPoint::Length(BRepAdaptor_Curve(edge)));
+    }
+    
+    while (static_cast<int>(edges.size()) < target) {
+        size_t longest = std::max_element(lengths.begin(), lengths.end()) - lengths.begin();
+        Standard_Real first = 0.0;
+        Standard_Real last = 0.0;
+        Handle(Geom_Curve) curve = BRep_Tool::Curve(edges[longest], first, last);
+        if (curve.IsNull()) {
+            return wire;
+        }
+        const Standard_Real middle = 0.5 * (first + last);
+        TopoDS_Edge head = BRepBuilderAPI_MakeEdge(curve, first, middle).Edge();
+        TopoDS_Edge tail = BRepBuilderAPI_MakeEdge(curve, middle, last).Edge();
+        // 反向的边沿线框走向是先tail后head
+        if (edges[longest].Orientation() == TopAbs_REVERSED) {
+            std::swap(head, tail);
+            head.Reverse();
+            tail.Reverse();
+        }
+        const double half = 0.5 * lengths[longest];
+        edges[longest] = head;
+        lengths[longest] = half;
+        edges.insert(edges.begin() + longest + 1, tail);
+        lengths.insert(lengths.begin() + longest + 1, half);
+    }
+    return RebuildWire(edges, wire);
+}
+
+// 闭合截面的起点挪到离参考点（XY投影）最近的顶点，避免放样面扭转
+TopoDS_Wire AlignStartVertex(const TopoDS_Wire& wire, const gp_Pnt& reference) {
+    if (!BRep_Tool::IsClosed(wire)) {
+        return wire;
+    }
+    std::vector<TopoDS_Edge> edges = OrderedEdges(wire);
+    size_t start = 0;
+    double best = -1.0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        gp_Pnt p = BRep_Tool::Pnt(TopExp::FirstVertex(edges[i], Standard_True));
+        double distance = gp_Pnt(p.X(), p.Y(), 0.0).SquareDistance(gp_Pnt(reference.X(), reference.Y(), 0.0));
+        if (best < 0.0 || distance < best) {
+            best = distance;
+            start = i;
+        }
+    }
+    if (start == 0) {
+        return wire;
+    }
+    std::rotate(edges.begin(), edges.begin() + start, edges.end());
+    return RebuildWire(edges, wire);
+}
+
+} // namespace
+
 LoftFeature::LoftFeature() : Feature(FeatureType::Loft, "Loft") {
     SetParameter("solid", 1.0);
     SetParameter("ruled", 0.0);
     SetParameter("closed", 0.0);
+    SetParameter("section_spacing", 10.0);
+    m_resultCache = std::make_shared<ResultCache>();
 }
 
 LoftFeature::LoftFeature(const std::string& name) : Feature(FeatureType::Loft, name) {
     SetParameter("solid", 1.0);
     SetParameter("ruled", 0.0);
     SetParameter("closed", 0.0);
+    SetParameter("section_spacing", 10.0);
+    m_resultCache = std::make_shared<ResultCache>();
 }
 
 void LoftFeature::AddSection(const cad_sketch::SketchPtr& section) {
@@ -87,6 +217,14 @@ bool LoftFeature::GetClosed() const {
     return GetParameter("closed") != 0.0;
 }
 
+void LoftFeature::SetSectionSpacing(double spacing) {
+    SetParameter("section_spacing", spacing);
+}
+
+double LoftFeature::GetSectionSpacing() const {
+    return GetParameter("section_spacing");
+}
+
 cad_core::ShapePtr LoftFeature::CreateShape() const {
     if (!ValidateParameters()) {
         return nullptr;
@@ -95,6 +233,48 @@ cad_core::ShapePtr LoftFeature::CreateShape() const {
     return LoftSections();
 }
 
+cad_core::ShapePtr LoftFeature::CreateCoarsePreviewShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+    
+    try {
+        // 粗略预览：抽取少量截面（保留首尾），折线截面直纹放样，忽略引导线
+        int count = GetSectionCount();
+        int used = std::min(count, kCoarseMaxSections);
+        
+        BRepOffsetAPI_ThruSections loft(GetSolid() ? Standard_True : Standard_False, Standard_True);
+        loft.CheckCompatibility(Standard_False);
+        TopoDS_Wire first;
+        for (int i = 0; i < used; ++i) {
+            int index = (used == 1) ? 0 : static_cast<int>(std::lround(static_cast<double>(i) * (count - 1) / (used - 1)));
+            TopoDS_Wire wire = MakeSectionWire(index, ProfileFidelity::Coarse);
+            if (wire.IsNull()) {
+                return nullptr;
+            }
+            loft.AddWire(wire);
+            if (i == 0) {
+                first = wire;
+            }
+        }
+        if (GetClosed()) {
+            loft.AddWire(MakeClosingWire(first));
+        }
+        
+        loft.Build();
+        if (!loft.IsDone()) {
+            return nullptr;
+        }
+        return std::make_shared<cad_core::Shape>(loft.Shape());
+    } catch (const Standard_Failure&) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<Feature> LoftFeature::Clone() const {
+    return std::make_shared<LoftFeature>(*this);
+}
+
 bool LoftFeature::ValidateParameters() const {
     if (!AreSectionsValid()) {
         return false;
@@ -104,12 +284,16 @@ bool LoftFeature::ValidateParameters() const {
         return false;
     }
     
+    // 只支持一条引导线
+    if (GetGuideCurveCount() > 1) {
+        return false;
+    }
+    
     return true;
 }
 
 std::shared_ptr<cad_core::ICommand> LoftFeature::CreateCommand() const {
-    // For now, return a simple sphere command as placeholder
-    return std::make_shared<cad_core::CreateSphereCommand>(5.0);
+    return std::make_shared<FeatureCommand>(Clone());
 }
 
 bool LoftFeature::AreSectionsValid() const {
@@ -131,27 +315,196 @@ bool LoftFeature::AreGuideCurvesValid() const {
 }
 
 cad_core::ShapePtr LoftFeature::LoftSections() const {
-    if (!AreSectionsValid() || GetSectionCount() < 2) {
+    if (!AreSectionsValid() || GetSectionCount() < 2 || !AreGuideCurvesValid() || GetGuideCurveCount() > 1) {
         return nullptr;
     }
     
+    auto inputs = CollectInputRevisions();
+    {
+        // 返回新的Shape对象：调用方改位置/颜色不会影响缓存
+        std::lock_guard<std::mutex> lock(m_resultCache->mutex);
+        if (!m_resultCache->shape.IsNull() && SameInputs(m_resultCache->inputs, inputs)
+            && m_resultCache->parameters == m_parameters) {
+            cad_core::RegenerationProfiler::RecordCacheHit();
+            return std::make_shared<cad_core::Shape>(m_resultCache->shape);
+        }
+    }
+    cad_core::RegenerationProfiler::RecordCacheMiss();
+    
     try {
-        // In a real implementation, this would:
-        // 1. Convert section sketches to OCCT wires
-        // 2. Optionally convert guide curves to OCCT wires
-        // 3. Use BRepOffsetAPI_ThruSections to create the lofted solid
-        // 4. Apply solid/ruled/closed parameters
+        // 截面转换 + 方向统一彼此独立，几十个截面时并行做
+        int count = GetSectionCount();
+        std::vector<TopoDS_Wire> wires(count);
+        {
+            cad_core::RegenerationProfiler::ScopedCall prepare("LoftSectionPreparation");
+            cad_core::TaskScheduler::Instance().ParallelFor(0, count, [this, &wires](int index) {
+                try {
+                    wires[index] = MakeSectionWire(index, ProfileFidelity::Exact);
+                } catch (const Standard_Failure&) {
+                    wires[index] = TopoDS_Wire();
+                }
+            }, cad_core::TaskPriority::Normal);
+        }
         
-        // For now, return a simple shape as placeholder
-        auto shape = std::make_shared<cad_core::Shape>();
+        for (const auto& wire : wires) {
+            if (wire.IsNull()) {
+                return nullptr;
+            }
+        }
         
-        // Placeholder: create a simple sphere-like shape
-        // In real implementation, this would properly loft between sections
+        // 兼容性处理（统一边数、对齐起点）也按截面并行做，ThruSections里就不再串行检查
+        if (m_guideCurves.empty()) {
+            MakeSectionsCompatible(wires);
+        }
+        
+        // 闭合放样：在最后一个截面之后再放一份第一个截面
+        if (GetClosed()) {
+            wires.push_back(MakeClosingWire(wires.front()));
+        }
         
-        return shape;
+        TopoDS_Shape result;
+        if (!m_guideCurves.empty()) {
+            result = LoftAlongGuide(wires);
+        } else {
+            BRepOffsetAPI_ThruSections loft(GetSolid() ? Standard_True : Standard_False,
+                                            GetRuled() ? Standard_True : Standard_False);
+            loft.CheckCompatibility(Standard_False);
+            for (const auto& wire : wires) {
+                loft.AddWire(wire);
+            }
+            cad_core::RegenerationProfiler::ScopedCall call("BRepOffsetAPI_ThruSections");
+            loft.Build();
+            if (loft.IsDone()) {
+                result = loft.Shape();
+            }
+        }
+        
+        if (result.IsNull()) {
+            return nullptr;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(m_resultCache->mutex);
+            m_resultCache->inputs = inputs;
+            m_resultCache->parameters = m_parameters;
+            m_resultCache->shape = result;
+        }
+        return std::make_shared<cad_core::Shape>(result);
+    } catch (const Standard_Failure&) {
+        return nullptr;
     } catch (...) {
         return nullptr;
     }
 }
 
+void LoftFeature::MakeSectionsCompatible(std::vector<TopoDS_Wire>& wires) const {
+    int target = 0;
+    for (const auto& wire : wires) {
+        target = std::max(target, static_cast<int>(OrderedEdges(wire).size()));
+    }
+    
+    // 各截面只和第一个截面的起点比较，彼此独立
+    std::vector<TopoDS_Edge> firstEdges = OrderedEdges(wires.front());
+    if (firstEdges.empty()) {
+        return;
+    }
+    const gp_Pnt reference = BRep_Tool::Pnt(TopExp::FirstVertex(firstEdges.front(), Standard_True));
+    
+    cad_core::RegenerationProfiler::ScopedCall call("LoftSectionCompatibility");
+    cad_core::TaskScheduler::Instance().ParallelFor(0, static_cast<int>(wires.size()), [&wires, target, &reference](int index) {
+        try {
+            wires[index] = AlignStartVertex(SplitToEdgeCount(wires[index], target), reference);
+        } catch (const Standard_Failure&) {
+            // 保留原截面，交给ThruSections报错
+        }
+    }, cad_core::TaskPriority::Normal);
+}
+
+TopoDS_Shape LoftFeature::LoftAlongGuide(const std::vector<TopoDS_Wire>& wires) const {
+    // ThruSections不支持引导线：沿Z轴直线脊线做PipeShell，引导线作为辅助脊线控制截面走向
+    double length = (static_cast<int>(wires.size()) - 1) * GetSectionSpacing();
+    TopoDS_Wire spine = BRepBuilderAPI_MakeWire(
+        BRepBuilderAPI_MakeEdge(gp::Origin(), gp_Pnt(0.0, 0.0, length)).Edge()).Wire();
+    
+    // PipeShell只有一条辅助脊线，ValidateParameters已拒绝多条引导线
+    TopoDS_Wire guide = MakeGuideWire(0);
+    if (guide.IsNull()) {
+        return TopoDS_Shape();
+    }
+    
+    cad_core::RegenerationProfiler::ScopedCall call("BRepOffsetAPI_MakePipeShell");
+    BRepOffsetAPI_MakePipeShell pipe(spine);
+    pipe.SetMode(guide, Standard_True, BRepFill_NoContact);
+    for (const auto& wire : wires) {
+        pipe.Add(wire, Standard_False, Standard_False);
+    }
+    pipe.Build();
+    if (!pipe.IsDone()) {
+        return TopoDS_Shape();
+    }
+    if (GetSolid()) {
+        pipe.MakeSolid();
+    }
+    return pipe.Shape();
+}
+
+TopoDS_Wire LoftFeature::MakeSectionWire(int index, ProfileFidelity fidelity) const {
+    std::vector<TopoDS_Wire> wires = ProfileCache::Instance().GetWires(m_sections[index], fidelity);
+    if (wires.empty()) {
+        return TopoDS_Wire();
+    }
+    
+    // 截面草图都画在XY平面上，按序号沿Z轴依次排开
+    gp_Trsf placement;
+    placement.SetTranslation(gp_Vec(0.0, 0.0, index * GetSectionSpacing()));
+    TopoDS_Wire placed = TopoDS::Wire(BRepBuilderAPI_Transform(wires.front(), placement, Standard_True).Shape());
+    return OrientCounterClockwise(placed);
+}
+
+TopoDS_Wire LoftFeature::MakeClosingWire(const TopoDS_Wire& first) const {
+    // first已经放在Z=0处（序号0），平移到最后一个截面之后的位置
+    gp_Trsf placement;
+    placement.SetTranslation(gp_Vec(0.0, 0.0, GetSectionCount() * GetSectionSpacing()));
+    return TopoDS::Wire(BRepBuilderAPI_Transform(first, placement, Standard_True).Shape());
+}
+
+TopoDS_Wire LoftFeature::MakeGuideWire(int index) const {
+    TopoDS_Wire path = ProfileCache::Instance().GetPathWire(m_guideCurves[index]);
+    if (path.IsNull()) {
+        return TopoDS_Wire();
+    }
+    
+    // 草图Y方向对应放样方向（Z），绕X轴转90度放进XZ平面
+    gp_Trsf rotation;
+    rotation.SetRotation(gp::OX(), M_PI / 2.0);
+    return TopoDS::Wire(BRepBuilderAPI_Transform(path, rotation, Standard_True).Shape());
+}
+
+std::vector<LoftFeature::InputRevision> LoftFeature::CollectInputRevisions() const {
+    std::vector<InputRevision> inputs;
+    inputs.reserve(m_sections.size() + m_guideCurves.size() + 1);
+    for (const auto& section : m_sections) {
+        inputs.emplace_back(section, section->GetRevision());
+    }
+    // 分隔截面和引导线，避免两组之间挪动元素时误命中
+    inputs.emplace_back(std::weak_ptr<cad_sketch::Sketch>(), 0);
+    for (const auto& guide : m_guideCurves) {
+        inputs.emplace_back(guide, guide->GetRevision());
+    }
+    return inputs;
+}
+
+bool LoftFeature::SameInputs(const std::vector<InputRevision>& lhs, const std::vector<InputRevision>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        // 缓存里的草图已释放时lock()为空，和当前输入对不上
+        if (lhs[i].second != rhs[i].second || lhs[i].first.lock() != rhs[i].first.lock()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace cad_feature
\ No newline at end of file
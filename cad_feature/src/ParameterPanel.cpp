@@ -1,6 +1,7 @@
 #include "cad_feature/ParameterPanel.h"
 #include "cad_feature/ExtrudeFeature.h"
 #include "cad_feature/RevolveFeature.h"
+#include <cmath>
 
 namespace cad_feature {
 
@@ -97,6 +98,26 @@ void ParameterPanel::CreateParameterWidgets() {
             CreateBoolParameter("closed", m_feature->GetParameter("closed") != 0.0);
             break;
         }
+        case FeatureType::LinearPattern: {
+            CreateGroupBox("线性阵列参数");
+            CreateIntParameter("count", static_cast<int>(m_feature->GetParameter("count")), 1, 10000);
+            CreateDoubleParameter("spacing", m_feature->GetParameter("spacing"), 0.001, 10000.0);
+            CreateDoubleParameter("direction_x", m_feature->GetParameter("direction_x"), -1.0, 1.0);
+            CreateDoubleParameter("direction_y", m_feature->GetParameter("direction_y"), -1.0, 1.0);
+            CreateDoubleParameter("direction_z", m_feature->GetParameter("direction_z"), -1.0, 1.0);
+            CreateIntParameter("count2", static_cast<int>(m_feature->GetParameter("count2")), 1, 10000);
+            CreateDoubleParameter("spacing2", m_feature->GetParameter("spacing2"), 0.001, 10000.0);
+            break;
+        }
+        case FeatureType::CircularPattern: {
+            CreateGroupBox("圆周阵列参数");
+            CreateIntParameter("count", static_cast<int>(m_feature->GetParameter("count")), 1, 10000);
+            CreateDoubleParameter("angle", m_feature->GetParameter("angle"), 0.001, 2.0 * M_PI);
+            CreateDoubleParameter("axis_x", m_feature->GetParameter("axis_x"), -1.0, 1.0);
+            CreateDoubleParameter("axis_y", m_feature->GetParameter("axis_y"), -1.0, 1.0);
+            CreateDoubleParameter("axis_z", m_feature->GetParameter("axis_z"), -1.0, 1.0);
+            break;
+        }
         default:
             break;
     }
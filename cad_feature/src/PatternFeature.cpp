@@ -0,0 +1,127 @@
+#include "cad_feature/PatternFeature.h"
+#include "cad_feature/FeatureCommand.h"
+#include "cad_core/BooleanOperations.h"
+#include <BRep_Builder.hxx>
+#include <Standard_Failure.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
+
+namespace cad_feature {
+
+PatternFeature::PatternFeature(FeatureType type, const std::string& name) : Feature(type, name) {
+    SetParameter("operation", static_cast<double>(PatternOperation::None));
+}
+
+void PatternFeature::SetSeedShape(const cad_core::ShapePtr& seed) {
+    m_seed = seed;
+}
+
+const cad_core::ShapePtr& PatternFeature::GetSeedShape() const {
+    return m_seed;
+}
+
+void PatternFeature::SetTargetShape(const cad_core::ShapePtr& target) {
+    m_target = target;
+}
+
+const cad_core::ShapePtr& PatternFeature::GetTargetShape() const {
+    return m_target;
+}
+
+void PatternFeature::SetOperation(PatternOperation operation) {
+    SetParameter("operation", static_cast<double>(operation));
+}
+
+PatternOperation PatternFeature::GetOperation() const {
+    return static_cast<PatternOperation>(static_cast<int>(GetParameter("operation")));
+}
+
+std::vector<gp_Trsf> PatternFeature::GetInstanceTransforms() const {
+    if (!ValidatePattern()) {
+        return std::vector<gp_Trsf>();
+    }
+    return ComputeTransforms();
+}
+
+int PatternFeature::GetInstanceCount() const {
+    return static_cast<int>(GetInstanceTransforms().size());
+}
+
+cad_core::ShapePtr PatternFeature::CreateInstancesShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+
+    try {
+        BRep_Builder builder;
+        TopoDS_Compound compound;
+        builder.MakeCompound(compound);
+        for (const auto& instance : MakeInstances()) {
+            builder.Add(compound, instance);
+        }
+        return std::make_shared<cad_core::Shape>(compound);
+    } catch (const Standard_Failure&) {
+        return nullptr;
+    }
+}
+
+cad_core::ShapePtr PatternFeature::CreateShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+
+    PatternOperation operation = GetOperation();
+    if (operation == PatternOperation::None || !m_target || !m_target->IsValid()) {
+        return CreateInstancesShape();
+    }
+
+    // 所有实例作为工具，一次布尔运算搞定
+    std::vector<cad_core::ShapePtr> tools;
+    for (const auto& instance : MakeInstances()) {
+        tools.push_back(std::make_shared<cad_core::Shape>(instance));
+    }
+
+    if (operation == PatternOperation::Cut) {
+        return cad_core::BooleanOperations::Difference(m_target, tools);
+    }
+    return cad_core::BooleanOperations::Union(m_target, tools);
+}
+
+bool PatternFeature::ValidateParameters() const {
+    if (!m_seed || !m_seed->IsValid()) {
+        return false;
+    }
+    return ValidatePattern();
+}
+
+std::shared_ptr<cad_core::ICommand> PatternFeature::CreateCommand() const {
+    return std::make_shared<FeatureCommand>(Clone());
+}
+
+cad_core::ShapePtr PatternFeature::CreateCoarsePreviewShape() const {
+    // 预览只摆实例，布尔运算留给精确结果
+    return CreateInstancesShape();
+}
+
+std::vector<cad_core::ShapePtr> PatternFeature::GetInputShapes() const {
+    std::vector<cad_core::ShapePtr> inputs;
+    if (m_seed) {
+        inputs.push_back(m_seed);
+    }
+    if (m_target && GetOperation() != PatternOperation::None) {
+        inputs.push_back(m_target);
+    }
+    return inputs;
+}
+
+std::vector<TopoDS_Shape> PatternFeature::MakeInstances() const {
+    std::vector<TopoDS_Shape> instances;
+    const TopoDS_Shape& seed = m_seed->GetOCCTShape();
+    for (const auto& transform : ComputeTransforms()) {
+        // Moved只改Location，TShape共享，不复制几何
+        instances.push_back(seed.Moved(TopLoc_Location(transform)));
+    }
+    return instances;
+}
+
+} // namespace cad_feature
@@ -0,0 +1,225 @@
+#include "cad_feature/ProfileBuilder.h"
+#include "cad_sketch/SketchLine.h"
+#include "cad_sketch/SketchArc.h"
+#include "cad_sketch/SketchCircle.h"
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakePolygon.hxx>
+#include <BRepBuilderAPI_MakeWire.hxx>
+#include <BRepGProp.hxx>
+#include <BRep_Tool.hxx>
+#include <GProp_GProps.hxx>
+#include <ShapeAnalysis_FreeBounds.hxx>
+#include <ShapeFix_Face.hxx>
+#include <TopTools_HSequenceOfShape.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Circ.hxx>
+#include <gp_Pln.hxx>
+#include <Standard_Failure.hxx>
+#include <algorithm>
+#include <cmath>
+
+namespace cad_feature {
+
+namespace {
+
+const double kConnectTolerance = 1e-6;
+
+gp_Pnt ToPnt(double x, double y) {
+    return gp_Pnt(x, y, 0.0);
+}
+
+// 粗略模式：圆弧离散成折线
+TopoDS_Wire MakeArcPolyline(double cx, double cy, double radius,
+                            double startAngle, double sweep, bool closed) {
+    int segments = std::max(2, static_cast<int>(std::ceil(
+        ProfileBuilder::kCoarseCircleSegments * sweep / (2.0 * M_PI))));
+
+    BRepBuilderAPI_MakePolygon polygon;
+    int pointCount = closed ? segments : segments + 1;
+    for (int i = 0; i < pointCount; ++i) {
+        double a = startAngle + sweep * i / segments;
+        polygon.Add(ToPnt(cx + radius * std::cos(a), cy + radius * std::sin(a)));
+    }
+    if (closed) {
+        polygon.Close();
+    }
+    return polygon.Wire();
+}
+
+double WireArea(const TopoDS_Wire& wire) {
+    if (!BRep_Tool::IsClosed(wire)) {
+        return 0.0;
+    }
+    BRepBuilderAPI_MakeFace faceMaker(wire, Standard_True);
+    if (!faceMaker.IsDone()) {
+        return 0.0;
+    }
+    GProp_GProps props;
+    BRepGProp::SurfaceProperties(faceMaker.Face(), props);
+    return std::abs(props.Mass());
+}
+
+double WireLength(const TopoDS_Wire& wire) {
+    GProp_GProps props;
+    BRepGProp::LinearProperties(wire, props);
+    return props.Mass();
+}
+
+} // namespace
+
+std::vector<TopoDS_Wire> ProfileBuilder::MakeWires(const cad_sketch::SketchPtr& sketch,
+                                                   ProfileFidelity fidelity) {
+    std::vector<TopoDS_Wire> wires;
+    if (!sketch || sketch->IsEmpty()) {
+        return wires;
+    }
+
+    const bool coarse = (fidelity == ProfileFidelity::Coarse);
+
+    try {
+        // 开放的边（直线、圆弧）先收集起来，统一拼接成线框
+        Handle(TopTools_HSequenceOfShape) openEdges = new TopTools_HSequenceOfShape();
+
+        for (const auto& element : sketch->GetElements()) {
+            if (!element) {
+                continue;
+            }
+
+            switch (element->GetType()) {
+                case cad_sketch::SketchElementType::Line: {
+                    auto line = std::dynamic_pointer_cast<cad_sketch::SketchLine>(element);
+                    if (!line || !line->GetStartPoint() || !line->GetEndPoint() || line->GetLength() < kConnectTolerance) {
+                        break;
+                    }
+                    BRepBuilderAPI_MakeEdge edgeMaker(
+                        ToPnt(line->GetStartPoint()->GetX(), line->GetStartPoint()->GetY()),
+                        ToPnt(line->GetEndPoint()->GetX(), line->GetEndPoint()->GetY()));
+                    if (edgeMaker.IsDone()) {
+                        openEdges->Append(edgeMaker.Edge());
+                    }
+                    break;
+                }
+                case cad_sketch::SketchElementType::Arc: {
+                    auto arc = std::dynamic_pointer_cast<cad_sketch::SketchArc>(element);
+                    if (!arc || !arc->GetCenter() || arc->GetRadius() <= 0.0) {
+                        break;
+                    }
+                    double cx = arc->GetCenter()->GetX();
+                    double cy = arc->GetCenter()->GetY();
+                    if (coarse) {
+                        TopoDS_Wire polyline = MakeArcPolyline(cx, cy, arc->GetRadius(),
+                                                               arc->GetStartAngle(), arc->GetSweepAngle(), false);
+                        for (TopExp_Explorer exp(polyline, TopAbs_EDGE); exp.More(); exp.Next()) {
+                            openEdges->Append(exp.Current());
+                        }
+                    } else {
+                        gp_Circ circ(gp_Ax2(ToPnt(cx, cy), gp::DZ()), arc->GetRadius());
+                        double start = arc->GetStartAngle();
+                        BRepBuilderAPI_MakeEdge edgeMaker(circ, start, start + arc->GetSweepAngle());
+                        if (edgeMaker.IsDone()) {
+                            openEdges->Append(edgeMaker.Edge());
+                        }
+                    }
+                    break;
+                }
+                case cad_sketch::SketchElementType::Circle: {
+                    auto circle = std::dynamic_pointer_cast<cad_sketch::SketchCircle>(element);
+                    if (!circle || !circle->GetCenter() || circle->GetRadius() <= 0.0) {
+                        break;
+                    }
+                    double cx = circle->GetCenter()->GetX();
+                    double cy = circle->GetCenter()->GetY();
+                    if (coarse) {
+                        wires.push_back(MakeArcPolyline(cx, cy, circle->GetRadius(), 0.0, 2.0 * M_PI, true));
+                    } else {
+                        gp_Circ circ(gp_Ax2(ToPnt(cx, cy), gp::DZ()), circle->GetRadius());
+                        BRepBuilderAPI_MakeWire wireMaker(BRepBuilderAPI_MakeEdge(circ).Edge());
+                        if (wireMaker.IsDone()) {
+                            wires.push_back(wireMaker.Wire());
+                        }
+                    }
+                    break;
+                }
+                default:
+                    // 孤立的点不参与轮廓
+                    break;
+            }
+        }
+
+        if (openEdges->Length() > 0) {
+            Handle(TopTools_HSequenceOfShape) connected;
+            ShapeAnalysis_FreeBounds::ConnectEdgesToWires(openEdges, kConnectTolerance, Standard_False, connected);
+            for (int i = 1; i <= connected->Length(); ++i) {
+                wires.push_back(TopoDS::Wire(connected->Value(i)));
+            }
+        }
+    } catch (const Standard_Failure&) {
+        wires.clear();
+        return wires;
+    }
+
+    // 闭合线框按面积排序，开放线框排在最后
+    std::vector<std::pair<double, TopoDS_Wire>> sorted;
+    sorted.reserve(wires.size());
+    for (const auto& wire : wires) {
+        sorted.emplace_back(WireArea(wire), wire);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    wires.clear();
+    for (const auto& entry : sorted) {
+        wires.push_back(entry.second);
+    }
+    return wires;
+}
+
+TopoDS_Face ProfileBuilder::MakeFace(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    std::vector<TopoDS_Wire> wires = MakeWires(sketch, fidelity);
+    if (wires.empty() || !BRep_Tool::IsClosed(wires.front())) {
+        return TopoDS_Face();
+    }
+
+    try {
+        BRepBuilderAPI_MakeFace faceMaker(gp_Pln(gp::XOY()), wires.front());
+        for (size_t i = 1; i < wires.size(); ++i) {
+            if (BRep_Tool::IsClosed(wires[i])) {
+                faceMaker.Add(wires[i]);
+            }
+        }
+        if (!faceMaker.IsDone()) {
+            return TopoDS_Face();
+        }
+
+        TopoDS_Face face = faceMaker.Face();
+        if (wires.size() > 1) {
+            // 孔的方向需要和外轮廓相反，交给ShapeFix处理
+            Handle(ShapeFix_Face) fixer = new ShapeFix_Face(face);
+            fixer->FixOrientation();
+            fixer->Perform();
+            face = fixer->Face();
+        }
+        return face;
+    } catch (const Standard_Failure&) {
+        return TopoDS_Face();
+    }
+}
+
+TopoDS_Wire ProfileBuilder::MakePathWire(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    std::vector<TopoDS_Wire> wires = MakeWires(sketch, fidelity);
+    if (wires.empty()) {
+        return TopoDS_Wire();
+    }
+
+    auto longest = std::max_element(wires.begin(), wires.end(),
+                                    [](const TopoDS_Wire& a, const TopoDS_Wire& b) {
+                                        return WireLength(a) < WireLength(b);
+                                    });
+    return *longest;
+}
+
+} // namespace cad_feature
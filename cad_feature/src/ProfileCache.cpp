@@ -0,0 +1,157 @@
+#include "cad_feature/ProfileCache.h"
+#include "cad_core/RegenerationProfiler.h"
+
+namespace cad_feature {
+
+ProfileCache& ProfileCache::Instance() {
+    static ProfileCache instance;
+    return instance;
+}
+
+ProfileCache::ProfileCache() : m_hits(0), m_misses(0) {
+}
+
+std::vector<TopoDS_Wire> ProfileCache::GetWires(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    if (!sketch) {
+        return std::vector<TopoDS_Wire>();
+    }
+
+    std::uint64_t revision = sketch->GetRevision();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = Lookup(sketch, fidelity);
+        if (entry.hasWires) {
+            ++m_hits;
+            cad_core::RegenerationProfiler::RecordCacheHit();
+            return entry.wires;
+        }
+        ++m_misses;
+        cad_core::RegenerationProfiler::RecordCacheMiss();
+    }
+
+    // 转换放在锁外面做，不同草图可以并行转换
+    std::vector<TopoDS_Wire> wires = ProfileBuilder::MakeWires(sketch, fidelity);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = Lookup(sketch, fidelity);
+    if (entry.revision == revision) {
+        entry.wires = wires;
+        entry.hasWires = true;
+    }
+    return wires;
+}
+
+TopoDS_Face ProfileCache::GetFace(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    if (!sketch) {
+        return TopoDS_Face();
+    }
+
+    std::uint64_t revision = sketch->GetRevision();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = Lookup(sketch, fidelity);
+        if (entry.hasFace) {
+            ++m_hits;
+            cad_core::RegenerationProfiler::RecordCacheHit();
+            return entry.face;
+        }
+        ++m_misses;
+        cad_core::RegenerationProfiler::RecordCacheMiss();
+    }
+
+    TopoDS_Face face = ProfileBuilder::MakeFace(sketch, fidelity);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = Lookup(sketch, fidelity);
+    if (entry.revision == revision) {
+        entry.face = face;
+        entry.hasFace = true;
+    }
+    return face;
+}
+
+TopoDS_Wire ProfileCache::GetPathWire(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    if (!sketch) {
+        return TopoDS_Wire();
+    }
+
+    std::uint64_t revision = sketch->GetRevision();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = Lookup(sketch, fidelity);
+        if (entry.hasPath) {
+            ++m_hits;
+            cad_core::RegenerationProfiler::RecordCacheHit();
+            return entry.path;
+        }
+        ++m_misses;
+        cad_core::RegenerationProfiler::RecordCacheMiss();
+    }
+
+    TopoDS_Wire path = ProfileBuilder::MakePathWire(sketch, fidelity);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = Lookup(sketch, fidelity);
+    if (entry.revision == revision) {
+        entry.path = path;
+        entry.hasPath = true;
+    }
+    return path;
+}
+
+void ProfileCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t ProfileCache::GetHitCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t ProfileCache::GetMissCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+size_t ProfileCache::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+ProfileCache::Entry& ProfileCache::Lookup(const cad_sketch::SketchPtr& sketch, ProfileFidelity fidelity) {
+    Key key(sketch.get(), fidelity);
+    auto it = m_entries.find(key);
+
+    // 地址可能被新草图复用，所以除了修订号还要确认还是同一个对象
+    bool stale = (it == m_entries.end())
+        || it->second.sketch.lock() != sketch
+        || it->second.revision != sketch->GetRevision();
+
+    if (stale) {
+        if (it == m_entries.end()) {
+            PurgeExpired();
+        }
+        Entry fresh;
+        fresh.sketch = sketch;
+        fresh.revision = sketch->GetRevision();
+        Entry& entry = m_entries[key];
+        entry = fresh;
+        return entry;
+    }
+    return it->second;
+}
+
+void ProfileCache::PurgeExpired() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.sketch.expired()) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace cad_feature
@@ -1,8 +1,13 @@
 #include "cad_feature/RevolveFeature.h"
-#include "cad_core/CreateCylinderCommand.h"
+#include "cad_feature/FeatureCommand.h"
+#include "cad_feature/ProfileCache.h"
+#include "cad_core/RegenerationProfiler.h"
 #include <BRepPrimAPI_MakeRevol.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <Standard_Failure.hxx>
 #include <gp_Ax1.hxx>
 #include <gp_Dir.hxx>
+#include <gp_Trsf.hxx>
 #include <cmath>
 
 namespace cad_feature {
@@ -82,7 +87,19 @@ cad_core::ShapePtr RevolveFeature::CreateShape() const {
         return nullptr;
     }
     
-    return RevolveSketch();
+    return RevolveSketch(ProfileFidelity::Exact);
+}
+
+cad_core::ShapePtr RevolveFeature::CreateCoarsePreviewShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+    
+    return RevolveSketch(ProfileFidelity::Coarse);
+}
+
+std::shared_ptr<Feature> RevolveFeature::Clone() const {
+    return std::make_shared<RevolveFeature>(*this);
 }
 
 bool RevolveFeature::ValidateParameters() const {
@@ -106,32 +123,45 @@ bool RevolveFeature::ValidateParameters() const {
 }
 
 std::shared_ptr<cad_core::ICommand> RevolveFeature::CreateCommand() const {
-    // For now, return a simple cylinder command as placeholder
-    return std::make_shared<cad_core::CreateCylinderCommand>(5.0, 10.0);
+    return std::make_shared<FeatureCommand>(Clone());
 }
 
 bool RevolveFeature::IsSketchValid() const {
     return m_sketch && !m_sketch->IsEmpty();
 }
 
-cad_core::ShapePtr RevolveFeature::RevolveSketch() const {
+cad_core::ShapePtr RevolveFeature::RevolveSketch(ProfileFidelity fidelity) const {
     if (!IsSketchValid()) {
         return nullptr;
     }
     
     try {
-        // In a real implementation, this would:
-        // 1. Convert sketch elements to OCCT wire/face
-        // 2. Create revolution axis from origin and direction
-        // 3. Use BRepPrimAPI_MakeRevol to create the solid
+        TopoDS_Face face = ProfileCache::Instance().GetFace(m_sketch, fidelity);
+        if (face.IsNull()) {
+            return nullptr;
+        }
         
-        // For now, return a simple shape as placeholder
-        auto shape = std::make_shared<cad_core::Shape>();
+        double ax, ay, az, ox, oy, oz;
+        GetAxis(ax, ay, az);
+        GetAxisOrigin(ox, oy, oz);
+        gp_Ax1 axis(gp_Pnt(ox, oy, oz), gp_Dir(ax, ay, az));
         
-        // Placeholder: create a simple cylinder-like shape
-        // In real implementation, this would properly revolve the sketch
+        double angle = GetAngle();
+        TopoDS_Shape base = face;
+        if (GetMidplane() && angle < 2.0 * M_PI) {
+            gp_Trsf rotation;
+            rotation.SetRotation(axis, -angle / 2.0);
+            base = BRepBuilderAPI_Transform(face, rotation, Standard_True).Shape();
+        }
         
-        return shape;
+        cad_core::RegenerationProfiler::ScopedCall call("BRepPrimAPI_MakeRevol");
+        BRepPrimAPI_MakeRevol revol(base, axis, angle);
+        if (!revol.IsDone()) {
+            return nullptr;
+        }
+        return std::make_shared<cad_core::Shape>(revol.Shape());
+    } catch (const Standard_Failure&) {
+        return nullptr;
     } catch (...) {
         return nullptr;
     }
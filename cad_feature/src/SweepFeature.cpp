@@ -1,6 +1,26 @@
 #include "cad_feature/SweepFeature.h"
-#include "cad_core/CreateBoxCommand.h"
-#include <BRepOffsetAPI_MakePipe.hxx>
+#include "cad_feature/FeatureCommand.h"
+#include "cad_feature/ProfileCache.h"
+#include "cad_core/RegenerationProfiler.h"
+#include <BRepOffsetAPI_MakePipeShell.hxx>
+#include <BRepAdaptor_CompCurve.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepGProp.hxx>
+#include <BRep_Tool.hxx>
+#include <GCPnts_UniformAbscissa.hxx>
+#include <GProp_GProps.hxx>
+#include <Law_Linear.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <gp.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Trsf.hxx>
+#include <algorithm>
 #include <cmath>
 
 namespace cad_feature {
@@ -65,6 +85,34 @@ cad_core::ShapePtr SweepFeature::CreateShape() const {
     return SweepProfile();
 }
 
+cad_core::ShapePtr SweepFeature::CreateCoarsePreviewShape() const {
+    if (!ValidateParameters()) {
+        return nullptr;
+    }
+    
+    try {
+        // 粗略预览：折线外轮廓沿折线路径扫掠，不做扭转、缩放和挖孔；
+        // 截面和精确结果一样放到路径起点并垂直于路径（草图都在XY平面上）
+        std::vector<TopoDS_Wire> sections = ProfileCache::Instance().GetWires(m_profile, ProfileFidelity::Coarse);
+        TopoDS_Wire path = ProfileCache::Instance().GetPathWire(m_path, ProfileFidelity::Coarse);
+        if (sections.empty() || path.IsNull() || !BRep_Tool::IsClosed(sections.front())) {
+            return nullptr;
+        }
+        
+        TopoDS_Shape result = SweepWire(sections.front(), path, gp_Pnt(), false);
+        if (result.IsNull()) {
+            return nullptr;
+        }
+        return std::make_shared<cad_core::Shape>(result);
+    } catch (const Standard_Failure&) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<Feature> SweepFeature::Clone() const {
+    return std::make_shared<SweepFeature>(*this);
+}
+
 bool SweepFeature::ValidateParameters() const {
     if (!IsProfileValid() || !IsPathValid()) {
         return false;
@@ -79,8 +127,7 @@ bool SweepFeature::ValidateParameters() const {
 }
 
 std::shared_ptr<cad_core::ICommand> SweepFeature::CreateCommand() const {
-    // For now, return a simple box command as placeholder
-    return std::make_shared<cad_core::CreateBoxCommand>(10.0, 10.0, 10.0);
+    return std::make_shared<FeatureCommand>(Clone());
 }
 
 bool SweepFeature::IsProfileValid() const {
@@ -97,22 +144,113 @@ cad_core::ShapePtr SweepFeature::SweepProfile() const {
     }
     
     try {
-        // In a real implementation, this would:
-        // 1. Convert profile sketch to OCCT wire/face
-        // 2. Convert path sketch to OCCT wire
-        // 3. Use BRepOffsetAPI_MakePipe to create the swept solid
-        // 4. Apply twist and scaling if specified
+        std::vector<TopoDS_Wire> sections = ProfileCache::Instance().GetWires(m_profile);
+        TopoDS_Wire path = ProfileCache::Instance().GetPathWire(m_path);
+        if (sections.empty() || path.IsNull() || !BRep_Tool::IsClosed(sections.front())) {
+            return nullptr;
+        }
+        
+        // 扭转和缩放都绕轮廓形心进行，内外轮廓用同一个中心才能保持相对位置
+        GProp_GProps props;
+        BRepGProp::SurfaceProperties(BRepBuilderAPI_MakeFace(sections.front(), Standard_True).Face(), props);
+        gp_Pnt center = props.CentreOfMass();
         
-        // For now, return a simple shape as placeholder
-        auto shape = std::make_shared<cad_core::Shape>();
+        TopoDS_Shape result = SweepWire(sections.front(), path, center);
+        if (result.IsNull()) {
+            return nullptr;
+        }
         
-        // Placeholder: create a simple box-like shape
-        // In real implementation, this would properly sweep the profile along the path
+        // 其余闭合线框是孔：各自扫成实体再减掉
+        for (size_t i = 1; i < sections.size(); ++i) {
+            if (!BRep_Tool::IsClosed(sections[i])) {
+                continue;
+            }
+            TopoDS_Shape hole = SweepWire(sections[i], path, center);
+            if (hole.IsNull()) {
+                return nullptr;
+            }
+            cad_core::RegenerationProfiler::ScopedCall call("BRepAlgoAPI_Cut");
+            BRepAlgoAPI_Cut cut(result, hole);
+            if (!cut.IsDone()) {
+                return nullptr;
+            }
+            result = cut.Shape();
+        }
         
-        return shape;
+        return std::make_shared<cad_core::Shape>(result);
+    } catch (const Standard_Failure&) {
+        return nullptr;
     } catch (...) {
         return nullptr;
     }
 }
 
-} // namespace cad_feature
\ No newline at end of file
+TopoDS_Shape SweepFeature::SweepWire(const TopoDS_Wire& section, const TopoDS_Wire& path, const gp_Pnt& center,
+                                     bool withLaw) const {
+    double twist = GetTwistAngle();
+    double scale = GetScaleFactor();
+    bool hasTwist = withLaw && std::abs(twist) > 1e-9;
+    bool hasScale = withLaw && std::abs(scale - 1.0) > 1e-9;
+    
+    // 闭合路径的起点和终点是同一个顶点，首尾截面无法同时满足扭转/缩放，直接拒绝
+    if ((hasTwist || hasScale) && BRep_Tool::IsClosed(path)) {
+        return TopoDS_Shape();
+    }
+    
+    BRepOffsetAPI_MakePipeShell pipe(path);
+    
+    // 保持原始朝向：修正Frenet标架，截面不会绕路径乱转；否则用纯Frenet标架
+    pipe.SetMode(GetKeepOriginalOrientation() ? Standard_False : Standard_True);
+    
+    TopoDS_Vertex pathStart, pathEnd;
+    TopExp::Vertices(path, pathStart, pathEnd);
+    
+    if (hasTwist) {
+        // 扭转：沿路径按弧长均匀放置若干中间截面，每段转角不超过kMaxTwistStep，
+        // 截面绕形心按比例旋转并缩放；只加一个终点截面时PipeShell的线性插值
+        // 会让截面收缩，转角≥180°时方向也会反
+        const double kMaxTwistStep = M_PI / 12.0;
+        int segments = std::max(2, static_cast<int>(std::ceil(std::abs(twist) / kMaxTwistStep)));
+        
+        BRepAdaptor_CompCurve curve(path);
+        GCPnts_UniformAbscissa abscissa(curve, segments + 1);
+        if (!abscissa.IsDone() || abscissa.NbPoints() != segments + 1) {
+            return TopoDS_Shape();
+        }
+        
+        for (int i = 0; i <= segments; ++i) {
+            double t = static_cast<double>(i) / segments;
+            TopoDS_Vertex location = i == 0 ? pathStart
+                                   : i == segments ? pathEnd
+                                   : BRepBuilderAPI_MakeVertex(curve.Value(abscissa.Parameter(i + 1))).Vertex();
+            
+            gp_Trsf scaling;
+            scaling.SetScale(center, 1.0 + (scale - 1.0) * t);
+            gp_Trsf rotation;
+            rotation.SetRotation(gp_Ax1(center, gp::DZ()), twist * t);
+            TopoDS_Shape placed = i == 0 ? TopoDS_Shape(section)
+                                : BRepBuilderAPI_Transform(section, rotation * scaling, Standard_True).Shape();
+            
+            // 截面画在XY平面上，带接触和修正地放到路径上并垂直于路径
+            pipe.Add(TopoDS::Wire(placed), location, Standard_True, Standard_True);
+        }
+    } else if (hasScale) {
+        // 只缩放：单截面加线性缩放律，PipeShell沿整条路径连续缩放
+        Handle(Law_Linear) law = new Law_Linear();
+        law->Set(0.0, 1.0, 1.0, scale);
+        pipe.SetLaw(section, law, pathStart, Standard_True, Standard_True);
+    } else {
+        // 截面画在XY平面上，带接触和修正地放到路径起点并垂直于路径
+        pipe.Add(section, pathStart, Standard_True, Standard_True);
+    }
+    
+    cad_core::RegenerationProfiler::ScopedCall call("BRepOffsetAPI_MakePipeShell");
+    pipe.Build();
+    if (!pipe.IsDone()) {
+        return TopoDS_Shape();
+    }
+    pipe.MakeSolid();
+    return pipe.Shape();
+}
+
+} // namespace cad_feature
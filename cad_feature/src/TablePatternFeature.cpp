@@ -0,0 +1,50 @@
+#include "cad_feature/TablePatternFeature.h"
+#include <gp.hxx>
+#include <gp_Vec.hxx>
+
+namespace cad_feature {
+
+TablePatternFeature::TablePatternFeature() : PatternFeature(FeatureType::TablePattern, "TablePattern") {
+}
+
+TablePatternFeature::TablePatternFeature(const std::string& name) : PatternFeature(FeatureType::TablePattern, name) {
+}
+
+void TablePatternFeature::AddInstance(double x, double y, double z, double rotationZ) {
+    gp_Trsf rotation;
+    rotation.SetRotation(gp::OZ(), rotationZ);
+    gp_Trsf translation;
+    translation.SetTranslation(gp_Vec(x, y, z));
+    m_table.push_back(translation * rotation);
+}
+
+void TablePatternFeature::AddInstance(const gp_Trsf& transform) {
+    m_table.push_back(transform);
+}
+
+void TablePatternFeature::ClearInstances() {
+    m_table.clear();
+}
+
+const std::vector<gp_Trsf>& TablePatternFeature::GetTable() const {
+    return m_table;
+}
+
+std::shared_ptr<Feature> TablePatternFeature::Clone() const {
+    return std::make_shared<TablePatternFeature>(*this);
+}
+
+std::vector<gp_Trsf> TablePatternFeature::ComputeTransforms() const {
+    // 种子本身始终是第一个实例
+    std::vector<gp_Trsf> transforms;
+    transforms.reserve(m_table.size() + 1);
+    transforms.push_back(gp_Trsf());
+    transforms.insert(transforms.end(), m_table.begin(), m_table.end());
+    return transforms;
+}
+
+bool TablePatternFeature::ValidatePattern() const {
+    return !m_table.empty();
+}
+
+} // namespace cad_feature
@@ -32,7 +32,12 @@ private:
     double m_tolerance;
     int m_maxIterations;
     
+    // 约束数达到这个值时误差计算分块并行，每块kConstraintChunk个
+    static constexpr int kParallelConstraintCount = 4096;
+    static constexpr int kConstraintChunk = 1024;
+    
     double CalculateSystemError() const;
+    double SumSquaredError(int begin, int end) const;
     bool IterativeSolve();
 };
 
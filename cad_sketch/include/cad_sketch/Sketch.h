@@ -26,6 +26,8 @@
 #include <vector>            // 动态数组 - 容器界的万金油
 #include <memory>            // 智能指针 - 内存管理的得力助手
 #include <string>            // 字符串 - 人机交流的桥梁
+#include <atomic>            // 原子量 - 修订号可能在后台线程读取
+#include <cstdint>
 
 namespace cad_sketch {
 
@@ -174,6 +176,21 @@ public:
      * @return 约束的总数
      */
     int GetConstraintCount() const;
+    
+    // ========== 修订号 - 草图的"版本戳" ==========
+    
+    /** 
+     * 获取修订号 - 草图或其中任何元素改过之后都会变大
+     * 下游（比如特征的轮廓缓存）靠它判断要不要重新转换
+     * 元素的坐标、半径等setter会自己更新修订号，不用再通知草图
+     * @return 当前修订号
+     */
+    std::uint64_t GetRevision() const;
+    
+    /** 
+     * 标记已修改 - 增删元素、约束和求解都会自动调用
+     */
+    void MarkModified();
 
 private:
     /** 草图名称 - 这幅"作品"的标题 */
@@ -187,6 +204,9 @@ private:
     
     /** 约束求解器 - 负责调解元素关系的"和事佬" */
     ConstraintSolver m_solver;
+    
+    /** 修订号 - 草图自身（增删元素和约束、求解）最后一次修改时取的全局修订号 */
+    std::atomic<std::uint64_t> m_revision;
 };
 
 /** 草图智能指针类型别名 - 让内存管理变得轻松愉快 */
@@ -31,6 +31,7 @@ public:
     SketchPointPtr GetEndPoint() const;
     
     std::string GetDescription() const override;
+    std::uint64_t GetRevision() const override;
 
 private:
     SketchPointPtr m_center;
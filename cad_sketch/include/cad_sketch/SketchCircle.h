@@ -23,6 +23,7 @@ public:
     double GetArea() const;
     
     std::string GetDescription() const override;
+    std::uint64_t GetRevision() const override;
 
 private:
     SketchPointPtr m_center;
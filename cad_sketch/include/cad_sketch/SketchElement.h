@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -29,12 +31,23 @@ public:
     void SetVisible(bool visible);
     
     virtual std::string GetDescription() const = 0;
+    
+    // 修订号：每次修改几何都从全局计数器取一个新值，
+    // 引用其他元素的（线的端点、圆心）取自己和它们中最大的
+    virtual std::uint64_t GetRevision() const;
+    
+    // 全局递增的修订号，草图自身的增删改也从这里取
+    static std::uint64_t NextRevision();
 
 protected:
+    // 设置坐标、半径等几何参数后调用
+    void MarkModified();
+    
     SketchElementType m_type;
     int m_id;
     bool m_selected;
     bool m_visible;
+    std::atomic<std::uint64_t> m_revision;
     
     static int s_nextId;
 };
@@ -21,6 +21,7 @@ public:
     double GetAngle() const;
     
     std::string GetDescription() const override;
+    std::uint64_t GetRevision() const override;
 
 private:
     SketchPointPtr m_startPoint;
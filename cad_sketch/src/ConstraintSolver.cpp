@@ -1,4 +1,6 @@
 #include "cad_sketch/ConstraintSolver.h"
+#include "cad_core/TaskScheduler.h"
+#include "cad_core/Tracer.h"
 #include <cmath>
 #include <algorithm>
 
@@ -31,6 +33,7 @@ bool ConstraintSolver::Solve() {
         return true;
     }
     
+    CAD_TRACE_ZONE_CAT("ConstraintSolver::Solve", "sketch");
     return IterativeSolve();
 }
 
@@ -60,16 +63,39 @@ int ConstraintSolver::GetMaxIterations() const {
 }
 
 double ConstraintSolver::CalculateSystemError() const {
+    // 约束多时分块在任务池里求误差平方和，各块结果按顺序相加，结果和串行一致；
+    // 约束少时开任务的开销比计算本身还大
+    const int count = static_cast<int>(m_constraints.size());
+    if (count < kParallelConstraintCount) {
+        return std::sqrt(SumSquaredError(0, count));
+    }
+    
+    const int chunks = (count + kConstraintChunk - 1) / kConstraintChunk;
+    std::vector<double> partial(chunks, 0.0);
+    cad_core::TaskScheduler::Instance().ParallelFor(0, chunks, [&](int chunk) {
+        int begin = chunk * kConstraintChunk;
+        partial[chunk] = SumSquaredError(begin, std::min(count, begin + kConstraintChunk));
+    }, cad_core::TaskPriority::Interactive);
+    
+    double totalError = 0.0;
+    for (double value : partial) {
+        totalError += value;
+    }
+    return std::sqrt(totalError);
+}
+
+double ConstraintSolver::SumSquaredError(int begin, int end) const {
     double totalError = 0.0;
     
-    for (const auto& constraint : m_constraints) {
+    for (int i = begin; i < end; ++i) {
+        const ConstraintPtr& constraint = m_constraints[i];
         if (constraint->IsActive()) {
             double error = constraint->GetError();
             totalError += error * error;
         }
     }
     
-    return std::sqrt(totalError);
+    return totalError;
 }
 
 bool ConstraintSolver::IterativeSolve() {
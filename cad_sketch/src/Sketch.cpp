@@ -3,10 +3,10 @@
 
 namespace cad_sketch {
 
-Sketch::Sketch() : m_name("Sketch") {
+Sketch::Sketch() : m_name("Sketch"), m_revision(SketchElement::NextRevision()) {
 }
 
-Sketch::Sketch(const std::string& name) : m_name(name) {
+Sketch::Sketch(const std::string& name) : m_name(name), m_revision(SketchElement::NextRevision()) {
 }
 
 const std::string& Sketch::GetName() const {
@@ -19,17 +19,20 @@ void Sketch::SetName(const std::string& name) {
 
 void Sketch::AddElement(const SketchElementPtr& element) {
     m_elements.push_back(element);
+    MarkModified();
 }
 
 void Sketch::RemoveElement(const SketchElementPtr& element) {
     auto it = std::find(m_elements.begin(), m_elements.end(), element);
     if (it != m_elements.end()) {
         m_elements.erase(it);
+        MarkModified();
     }
 }
 
 void Sketch::ClearElements() {
     m_elements.clear();
+    MarkModified();
 }
 
 const std::vector<SketchElementPtr>& Sketch::GetElements() const {
@@ -48,6 +51,7 @@ SketchElementPtr Sketch::GetElementById(int id) const {
 void Sketch::AddConstraint(const ConstraintPtr& constraint) {
     m_constraints.push_back(constraint);
     m_solver.AddConstraint(constraint);
+    MarkModified();
 }
 
 void Sketch::RemoveConstraint(const ConstraintPtr& constraint) {
@@ -55,12 +59,14 @@ void Sketch::RemoveConstraint(const ConstraintPtr& constraint) {
     if (it != m_constraints.end()) {
         m_constraints.erase(it);
         m_solver.RemoveConstraint(constraint);
+        MarkModified();
     }
 }
 
 void Sketch::ClearConstraints() {
     m_constraints.clear();
     m_solver.ClearConstraints();
+    MarkModified();
 }
 
 const std::vector<ConstraintPtr>& Sketch::GetConstraints() const {
@@ -68,6 +74,8 @@ const std::vector<ConstraintPtr>& Sketch::GetConstraints() const {
 }
 
 bool Sketch::SolveConstraints() {
+    // 求解会移动元素
+    MarkModified();
     return m_solver.Solve();
 }
 
@@ -111,4 +119,17 @@ int Sketch::GetConstraintCount() const {
     return static_cast<int>(m_constraints.size());
 }
 
+std::uint64_t Sketch::GetRevision() const {
+    // 修订号全局递增，任何元素改过之后都比之前所有的值大，取最大值即可
+    std::uint64_t revision = m_revision.load(std::memory_order_acquire);
+    for (const auto& element : m_elements) {
+        revision = std::max(revision, element->GetRevision());
+    }
+    return revision;
+}
+
+void Sketch::MarkModified() {
+    m_revision.store(SketchElement::NextRevision(), std::memory_order_release);
+}
+
 } // namespace cad_sketch
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "cad_sketch/SketchArc.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -26,6 +27,7 @@ const SketchPointPtr& SketchArc::GetCenter() const {
 
 void SketchArc::SetCenter(const SketchPointPtr& center) {
     m_center = center;
+    MarkModified();
 }
 
 double SketchArc::GetRadius() const {
@@ -34,6 +36,7 @@ double SketchArc::GetRadius() const {
 
 void SketchArc::SetRadius(double radius) {
     m_radius = radius;
+    MarkModified();
 }
 
 double SketchArc::GetStartAngle() const {
@@ -42,6 +45,7 @@ double SketchArc::GetStartAngle() const {
 
 void SketchArc::SetStartAngle(double angle) {
     m_startAngle = angle;
+    MarkModified();
 }
 
 double SketchArc::GetEndAngle() const {
@@ -50,6 +54,7 @@ double SketchArc::GetEndAngle() const {
 
 void SketchArc::SetEndAngle(double angle) {
     m_endAngle = angle;
+    MarkModified();
 }
 
 double SketchArc::GetSweepAngle() const {
@@ -79,6 +84,14 @@ SketchPointPtr SketchArc::GetEndPoint() const {
     return std::make_shared<SketchPoint>(x, y);
 }
 
+std::uint64_t SketchArc::GetRevision() const {
+    std::uint64_t revision = SketchElement::GetRevision();
+    if (m_center) {
+        revision = std::max(revision, m_center->GetRevision());
+    }
+    return revision;
+}
+
 std::string SketchArc::GetDescription() const {
     std::ostringstream oss;
     oss << "Arc (Radius: " << m_radius << ", Sweep: " << GetSweepAngle() * 180.0 / M_PI << "°)";
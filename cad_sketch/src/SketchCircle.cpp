@@ -1,4 +1,5 @@
 #include "cad_sketch/SketchCircle.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -23,6 +24,7 @@ const SketchPointPtr& SketchCircle::GetCenter() const {
 
 void SketchCircle::SetCenter(const SketchPointPtr& center) {
     m_center = center;
+    MarkModified();
 }
 
 double SketchCircle::GetRadius() const {
@@ -31,6 +33,7 @@ double SketchCircle::GetRadius() const {
 
 void SketchCircle::SetRadius(double radius) {
     m_radius = radius;
+    MarkModified();
 }
 
 double SketchCircle::GetDiameter() const {
@@ -45,6 +48,14 @@ double SketchCircle::GetArea() const {
     return M_PI * m_radius * m_radius;
 }
 
+std::uint64_t SketchCircle::GetRevision() const {
+    std::uint64_t revision = SketchElement::GetRevision();
+    if (m_center) {
+        revision = std::max(revision, m_center->GetRevision());
+    }
+    return revision;
+}
+
 std::string SketchCircle::GetDescription() const {
     std::ostringstream oss;
     oss << "Circle (Radius: " << m_radius << ")";
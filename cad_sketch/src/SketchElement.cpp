@@ -4,8 +4,12 @@ namespace cad_sketch {
 
 int SketchElement::s_nextId = 1;
 
+namespace {
+std::atomic<std::uint64_t> s_revisionCounter(0);
+}
+
 SketchElement::SketchElement(SketchElementType type)
-    : m_type(type), m_id(s_nextId++), m_selected(false), m_visible(true) {
+    : m_type(type), m_id(s_nextId++), m_selected(false), m_visible(true), m_revision(NextRevision()) {
 }
 
 SketchElementType SketchElement::GetType() const {
@@ -36,4 +40,16 @@ void SketchElement::SetVisible(bool visible) {
     m_visible = visible;
 }
 
+std::uint64_t SketchElement::GetRevision() const {
+    return m_revision.load(std::memory_order_acquire);
+}
+
+std::uint64_t SketchElement::NextRevision() {
+    return s_revisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void SketchElement::MarkModified() {
+    m_revision.store(NextRevision(), std::memory_order_release);
+}
+
 } // namespace cad_sketch
\ No newline at end of file
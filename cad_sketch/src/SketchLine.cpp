@@ -1,4 +1,5 @@
 #include "cad_sketch/SketchLine.h"
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -29,10 +30,12 @@ const SketchPointPtr& SketchLine::GetEndPoint() const {
 
 void SketchLine::SetStartPoint(const SketchPointPtr& point) {
     m_startPoint = point;
+    MarkModified();
 }
 
 void SketchLine::SetEndPoint(const SketchPointPtr& point) {
     m_endPoint = point;
+    MarkModified();
 }
 
 double SketchLine::GetLength() const {
@@ -51,6 +54,17 @@ double SketchLine::GetAngle() const {
     return std::atan2(dy, dx);
 }
 
+std::uint64_t SketchLine::GetRevision() const {
+    std::uint64_t revision = SketchElement::GetRevision();
+    if (m_startPoint) {
+        revision = std::max(revision, m_startPoint->GetRevision());
+    }
+    if (m_endPoint) {
+        revision = std::max(revision, m_endPoint->GetRevision());
+    }
+    return revision;
+}
+
 std::string SketchLine::GetDescription() const {
     std::ostringstream oss;
     oss << "Line (Length: " << GetLength() << ")";
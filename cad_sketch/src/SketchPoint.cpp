@@ -21,6 +21,7 @@ const cad_core::Point& SketchPoint::GetPoint() const {
 
 void SketchPoint::SetPoint(const cad_core::Point& point) {
     m_point = point;
+    MarkModified();
 }
 
 double SketchPoint::GetX() const {
@@ -33,14 +34,17 @@ double SketchPoint::GetY() const {
 
 void SketchPoint::SetX(double x) {
     m_point.SetX(x);
+    MarkModified();
 }
 
 void SketchPoint::SetY(double y) {
     m_point.SetY(y);
+    MarkModified();
 }
 
 void SketchPoint::SetXY(double x, double y) {
     m_point.SetXYZ(x, y, 0);
+    MarkModified();
 }
 
 std::string SketchPoint::GetDescription() const {
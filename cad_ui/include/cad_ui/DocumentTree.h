@@ -17,10 +17,14 @@ public:
     explicit DocumentTree(QWidget* parent = nullptr);
     ~DocumentTree() = default;
 
-    void AddShape(const cad_core::ShapePtr& shape);
+    void AddShape(const cad_core::ShapePtr& shape, const QString& name = QString());
     void RemoveShape(const cad_core::ShapePtr& shape);
+    // 原地替换条目对应的形状，名称和位置不变
+    void ReplaceShape(const cad_core::ShapePtr& oldShape, const cad_core::ShapePtr& newShape);
     void AddFeature(const cad_feature::FeaturePtr& feature);
     void RemoveFeature(const cad_feature::FeaturePtr& feature);
+    // 刷新特征项上的重建报告（耗时列 + 提示）
+    void UpdateFeatureReport(const cad_feature::FeaturePtr& feature);
     void Clear();
 
 signals:
@@ -9,6 +9,8 @@
 #include <QLabel>
 #include <QGroupBox>
 #include <QCheckBox>
+#include <QDoubleSpinBox>
+#include <QSpinBox>
 
 namespace cad_ui {
 
@@ -21,6 +23,13 @@ public:
 
     QString GetFileName() const;
     QString GetFormat() const;
+    void SetFormat(const QString& format);
+    
+    // STL 网格参数
+    double GetLinearDeflection() const;
+    double GetAngularDeflection() const;  // 弧度
+    bool IsAsciiStl() const;
+    int GetLodLevels() const;             // glTF 额外的粗糙级数
     
 private slots:
     void OnBrowse();
@@ -35,6 +44,13 @@ private:
     QPushButton* m_okButton;
     QPushButton* m_cancelButton;
     
+    QGroupBox* m_stlGroup;
+    QDoubleSpinBox* m_linearDeflectionSpin;
+    QDoubleSpinBox* m_angularDeflectionSpin;
+    QCheckBox* m_asciiCheck;
+    QSpinBox* m_lodSpin;
+    QLabel* m_lodLabel;
+    
     void SetupUI();
     void UpdateFormatOptions();
 };
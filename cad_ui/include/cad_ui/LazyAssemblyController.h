@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <Bnd_Box.hxx>
+#include <Quantity_Color.hxx>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "cad_core/LazyPartStore.h"
+#include "cad_core/Shape.h"
+
+namespace cad_ui {
+
+class QtOccView;
+class DocumentTree;
+
+/**
+ * @class LazyAssemblyController
+ * @brief 大装配的延迟显示
+ *
+ * 零件先以包围盒线框（代理）显示在视图和文档树中；视图变化后，落在窗口内且
+ * 投影足够大的零件分批换成真实几何。选中或被操作使用的零件立即加载并固定，
+ * 其余零件超出内存预算时按最近最少使用卸载，重新显示为代理。
+ */
+class LazyAssemblyController : public QObject {
+    Q_OBJECT
+
+public:
+    LazyAssemblyController(QtOccView* viewer, DocumentTree* tree, QObject* parent = nullptr);
+    ~LazyAssemblyController() = default;
+
+    // 登记零件（先放进待显示队列，FlushPendingParts时批量显示代理）
+    int AddPart(const std::string& name, const Bnd_Box& box,
+                cad_core::LazyPartStore::Loader loader,
+                cad_core::LazyPartStore::Unloader unloader = nullptr);
+    void SetPartColor(int id, const Quantity_Color& color);
+    void FlushPendingParts(bool fitAll);
+    void RemovePart(int id);
+    // 只重置内部状态，视图和文档树由调用方清空
+    void Clear();
+
+    bool IsLazyShape(const cad_core::ShapePtr& shape) const;
+    bool IsProxy(const cad_core::ShapePtr& shape) const;
+    // 代理 -> 真实几何（普通形状原样返回）
+    cad_core::ShapePtr Materialize(const cad_core::ShapePtr& shape);
+    // 外部几何被替换后刷新已加载的零件
+    void Reload(int id);
+    // 当前选中的零件固定不卸载
+    void SetSelectedShape(const cad_core::ShapePtr& shape);
+
+    void SetMemoryBudget(size_t bytes);
+    // 每轮加载前把这一轮要加载的零件编号一次交给预读函数（例如一次读入文件中的
+    // 多个标签），之后逐个加载时直接从内存取；Clear()时清除
+    using Prefetcher = std::function<void(const std::vector<int>& ids)>;
+    void SetPrefetcher(Prefetcher prefetcher);
+    cad_core::LazyPartStore& GetStore() { return m_store; }
+
+    // 每次最多加载的零件数，剩下的下一轮再加载，保持界面可交互
+    static const int kMaterializePerTick = 64;
+    // 投影小于这个像素数的零件保持代理
+    static const int kMinPixelSize = 4;
+
+public slots:
+    void ScheduleVisibilityUpdate();
+
+private slots:
+    void UpdateVisibility();
+
+private:
+    void ShowMaterialized(int id, const cad_core::ShapePtr& shape);
+    void ShowProxy(int id, const cad_core::ShapePtr& evicted);
+    int FindPart(const cad_core::ShapePtr& shape) const;
+    static cad_core::ShapePtr MakeProxy(const Bnd_Box& box);
+
+    QtOccView* m_viewer;
+    DocumentTree* m_tree;
+    QTimer* m_visibilityTimer;
+    cad_core::LazyPartStore m_store;
+
+    std::vector<cad_core::ShapePtr> m_proxies;    // 零件编号 -> 代理
+    std::vector<cad_core::ShapePtr> m_displayed;  // 零件编号 -> 当前显示的形状
+    std::map<int, Quantity_Color> m_colors;
+    std::map<cad_core::ShapePtr, int> m_partByShape;
+    std::vector<int> m_pending;
+    int m_selectedPart;
+    Prefetcher m_prefetcher;
+};
+
+} // namespace cad_ui
@@ -18,6 +18,10 @@
 #include <QComboBox>
 #include <QTextEdit>
 #include <QSplitter>
+#include <QTimer>
+#include <QFuture>
+#include <QLockFile>
+#include <functional>
 
 #include "QtOccView.h"
 #include "DocumentTree.h"
@@ -33,15 +37,20 @@
 #include "cad_core/OCAFManager.h"
 #include "cad_core/TransformCommand.h"
 #include "cad_feature/FeatureManager.h"
+#include "cad_feature/LivePreview.h"
+#include "cad_feature/ParameterPanel.h"
 
 namespace cad_ui {
 
+class LazyAssemblyController;
+class ExportDialog;
+
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
     explicit MainWindow(QWidget* parent = nullptr);
-    ~MainWindow() = default;
+    ~MainWindow();
 
     // 初始化
     bool Initialize();
@@ -101,6 +110,7 @@ private slots:
     void OnViewShaded();
     void OnViewOrthographic();
     void OnViewPerspective();
+    void OnTogglePerformanceHud(bool show);
     void OnSetTransparency();
     
     void OnCreateBox();
@@ -113,14 +123,20 @@ private slots:
     
     void OnImportSTEP();
     void OnImportIGES();
+    void OnImportMesh();
     void OnExportSTEP();
     void OnExportIGES();
     void OnExportSTL();
+    void OnExportGLTF();
     
     void OnShowGrid();
     void OnShowAxes();
     void OnDarkTheme();
     void OnLightTheme();
+    void OnExportRegenerationTrace();
+    void OnRecordPerformanceTrace(bool enabled);
+    void OnExportPerformanceTrace();
+    void OnAutosave();
     
     void OnAbout();
     void OnAboutQt();
@@ -151,6 +167,8 @@ private slots:
     void OnFilletChamferOperationRequested(FilletChamferType type, 
                                          const std::vector<cad_core::ShapePtr>& edges,
                                          double radius, double distance1, double distance2);
+    // 状态栏上的取消按钮：请求正在执行的命令停止
+    void OnCancelCommand();
     void OnTransformOperationRequested(std::shared_ptr<cad_core::TransformCommand> command);
     void OnTransformPreviewRequested(std::shared_ptr<cad_core::TransformCommand> command);
     void OnTransformResetRequested();
@@ -191,6 +209,13 @@ private:
     // Dock widgets
     QDockWidget* m_documentDock;
     QDockWidget* m_propertyDock;
+    QDockWidget* m_featureDock;
+    
+    // 特征参数编辑：改参数时先显示粗略预览（线框），精确结果算好后替换
+    cad_feature::ParameterPanel* m_featureParameterPanel;
+    cad_feature::LivePreview* m_featurePreview;
+    cad_core::ShapePtr m_featurePreviewShape;
+    bool m_featureEdited;
     
     // Managers
     std::unique_ptr<cad_core::CommandManager> m_commandManager;
@@ -205,15 +230,37 @@ private:
     // Current document info
     QString m_currentFileName;
     bool m_documentModified;
+    quint64 m_modificationCount;   // 每次改动加一，后台保存完成时据此判断期间是否又有改动
+    
+    // 保存和自动保存（原生格式在后台写出）
+    QFuture<bool> m_saveFuture;
+    QFuture<bool> m_autosaveFuture;
+    QTimer* m_autosaveTimer;
+    std::shared_ptr<cad_core::NativeSaveSession> m_autosaveSession;
+    
+    // 崩溃恢复日志；锁文件表明日志属于正在运行的进程
+    std::shared_ptr<cad_core::OperationJournal> m_journal;
+    std::unique_ptr<QLockFile> m_journalLock;
+    
+    // 非原生格式文档的预览缓存（.acad把预览写在文件里）
+    std::unique_ptr<cad_core::PreviewCache> m_previewCache;
     
     // Transform preview support
     std::vector<cad_core::ShapePtr> m_previewShapes;
     bool m_previewActive;
     
+    // 大装配延迟加载
+    LazyAssemblyController* m_lazyAssembly;
+    
     // Sketch mode support
     bool m_waitingForFaceSelection;
     TopoDS_Face m_selectedFace;
     
+    // 控制台窗口的日志输出（Logger::AddSink返回的编号）
+    int m_logSinkId;
+    // 正在执行的异步命令的进度（取消用）
+    Handle(cad_core::CommandProgress) m_commandProgress;
+    
     void CreateMenus();
     void CreateToolBars();
     void CreateStatusBar();
@@ -223,12 +270,55 @@ private:
     void CreateSelectionModeCombo();
     void CreateConsole();
     
+    // 特征编辑
+    void BeginFeatureEditing(const cad_feature::FeaturePtr& feature);
+    void EndFeatureEditing();
+    void ShowFeaturePreview(const cad_core::ShapePtr& shape, cad_feature::PreviewTier tier);
+    void ClearFeaturePreview();
+    
     void UpdateWindowTitle();
     void UpdateActions();
     void RefreshUIFromOCAF();  // Refresh UI from OCAF document state
     
     bool SaveChanges();
     void SetDocumentModified(bool modified);
+    bool ChooseSaveFileName();
+    // wait为false时原生格式在后台保存，立即返回
+    bool SaveDocumentFile(const QString& fileName, bool wait);
+    QString AutosaveFileName() const;
+    // 保存时的预览：界面线程上渲染缩略图，粗网格由调用方生成（可在后台）
+    std::shared_ptr<cad_core::DocumentPreview> RenderDocumentPreview() const;
+    void DiscardAutosave();
+    
+    // 崩溃恢复
+    QString RecoveryFileName(const QString& fileName, const QString& suffix) const;
+    void StartJournal(const QString& baseFile);
+    void AttachJournal(const std::shared_ptr<cad_core::OperationJournal>& journal);
+    // 保存开始时调用：之后的修改记到以baseFile为起点的新段；返回的函数在保存成功后调用
+    std::function<void()> CheckpointJournal(const std::string& baseFile, const std::vector<std::string>& entries);
+    bool IsJournalAbandoned(const QString& journalPath) const;
+    bool RecoverFromJournal(const QString& journalPath);
+    void CheckUntitledRecovery();
+    
+    // STEP 导入（后台翻译 + 后台修复，零件分批显示）
+    struct StepImportSession;
+    void FlushStepImportParts(const std::shared_ptr<StepImportSession>& session);
+    void OnStepImportFinished(const std::shared_ptr<StepImportSession>& session, bool succeeded);
+    void OnStepHealingFinished(const std::shared_ptr<StepImportSession>& session);
+    // 正在翻译的导入（翻译线程直接写文档，事务打开），没有则为空
+    std::shared_ptr<StepImportSession> m_stepImport;
+    
+    // 网格导出（导出对话框确认后调用，后台执行）
+    void ExportSTL(const ExportDialog& dialog);
+    void ExportGLTF(const ExportDialog& dialog);
+    void ExportIGES(const QString& fileName);
+    
+    // 异步命令：在任务池上执行，进度显示在状态栏；apply在界面线程上把结果写入文档，
+    // 返回true时提交事务，否则（以及失败、取消时）放弃事务
+    void RunCommandAsync(const cad_core::CommandPtr& command, const std::function<bool()>& apply);
+    void SetCommandRunning(bool running);
+    // 异步命令执行中或STEP正在翻译：文档事务是打开的，不能保存、撤销或开始新的修改
+    bool IsDocumentBusy() const;
     
     // Actions
     QAction* m_newAction;
@@ -252,6 +342,7 @@ private:
     QAction* m_viewShadedAction;
     QAction* m_viewOrthographicAction;
     QAction* m_viewPerspectiveAction;
+    QAction* m_performanceHudAction;
     
     QAction* m_createBoxAction;
     QAction* m_createCylinderAction;
@@ -283,15 +374,21 @@ private:
     
     QAction* m_importSTEPAction;
     QAction* m_importIGESAction;
+    QAction* m_importMeshAction;
     QAction* m_exportSTEPAction;
     QAction* m_exportIGESAction;
     QAction* m_exportSTLAction;
+    QAction* m_exportGLTFAction;
+    QAction* m_lazyLoadingAction;
     
     QAction* m_showGridAction;
     QAction* m_showAxesAction;
     QAction* m_setTransparencyAction;
     QAction* m_darkThemeAction;
     QAction* m_lightThemeAction;
+    QAction* m_exportRegenTraceAction;
+    QAction* m_recordTraceAction;
+    QAction* m_exportPerfTraceAction;
     
     QAction* m_aboutAction;
     QAction* m_aboutQtAction;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QFileDialog>
+#include <QLabel>
+
+#include "cad_core/DocumentPreview.h"
+
+namespace cad_ui {
+
+/**
+ * @class PreviewFileDialog
+ * @brief 带预览的打开文件对话框
+ *
+ * 在Qt自带（非系统）的文件对话框右侧显示选中文档的缩略图、尺寸和零件数，
+ * 预览取自文件内嵌的PREV块或预览缓存，不读B-rep。
+ */
+class PreviewFileDialog : public QFileDialog {
+    Q_OBJECT
+
+public:
+    PreviewFileDialog(QWidget* parent, const QString& caption, const QString& filter,
+                      const cad_core::PreviewCache* cache);
+
+    // 与QFileDialog::getOpenFileName相同，取消时返回空串
+    static QString GetOpenFileName(QWidget* parent, const QString& caption, const QString& filter,
+                                   const cad_core::PreviewCache* cache);
+
+private slots:
+    void OnCurrentChanged(const QString& path);
+
+private:
+    const cad_core::PreviewCache* m_cache;
+    QLabel* m_imageLabel;
+    QLabel* m_infoLabel;
+};
+
+} // namespace cad_ui
@@ -6,6 +6,7 @@
 #include <QKeyEvent>
 #include <QResizeEvent>
 #include <QTimer>
+#include <functional>
 #include <map>
 #include <memory>
 
@@ -13,10 +14,16 @@
 #include <V3d_Viewer.hxx>
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_Shape.hxx>
+#include <Quantity_Color.hxx>
+#include <gp_Trsf.hxx>
 #include <AIS_ViewController.hxx>
 #include <Graphic3d_GraphicDriver.hxx>
+#include <AIS_TextLabel.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <Aspect_Window.hxx>
 
 #include "cad_core/Shape.h"
+#include "cad_core/DocumentPreview.h"
 #include "cad_core/SelectionManager.h"
 
 namespace cad_ui {
@@ -30,6 +37,8 @@ public:
 
     // 视图器初始化
     bool InitViewer();
+    // 在不显示的虚拟窗口上初始化（离屏渲染，供基准测试使用）
+    bool InitOffscreen(int width, int height);
     
     // 视图操作
     void FitAll();
@@ -44,7 +53,18 @@ public:
     
     // 形状显示
     void DisplayShape(const cad_core::ShapePtr& shape);
+    // 批量显示：全部加入后只适配视图、重绘一次（导入大装配时使用）
+    void DisplayShapes(const std::vector<cad_core::ShapePtr>& shapes, bool fitAll = true);
+    void SetShapeColor(const cad_core::ShapePtr& shape, const Quantity_Color& color);
+    void SetShapeWireframe(const cad_core::ShapePtr& shape, bool wireframe);
+    // 替换显示对象的几何，保留颜色和选择设置；不重绘，调用方最后调用RedrawAll()
+    void ReplaceShape(const cad_core::ShapePtr& oldShape, const cad_core::ShapePtr& newShape);
+    // 阵列显示：种子只建一份表示，各实例通过连接对象引用它（pattern作为移除时的键）
+    void DisplayPattern(const cad_core::ShapePtr& pattern, const cad_core::ShapePtr& seed,
+                        const std::vector<gp_Trsf>& transforms);
     void RemoveShape(const cad_core::ShapePtr& shape);
+    // 打开文档前先显示预览中的粗网格（不可选择），ClearShapes()时一起移除
+    void DisplayPreview(const cad_core::DocumentPreview& preview);
     void ClearShapes();
     void RedrawAll();
     virtual QPaintEngine* paintEngine() const;
@@ -90,6 +110,14 @@ public:
     // 坐标轴
     void ShowAxes(bool show);
     
+    // 性能HUD：帧率/帧时间、三角形和绘制对象数（OCCT帧统计，在叠加层绘制），
+    // 待三角化的对象数、最近一次操作耗时和进程内存（文字标签，只随正常重绘刷新）
+    void ShowPerformanceHud(bool show);
+    bool IsPerformanceHudVisible() const { return !m_hudLabel.IsNull(); }
+    // 提供最近一次操作的名称和耗时（毫秒），没有时返回false
+    using LastOperationProvider = std::function<bool(std::string& name, double& milliseconds)>;
+    void SetLastOperationProvider(LastOperationProvider provider) { m_lastOperationProvider = std::move(provider); }
+    
     // 透明度控制
     void SetAllTransparency(double transparency);
     
@@ -124,6 +152,10 @@ protected:
     void changeEvent(QEvent* event) override;
 
 private:
+    // 创建驱动、视图器、上下文和视图，并绑定到给定窗口
+    void SetupViewer(const Handle(Aspect_DisplayConnection)& displayConnection,
+                     const Handle(Aspect_Window)& window);
+
     Handle(V3d_Viewer) m_viewer;
     Handle(V3d_View) m_view;
     Handle(AIS_InteractiveContext) m_context;
@@ -141,6 +173,9 @@ private:
     // 用于选择同步的形状映射
     std::map<cad_core::ShapePtr, Handle(AIS_Shape)> m_shapeToAIS;
     
+    // 阵列形状 -> 实例化显示对象
+    std::map<cad_core::ShapePtr, Handle(AIS_InteractiveObject)> m_patternToAIS;
+    
     // 当前选择状态（单选模式）
     cad_core::ShapePtr m_currentSelectedShape;
     Handle(AIS_Shape) m_currentSelectedAIS;
@@ -164,12 +199,19 @@ private:
     // 当前选择模式
     int m_currentSelectionMode;
     
+    // 性能HUD
+    Handle(AIS_TextLabel) m_hudLabel;
+    QTimer* m_hudTimer;
+    LastOperationProvider m_lastOperationProvider;
+    
     void InitializeOCC();
     void RedrawView();
     void HandleSelection(const QPoint& point);
     
 private slots:
     void OnRedrawTimer();
+    // 刷新HUD文字，不触发重绘
+    void UpdatePerformanceHud();
 };
 
 } // namespace cad_ui
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <QStatusBar>
 #include <QLabel>
+#include <QProgressBar>
+#include <QToolButton>
 
 namespace cad_ui {
 
@@ -15,11 +17,28 @@ public:
     // 更新鼠标位置显示
     void updateMousePosition(double x, double y, double z);
     void updateMousePosition2D(int screenX, int screenY);
+    
+    // 后台命令的进度条和取消按钮，只在命令执行期间显示
+    void beginProgress(const QString& text);
+    void updateProgress(int percent, const QString& stage);
+    void endProgress();
+    
+    // 撤销历史的内存占用（估算），trimmedSteps为超出预算被丢弃的步数
+    void updateHistoryMemory(quint64 memoryBytes, int trimmedSteps);
+
+signals:
+    void cancelRequested();
 
 private:
     QLabel* m_mousePositionLabel;
+    QLabel* m_historyMemoryLabel;
+    QProgressBar* m_progressBar;
+    QToolButton* m_cancelButton;
+    QString m_progressText;
     
     void setupMousePositionDisplay();
+    void setupProgressDisplay();
+    void setupHistoryMemoryDisplay();
 };
 
-} // namespace cad_ui
\ No newline at end of file
+} // namespace cad_ui
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <string>
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <Aspect_Window.hxx>
+
+#include "cad_core/DocumentPreview.h"
+
+namespace cad_ui {
+
+/**
+ * @class ThumbnailRenderer
+ * @brief 文档缩略图的离屏渲染
+ *
+ * 保存时在文档视图器上临时建一个离屏V3d_View，直接渲染已经显示的对象；
+ * 只有预览数据时（文件对话框、无界面运行）用自己的离屏视图器渲染粗网格。
+ * 没有可用的OpenGL时退回软件光栅化（QPainter画粗网格）。
+ * 只在界面线程（无界面时为主线程）上调用。
+ */
+class ThumbnailRenderer {
+public:
+    // 渲染context中已显示的对象（固定在屏幕上的视图方块、坐标轴除外）
+    static QImage RenderContext(const Handle(AIS_InteractiveContext)& context, const QSize& size);
+    // 渲染预览中的粗网格
+    static QImage RenderPreview(const cad_core::DocumentPreview& preview, const QSize& size);
+    // 软件光栅化：等轴测投影，按深度从远到近画三角形
+    static QImage RenderSoftware(const cad_core::DocumentPreview& preview, const QSize& size);
+
+    static std::string EncodePng(const QImage& image);
+
+    // 不显示的虚拟窗口，V3d_View渲染到离屏帧缓冲（缩略图、视图基准共用）
+    static Handle(Aspect_Window) CreateOffscreenWindow(const Handle(Aspect_DisplayConnection)& connection,
+                                                       const QSize& size);
+
+    static const int kThumbnailSize = 256;
+};
+
+} // namespace cad_ui
@@ -1,4 +1,5 @@
 #include "cad_ui/DocumentTree.h"
+#include "cad_core/RegenerationProfiler.h"
 #include <QHeaderView>
 
 Q_DECLARE_METATYPE(cad_core::ShapePtr)
@@ -15,7 +16,11 @@ DocumentTree::DocumentTree(QWidget* parent) : QTreeWidget(parent) {
 }
 
 void DocumentTree::SetupTree() {
-    setHeaderLabel("Document");
+    setColumnCount(2);
+    setHeaderLabels(QStringList() << "Document" << "Regen");
+    header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    header()->setStretchLastSection(false);
     setRootIsDecorated(true);
     setSelectionMode(QAbstractItemView::SingleSelection);
     
@@ -49,11 +54,11 @@ void DocumentTree::CreateContextMenu() {
     connect(m_toggleVisibilityAction, &QAction::triggered, this, &DocumentTree::OnToggleVisibility);
 }
 
-void DocumentTree::AddShape(const cad_core::ShapePtr& shape) {
+void DocumentTree::AddShape(const cad_core::ShapePtr& shape, const QString& name) {
     if (!shape) return;
     
     QTreeWidgetItem* item = new QTreeWidgetItem(m_shapesRoot);
-    item->setText(0, QString("Shape %1").arg(m_shapesRoot->childCount()));
+    item->setText(0, name.isEmpty() ? QString("Shape %1").arg(m_shapesRoot->childCount()) : name);
     item->setData(0, Qt::UserRole, QVariant::fromValue(shape));
     
     m_shapesRoot->addChild(item);
@@ -74,6 +79,19 @@ void DocumentTree::RemoveShape(const cad_core::ShapePtr& shape) {
     }
 }
 
+void DocumentTree::ReplaceShape(const cad_core::ShapePtr& oldShape, const cad_core::ShapePtr& newShape) {
+    if (!oldShape || !newShape) return;
+    
+    for (int i = 0; i < m_shapesRoot->childCount(); ++i) {
+        QTreeWidgetItem* item = m_shapesRoot->child(i);
+        auto itemShape = item->data(0, Qt::UserRole).value<cad_core::ShapePtr>();
+        if (itemShape == oldShape) {
+            item->setData(0, Qt::UserRole, QVariant::fromValue(newShape));
+            break;
+        }
+    }
+}
+
 void DocumentTree::AddFeature(const cad_feature::FeaturePtr& feature) {
     if (!feature) return;
     
@@ -99,6 +117,43 @@ void DocumentTree::RemoveFeature(const cad_feature::FeaturePtr& feature) {
     }
 }
 
+void DocumentTree::UpdateFeatureReport(const cad_feature::FeaturePtr& feature) {
+    if (!feature) return;
+    
+    cad_core::RegenerationRecord record;
+    if (!cad_core::RegenerationProfiler::Instance().GetLastFeatureRecord(feature->GetId(), record)) {
+        return;
+    }
+    
+    for (int i = 0; i < m_featuresRoot->childCount(); ++i) {
+        QTreeWidgetItem* item = m_featuresRoot->child(i);
+        auto itemFeature = item->data(0, Qt::UserRole).value<cad_feature::FeaturePtr>();
+        if (itemFeature != feature) {
+            continue;
+        }
+        
+        item->setText(1, QString("%1 ms").arg(record.durationUs / 1000.0, 0, 'f', 1));
+        
+        QString report = QString("Regeneration: %1 ms\n"
+                                 "Memory delta: %2 KB\n"
+                                 "Faces in/out: %3 / %4\n"
+                                 "Cache hit/miss: %5 / %6\n"
+                                 "Thread: %7\n"
+                                 "Result: %8")
+            .arg(record.durationUs / 1000.0, 0, 'f', 2)
+            .arg(record.memoryDeltaBytes / 1024)
+            .arg(record.facesIn)
+            .arg(record.facesOut)
+            .arg(record.cacheHits)
+            .arg(record.cacheMisses)
+            .arg(record.threadId)
+            .arg(record.succeeded ? "OK" : "Failed");
+        item->setToolTip(0, report);
+        item->setToolTip(1, report);
+        break;
+    }
+}
+
 void DocumentTree::Clear() {
     m_shapesRoot->takeChildren();
     m_featuresRoot->takeChildren();
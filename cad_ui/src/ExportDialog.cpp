@@ -1,6 +1,8 @@
 #include "cad_ui/ExportDialog.h"
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QFormLayout>
+#include <cmath>
 
 namespace cad_ui {
 
@@ -40,8 +42,40 @@ void ExportDialog::SetupUI() {
     m_formatCombo->addItem("STEP (*.step)", "step");
     m_formatCombo->addItem("IGES (*.iges)", "iges");
     m_formatCombo->addItem("STL (*.stl)", "stl");
+    m_formatCombo->addItem("glTF Binary (*.glb)", "glb");
+    m_formatCombo->addItem("glTF (*.gltf)", "gltf");
     formatLayout->addWidget(m_formatCombo);
     
+    // STL options
+    m_stlGroup = new QGroupBox("Mesh");
+    QFormLayout* stlLayout = new QFormLayout(m_stlGroup);
+    
+    m_linearDeflectionSpin = new QDoubleSpinBox();
+    m_linearDeflectionSpin->setDecimals(4);
+    m_linearDeflectionSpin->setRange(0.0001, 100.0);
+    m_linearDeflectionSpin->setSingleStep(0.01);
+    m_linearDeflectionSpin->setValue(0.1);
+    m_linearDeflectionSpin->setToolTip("Maximum distance between the mesh and the surface");
+    stlLayout->addRow("Chordal deflection:", m_linearDeflectionSpin);
+    
+    m_angularDeflectionSpin = new QDoubleSpinBox();
+    m_angularDeflectionSpin->setDecimals(1);
+    m_angularDeflectionSpin->setRange(1.0, 90.0);
+    m_angularDeflectionSpin->setSuffix(" deg");
+    m_angularDeflectionSpin->setValue(28.6);
+    m_angularDeflectionSpin->setToolTip("Maximum angle between adjacent facet normals");
+    stlLayout->addRow("Angular deflection:", m_angularDeflectionSpin);
+    
+    m_asciiCheck = new QCheckBox("ASCII (larger, slower)");
+    stlLayout->addRow(m_asciiCheck);
+    
+    m_lodSpin = new QSpinBox();
+    m_lodSpin->setRange(0, 4);
+    m_lodSpin->setValue(0);
+    m_lodSpin->setToolTip("Extra coarser levels written next to the main file (name_lod1, name_lod2, ...)");
+    m_lodLabel = new QLabel("Levels of detail:");
+    stlLayout->addRow(m_lodLabel, m_lodSpin);
+    
     // Buttons
     QHBoxLayout* buttonLayout = new QHBoxLayout();
     m_okButton = new QPushButton("Export");
@@ -52,9 +86,12 @@ void ExportDialog::SetupUI() {
     
     m_mainLayout->addWidget(fileGroup);
     m_mainLayout->addWidget(formatGroup);
+    m_mainLayout->addWidget(m_stlGroup);
     m_mainLayout->addLayout(buttonLayout);
     
     setLayout(m_mainLayout);
+    
+    UpdateFormatOptions();
 }
 
 QString ExportDialog::GetFileName() const {
@@ -65,6 +102,29 @@ QString ExportDialog::GetFormat() const {
     return m_formatCombo->currentData().toString();
 }
 
+void ExportDialog::SetFormat(const QString& format) {
+    int index = m_formatCombo->findData(format);
+    if (index >= 0) {
+        m_formatCombo->setCurrentIndex(index);
+    }
+}
+
+double ExportDialog::GetLinearDeflection() const {
+    return m_linearDeflectionSpin->value();
+}
+
+double ExportDialog::GetAngularDeflection() const {
+    return m_angularDeflectionSpin->value() * M_PI / 180.0;
+}
+
+bool ExportDialog::IsAsciiStl() const {
+    return m_asciiCheck->isChecked();
+}
+
+int ExportDialog::GetLodLevels() const {
+    return m_lodSpin->value();
+}
+
 void ExportDialog::OnBrowse() {
     QString format = GetFormat();
     QString filter;
@@ -75,6 +135,10 @@ void ExportDialog::OnBrowse() {
         filter = "IGES Files (*.iges *.igs)";
     } else if (format == "stl") {
         filter = "STL Files (*.stl)";
+    } else if (format == "glb") {
+        filter = "glTF Binary Files (*.glb)";
+    } else if (format == "gltf") {
+        filter = "glTF Files (*.gltf)";
     }
     
     QString fileName = QFileDialog::getSaveFileName(this, "Export File", "", filter);
@@ -97,8 +161,14 @@ void ExportDialog::OnAccept() {
 }
 
 void ExportDialog::UpdateFormatOptions() {
-    // Update format-specific options when format changes
-    // This is a placeholder for format-specific settings
+    // Mesh settings apply to STL and glTF
+    QString format = GetFormat();
+    bool gltf = (format == "glb" || format == "gltf");
+    m_stlGroup->setVisible(format == "stl" || gltf);
+    m_asciiCheck->setVisible(format == "stl");
+    m_lodLabel->setVisible(gltf);
+    m_lodSpin->setVisible(gltf);
+    adjustSize();
 }
 
 } // namespace cad_ui
@@ -0,0 +1,332 @@
+#include "cad_ui/LazyAssemblyController.h"
+#include "cad_ui/QtOccView.h"
+#include "cad_ui/DocumentTree.h"
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <Standard_Failure.hxx>
+#include <V3d_View.hxx>
+#include <algorithm>
+
+namespace cad_ui {
+
+namespace {
+
+// 视图变化后等一会儿再判断可见性，避免拖动过程中反复加载
+const int kVisibilityDelayMs = 150;
+const double kProxyGap = 1e-3;
+
+} // namespace
+
+LazyAssemblyController::LazyAssemblyController(QtOccView* viewer, DocumentTree* tree, QObject* parent)
+    : QObject(parent)
+    , m_viewer(viewer)
+    , m_tree(tree)
+    , m_selectedPart(-1) {
+    m_visibilityTimer = new QTimer(this);
+    m_visibilityTimer->setSingleShot(true);
+    connect(m_visibilityTimer, &QTimer::timeout, this, &LazyAssemblyController::UpdateVisibility);
+
+    m_store.SetEvictCallback([this](int id, const cad_core::ShapePtr& shape) {
+        ShowProxy(id, shape);
+    });
+}
+
+int LazyAssemblyController::AddPart(const std::string& name, const Bnd_Box& box,
+                                    cad_core::LazyPartStore::Loader loader,
+                                    cad_core::LazyPartStore::Unloader unloader) {
+    int id = m_store.AddPart(name, box, std::move(loader), std::move(unloader));
+
+    cad_core::ShapePtr proxy = MakeProxy(box);
+    m_proxies.resize(id + 1);
+    m_displayed.resize(id + 1);
+    m_proxies[id] = proxy;
+    m_displayed[id] = proxy;
+    if (proxy) {
+        m_partByShape[proxy] = id;
+    }
+    m_pending.push_back(id);
+    return id;
+}
+
+void LazyAssemblyController::SetPartColor(int id, const Quantity_Color& color) {
+    m_colors[id] = color;
+}
+
+void LazyAssemblyController::FlushPendingParts(bool fitAll) {
+    if (m_pending.empty()) {
+        return;
+    }
+
+    std::vector<cad_core::ShapePtr> proxies;
+    proxies.reserve(m_pending.size());
+    for (int id : m_pending) {
+        if (m_proxies[id]) {
+            proxies.push_back(m_proxies[id]);
+        }
+    }
+
+    m_viewer->DisplayShapes(proxies, fitAll);
+    for (int id : m_pending) {
+        const cad_core::ShapePtr& proxy = m_proxies[id];
+        if (proxy) {
+            m_viewer->SetShapeWireframe(proxy, true);
+            m_viewer->SetShapeColor(proxy, Quantity_Color(Quantity_NOC_GRAY60));
+            m_tree->AddShape(proxy, QString::fromStdString(m_store.GetName(id)));
+        }
+    }
+    m_pending.clear();
+
+    ScheduleVisibilityUpdate();
+}
+
+void LazyAssemblyController::RemovePart(int id) {
+    if (!m_store.IsValidPart(id)) {
+        return;
+    }
+
+    cad_core::ShapePtr shape = m_displayed[id];
+    if (shape) {
+        m_viewer->RemoveShape(shape);
+        m_tree->RemoveShape(shape);
+        m_partByShape.erase(shape);
+    }
+    m_partByShape.erase(m_proxies[id]);
+    m_displayed[id].reset();
+    m_proxies[id].reset();
+    m_colors.erase(id);
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), id), m_pending.end());
+
+    m_store.RemovePart(id);
+    if (m_selectedPart == id) {
+        m_selectedPart = -1;
+    }
+}
+
+void LazyAssemblyController::Clear() {
+    m_visibilityTimer->stop();
+    m_store.Clear();
+    m_proxies.clear();
+    m_displayed.clear();
+    m_colors.clear();
+    m_partByShape.clear();
+    m_pending.clear();
+    m_selectedPart = -1;
+    m_prefetcher = nullptr;
+}
+
+bool LazyAssemblyController::IsLazyShape(const cad_core::ShapePtr& shape) const {
+    return FindPart(shape) >= 0;
+}
+
+bool LazyAssemblyController::IsProxy(const cad_core::ShapePtr& shape) const {
+    int id = FindPart(shape);
+    return id >= 0 && m_proxies[id] == shape;
+}
+
+cad_core::ShapePtr LazyAssemblyController::Materialize(const cad_core::ShapePtr& shape) {
+    int id = FindPart(shape);
+    if (id < 0) {
+        return shape;
+    }
+
+    cad_core::ShapePtr real = m_store.Materialize(id);
+    if (!real) {
+        return shape;
+    }
+    if (m_displayed[id] != real) {
+        ShowMaterialized(id, real);
+        m_viewer->RedrawAll();
+    }
+    return real;
+}
+
+void LazyAssemblyController::Reload(int id) {
+    if (!m_store.IsLoaded(id)) {
+        return;
+    }
+
+    cad_core::ShapePtr real = m_store.Reload(id);
+    if (real && m_displayed[id] != real) {
+        ShowMaterialized(id, real);
+    }
+}
+
+void LazyAssemblyController::SetSelectedShape(const cad_core::ShapePtr& shape) {
+    if (m_selectedPart >= 0) {
+        m_store.SetPinned(m_selectedPart, false);
+    }
+    m_selectedPart = FindPart(shape);
+    if (m_selectedPart >= 0) {
+        m_store.SetPinned(m_selectedPart, true);
+    }
+}
+
+void LazyAssemblyController::SetMemoryBudget(size_t bytes) {
+    m_store.SetMemoryBudget(bytes);
+}
+
+void LazyAssemblyController::SetPrefetcher(Prefetcher prefetcher) {
+    m_prefetcher = std::move(prefetcher);
+}
+
+void LazyAssemblyController::ScheduleVisibilityUpdate() {
+    if (m_store.GetPartCount() > 0) {
+        m_visibilityTimer->start(kVisibilityDelayMs);
+    }
+}
+
+void LazyAssemblyController::UpdateVisibility() {
+    Handle(V3d_View) view = m_viewer->GetView();
+    if (view.IsNull()) {
+        return;
+    }
+
+    const int width = m_viewer->width();
+    const int height = m_viewer->height();
+
+    // 可见零件本轮先标记使用，加载新零件时优先卸载看不见的
+    m_store.BeginFrame();
+    std::vector<std::pair<int, int>> candidates;   // (投影尺寸, 零件编号)
+
+    for (int id = 0; id < static_cast<int>(m_store.GetPartCount()); ++id) {
+        if (!m_store.IsValidPart(id)) {
+            continue;
+        }
+
+        const Bnd_Box& box = m_store.GetBoundingBox(id);
+        if (box.IsVoid()) {
+            // 没有包围盒就没法剔除，直接当作可见
+            if (!m_store.IsLoaded(id)) {
+                candidates.emplace_back(width + height, id);
+            }
+            continue;
+        }
+
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        int left = width, top = height, right = -1, bottom = -1;
+        for (int corner = 0; corner < 8; ++corner) {
+            Standard_Integer px = 0, py = 0;
+            view->Convert((corner & 1) ? xmax : xmin,
+                          (corner & 2) ? ymax : ymin,
+                          (corner & 4) ? zmax : zmin, px, py);
+            left = std::min(left, static_cast<int>(px));
+            right = std::max(right, static_cast<int>(px));
+            top = std::min(top, static_cast<int>(py));
+            bottom = std::max(bottom, static_cast<int>(py));
+        }
+
+        bool onScreen = right >= 0 && bottom >= 0 && left < width && top < height;
+        int size = std::max(right - left, bottom - top);
+        if (!onScreen || size < kMinPixelSize) {
+            continue;
+        }
+
+        if (m_store.IsLoaded(id)) {
+            m_store.Touch(id);
+        } else {
+            candidates.emplace_back(size, id);
+        }
+    }
+
+    // 屏幕上越大的零件越先加载
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+
+    if (m_prefetcher && !candidates.empty()) {
+        std::vector<int> batch;
+        for (size_t i = 0; i < candidates.size() && static_cast<int>(i) < kMaterializePerTick; ++i) {
+            batch.push_back(candidates[i].second);
+        }
+        m_prefetcher(batch);
+    }
+
+    int loaded = 0;
+    for (const auto& candidate : candidates) {
+        if (loaded >= kMaterializePerTick) {
+            break;
+        }
+        cad_core::ShapePtr real = m_store.Materialize(candidate.second);
+        if (real) {
+            ShowMaterialized(candidate.second, real);
+        }
+        ++loaded;
+    }
+
+    if (loaded > 0) {
+        m_viewer->RedrawAll();
+    }
+
+    // 还有没加载完的，下一轮接着来
+    if (static_cast<int>(candidates.size()) > loaded) {
+        m_visibilityTimer->start(0);
+    }
+}
+
+void LazyAssemblyController::ShowMaterialized(int id, const cad_core::ShapePtr& shape) {
+    cad_core::ShapePtr previous = m_displayed[id];
+    if (!previous || previous == shape) {
+        return;
+    }
+
+    m_viewer->ReplaceShape(previous, shape);
+    m_viewer->SetShapeWireframe(shape, false);
+    auto color = m_colors.find(id);
+    m_viewer->SetShapeColor(shape, color != m_colors.end() ? color->second : Quantity_Color(Quantity_NOC_ORANGE));
+    m_tree->ReplaceShape(previous, shape);
+
+    if (previous != m_proxies[id]) {
+        m_partByShape.erase(previous);
+    }
+    m_partByShape[shape] = id;
+    m_displayed[id] = shape;
+}
+
+void LazyAssemblyController::ShowProxy(int id, const cad_core::ShapePtr& evicted) {
+    if (id < 0 || id >= static_cast<int>(m_displayed.size())) {
+        return;
+    }
+
+    cad_core::ShapePtr proxy = m_proxies[id];
+    if (!proxy || m_displayed[id] != evicted) {
+        return;
+    }
+
+    m_viewer->ReplaceShape(evicted, proxy);
+    m_viewer->SetShapeWireframe(proxy, true);
+    m_viewer->SetShapeColor(proxy, Quantity_Color(Quantity_NOC_GRAY60));
+    m_tree->ReplaceShape(evicted, proxy);
+
+    m_partByShape.erase(evicted);
+    m_displayed[id] = proxy;
+}
+
+int LazyAssemblyController::FindPart(const cad_core::ShapePtr& shape) const {
+    if (!shape) {
+        return -1;
+    }
+    auto it = m_partByShape.find(shape);
+    return it != m_partByShape.end() ? it->second : -1;
+}
+
+cad_core::ShapePtr LazyAssemblyController::MakeProxy(const Bnd_Box& box) {
+    if (box.IsVoid()) {
+        return nullptr;
+    }
+
+    try {
+        // 扁平零件的包围盒可能某一维为零，稍微撑开一点
+        Bnd_Box enlarged = box;
+        enlarged.Enlarge(kProxyGap);
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        enlarged.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+
+        BRepPrimAPI_MakeBox maker(gp_Pnt(xmin, ymin, zmin), gp_Pnt(xmax, ymax, zmax));
+        return std::make_shared<cad_core::Shape>(maker.Shape());
+    } catch (const Standard_Failure&) {
+        return nullptr;
+    }
+}
+
+} // namespace cad_ui
+
+#include "LazyAssemblyController.moc"
@@ -2,6 +2,9 @@
 #include "cad_ui/ExportDialog.h"
 #include "cad_ui/AboutDialog.h"
 #include "cad_ui/CreatePrimitiveDialog.h"
+#include "cad_ui/LazyAssemblyController.h"
+#include "cad_ui/PreviewFileDialog.h"
+#include "cad_ui/ThumbnailRenderer.h"
 #include "cad_core/CreateBoxCommand.h"
 #include "cad_core/CreateCylinderCommand.h"
 #include "cad_core/CreateSphereCommand.h"
@@ -9,8 +12,25 @@
 #include "cad_core/ShapeFactory.h"
 #include "cad_core/BooleanOperations.h"
 #include "cad_core/FilletChamferOperations.h"
+#include "cad_core/BooleanCommand.h"
+#include "cad_core/FilletChamferCommand.h"
 #include "cad_core/SelectionManager.h"
+#include "cad_core/RegenerationProfiler.h"
+#include "cad_core/Tracer.h"
+#include "cad_core/Logger.h"
+#include "cad_core/StepImporter.h"
+#include "cad_core/ExportParts.h"
+#include "cad_core/StlExporter.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/GltfExporter.h"
+#include "cad_core/IgesImporter.h"
+#include "cad_core/IgesExporter.h"
+#include "cad_core/OperationJournal.h"
+#include "cad_core/DocumentPreview.h"
+#include "cad_core/TaskScheduler.h"
+#include "cad_feature/PatternFeature.h"
 #include <TopoDS.hxx>
+#include <Standard_Failure.hxx>
 
 #include <iostream>
 #include <QApplication>
@@ -22,6 +42,7 @@
 #include <QSettings>
 #include <QTabWidget>
 #include <QFile>
+#include <QFileInfo>
 #include <QTextStream>
 #include <QDebug>
 #include <QToolButton>
@@ -29,17 +50,95 @@
 #include <QVBoxLayout>
 #include <QFrame>
 #include <QLabel>
+#include <QDialog>
+#include <QProgressDialog>
+#include <QPointer>
+#include <QScrollBar>
+#include <QTextCursor>
+#include <QTextEdit>
+#include <QDir>
+#include <QStandardPaths>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <functional>
 #include <map>
+#include <mutex>
 
 namespace cad_ui {
 
+namespace {
+
+// 快照中零件的标签条目，按保存到文件中的顺序
+std::vector<std::string> SnapshotEntries(const cad_core::NativeSaveSession::Snapshot& snapshot) {
+    std::vector<std::string> entries;
+    entries.reserve(snapshot.parts.size());
+    for (const cad_core::NativeDocumentFile::PartData& part : snapshot.parts) {
+        entries.push_back(part.entry);
+    }
+    return entries;
+}
+
+// 控制台保留的行数
+const int kConsoleHistoryLines = 5000;
+
+// 一批日志行一次插入到控制台末尾；用户没有往上翻时保持滚动到底部
+void AppendConsoleLines(QTextEdit* console, const QStringList& lines) {
+    if (lines.isEmpty()) {
+        return;
+    }
+    QScrollBar* scrollBar = console->verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+    
+    QTextCursor cursor(console->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    for (const QString& line : lines) {
+        if (!console->document()->isEmpty()) {
+            cursor.insertBlock();
+        }
+        cursor.insertText(line);
+    }
+    cursor.endEditBlock();
+    
+    if (atBottom) {
+        scrollBar->setValue(scrollBar->maximum());
+    }
+}
+
+// 在共享任务池里执行，通过QFutureInterface交给QFutureWatcher，
+// 和预览、网格、布尔共用同一组线程，不再另开QThreadPool
+QFuture<bool> RunInTaskPool(std::function<bool()> work,
+                            cad_core::TaskPriority priority = cad_core::TaskPriority::Normal) {
+    QFutureInterface<bool> promise;
+    promise.reportStarted();
+    QFuture<bool> future = promise.future();
+    cad_core::TaskScheduler::Instance().Submit([promise, work]() mutable {
+        bool result = false;
+        try {
+            result = work();
+        } catch (...) {
+            // 无论成败都要完成future，否则watcher和waitForFinished永远等下去
+        }
+        promise.reportResult(result);
+        promise.reportFinished();
+    }, priority);
+    return future;
+}
+
+} // namespace
+
 MainWindow::MainWindow(QWidget* parent) 
-    : QMainWindow(parent), m_tabWidget(nullptr), m_documentModified(false), 
+    : QMainWindow(parent), m_tabWidget(nullptr), m_documentModified(false), m_modificationCount(0),
+      m_autosaveTimer(nullptr), 
       m_isDragging(false), m_dragStartPosition(), m_titleBar(nullptr),
       m_titleLabel(nullptr), m_minimizeButton(nullptr), m_maximizeButton(nullptr),
       m_closeButton(nullptr), m_currentBooleanDialog(nullptr), m_currentFilletChamferDialog(nullptr),
-      m_currentTransformDialog(nullptr), m_previewActive(false), 
-      m_waitingForFaceSelection(false) {
+      m_currentTransformDialog(nullptr), m_featureDock(nullptr),
+      m_featureParameterPanel(nullptr), m_featurePreview(nullptr), m_featureEdited(false),
+      m_previewActive(false), 
+      m_waitingForFaceSelection(false), m_logSinkId(0) {
     
     // Load modern flat stylesheet
     QFile styleFile(":/resources/styles.qss");
@@ -89,6 +188,20 @@ MainWindow::MainWindow(QWidget* parent)
     m_viewer = new QtOccView(this);
     m_viewer->setObjectName("viewer3D");
     m_tabWidget->addTab(m_viewer, "Document 1");
+    // 性能HUD中的"最近一次操作"取最近提交的文档事务
+    m_viewer->SetLastOperationProvider([this](std::string& name, double& milliseconds) {
+        return m_ocafManager && m_ocafManager->GetLastTransaction(name, milliseconds);
+    });
+    
+    // 大装配延迟加载（预算单位MB，保存在设置里）
+    m_lazyAssembly = new LazyAssemblyController(m_viewer, m_documentTree, this);
+    QSettings settings;
+    m_lazyAssembly->SetMemoryBudget(
+        static_cast<size_t>(settings.value("LazyAssembly/MemoryBudgetMB", 1024).toULongLong()) * 1024 * 1024);
+    // 文档撤销栈的内存预算（MB）
+    const quint64 defaultHistoryBudgetMB = cad_core::OCAFDocument::kDefaultUndoMemoryBudgetBytes / (1024 * 1024);
+    m_ocafManager->SetUndoMemoryBudget(
+        static_cast<size_t>(settings.value("History/MemoryBudgetMB", defaultHistoryBudgetMB).toULongLong()) * 1024 * 1024);
     
     // Create main splitter with viewer and console
     m_mainSplitter = new QSplitter(Qt::Vertical, this);
@@ -109,6 +222,18 @@ MainWindow::MainWindow(QWidget* parent)
     // Connect signals
     ConnectSignals();
     
+    // 定时自动保存（间隔单位分钟，0表示关闭），只在文档有改动时写出
+    m_autosaveTimer = new QTimer(this);
+    connect(m_autosaveTimer, &QTimer::timeout, this, &MainWindow::OnAutosave);
+    int autosaveMinutes = settings.value("Autosave/IntervalMinutes", 5).toInt();
+    if (autosaveMinutes > 0) {
+        m_autosaveTimer->start(autosaveMinutes * 60 * 1000);
+    }
+    
+    QString previewDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/previews";
+    QDir().mkpath(previewDirectory);
+    m_previewCache.reset(new cad_core::PreviewCache(previewDirectory.toStdString()));
+    
     // Connect tab widget signals
     connect(m_tabWidget, &QTabWidget::tabCloseRequested, this, &MainWindow::CloseDocumentTab);
     connect(m_tabWidget, &QTabWidget::currentChanged, this, &MainWindow::OnTabChanged);
@@ -127,6 +252,12 @@ MainWindow::MainWindow(QWidget* parent)
     UpdateWindowTitle();
 }
 
+MainWindow::~MainWindow() {
+    // 之后日志线程不会再调用这个窗口的sink
+    cad_core::Logger::Instance().RemoveSink(m_logSinkId);
+    qInstallMessageHandler(nullptr);
+}
+
 bool MainWindow::Initialize() {
     
     // Initialize OCAF manager
@@ -140,6 +271,9 @@ bool MainWindow::Initialize() {
         QMessageBox::critical(this, "Error", "Failed to create new OCAF document");
         return false;
     }
+    StartJournal(QString());
+    // 窗口显示后再检查上次未正常退出留下的未命名文档
+    QTimer::singleShot(0, this, &MainWindow::CheckUntitledRecovery);
     
     // Set initial view and render
     m_viewer->FitAll();
@@ -170,6 +304,33 @@ void MainWindow::CreateActions() {
     m_exitAction->setShortcut(QKeySequence::Quit);
     m_exitAction->setStatusTip("Exit the application");
     
+    // Import/Export actions
+    m_importSTEPAction = new QAction("Import &STEP...", this);
+    m_importSTEPAction->setStatusTip("Import a STEP part or assembly");
+    
+    m_importIGESAction = new QAction("Import &IGES...", this);
+    m_importIGESAction->setStatusTip("Import an IGES file");
+    
+    m_importMeshAction = new QAction("Import &Mesh (STL/OBJ)...", this);
+    m_importMeshAction->setStatusTip("Import a triangle mesh without converting it to B-rep");
+    
+    m_exportSTEPAction = new QAction("Export S&TEP...", this);
+    m_exportSTEPAction->setStatusTip("Export the document as STEP");
+    
+    m_exportIGESAction = new QAction("Export I&GES...", this);
+    m_exportIGESAction->setStatusTip("Export the document as IGES");
+    
+    m_exportSTLAction = new QAction("Export ST&L...", this);
+    m_exportSTLAction->setStatusTip("Export the document as STL mesh");
+    
+    m_exportGLTFAction = new QAction("Export gl&TF/GLB...", this);
+    m_exportGLTFAction->setStatusTip("Export the tessellated scene as glTF 2.0 for web viewers");
+    
+    m_lazyLoadingAction = new QAction("&Lazy Assembly Loading", this);
+    m_lazyLoadingAction->setCheckable(true);
+    m_lazyLoadingAction->setChecked(QSettings().value("LazyAssembly/Enabled", false).toBool());
+    m_lazyLoadingAction->setStatusTip("Load structure and bounding boxes first, part geometry on demand");
+    
     // Edit actions
     m_undoAction = new QAction("&Undo", this);
     m_undoAction->setShortcut(QKeySequence::Undo);
@@ -223,6 +384,11 @@ void MainWindow::CreateActions() {
     m_setTransparencyAction->setShortcut(QKeySequence("T"));
     m_setTransparencyAction->setStatusTip("Set all models to 50% transparency");
     
+    m_performanceHudAction = new QAction("Performance &HUD", this);
+    m_performanceHudAction->setCheckable(true);
+    m_performanceHudAction->setShortcut(QKeySequence("Ctrl+Shift+H"));
+    m_performanceHudAction->setStatusTip("Show frame rate, triangles, memory and the last operation time in the 3D view");
+    
     m_projectionModeGroup = new QActionGroup(this);
     m_projectionModeGroup->addAction(m_viewOrthographicAction);
     m_projectionModeGroup->addAction(m_viewPerspectiveAction);
@@ -322,6 +488,18 @@ void MainWindow::CreateActions() {
     m_themeGroup->addAction(m_darkThemeAction);
     m_themeGroup->addAction(m_lightThemeAction);
     
+    // Profiling actions
+    m_exportRegenTraceAction = new QAction("Export &Regeneration Trace...", this);
+    m_exportRegenTraceAction->setStatusTip("Export feature regeneration timings as Chrome trace JSON");
+    
+    m_recordTraceAction = new QAction("Record &Performance Trace", this);
+    m_recordTraceAction->setStatusTip("Record timing zones of modeling, document and view operations");
+    m_recordTraceAction->setCheckable(true);
+    m_recordTraceAction->setChecked(cad_core::Tracer::Instance().IsEnabled());
+    
+    m_exportPerfTraceAction = new QAction("Export Performance &Trace...", this);
+    m_exportPerfTraceAction->setStatusTip("Export recorded timing zones as Chrome trace JSON (attach it to bug reports)");
+    
     // Help actions
     m_aboutAction = new QAction("&About", this);
     m_aboutAction->setStatusTip("Show the application's About box");
@@ -339,6 +517,17 @@ void MainWindow::CreateMenus() {
     fileMenu->addAction(m_saveAction);
     fileMenu->addAction(m_saveAsAction);
     fileMenu->addSeparator();
+    QMenu* importMenu = fileMenu->addMenu("&Import");
+    importMenu->addAction(m_importSTEPAction);
+    importMenu->addAction(m_importIGESAction);
+    importMenu->addAction(m_importMeshAction);
+    QMenu* exportMenu = fileMenu->addMenu("&Export");
+    exportMenu->addAction(m_exportSTEPAction);
+    exportMenu->addAction(m_exportIGESAction);
+    exportMenu->addAction(m_exportSTLAction);
+    exportMenu->addAction(m_exportGLTFAction);
+    fileMenu->addAction(m_lazyLoadingAction);
+    fileMenu->addSeparator();
     fileMenu->addAction(m_exitAction);
     
     // Edit menu
@@ -359,6 +548,7 @@ void MainWindow::CreateMenus() {
     viewMenu->addAction(m_viewPerspectiveAction);
     viewMenu->addSeparator();
     viewMenu->addAction(m_setTransparencyAction);
+    viewMenu->addAction(m_performanceHudAction);
     
     // Create menu
     QMenu* createMenu = menuBar()->addMenu("&Create");
@@ -394,6 +584,10 @@ void MainWindow::CreateMenus() {
     QMenu* toolsMenu = menuBar()->addMenu("&Tools");
     toolsMenu->addAction(m_darkThemeAction);
     toolsMenu->addAction(m_lightThemeAction);
+    toolsMenu->addSeparator();
+    toolsMenu->addAction(m_exportRegenTraceAction);
+    toolsMenu->addAction(m_recordTraceAction);
+    toolsMenu->addAction(m_exportPerfTraceAction);
     
     // Help menu
     QMenu* helpMenu = menuBar()->addMenu("&Help");
@@ -885,6 +1079,9 @@ void MainWindow::CreateToolBars() {
 }
 
 void MainWindow::CreateStatusBar() {
+    m_statusBar = new StatusBar(this);
+    setStatusBar(m_statusBar);
+    connect(m_statusBar, &StatusBar::cancelRequested, this, &MainWindow::OnCancelCommand);
     statusBar()->showMessage("Ready");
 }
 
@@ -900,6 +1097,15 @@ void MainWindow::CreateDockWidgets() {
     m_propertyPanel = new PropertyPanel(this);
     m_propertyDock->setWidget(m_propertyPanel);
     addDockWidget(Qt::RightDockWidgetArea, m_propertyDock);
+    
+    // Feature parameter dock (shown while a feature is being edited)
+    m_featureDock = new QDockWidget("Feature Parameters", this);
+    m_featureParameterPanel = new cad_feature::ParameterPanel(this);
+    m_featureDock->setWidget(m_featureParameterPanel);
+    addDockWidget(Qt::RightDockWidgetArea, m_featureDock);
+    m_featureDock->hide();
+    
+    m_featurePreview = new cad_feature::LivePreview(this);
 }
 
 void MainWindow::ConnectSignals() {
@@ -909,6 +1115,16 @@ void MainWindow::ConnectSignals() {
     connect(m_saveAction, &QAction::triggered, this, &MainWindow::OnSaveDocument);
     connect(m_saveAsAction, &QAction::triggered, this, &MainWindow::OnSaveDocumentAs);
     connect(m_exitAction, &QAction::triggered, this, &MainWindow::OnExit);
+    connect(m_importSTEPAction, &QAction::triggered, this, &MainWindow::OnImportSTEP);
+    connect(m_importIGESAction, &QAction::triggered, this, &MainWindow::OnImportIGES);
+    connect(m_importMeshAction, &QAction::triggered, this, &MainWindow::OnImportMesh);
+    connect(m_exportSTEPAction, &QAction::triggered, this, &MainWindow::OnExportSTEP);
+    connect(m_exportIGESAction, &QAction::triggered, this, &MainWindow::OnExportIGES);
+    connect(m_exportSTLAction, &QAction::triggered, this, &MainWindow::OnExportSTL);
+    connect(m_exportGLTFAction, &QAction::triggered, this, &MainWindow::OnExportGLTF);
+    connect(m_lazyLoadingAction, &QAction::toggled, this, [](bool enabled) {
+        QSettings().setValue("LazyAssembly/Enabled", enabled);
+    });
     
     // Edit actions
     connect(m_undoAction, &QAction::triggered, this, &MainWindow::OnUndo);
@@ -922,6 +1138,7 @@ void MainWindow::ConnectSignals() {
     connect(m_viewShadedAction, &QAction::triggered, this, &MainWindow::OnViewShaded);
     connect(m_viewOrthographicAction, &QAction::triggered, this, &MainWindow::OnViewOrthographic);
     connect(m_viewPerspectiveAction, &QAction::triggered, this, &MainWindow::OnViewPerspective);
+    connect(m_performanceHudAction, &QAction::toggled, this, &MainWindow::OnTogglePerformanceHud);
     connect(m_setTransparencyAction, &QAction::triggered, this, &MainWindow::OnSetTransparency);
     
     // Create actions
@@ -953,6 +1170,43 @@ void MainWindow::ConnectSignals() {
     connect(m_darkThemeAction, &QAction::triggered, this, &MainWindow::OnDarkTheme);
     connect(m_lightThemeAction, &QAction::triggered, this, &MainWindow::OnLightTheme);
     
+    // Profiling actions
+    connect(m_exportRegenTraceAction, &QAction::triggered, this, &MainWindow::OnExportRegenerationTrace);
+    connect(m_recordTraceAction, &QAction::toggled, this, &MainWindow::OnRecordPerformanceTrace);
+    connect(m_exportPerfTraceAction, &QAction::triggered, this, &MainWindow::OnExportPerformanceTrace);
+    
+    // Feature manager notifications keep the document tree and its regeneration report current
+    m_featureManager->SetFeatureAddedCallback([this](const cad_feature::FeaturePtr& feature) {
+        m_documentTree->AddFeature(feature);
+    });
+    m_featureManager->SetFeatureRemovedCallback([this](const cad_feature::FeaturePtr& feature) {
+        m_documentTree->RemoveFeature(feature);
+    });
+    m_featureManager->SetFeatureUpdatedCallback([this](const cad_feature::FeaturePtr& feature) {
+        m_documentTree->UpdateFeatureReport(feature);
+    });
+    
+    // 特征参数修改后立即刷新预览：粗略结果同步给出，精确结果在后台算完后替换
+    m_featureParameterPanel->SetParameterChangedCallback([this](const std::string&, double) {
+        m_featureEdited = true;
+        if (m_featurePreview->IsPreviewActive()) {
+            m_featurePreview->UpdatePreview();
+        } else {
+            m_featurePreview->StartPreview();
+        }
+    });
+    m_featurePreview->SetTieredPreviewCallback([this](const cad_core::ShapePtr& shape, cad_feature::PreviewTier tier) {
+        ShowFeaturePreview(shape, tier);
+    });
+    m_featurePreview->SetPreviewClearCallback([this]() {
+        ClearFeaturePreview();
+    });
+    connect(m_featureDock, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (!visible) {
+            EndFeatureEditing();
+        }
+    });
+    
     // Help actions
     connect(m_aboutAction, &QAction::triggered, this, &MainWindow::OnAbout);
     connect(m_aboutQtAction, &QAction::triggered, this, &MainWindow::OnAboutQt);
@@ -960,13 +1214,14 @@ void MainWindow::ConnectSignals() {
     // Viewer signals
     connect(m_viewer, &QtOccView::ShapeSelected, this, &MainWindow::OnShapeSelected);
     connect(m_viewer, &QtOccView::ViewChanged, this, &MainWindow::OnViewChanged);
+    connect(m_viewer, &QtOccView::ViewChanged, m_lazyAssembly, &LazyAssemblyController::ScheduleVisibilityUpdate);
     connect(m_viewer, &QtOccView::FaceSelected, this, &MainWindow::OnFaceSelected);
     connect(m_viewer, &QtOccView::SketchModeEntered, this, &MainWindow::OnSketchModeEntered);
     connect(m_viewer, &QtOccView::SketchModeExited, this, &MainWindow::OnSketchModeExited);
     
     // Mouse position signals
     //connect(m_viewer, &QtOccView::MousePositionChanged, m_statusBar, &StatusBar::updateMousePosition2D);
-    //connect(m_viewer, &QtOccView::Mouse3DPositionChanged, m_statusBar, &StatusBar::updateMousePosition);
+    connect(m_viewer, &QtOccView::Mouse3DPositionChanged, m_statusBar, &StatusBar::updateMousePosition);
     
     // Document tree signals for selection synchronization
     connect(m_documentTree, &DocumentTree::ShapeSelected, this, &MainWindow::OnDocumentTreeShapeSelected);
@@ -975,17 +1230,22 @@ void MainWindow::ConnectSignals() {
 
 void MainWindow::UpdateActions() {
     bool hasDocument = !m_currentFileName.isEmpty();
-    bool canUndo = m_ocafManager->CanUndo();
-    bool canRedo = m_ocafManager->CanRedo();
+    // 异步命令执行或STEP翻译期间文档事务是打开的，不能撤销、重做或保存
+    bool busy = IsDocumentBusy();
+    bool canUndo = !busy && m_ocafManager->CanUndo();
+    bool canRedo = !busy && m_ocafManager->CanRedo();
     
-    m_saveAction->setEnabled(hasDocument && m_documentModified);
-    m_saveAsAction->setEnabled(hasDocument);
+    m_saveAction->setEnabled(!busy && hasDocument && m_documentModified);
+    m_saveAsAction->setEnabled(!busy && hasDocument);
     m_undoAction->setEnabled(canUndo);
     m_redoAction->setEnabled(canRedo);
     
     // Update action text based on availability
     m_undoAction->setText(canUndo ? "&Undo" : "&Undo");
     m_redoAction->setText(canRedo ? "&Redo" : "&Redo");
+    
+    m_statusBar->updateHistoryMemory(m_ocafManager->GetUndoMemoryUsage(),
+                                     static_cast<int>(m_ocafManager->GetTrimmedUndoSteps()));
 }
 
 void MainWindow::RefreshUIFromOCAF() {
@@ -998,17 +1258,52 @@ void MainWindow::RefreshUIFromOCAF() {
     // Clear current UI state
     m_viewer->ClearShapes();
     m_documentTree->Clear();
-    
-    // Reload all shapes from OCAF document
-    auto allShapes = m_ocafManager->GetAllShapes();
-    qDebug() << "Found" << allShapes.size() << "shapes in OCAF document";
-    
-    for (const auto& shape : allShapes) {
-        if (shape) {
-            // Display in 3D viewer
-            m_viewer->DisplayShape(shape);
-            // Add to document tree
-            m_documentTree->AddShape(shape);
+    m_lazyAssembly->Clear();
+    
+    std::shared_ptr<cad_core::OCAFDocument> document = m_ocafManager->GetDocument();
+    if (document && document->IsLazy()) {
+        // 延迟打开的文档：有包围盒的形状先显示代理，几何等可见/选中时再读
+        std::vector<cad_core::ShapePtr> eagerShapes;
+        auto labelsById = std::make_shared<std::map<int, TDF_Label>>();
+        for (const auto& label : document->GetAllShapes()) {
+            Bnd_Box box;
+            if (document->GetBoundingBox(label, box)) {
+                int id = m_lazyAssembly->AddPart(document->GetName(label), box,
+                                                 [document, label]() { return document->GetShape(label); },
+                                                 [document, label]() { document->UnloadShape(label); });
+                (*labelsById)[id] = label;
+            } else if (cad_core::ShapePtr shape = document->GetShape(label)) {
+                eagerShapes.push_back(shape);
+                m_documentTree->AddShape(shape, QString::fromStdString(document->GetName(label)));
+            }
+        }
+        qDebug() << "Lazy document:" << m_lazyAssembly->GetStore().GetPartCount() << "deferred shapes,"
+                 << eagerShapes.size() << "loaded shapes";
+        // 同一轮要显示的零件一次从文件读入，而不是每个零件各解析一遍文件
+        m_lazyAssembly->SetPrefetcher([document, labelsById](const std::vector<int>& ids) {
+            std::vector<TDF_Label> labels;
+            for (int id : ids) {
+                auto it = labelsById->find(id);
+                if (it != labelsById->end()) {
+                    labels.push_back(it->second);
+                }
+            }
+            document->PrefetchShapes(labels);
+        });
+        m_viewer->DisplayShapes(eagerShapes, false);
+        m_lazyAssembly->FlushPendingParts(true);
+    } else {
+        // Reload all shapes from OCAF document
+        auto allShapes = m_ocafManager->GetAllShapes();
+        qDebug() << "Found" << allShapes.size() << "shapes in OCAF document";
+        
+        for (const auto& shape : allShapes) {
+            if (shape) {
+                // Display in 3D viewer
+                m_viewer->DisplayShape(shape);
+                // Add to document tree
+                m_documentTree->AddShape(shape);
+            }
         }
     }
     
@@ -1034,7 +1329,31 @@ void MainWindow::UpdateWindowTitle() {
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
+    // 翻译线程还在写文档：先取消，等完成回调回滚事务后再关闭
+    if (m_stepImport) {
+        m_stepImport->importer->Cancel();
+        statusBar()->showMessage("Cancelling STEP import...", 3000);
+        event->ignore();
+        return;
+    }
+    
+    // 正在执行的命令先取消，等它的完成回调放弃事务后再询问是否保存
+    if (m_commandManager->IsBusy()) {
+        OnCancelCommand();
+        m_commandManager->WaitForAsyncCommands();
+        QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    }
+    
     if (SaveChanges()) {
+        // 后台保存写完再退出；正常退出不需要自动保存的文件
+        m_saveFuture.waitForFinished();
+        m_autosaveFuture.waitForFinished();
+        DiscardAutosave();
+        if (m_journal) {
+            m_journal->Remove();
+            m_journal.reset();
+            m_journalLock.reset();
+        }
         event->accept();
     } else {
         event->ignore();
@@ -1064,7 +1383,10 @@ bool MainWindow::SaveChanges() {
             QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel);
         
         if (result == QMessageBox::Save) {
-            return OnSaveDocument();
+            if (m_currentFileName.isEmpty() && !ChooseSaveFileName()) {
+                return false;
+            }
+            return SaveDocumentFile(m_currentFileName, true);
         } else if (result == QMessageBox::Cancel) {
             return false;
         }
@@ -1073,6 +1395,9 @@ bool MainWindow::SaveChanges() {
 }
 
 void MainWindow::SetDocumentModified(bool modified) {
+    if (modified) {
+        ++m_modificationCount;
+    }
     m_documentModified = modified;
     UpdateActions();
     UpdateWindowTitle();
@@ -1084,28 +1409,352 @@ void MainWindow::OnNewDocument() {
 }
 
 void MainWindow::OnOpenDocument() {
-    // Placeholder implementation
-    QMessageBox::information(this, "Open Document", "Open document functionality not implemented yet");
+    if (!SaveChanges()) {
+        return;
+    }
+    
+    QString fileName = PreviewFileDialog::GetOpenFileName(this, "Open Document",
+                                                          "AnderCAD Files (*.acad *.cad);;All Files (*)",
+                                                          m_previewCache.get());
+    if (fileName.isEmpty()) {
+        return;
+    }
+    EndFeatureEditing();
+    
+    // 上次编辑这个文件时崩溃了：从日志恢复未保存的修改
+    QString journalPath = RecoveryFileName(fileName, "journal");
+    if (IsJournalAbandoned(journalPath) &&
+        QMessageBox::question(this, "Recover Document",
+                              QString("%1 was not closed properly. Recover the unsaved changes?")
+                                  .arg(QFileInfo(fileName).fileName()),
+                              QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+        m_currentFileName = fileName;
+        RecoverFromJournal(journalPath);
+        return;
+    }
+    
+    // 读B-rep之前先显示预览的粗网格，打开完成后RefreshUIFromOCAF()换成真正的形状
+    cad_core::DocumentPreview preview;
+    if (cad_core::DocumentPreview::Load(fileName.toStdString(), m_previewCache.get(), preview)) {
+        m_viewer->ClearShapes();
+        m_viewer->DisplayPreview(preview);
+    }
+    
+    bool lazy = m_lazyLoadingAction->isChecked();
+    if (!m_ocafManager->OpenDocument(fileName.toStdString(), lazy)) {
+        QMessageBox::warning(this, "Open Document", QString("Failed to open %1.").arg(fileName));
+        RefreshUIFromOCAF();
+        return;
+    }
+    
+    m_currentFileName = fileName;
+    m_autosaveSession.reset();
+    StartJournal(fileName);
+    RefreshUIFromOCAF();
+    SetDocumentModified(false);
+    statusBar()->showMessage(lazy ? "Document opened (geometry loads on demand)" : "Document opened", 3000);
 }
 
 bool MainWindow::OnSaveDocument() {
     if (m_currentFileName.isEmpty()) {
         return OnSaveDocumentAs();
     }
-    // Placeholder implementation
-    SetDocumentModified(false);
-    return true;
+    return SaveDocumentFile(m_currentFileName, false);
 }
 
 bool MainWindow::OnSaveDocumentAs() {
-    // Placeholder implementation
-    QString fileName = QFileDialog::getSaveFileName(this, "Save Document", "", "CAD Files (*.cad)");
-    if (!fileName.isEmpty()) {
-        m_currentFileName = fileName;
+    if (!ChooseSaveFileName()) {
+        return false;
+    }
+    return SaveDocumentFile(m_currentFileName, false);
+}
+
+bool MainWindow::ChooseSaveFileName() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Document", "",
+                                                    "AnderCAD Files (*.acad);;OCAF Binary Files (*.cad)");
+    if (fileName.isEmpty()) {
+        return false;
+    }
+    
+    m_currentFileName = fileName;
+    return true;
+}
+
+bool MainWindow::SaveDocumentFile(const QString& fileName, bool wait) {
+    std::shared_ptr<cad_core::OCAFDocument> document = m_ocafManager->GetDocument();
+    // 特征参数只有原生格式会写出
+    document->SetFeatureRecords(m_featureManager->GetFeatureRecords());
+    std::string path = fileName.toStdString();
+    
+    if (!cad_core::NativeDocumentFile::IsNativeFileName(path)) {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        bool saved = m_ocafManager->SaveDocument(path);
+        QApplication::restoreOverrideCursor();
+        if (!saved) {
+            QMessageBox::warning(this, "Save Document", QString("Failed to save %1.").arg(fileName));
+            return false;
+        }
+        std::function<void()> checkpoint = CheckpointJournal(path, std::vector<std::string>());
+        if (checkpoint) {
+            checkpoint();
+        }
+        // OCAF格式放不下预览，存到缓存里
+        std::shared_ptr<cad_core::DocumentPreview> preview = RenderDocumentPreview();
+        preview->Build(document->CreateSaveSnapshot().parts);
+        m_previewCache->Store(path, *preview);
         SetDocumentModified(false);
+        statusBar()->showMessage(QString("Saved %1").arg(fileName), 3000);
         return true;
     }
-    return false;
+    
+    // 原生格式：界面线程上只拍快照（复制形状句柄），编码和写文件在后台；
+    // 没改动的零件沿用文件中的块，只追加变化的部分
+    std::shared_ptr<cad_core::NativeSaveSession> session = document->GetSaveSession(path);
+    auto snapshot = std::make_shared<cad_core::NativeSaveSession::Snapshot>(document->CreateSaveSnapshot());
+    auto error = std::make_shared<std::string>();
+    const quint64 modification = m_modificationCount;
+    std::function<void()> checkpoint = CheckpointJournal(path, SnapshotEntries(*snapshot));
+    std::shared_ptr<cad_core::DocumentPreview> preview = RenderDocumentPreview();
+    m_saveFuture = RunInTaskPool([session, snapshot, preview, error]() {
+        preview->Build(snapshot->parts);
+        snapshot->preview = preview;
+        return session->Save(*snapshot, *error);
+    });
+    
+    auto finish = [this, session, error, fileName, modification, checkpoint](bool saved) {
+        if (!saved) {
+            QMessageBox::warning(this, "Save Document", QString("Failed to save %1:\n%2")
+                                     .arg(fileName)
+                                     .arg(QString::fromStdString(*error)));
+            return false;
+        }
+        if (checkpoint) {
+            checkpoint();
+        }
+        // 保存期间又有改动时文档仍是已修改状态
+        if (modification == m_modificationCount) {
+            SetDocumentModified(false);
+        }
+        QString kilobytes = QString::number(static_cast<qulonglong>(session->GetLastBytesWritten() / 1024));
+        statusBar()->showMessage(session->WasLastSaveDelta()
+                                     ? QString("Saved %1 (%2 KB of changes appended)").arg(fileName).arg(kilobytes)
+                                     : QString("Saved %1 (%2 KB)").arg(fileName).arg(kilobytes), 3000);
+        return true;
+    };
+    
+    if (wait) {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        m_saveFuture.waitForFinished();
+        QApplication::restoreOverrideCursor();
+        return finish(m_saveFuture.result());
+    }
+    
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [watcher, finish]() {
+        bool saved = watcher->result();
+        watcher->deleteLater();
+        finish(saved);
+    });
+    watcher->setFuture(m_saveFuture);
+    statusBar()->showMessage(QString("Saving %1...").arg(fileName));
+    return true;
+}
+
+void MainWindow::OnAutosave() {
+    // 没有改动、上一次还没写完、命令还在执行或STEP还在翻译（事务未结束）时跳过
+    if (!m_documentModified || m_autosaveFuture.isRunning() || IsDocumentBusy()) {
+        return;
+    }
+    // 延迟打开的OCAF文档拍快照要读出全部几何，不自动保存
+    std::shared_ptr<cad_core::OCAFDocument> document = m_ocafManager->GetDocument();
+    if (document->IsLazy() && !cad_core::NativeDocumentFile::IsNativeFileName(m_currentFileName.toStdString())) {
+        return;
+    }
+    
+    std::string path = AutosaveFileName().toStdString();
+    if (!m_autosaveSession || m_autosaveSession->GetFileName() != path) {
+        m_autosaveSession = std::make_shared<cad_core::NativeSaveSession>(path);
+    }
+    document->SetFeatureRecords(m_featureManager->GetFeatureRecords());
+    
+    std::shared_ptr<cad_core::NativeSaveSession> session = m_autosaveSession;
+    auto snapshot = std::make_shared<cad_core::NativeSaveSession::Snapshot>(document->CreateSaveSnapshot());
+    auto error = std::make_shared<std::string>();
+    // 自动保存的文件同时作为恢复日志的新起点
+    std::function<void()> checkpoint = CheckpointJournal(path, SnapshotEntries(*snapshot));
+    m_autosaveFuture = RunInTaskPool([session, snapshot, error]() {
+        return session->Save(*snapshot, *error);
+    }, cad_core::TaskPriority::Background);
+    
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, session, error, checkpoint]() {
+        bool saved = watcher->result();
+        watcher->deleteLater();
+        if (!saved) {
+            qDebug() << "Autosave failed:" << QString::fromStdString(*error);
+            return;
+        }
+        if (checkpoint) {
+            checkpoint();
+        }
+        statusBar()->showMessage(QString("Autosaved (%1 KB)")
+                                     .arg(static_cast<qulonglong>(session->GetLastBytesWritten() / 1024)), 2000);
+    });
+    watcher->setFuture(m_autosaveFuture);
+}
+
+QString MainWindow::AutosaveFileName() const {
+    return RecoveryFileName(m_currentFileName, "autosave.acad");
+}
+
+std::shared_ptr<cad_core::DocumentPreview> MainWindow::RenderDocumentPreview() const {
+    auto preview = std::make_shared<cad_core::DocumentPreview>();
+    QtOccView* viewer = GetCurrentViewer();
+    if (viewer) {
+        const QSize size(ThumbnailRenderer::kThumbnailSize, ThumbnailRenderer::kThumbnailSize);
+        QImage image = ThumbnailRenderer::RenderContext(viewer->GetContext(), size);
+        if (!image.isNull()) {
+            preview->SetImage(ThumbnailRenderer::EncodePng(image), image.width(), image.height());
+        }
+    }
+    return preview;
+}
+
+QString MainWindow::RecoveryFileName(const QString& fileName, const QString& suffix) const {
+    // 已保存过的文档写到同目录下的隐藏文件，未命名的文档写到应用数据目录
+    if (!fileName.isEmpty()) {
+        QFileInfo info(fileName);
+        return info.absoluteDir().filePath("." + info.completeBaseName() + "." + suffix);
+    }
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/autosave";
+    QDir().mkpath(directory);
+    return directory + QString("/untitled-%1.%2").arg(QCoreApplication::applicationPid()).arg(suffix);
+}
+
+void MainWindow::DiscardAutosave() {
+    // 正在写的自动保存结束后再删（完成时会再调用这里）
+    if (!m_autosaveSession || m_autosaveFuture.isRunning()) {
+        return;
+    }
+    QFile::remove(QString::fromStdString(m_autosaveSession->GetFileName()));
+    m_autosaveSession.reset();
+}
+
+void MainWindow::StartJournal(const QString& baseFile) {
+    // 旧文档的日志已经没用了（关闭前已询问过是否保存）
+    if (m_journal) {
+        m_journal->Remove();
+    }
+    auto journal = std::make_shared<cad_core::OperationJournal>(
+        RecoveryFileName(m_currentFileName, "journal").toStdString());
+    if (!journal->Start(baseFile.toStdString(), std::vector<std::string>())) {
+        qDebug() << "Cannot start operation journal" << QString::fromStdString(journal->GetPath());
+        m_journal.reset();
+        m_journalLock.reset();
+        return;
+    }
+    AttachJournal(journal);
+}
+
+void MainWindow::AttachJournal(const std::shared_ptr<cad_core::OperationJournal>& journal) {
+    m_journal = journal;
+    m_ocafManager->GetDocument()->SetJournal(journal);
+    m_journalLock.reset(new QLockFile(QString::fromStdString(journal->GetPath()) + ".lock"));
+    m_journalLock->setStaleLockTime(0);
+    m_journalLock->tryLock(0);
+}
+
+std::function<void()> MainWindow::CheckpointJournal(const std::string& baseFile,
+                                                    const std::vector<std::string>& entries) {
+    std::string path = RecoveryFileName(m_currentFileName, "journal").toStdString();
+    if (m_journal && m_journal->GetPath() == path) {
+        int segment = m_journal->Rotate(baseFile, entries);
+        std::shared_ptr<cad_core::OperationJournal> journal = m_journal;
+        return [journal, segment]() { journal->DiscardSegmentsBefore(segment); };
+    }
+    
+    // 另存为（或恢复了别的日志）：在新位置重新开始，旧日志在保存成功后删除
+    std::shared_ptr<cad_core::OperationJournal> previous = m_journal;
+    auto journal = std::make_shared<cad_core::OperationJournal>(path);
+    if (!journal->Start(baseFile, entries)) {
+        return std::function<void()>();
+    }
+    AttachJournal(journal);
+    return [previous]() {
+        if (previous) {
+            previous->Remove();
+        }
+    };
+}
+
+bool MainWindow::IsJournalAbandoned(const QString& journalPath) const {
+    if (m_journal && m_journal->GetPath() == journalPath.toStdString()) {
+        return false;
+    }
+    // 拿得到锁说明写日志的进程已经不在了
+    QLockFile lock(journalPath + ".lock");
+    lock.setStaleLockTime(0);
+    return lock.tryLock(0) && cad_core::OperationJournal::HasRecoveryData(journalPath.toStdString());
+}
+
+bool MainWindow::RecoverFromJournal(const QString& journalPath) {
+    cad_core::OperationJournal::ReplayStats stats;
+    std::string error;
+    QElapsedTimer timer;
+    timer.start();
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool recovered = cad_core::OperationJournal::Replay(journalPath.toStdString(), *m_ocafManager->GetDocument(),
+                                                       m_lazyLoadingAction->isChecked(), stats, error);
+    QApplication::restoreOverrideCursor();
+    if (!recovered) {
+        QMessageBox::warning(this, "Recover Document",
+                             QString("Recovery failed:\n%1").arg(QString::fromStdString(error)));
+        return false;
+    }
+    
+    // 接着恢复出来的日志记录；下面的自动保存成功后旧段才会删除
+    if (m_journal) {
+        m_journal->Remove();
+    }
+    auto journal = std::make_shared<cad_core::OperationJournal>(journalPath.toStdString());
+    if (journal->Resume()) {
+        AttachJournal(journal);
+    } else {
+        m_journal.reset();
+        m_journalLock.reset();
+    }
+    
+    m_autosaveSession.reset();
+    RefreshUIFromOCAF();
+    SetDocumentModified(true);
+    statusBar()->showMessage(QString("Recovered %1 operations (%2 shapes) in %3 s")
+                                 .arg(static_cast<qulonglong>(stats.transactions))
+                                 .arg(static_cast<qulonglong>(stats.shapes))
+                                 .arg(timer.elapsed() / 1000.0, 0, 'f', 1), 5000);
+    OnAutosave();
+    return true;
+}
+
+void MainWindow::CheckUntitledRecovery() {
+    // 其他进程留下的未命名文档日志（untitled-<pid>.journal.<N>）
+    QDir directory(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/autosave");
+    QSet<QString> journals;
+    for (const QString& name : directory.entryList(QStringList() << "untitled-*.journal.*", QDir::Files)) {
+        journals.insert(directory.filePath(name.left(name.lastIndexOf('.'))));
+    }
+    
+    for (const QString& journalPath : journals) {
+        if (!IsJournalAbandoned(journalPath)) {
+            continue;
+        }
+        if (QMessageBox::question(this, "Recover Document",
+                                  "An unsaved document from a previous session was found. Recover it?",
+                                  QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+            RecoverFromJournal(journalPath);
+            return;
+        }
+        cad_core::OperationJournal(journalPath.toStdString()).Remove();
+    }
 }
 
 void MainWindow::OnExit() {
@@ -1290,6 +1939,46 @@ void MainWindow::OnLightTheme() {
     m_themeManager->SetTheme("light");
 }
 
+void MainWindow::OnExportRegenerationTrace() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Regeneration Trace", "regeneration_trace.json",
+                                                    "Chrome Trace (*.json);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    if (!cad_core::RegenerationProfiler::Instance().ExportChromeTrace(fileName.toStdString())) {
+        QMessageBox::warning(this, "Export Failed", "Could not write trace file: " + fileName);
+        return;
+    }
+    
+    qDebug() << "Regeneration trace exported to" << fileName;
+}
+
+void MainWindow::OnRecordPerformanceTrace(bool enabled) {
+    cad_core::Tracer& tracer = cad_core::Tracer::Instance();
+    if (enabled && !tracer.IsEnabled()) {
+        // 重新开始录制，之前的事件不再导出
+        tracer.Clear();
+    }
+    tracer.SetEnabled(enabled);
+    statusBar()->showMessage(enabled ? "Performance trace recording started" : "Performance trace recording stopped", 3000);
+}
+
+void MainWindow::OnExportPerformanceTrace() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Performance Trace", "andercad_trace.json",
+                                                    "Chrome Trace (*.json);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    if (!cad_core::Tracer::Instance().ExportChromeTrace(fileName.toStdString())) {
+        QMessageBox::warning(this, "Export Failed", "Could not write trace file: " + fileName);
+        return;
+    }
+    
+    statusBar()->showMessage("Performance trace exported to " + fileName, 3000);
+}
+
 void MainWindow::OnAbout() {
     AboutDialog dialog(this);
     dialog.exec();
@@ -1300,11 +1989,18 @@ void MainWindow::OnAboutQt() {
 }
 
 void MainWindow::OnShapeSelected(const cad_core::ShapePtr& shape) {
+    // 选中的是延迟零件的代理时，先换成真实几何再交给后续操作
+    cad_core::ShapePtr selected = m_lazyAssembly->Materialize(shape);
+    m_lazyAssembly->SetSelectedShape(selected);
+    if (selected != shape) {
+        m_viewer->SelectShape(selected);
+    }
+    
     // Update property panel with selected shape
-    m_propertyPanel->SetShape(shape);
+    m_propertyPanel->SetShape(selected);
     
     // Forward selection to active dialogs
-    OnObjectSelected(shape);
+    OnObjectSelected(selected);
 }
 
 void MainWindow::OnViewChanged() {
@@ -1314,18 +2010,85 @@ void MainWindow::OnViewChanged() {
 // Document tree selection handlers
 void MainWindow::OnDocumentTreeShapeSelected(const cad_core::ShapePtr& shape) {
     // When a shape is selected in the document tree, select it in the 3D viewer
+    EndFeatureEditing();
     if (m_viewer && shape) {
-        m_viewer->SelectShape(shape);
-        m_propertyPanel->SetShape(shape);
+        cad_core::ShapePtr selected = m_lazyAssembly->Materialize(shape);
+        m_lazyAssembly->SetSelectedShape(selected);
+        m_viewer->SelectShape(selected);
+        m_propertyPanel->SetShape(selected);
     }
 }
 
 void MainWindow::OnDocumentTreeFeatureSelected(const cad_feature::FeaturePtr& feature) {
     // Handle feature selection from document tree
     if (feature) {
-        // Update property panel to show feature properties
-        // This would require extending PropertyPanel to handle features
-        qDebug() << "Feature selected:" << QString::fromStdString(feature->GetName());
+        BeginFeatureEditing(feature);
+    }
+}
+
+void MainWindow::BeginFeatureEditing(const cad_feature::FeaturePtr& feature) {
+    if (m_featurePreview->GetFeature() == feature) {
+        return;
+    }
+    EndFeatureEditing();
+    
+    m_featureEdited = false;
+    m_propertyPanel->SetFeature(feature);
+    m_featureParameterPanel->SetFeature(feature);
+    m_featurePreview->SetFeature(feature);
+    m_featureDock->setWindowTitle(QString("Feature Parameters - %1").arg(QString::fromStdString(feature->GetName())));
+    m_featureDock->show();
+    m_featureDock->raise();
+}
+
+void MainWindow::EndFeatureEditing() {
+    if (!m_featurePreview) {
+        return;
+    }
+    cad_feature::FeaturePtr feature = m_featurePreview->GetFeature();
+    if (!feature) {
+        return;
+    }
+    
+    // 先清掉预览（丢弃还在计算的精确结果），再按修改后的参数重新生成特征
+    m_featurePreview->StopPreview();
+    m_featurePreview->SetFeature(nullptr);
+    m_featureParameterPanel->SetFeature(nullptr);
+    ClearFeaturePreview();
+    if (m_featureEdited) {
+        m_featureEdited = false;
+        m_featureManager->UpdateFeature(feature);
+        SetDocumentModified(true);
+    }
+    m_featureDock->hide();
+}
+
+void MainWindow::ShowFeaturePreview(const cad_core::ShapePtr& shape, cad_feature::PreviewTier tier) {
+    ClearFeaturePreview();
+    if (!shape) {
+        return;
+    }
+    
+    m_featurePreviewShape = shape;
+    
+    // 只摆实例的阵列结果（粗略预览，或不做布尔的阵列）：种子网格化一次，
+    // 实例按变换引用同一份显示数据
+    auto pattern = std::dynamic_pointer_cast<cad_feature::PatternFeature>(m_featurePreview->GetFeature());
+    if (pattern && pattern->GetSeedShape()
+        && (tier == cad_feature::PreviewTier::Coarse || pattern->GetOperation() == cad_feature::PatternOperation::None)) {
+        m_viewer->DisplayPattern(shape, pattern->GetSeedShape(), pattern->GetInstanceTransforms());
+        return;
+    }
+    
+    // 粗略结果用线框显示，和精确结果区分开
+    m_viewer->DisplayShape(shape);
+    m_viewer->SetShapeWireframe(shape, tier == cad_feature::PreviewTier::Coarse);
+}
+
+void MainWindow::ClearFeaturePreview() {
+    if (m_featurePreviewShape) {
+        m_viewer->RemoveShape(m_featurePreviewShape);
+        m_featurePreviewShape.reset();
     }
 }
 
@@ -1362,12 +2125,439 @@ void MainWindow::OnCreateLoft() {
     QMessageBox::information(this, "Create Loft", "Loft feature creation not implemented yet");
 }
 
+// 一次STEP导入在后台线程和界面线程之间共享的状态
+struct MainWindow::StepImportSession {
+    using Part = cad_core::StepImporter::Part;
+    
+    std::shared_ptr<cad_core::StepImporter> importer;
+    QPointer<QProgressDialog> progress;
+    QString fileName;
+    bool lazy = false;
+    
+    // 后台线程放入，界面线程分批取出
+    std::mutex mutex;
+    std::vector<std::pair<int, Part>> pendingParts;
+    std::vector<std::pair<int, Part>> pendingHealed;
+    
+    // 零件序号 -> 翻译出的形状 / 当前几何（修复后更新）
+    std::map<int, cad_core::ShapePtr> originalShapes;
+    std::map<int, cad_core::ShapePtr> displayedShapes;
+    // 延迟模式：零件序号 -> 延迟零件编号
+    std::map<int, int> lazyParts;
+};
+
 void MainWindow::OnImportSTEP() {
-    QMessageBox::information(this, "Import STEP", "STEP import not implemented yet");
+    QString fileName = QFileDialog::getOpenFileName(this, "Import STEP", "",
+                                                    "STEP Files (*.step *.stp);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (IsDocumentBusy()) {
+        QMessageBox::information(this, "Import STEP", "Another operation is still running.");
+        return;
+    }
+    
+    auto session = std::make_shared<StepImportSession>();
+    session->importer = std::make_shared<cad_core::StepImporter>();
+    session->fileName = fileName;
+    session->lazy = m_lazyLoadingAction->isChecked();
+    
+    QProgressDialog* progress = new QProgressDialog("Reading file...", "Cancel", 0, 100, this);
+    progress->setWindowTitle("Import STEP");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setValue(0);
+    session->progress = progress;
+    
+    std::weak_ptr<cad_core::StepImporter> weakImporter = session->importer;
+    connect(progress, &QProgressDialog::canceled, this, [weakImporter]() {
+        if (auto importer = weakImporter.lock()) {
+            importer->Cancel();
+        }
+    });
+    
+    // 以下回调都在后台线程触发，统一转到界面线程
+    session->importer->SetProgressCallback([this, session](int percent, const std::string& stage) {
+        QString label = QString::fromStdString(stage) + "...";
+        QMetaObject::invokeMethod(this, [session, percent, label]() {
+            if (session->progress) {
+                session->progress->setLabelText(label);
+                session->progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    session->importer->SetPartCallback([this, session](int index, const StepImportSession::Part& part) {
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            first = session->pendingParts.empty() && session->pendingHealed.empty();
+            session->pendingParts.emplace_back(index, part);
+        }
+        // 队列从空变为非空时才投递一次，界面线程一次取走一批
+        if (first) {
+            QMetaObject::invokeMethod(this, [this, session]() { FlushStepImportParts(session); },
+                                      Qt::QueuedConnection);
+        }
+    });
+    
+    session->importer->SetPartHealedCallback([this, session](int index, const StepImportSession::Part& part) {
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            first = session->pendingParts.empty() && session->pendingHealed.empty();
+            session->pendingHealed.emplace_back(index, part);
+        }
+        if (first) {
+            QMetaObject::invokeMethod(this, [this, session]() { FlushStepImportParts(session); },
+                                      Qt::QueuedConnection);
+        }
+    });
+    
+    // 翻译期间后台线程会写入XCAF树，整个导入作为一次事务；
+    // 事务结束前自动保存、撤销和其他命令都要等待
+    m_ocafManager->StartTransaction("Import STEP");
+    m_stepImport = session;
+    UpdateActions();
+    
+    std::shared_ptr<cad_core::OCAFDocument> document = m_ocafManager->GetDocument();
+    std::string path = fileName.toStdString();
+    
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, session, watcher]() {
+        bool succeeded = watcher->result();
+        watcher->deleteLater();
+        OnStepImportFinished(session, succeeded);
+    });
+    watcher->setFuture(RunInTaskPool([session, document, path]() {
+        return session->importer->Import(path, *document);
+    }));
+}
+
+void MainWindow::FlushStepImportParts(const std::shared_ptr<StepImportSession>& session) {
+    std::vector<std::pair<int, StepImportSession::Part>> parts;
+    std::vector<std::pair<int, StepImportSession::Part>> healed;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        parts.swap(session->pendingParts);
+        healed.swap(session->pendingHealed);
+    }
+    if (parts.empty() && healed.empty()) {
+        return;
+    }
+    
+    // 新零件：批量显示，再逐个上色
+    std::vector<cad_core::ShapePtr> shapes;
+    shapes.reserve(parts.size());
+    for (const auto& entry : parts) {
+        const auto& part = entry.second;
+        session->originalShapes[entry.first] = part.shape;
+        session->displayedShapes[entry.first] = part.shape;
+        if (session->lazy) {
+            // 延迟模式：先显示包围盒代理，可见时才生成显示网格
+            int index = entry.first;
+            int id = m_lazyAssembly->AddPart(part.name, part.box,
+                                             [session, index]() { return session->displayedShapes[index]; });
+            if (part.hasColor) {
+                m_lazyAssembly->SetPartColor(id, part.color);
+            }
+            session->lazyParts[index] = id;
+            continue;
+        }
+        m_documentTree->AddShape(part.shape, QString::fromStdString(part.name));
+        shapes.push_back(part.shape);
+    }
+    if (session->lazy) {
+        m_lazyAssembly->FlushPendingParts(true);
+    }
+    if (!shapes.empty()) {
+        m_viewer->DisplayShapes(shapes);
+        for (const auto& entry : parts) {
+            if (entry.second.hasColor) {
+                m_viewer->SetShapeColor(entry.second.shape, entry.second.color);
+            }
+        }
+    }
+    
+    // 修复完成的零件：原地替换显示对象
+    for (const auto& entry : healed) {
+        auto it = session->displayedShapes.find(entry.first);
+        if (it == session->displayedShapes.end()) {
+            continue;
+        }
+        cad_core::ShapePtr previous = it->second;
+        it->second = entry.second.shape;
+        
+        auto lazyIt = session->lazyParts.find(entry.first);
+        if (lazyIt != session->lazyParts.end()) {
+            m_lazyAssembly->Reload(lazyIt->second);
+        } else {
+            m_viewer->ReplaceShape(previous, entry.second.shape);
+            m_documentTree->ReplaceShape(previous, entry.second.shape);
+        }
+    }
+    
+    m_viewer->RedrawAll();
+}
+
+void MainWindow::OnStepImportFinished(const std::shared_ptr<StepImportSession>& session, bool succeeded) {
+    FlushStepImportParts(session);
+    // 翻译线程已经结束，下面在界面线程上提交或回滚事务
+    m_stepImport.reset();
+    
+    if (!succeeded) {
+        // 撤掉已经显示出来的零件，XCAF里写了一半的内容随事务一起回滚
+        for (const auto& entry : session->displayedShapes) {
+            auto lazyIt = session->lazyParts.find(entry.first);
+            if (lazyIt != session->lazyParts.end()) {
+                m_lazyAssembly->RemovePart(lazyIt->second);
+            } else {
+                m_viewer->RemoveShape(entry.second);
+                m_documentTree->RemoveShape(entry.second);
+            }
+        }
+        m_ocafManager->AbortTransaction();
+        
+        bool cancelled = session->importer->IsCancelled();
+        if (session->progress) {
+            session->progress->close();
+            session->progress->deleteLater();
+        }
+        if (!cancelled) {
+            QMessageBox::warning(this, "Import STEP",
+                                 QString("Failed to import %1:\n%2")
+                                     .arg(session->fileName)
+                                     .arg(QString::fromStdString(session->importer->GetLastError())));
+        }
+        // 导入器的回调里持有会话，释放掉以断开引用环
+        session->importer.reset();
+        UpdateActions();
+        return;
+    }
+    
+    // 翻译线程已经结束，这时再把零件登记到文档形状列表
+    const auto& parts = session->importer->GetParts();
+    for (size_t i = 0; i < parts.size(); ++i) {
+        m_ocafManager->AddShape(session->originalShapes[static_cast<int>(i)], parts[i].name);
+    }
+    m_ocafManager->CommitTransaction();
+    SetDocumentModified(true);
+    UpdateActions();
+    
+    statusBar()->showMessage(QString("Imported %1 parts from %2").arg(parts.size()).arg(session->fileName), 3000);
+    
+    // 后台修复：零件已经可以看了，修好一个替换一个，取消则保留未修复的形状
+    if (session->progress) {
+        session->progress->setLabelText("Healing...");
+        session->progress->setCancelButtonText("Skip");
+        session->progress->setValue(0);
+    }
+    
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, session, watcher]() {
+        watcher->deleteLater();
+        OnStepHealingFinished(session);
+    });
+    watcher->setFuture(RunInTaskPool([session]() {
+        return session->importer->HealParts();
+    }));
+}
+
+void MainWindow::OnStepHealingFinished(const std::shared_ptr<StepImportSession>& session) {
+    FlushStepImportParts(session);
+    
+    // 把修复结果写回文档：形状列表逐个替换，XCAF原型统一更新
+    bool changed = false;
+    m_ocafManager->StartTransaction("Heal STEP Import");
+    for (const auto& entry : session->displayedShapes) {
+        cad_core::ShapePtr original = session->originalShapes[entry.first];
+        if (entry.second != original) {
+            changed = m_ocafManager->ReplaceShape(original, entry.second) || changed;
+        }
+    }
+    if (changed) {
+        session->importer->ApplyHealedShapes(*m_ocafManager->GetDocument());
+        m_ocafManager->CommitTransaction();
+        SetDocumentModified(true);
+    } else {
+        m_ocafManager->AbortTransaction();
+    }
+    
+    if (session->progress) {
+        session->progress->close();
+        session->progress->deleteLater();
+    }
+    session->importer.reset();
+    UpdateActions();
 }
 
 void MainWindow::OnImportIGES() {
-    QMessageBox::information(this, "Import IGES", "IGES import not implemented yet");
+    QString fileName = QFileDialog::getOpenFileName(this, "Import IGES", QString(),
+                                                    "IGES Files (*.igs *.iges *.IGS *.IGES);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    auto importer = std::make_shared<cad_core::IgesImporter>();
+    QPointer<QProgressDialog> progress = new QProgressDialog("Reading file...", "Cancel", 0, 100, this);
+    progress->setWindowTitle("Import IGES");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setValue(0);
+    
+    std::weak_ptr<cad_core::IgesImporter> weakImporter = importer;
+    connect(progress, &QProgressDialog::canceled, this, [weakImporter]() {
+        if (auto importer = weakImporter.lock()) {
+            importer->Cancel();
+        }
+    });
+    
+    importer->SetProgressCallback([this, progress](int percent, const std::string& stage) {
+        QString label = QString::fromStdString(stage) + "...";
+        QMetaObject::invokeMethod(this, [progress, percent, label]() {
+            if (progress) {
+                progress->setLabelText(label);
+                progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    // 解析、并行翻译和缝合都在后台完成，零件回到界面线程再写入文档
+    std::string path = fileName.toStdString();
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, importer, progress, fileName]() {
+        bool succeeded = watcher->result();
+        watcher->deleteLater();
+        if (progress) {
+            progress->close();
+            progress->deleteLater();
+        }
+        
+        if (!succeeded) {
+            if (!importer->IsCancelled()) {
+                QMessageBox::warning(this, "Import IGES",
+                                     QString("Failed to import %1:\n%2")
+                                         .arg(fileName)
+                                         .arg(QString::fromStdString(importer->GetLastError())));
+            }
+            return;
+        }
+        
+        m_ocafManager->StartTransaction("Import IGES");
+        for (const auto& part : importer->GetParts()) {
+            if (!m_ocafManager->AddShape(part.shape, part.name)) {
+                continue;
+            }
+            m_viewer->DisplayShape(part.shape);
+            if (part.hasColor) {
+                m_viewer->SetShapeColor(part.shape, part.color);
+            }
+            m_documentTree->AddShape(part.shape, QString::fromStdString(part.name));
+        }
+        m_ocafManager->CommitTransaction();
+        SetDocumentModified(true);
+        UpdateActions();
+        
+        statusBar()->showMessage(QString("Imported %1 parts from %2 entities (%3 faces sewn, %4 free edges) from %5")
+                                     .arg(static_cast<qulonglong>(importer->GetParts().size()))
+                                     .arg(static_cast<qulonglong>(importer->GetEntityCount()))
+                                     .arg(static_cast<qulonglong>(importer->GetSewnFaceCount()))
+                                     .arg(static_cast<qulonglong>(importer->GetFreeEdgeCount()))
+                                     .arg(fileName), 5000);
+        
+        // 部分实体翻译失败：逐个列出，其余零件照常导入
+        const auto& failures = importer->GetFailures();
+        if (!failures.empty()) {
+            QStringList lines;
+            for (const auto& failure : failures) {
+                lines << QString("DE %1 (type %2, form %3): %4")
+                             .arg(failure.entity)
+                             .arg(failure.type)
+                             .arg(failure.form)
+                             .arg(QString::fromStdString(failure.message));
+            }
+            QMessageBox box(QMessageBox::Warning, "Import IGES",
+                            QString("%1 of %2 entities could not be translated.")
+                                .arg(static_cast<qulonglong>(failures.size()))
+                                .arg(static_cast<qulonglong>(importer->GetEntityCount())),
+                            QMessageBox::Ok, this);
+            box.setDetailedText(lines.join("\n"));
+            box.exec();
+        }
+    });
+    watcher->setFuture(RunInTaskPool([importer, path]() {
+        return importer->Import(path);
+    }));
+}
+
+void MainWindow::OnImportMesh() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Import Mesh", QString(),
+                                                    "Mesh Files (*.stl *.STL *.obj *.OBJ);;STL Files (*.stl *.STL);;OBJ Files (*.obj *.OBJ)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    auto importer = std::make_shared<cad_core::MeshImporter>();
+    QPointer<QProgressDialog> progress = new QProgressDialog("Reading mesh...", QString(), 0, 100, this);
+    progress->setWindowTitle("Import Mesh");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setValue(0);
+    
+    importer->SetProgressCallback([this, progress](int percent) {
+        QMetaObject::invokeMethod(this, [progress, percent]() {
+            if (progress) {
+                progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    // 解析和焊接在后台完成，结果回到界面线程再写入文档
+    std::string path = fileName.toStdString();
+    auto result = std::make_shared<cad_core::ShapePtr>();
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, importer, progress, fileName, result]() {
+        watcher->deleteLater();
+        if (progress) {
+            progress->close();
+            progress->deleteLater();
+        }
+        
+        cad_core::ShapePtr shape = *result;
+        if (!shape) {
+            QMessageBox::warning(this, "Import Mesh",
+                                 QString("Failed to import %1:\n%2")
+                                     .arg(fileName)
+                                     .arg(QString::fromStdString(importer->GetLastError())));
+            return;
+        }
+        
+        m_ocafManager->StartTransaction("Import Mesh");
+        QString name = QFileInfo(fileName).completeBaseName();
+        if (!m_ocafManager->AddShape(shape, name.toStdString())) {
+            m_ocafManager->AbortTransaction();
+            QMessageBox::warning(this, "Import Mesh", "Failed to add mesh to document.");
+            return;
+        }
+        m_viewer->DisplayShape(shape);
+        m_documentTree->AddShape(shape, name);
+        m_ocafManager->CommitTransaction();
+        SetDocumentModified(true);
+        UpdateActions();
+        
+        statusBar()->showMessage(QString("Imported %1 triangles, %2 vertices from %3")
+                                     .arg(static_cast<qulonglong>(importer->GetTriangleCount()))
+                                     .arg(static_cast<qulonglong>(importer->GetNodeCount()))
+                                     .arg(fileName), 5000);
+    });
+    watcher->setFuture(RunInTaskPool([importer, path, result]() {
+        *result = importer->Import(path);
+        return *result != nullptr;
+    }));
 }
 
 void MainWindow::OnExportSTEP() {
@@ -1375,11 +2565,207 @@ void MainWindow::OnExportSTEP() {
 }
 
 void MainWindow::OnExportIGES() {
-    QMessageBox::information(this, "Export IGES", "IGES export not implemented yet");
+    QString fileName = QFileDialog::getSaveFileName(this, "Export IGES", QString(),
+                                                    "IGES Files (*.igs *.iges)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    ExportIGES(fileName);
 }
 
 void MainWindow::OnExportSTL() {
-    QMessageBox::information(this, "Export STL", "STL export not implemented yet");
+    ExportDialog dialog(this);
+    dialog.SetFormat("stl");
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    if (dialog.GetFormat() == "step") {
+        OnExportSTEP();
+    } else if (dialog.GetFormat() == "iges") {
+        ExportIGES(dialog.GetFileName());
+    } else if (dialog.GetFormat() == "glb" || dialog.GetFormat() == "gltf") {
+        ExportGLTF(dialog);
+    } else {
+        ExportSTL(dialog);
+    }
+}
+
+void MainWindow::OnExportGLTF() {
+    ExportDialog dialog(this);
+    dialog.SetFormat("glb");
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    if (dialog.GetFormat() == "step") {
+        OnExportSTEP();
+    } else if (dialog.GetFormat() == "iges") {
+        ExportIGES(dialog.GetFileName());
+    } else if (dialog.GetFormat() == "stl") {
+        ExportSTL(dialog);
+    } else {
+        ExportGLTF(dialog);
+    }
+}
+
+void MainWindow::ExportSTL(const ExportDialog& dialog) {
+    std::vector<cad_core::ExportPart> parts = cad_core::CollectExportParts(*m_ocafManager->GetDocument());
+    if (parts.empty()) {
+        QMessageBox::information(this, "Export STL", "The document has no shapes to export.");
+        return;
+    }
+    
+    cad_core::StlExportOptions options;
+    options.linearDeflection = dialog.GetLinearDeflection();
+    options.angularDeflection = dialog.GetAngularDeflection();
+    options.ascii = dialog.IsAsciiStl();
+    auto exporter = std::make_shared<cad_core::StlExporter>(options);
+    
+    QPointer<QProgressDialog> progress = new QProgressDialog("Tessellating and writing STL...", QString(), 0, 100, this);
+    progress->setWindowTitle("Export STL");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setValue(0);
+    
+    exporter->SetProgressCallback([this, progress](int percent) {
+        QMetaObject::invokeMethod(this, [progress, percent]() {
+            if (progress) {
+                progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    // 网格化和写文件都放到后台，界面只显示进度
+    QString fileName = dialog.GetFileName();
+    std::string path = fileName.toStdString();
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, exporter, progress, fileName]() {
+        bool succeeded = watcher->result();
+        watcher->deleteLater();
+        if (progress) {
+            progress->close();
+            progress->deleteLater();
+        }
+        
+        if (succeeded) {
+            statusBar()->showMessage(QString("Exported %1 triangles to %2")
+                                         .arg(static_cast<qulonglong>(exporter->GetTriangleCount()))
+                                         .arg(fileName), 5000);
+        } else {
+            QMessageBox::warning(this, "Export STL",
+                                 QString("Failed to export %1:\n%2")
+                                     .arg(fileName)
+                                     .arg(QString::fromStdString(exporter->GetLastError())));
+        }
+    });
+    watcher->setFuture(RunInTaskPool([exporter, parts, path]() {
+        return exporter->Export(parts, path);
+    }, cad_core::TaskPriority::Background));
+}
+
+void MainWindow::ExportGLTF(const ExportDialog& dialog) {
+    // 零件和名称在主线程从文档里取出，后台只做网格化和写文件
+    std::vector<cad_core::ExportPart> parts = cad_core::CollectExportParts(*m_ocafManager->GetDocument());
+    if (parts.empty()) {
+        QMessageBox::information(this, "Export glTF", "The document has no shapes to export.");
+        return;
+    }
+    
+    cad_core::GltfExportOptions options;
+    options.linearDeflection = dialog.GetLinearDeflection();
+    options.angularDeflection = dialog.GetAngularDeflection();
+    options.binary = (dialog.GetFormat() == "glb");
+    options.lodLevels = dialog.GetLodLevels();
+    auto exporter = std::make_shared<cad_core::GltfExporter>(options);
+    
+    QPointer<QProgressDialog> progress = new QProgressDialog("Tessellating and writing glTF...", QString(), 0, 100, this);
+    progress->setWindowTitle("Export glTF");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setValue(0);
+    
+    exporter->SetProgressCallback([this, progress](int percent) {
+        QMetaObject::invokeMethod(this, [progress, percent]() {
+            if (progress) {
+                progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    QString fileName = dialog.GetFileName();
+    std::string path = fileName.toStdString();
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, exporter, progress, fileName]() {
+        bool succeeded = watcher->result();
+        watcher->deleteLater();
+        if (progress) {
+            progress->close();
+            progress->deleteLater();
+        }
+        
+        if (succeeded) {
+            statusBar()->showMessage(QString("Exported %1 meshes, %2 nodes to %3 (%4 files)")
+                                         .arg(static_cast<qulonglong>(exporter->GetMeshCount()))
+                                         .arg(static_cast<qulonglong>(exporter->GetNodeCount()))
+                                         .arg(fileName)
+                                         .arg(static_cast<qulonglong>(exporter->GetWrittenFiles().size())), 5000);
+        } else {
+            QMessageBox::warning(this, "Export glTF",
+                                 QString("Failed to export %1:\n%2")
+                                     .arg(fileName)
+                                     .arg(QString::fromStdString(exporter->GetLastError())));
+        }
+    });
+    watcher->setFuture(RunInTaskPool([exporter, parts, path]() {
+        return exporter->Export(parts, path);
+    }, cad_core::TaskPriority::Background));
+}
+
+void MainWindow::ExportIGES(const QString& fileName) {
+    std::vector<cad_core::ExportPart> parts = cad_core::CollectExportParts(*m_ocafManager->GetDocument());
+    if (parts.empty()) {
+        QMessageBox::information(this, "Export IGES", "The document has no shapes to export.");
+        return;
+    }
+    
+    auto exporter = std::make_shared<cad_core::IgesExporter>();
+    QPointer<QProgressDialog> progress = new QProgressDialog("Translating and writing IGES...", QString(), 0, 100, this);
+    progress->setWindowTitle("Export IGES");
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->setValue(0);
+    
+    exporter->SetProgressCallback([this, progress](int percent) {
+        QMetaObject::invokeMethod(this, [progress, percent]() {
+            if (progress) {
+                progress->setValue(percent);
+            }
+        }, Qt::QueuedConnection);
+    });
+    
+    std::string path = fileName.toStdString();
+    QFutureWatcher<bool>* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, exporter, progress, fileName]() {
+        bool succeeded = watcher->result();
+        watcher->deleteLater();
+        if (progress) {
+            progress->close();
+            progress->deleteLater();
+        }
+        
+        if (succeeded) {
+            statusBar()->showMessage(QString("Exported %1 entities to %2")
+                                         .arg(static_cast<qulonglong>(exporter->GetEntityCount()))
+                                         .arg(fileName), 5000);
+        } else {
+            QMessageBox::warning(this, "Export IGES",
+                                 QString("Failed to export %1:\n%2")
+                                     .arg(fileName)
+                                     .arg(QString::fromStdString(exporter->GetLastError())));
+        }
+    });
+    watcher->setFuture(RunInTaskPool([exporter, parts, path]() {
+        return exporter->Export(parts, path);
+    }, cad_core::TaskPriority::Background));
 }
 
 void MainWindow::OnShowGrid() {
@@ -1389,6 +2775,10 @@ void MainWindow::OnShowGrid() {
     m_viewer->ShowGrid(gridVisible);
 }
 
+void MainWindow::OnTogglePerformanceHud(bool show) {
+    m_viewer->ShowPerformanceHud(show);
+}
+
 void MainWindow::OnShowAxes() {
     // Toggle axes visibility
     static bool axesVisible = true;
@@ -1557,6 +2947,8 @@ void MainWindow::CloseDocumentTab(int index) {
 
 void MainWindow::OnTabChanged(int index) {
     if (index >= 0 && index < m_tabWidget->count()) {
+        // 预览形状显示在原来的视图里，切换前结束编辑
+        EndFeatureEditing();
         m_viewer = qobject_cast<QtOccView*>(m_tabWidget->widget(index));
         UpdateCurrentDocument();
     }
@@ -1725,34 +3117,44 @@ void MainWindow::CreateConsole() {
         "}"
     );
     
-    // Install custom message handler to redirect qDebug to console
-    qInstallMessageHandler([](QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-        // Get the main window instance to access console
-        foreach (QWidget *widget, QApplication::topLevelWidgets()) {
-            MainWindow *mainWindow = qobject_cast<MainWindow*>(widget);
-            if (mainWindow && mainWindow->m_console) {
-                QString formattedMsg;
-                switch (type) {
-                    case QtDebugMsg:
-                        formattedMsg = QString("[DEBUG] %1").arg(msg);
-                        break;
-                    case QtWarningMsg:
-                        formattedMsg = QString("[WARNING] %1").arg(msg);
-                        break;
-                    case QtCriticalMsg:
-                        formattedMsg = QString("[CRITICAL] %1").arg(msg);
-                        break;
-                    case QtFatalMsg:
-                        formattedMsg = QString("[FATAL] %1").arg(msg);
-                        break;
-                    case QtInfoMsg:
-                        formattedMsg = QString("[INFO] %1").arg(msg);
-                        break;
-                }
-                mainWindow->m_console->append(formattedMsg);
-                break;
-            }
+    // 控制台只保留最近的若干行，旧的行自动丢弃
+    m_console->document()->setMaximumBlockCount(kConsoleHistoryLines);
+    
+    // qDebug等Qt消息转给日志系统（类别"qt"），与其他日志一起按级别过滤、异步输出
+    qInstallMessageHandler([](QtMsgType type, const QMessageLogContext& context, const QString& msg) {
+        Q_UNUSED(context);
+        cad_core::LogLevel level = cad_core::LogLevel::Debug;
+        switch (type) {
+            case QtDebugMsg:    level = cad_core::LogLevel::Debug; break;
+            case QtInfoMsg:     level = cad_core::LogLevel::Info; break;
+            case QtWarningMsg:  level = cad_core::LogLevel::Warning; break;
+            case QtCriticalMsg: level = cad_core::LogLevel::Error; break;
+            case QtFatalMsg:
+                cad_core::Logger::Instance().Flush();
+                fprintf(stderr, "[FATAL] %s\n", msg.toLocal8Bit().constData());
+                abort();
+        }
+        if (cad_core::Logger::Instance().IsEnabled(level, "qt")) {
+            cad_core::Logger::Instance().Write(level, "qt", msg.toStdString());
+        }
+    });
+    
+    // 日志线程每批调用一次sink；整批排进界面线程，一次追加到控制台
+    QPointer<QTextEdit> console = m_console;
+    m_logSinkId = cad_core::Logger::Instance().AddSink([console](const std::vector<cad_core::LogRecord>& batch) {
+        QStringList lines;
+        lines.reserve(static_cast<int>(batch.size()));
+        for (const cad_core::LogRecord& record : batch) {
+            lines << QString("[%1] [%2] %3")
+                         .arg(cad_core::Logger::LevelName(record.level))
+                         .arg(record.category)
+                         .arg(QString::fromStdString(record.message));
         }
+        QMetaObject::invokeMethod(console, [console, lines]() {
+            if (console) {
+                AppendConsoleLines(console, lines);
+            }
+        }, Qt::QueuedConnection);
     });
     
     m_console->append("[SYSTEM] Console initialized");
@@ -1815,6 +3217,11 @@ void MainWindow::OnObjectSelected(const cad_core::ShapePtr& shape) {
 void MainWindow::OnBooleanOperationRequested(BooleanOperationType type, 
                                            const std::vector<cad_core::ShapePtr>& targets,
                                            const std::vector<cad_core::ShapePtr>& tools) {
+    if (IsDocumentBusy()) {
+        QMessageBox::information(this, "Boolean Operation", "Another operation is still running.");
+        return;
+    }
+    
     // Validate selection based on operation type
     if (type == BooleanOperationType::Union) {
         if (targets.empty()) {
@@ -1832,103 +3239,40 @@ void MainWindow::OnBooleanOperationRequested(BooleanOperationType type,
         }
     }
     
-    // Start OCAF transaction
-    QString operationName;
+    cad_core::BooleanOperations::BooleanType booleanType = cad_core::BooleanOperations::BooleanType::Union;
     switch (type) {
         case BooleanOperationType::Union:
-            operationName = "Boolean Union";
+            booleanType = cad_core::BooleanOperations::BooleanType::Union;
             break;
         case BooleanOperationType::Intersection:
-            operationName = "Boolean Intersection";
+            booleanType = cad_core::BooleanOperations::BooleanType::Intersection;
             break;
         case BooleanOperationType::Difference:
-            operationName = "Boolean Difference";
+            booleanType = cad_core::BooleanOperations::BooleanType::Difference;
             break;
     }
     
-    m_ocafManager->StartTransaction(operationName.toStdString());
-    
-    cad_core::ShapePtr result;
-    try {
-        if (type == BooleanOperationType::Union) {
-            // Combine all targets and tools for union
-            std::vector<cad_core::ShapePtr> allShapes = targets;
-            allShapes.insert(allShapes.end(), tools.begin(), tools.end());
-            result = cad_core::BooleanOperations::Union(allShapes);
-        } else if (type == BooleanOperationType::Intersection) {
-            // Use first target as base, intersect with all others
-            result = targets[0];
-            for (size_t i = 1; i < targets.size(); ++i) {
-                if (result) {
-                    result = cad_core::BooleanOperations::Intersection({result, targets[i]});
-                }
-            }
-            for (const auto& tool : tools) {
-                if (result) {
-                    result = cad_core::BooleanOperations::Intersection({result, tool});
-                }
-            }
-        } else if (type == BooleanOperationType::Difference) {
-            // Use first target as base, subtract all tools
-            result = targets[0];
-            for (const auto& tool : tools) {
-                if (result) {
-                    result = cad_core::BooleanOperations::Difference(result, tool);
-                }
-            }
+    // 运算在任务池上执行；结果在界面线程上写入文档：
+    // 加入结果，目标和工具都从文档、视图和文档树中删除
+    auto command = std::make_shared<cad_core::BooleanCommand>(booleanType, targets, tools);
+    const QString resultName = QString("%1 Result").arg(command->GetName());
+    RunCommandAsync(command, [this, command, targets, tools, resultName]() {
+        cad_core::ShapePtr result = command->GetResult();
+        if (!m_ocafManager->AddShape(result, resultName.toStdString())) {
+            return false;
         }
+        m_viewer->DisplayShape(result);
+        m_documentTree->AddShape(result);
         
-        if (result) {
-            // Add result to document
-            if (m_ocafManager->AddShape(result, (operationName + " Result").toStdString())) {
-                // Display the new result shape
-                m_viewer->DisplayShape(result);
-                m_documentTree->AddShape(result);
-                
-                // For Union: Remove all original objects (targets and tools) from OCAF
-                // For Intersection/Difference: Remove original and tool objects from OCAF, keep only result
-                if (type == BooleanOperationType::Union) {
-                    // Union: Remove all input objects (targets + tools) from OCAF document
-                    for (const auto& shape : targets) {
-                        m_ocafManager->RemoveShape(shape);  // Remove from OCAF
-                        m_viewer->RemoveShape(shape);       // Remove from 3D view
-                        m_documentTree->RemoveShape(shape); // Remove from document tree
-                    }
-                    for (const auto& shape : tools) {
-                        m_ocafManager->RemoveShape(shape);  // Remove from OCAF
-                        m_viewer->RemoveShape(shape);       // Remove from 3D view
-                        m_documentTree->RemoveShape(shape); // Remove from document tree
-                    }
-                } else {
-                    // Intersection/Difference: Remove original and tool objects from OCAF
-                    for (const auto& shape : targets) {
-                        m_ocafManager->RemoveShape(shape);  // Remove from OCAF
-                        m_viewer->RemoveShape(shape);       // Remove from 3D view
-                        m_documentTree->RemoveShape(shape); // Remove from document tree
-                    }
-                    for (const auto& shape : tools) {
-                        m_ocafManager->RemoveShape(shape);  // Remove from OCAF
-                        m_viewer->RemoveShape(shape);       // Remove from 3D view
-                        m_documentTree->RemoveShape(shape); // Remove from document tree
-                    }
-                }
-                
-                m_ocafManager->CommitTransaction();
-                SetDocumentModified(true);
-                UpdateActions();
-                statusBar()->showMessage(operationName + " completed successfully");
-            } else {
-                m_ocafManager->AbortTransaction();
-                QMessageBox::warning(this, "Error", "Failed to add result to document.");
+        for (const auto& shapes : { targets, tools }) {
+            for (const auto& shape : shapes) {
+                m_ocafManager->RemoveShape(shape);  // Remove from OCAF
+                m_viewer->RemoveShape(shape);       // Remove from 3D view
+                m_documentTree->RemoveShape(shape); // Remove from document tree
             }
-        } else {
-            m_ocafManager->AbortTransaction();
-            QMessageBox::warning(this, "Error", operationName + " operation failed.");
         }
-    } catch (const std::exception& e) {
-        m_ocafManager->AbortTransaction();
-        QMessageBox::warning(this, "Error", QString("Boolean operation failed: %1").arg(e.what()));
-    }
+        return true;
+    });
     
     // Clean up dialog
     if (m_currentBooleanDialog) {
@@ -1940,6 +3284,12 @@ void MainWindow::OnBooleanOperationRequested(BooleanOperationType type,
 void MainWindow::OnFilletChamferOperationRequested(FilletChamferType type, 
                                                  const std::vector<cad_core::ShapePtr>& edges,
                                                  double radius, double distance1, double distance2) {
+    Q_UNUSED(distance2);
+    if (IsDocumentBusy()) {
+        QMessageBox::information(this, "Fillet/Chamfer", "Another operation is still running.");
+        return;
+    }
+    
     if (edges.empty()) {
         QMessageBox::warning(this, "Fillet/Chamfer", "Please select edges for operation.");
         return;
@@ -1952,69 +3302,34 @@ void MainWindow::OnFilletChamferOperationRequested(FilletChamferType type,
         return;
     }
     
-    qDebug() << "Fillet/Chamfer operation requested with edges from" << edgesByShape.size() << "shape(s)";
+    CAD_LOG_DEBUG("modify", "Fillet/Chamfer operation requested with edges from " << edgesByShape.size() << " shape(s)");
     
-    // Start OCAF transaction
-    QString operationName = (type == FilletChamferType::Fillet) ? "Fillet" : "Chamfer";
-    m_ocafManager->StartTransaction(operationName.toStdString());
+    const bool fillet = (type == FilletChamferType::Fillet);
+    auto command = std::make_shared<cad_core::FilletChamferCommand>(
+        fillet ? cad_core::FilletChamferCommand::Type::Fillet : cad_core::FilletChamferCommand::Type::Chamfer,
+        edgesByShape, fillet ? radius : distance1);
+    const QString shapeName = QString("%1 Result on Shape").arg(command->GetName());
     
-    try {
+    // 每个成功的形状：结果加入文档，原形状从文档、视图和文档树中删除
+    RunCommandAsync(command, [this, command, shapeName]() {
         bool anySuccess = false;
-        
-        // Process each shape that has selected edges
-        for (const auto& shapeEdgePair : edgesByShape) {
-            cad_core::ShapePtr baseShape = shapeEdgePair.first;
-            const std::vector<TopoDS_Edge>& edges = shapeEdgePair.second;
-            
-            if (!baseShape || edges.empty()) {
+        for (const auto& entry : command->GetResults()) {
+            const cad_core::ShapePtr& baseShape = entry.first;
+            const cad_core::ShapePtr& result = entry.second;
+            if (!m_ocafManager->AddShape(result, shapeName.toStdString())) {
+                CAD_LOG_WARNING("modify", "Failed to add " << command->GetName() << " result to OCAF");
                 continue;
             }
+            m_ocafManager->RemoveShape(baseShape);  // Remove from OCAF
+            m_viewer->RemoveShape(baseShape);       // Remove from 3D view
+            m_documentTree->RemoveShape(baseShape); // Remove from document tree
             
-            qDebug() << "Processing" << edges.size() << "edges on shape";
-            
-            // Perform the operation on this shape with its edges
-            cad_core::ShapePtr result;
-            if (type == FilletChamferType::Fillet) {
-                result = cad_core::FilletChamferOperations::CreateFillet(baseShape, edges, radius);
-            } else {
-                result = cad_core::FilletChamferOperations::CreateChamfer(baseShape, edges, distance1);
-            }
-            
-            if (result) {
-                QString shapeName = QString("%1 Result on Shape").arg(operationName);
-                if (m_ocafManager->AddShape(result, shapeName.toStdString())) {
-                    // Remove the original shape from OCAF, viewer, and document tree
-                    qDebug() << "Removing original shape before displaying" << operationName << "result";
-                    m_ocafManager->RemoveShape(baseShape);  // Remove from OCAF
-                    m_viewer->RemoveShape(baseShape);       // Remove from 3D view
-                    m_documentTree->RemoveShape(baseShape); // Remove from document tree
-                    
-                    // Display the new result
-                    m_viewer->DisplayShape(result);
-                    m_documentTree->AddShape(result);
-                    anySuccess = true;
-                    qDebug() << "Successfully created" << operationName << "with" << edges.size() << "edges";
-                } else {
-                    qDebug() << "Failed to add" << operationName << "result to OCAF";
-                }
-            } else {
-                qDebug() << operationName << "operation failed for this shape";
-            }
-        }
-        
-        if (anySuccess) {
-            m_ocafManager->CommitTransaction();
-            SetDocumentModified(true);
-            UpdateActions();
-            statusBar()->showMessage(operationName + " completed successfully");
-        } else {
-            m_ocafManager->AbortTransaction();
-            QMessageBox::warning(this, "Error", operationName + " operation failed.");
+            m_viewer->DisplayShape(result);
+            m_documentTree->AddShape(result);
+            anySuccess = true;
         }
-    } catch (const std::exception& e) {
-        m_ocafManager->AbortTransaction();
-        QMessageBox::warning(this, "Error", QString("%1 operation failed: %2").arg(operationName).arg(e.what()));
-    }
+        return anySuccess;
+    });
     
     // Clear edge selection after operation
     m_viewer->ClearEdgeSelection();
@@ -2026,6 +3341,94 @@ void MainWindow::OnFilletChamferOperationRequested(FilletChamferType type,
     }
 }
 
+void MainWindow::RunCommandAsync(const cad_core::CommandPtr& command, const std::function<bool()>& apply) {
+    const QString name = QString::fromUtf8(command->GetName());
+    
+    // 事务在开始时打开：取消或失败时整个放弃，文档保持原样
+    m_ocafManager->StartTransaction(command->GetName());
+    
+    Handle(cad_core::CommandProgress) progress = new cad_core::CommandProgress();
+    QPointer<StatusBar> progressBar = m_statusBar;
+    progress->SetCallback([this, progressBar](int percent, const std::string& stage) {
+        const QString label = QString::fromStdString(stage);
+        QMetaObject::invokeMethod(this, [progressBar, percent, label]() {
+            if (progressBar) {
+                progressBar->updateProgress(percent, label);
+            }
+        }, Qt::QueuedConnection);
+    });
+    m_commandProgress = progress;
+    m_statusBar->beginProgress(name);
+    SetCommandRunning(true);
+    
+    m_commandManager->ExecuteCommandAsync(command, progress,
+        [this](std::function<void()> function) {
+            QMetaObject::invokeMethod(this, std::move(function), Qt::QueuedConnection);
+        },
+        [this, name, apply](bool succeeded, bool cancelled) {
+            m_commandProgress.Nullify();
+            m_statusBar->endProgress();
+            SetCommandRunning(false);
+            
+            bool applied = false;
+            if (succeeded) {
+                try {
+                    applied = apply();
+                } catch (const Standard_Failure&) {
+                    applied = false;
+                } catch (const std::exception&) {
+                    applied = false;
+                }
+            }
+            
+            // 撤销由文档事务负责，命令本身不保留
+            if (applied) {
+                m_ocafManager->CommitTransaction();
+                SetDocumentModified(true);
+                UpdateActions();
+                statusBar()->showMessage(name + " completed successfully");
+            } else {
+                m_ocafManager->AbortTransaction();
+                UpdateActions();
+                if (cancelled) {
+                    statusBar()->showMessage(name + " cancelled", 3000);
+                } else {
+                    QMessageBox::warning(this, "Error", name + " operation failed.");
+                }
+            }
+        });
+}
+
+bool MainWindow::IsDocumentBusy() const {
+    return m_commandManager->IsBusy() || m_stepImport != nullptr;
+}
+
+void MainWindow::SetCommandRunning(bool running) {
+    // 同一时间只执行一个建模命令：菜单、工具栏和停靠窗口在执行期间禁用，
+    // 视图仍可旋转缩放，状态栏上的取消按钮可用
+    menuBar()->setEnabled(!running);
+    for (QToolBar* toolBar : findChildren<QToolBar*>()) {
+        toolBar->setEnabled(!running);
+    }
+    m_documentDock->setEnabled(!running);
+    m_propertyDock->setEnabled(!running);
+    m_featureDock->setEnabled(!running);
+    // 非模态对话框（布尔、圆角倒角、变换）会自己开关事务，执行期间一起禁用，
+    // 否则可能提交或放弃正在执行的命令的事务
+    for (QDialog* dialog : findChildren<QDialog*>(QString(), Qt::FindDirectChildrenOnly)) {
+        if (!dialog->isModal()) {
+            dialog->setEnabled(!running);
+        }
+    }
+    UpdateActions();
+}
+
+void MainWindow::OnCancelCommand() {
+    if (!m_commandProgress.IsNull()) {
+        m_commandProgress->Cancel();
+    }
+}
+
 // =============================================================================
 // Transform Operations Implementation
 // =============================================================================
@@ -2057,6 +3460,10 @@ void MainWindow::OnTransformOperationRequested(std::shared_ptr<cad_core::Transfo
     if (!command) {
         return;
     }
+    if (IsDocumentBusy()) {
+        QMessageBox::information(this, "Transform", "Another operation is still running.");
+        return;
+    }
     
     try {
         // Reset any preview first
@@ -0,0 +1,83 @@
+#include "cad_ui/PreviewFileDialog.h"
+#include "cad_ui/ThumbnailRenderer.h"
+#include <QFileInfo>
+#include <QGridLayout>
+#include <QVBoxLayout>
+
+namespace cad_ui {
+
+PreviewFileDialog::PreviewFileDialog(QWidget* parent, const QString& caption, const QString& filter,
+                                     const cad_core::PreviewCache* cache)
+    : QFileDialog(parent, caption, QString(), filter), m_cache(cache) {
+    // 系统对话框不能加控件
+    setOption(QFileDialog::DontUseNativeDialog, true);
+    setFileMode(QFileDialog::ExistingFile);
+    setAcceptMode(QFileDialog::AcceptOpen);
+
+    QWidget* panel = new QWidget(this);
+    QVBoxLayout* panelLayout = new QVBoxLayout(panel);
+    m_imageLabel = new QLabel(panel);
+    m_imageLabel->setFixedSize(ThumbnailRenderer::kThumbnailSize, ThumbnailRenderer::kThumbnailSize);
+    m_imageLabel->setAlignment(Qt::AlignCenter);
+    m_imageLabel->setFrameShape(QFrame::StyledPanel);
+    m_infoLabel = new QLabel(panel);
+    m_infoLabel->setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    m_infoLabel->setWordWrap(true);
+    panelLayout->addWidget(m_imageLabel);
+    panelLayout->addWidget(m_infoLabel);
+    panelLayout->addStretch();
+
+    // 非系统对话框的布局是QGridLayout，预览放在最右一列
+    if (QGridLayout* grid = qobject_cast<QGridLayout*>(layout())) {
+        grid->addWidget(panel, 0, grid->columnCount(), grid->rowCount(), 1);
+    }
+
+    connect(this, &QFileDialog::currentChanged, this, &PreviewFileDialog::OnCurrentChanged);
+    OnCurrentChanged(QString());
+}
+
+QString PreviewFileDialog::GetOpenFileName(QWidget* parent, const QString& caption, const QString& filter,
+                                           const cad_core::PreviewCache* cache) {
+    PreviewFileDialog dialog(parent, caption, filter, cache);
+    if (dialog.exec() != QDialog::Accepted || dialog.selectedFiles().isEmpty()) {
+        return QString();
+    }
+    return dialog.selectedFiles().first();
+}
+
+void PreviewFileDialog::OnCurrentChanged(const QString& path) {
+    m_imageLabel->clear();
+    m_imageLabel->setText("No preview");
+    m_infoLabel->clear();
+
+    cad_core::DocumentPreview preview;
+    if (path.isEmpty() || !QFileInfo(path).isFile() ||
+        !cad_core::DocumentPreview::Load(path.toStdString(), m_cache, preview)) {
+        return;
+    }
+
+    // 优先用保存时渲染的缩略图，没有时渲染粗网格
+    const std::string& png = preview.GetImage();
+    QImage image = QImage::fromData(reinterpret_cast<const uchar*>(png.data()), static_cast<int>(png.size()), "PNG");
+    if (image.isNull()) {
+        image = ThumbnailRenderer::RenderPreview(preview, m_imageLabel->size());
+    }
+    if (!image.isNull()) {
+        m_imageLabel->setPixmap(QPixmap::fromImage(image.scaled(m_imageLabel->size(), Qt::KeepAspectRatio,
+                                                                Qt::SmoothTransformation)));
+    }
+
+    QString info = QString("%1 parts").arg(static_cast<qulonglong>(preview.GetPartCount()));
+    const Bnd_Box& box = preview.GetBoundingBox();
+    if (!box.IsVoid()) {
+        double xmin, ymin, zmin, xmax, ymax, zmax;
+        box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        info = QString("%1 x %2 x %3 mm\n").arg(xmax - xmin, 0, 'f', 1).arg(ymax - ymin, 0, 'f', 1)
+                   .arg(zmax - zmin, 0, 'f', 1) + info;
+    }
+    m_infoLabel->setText(info);
+}
+
+} // namespace cad_ui
+
+#include "PreviewFileDialog.moc"
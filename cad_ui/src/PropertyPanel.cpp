@@ -110,6 +110,15 @@ void PropertyPanel::CreateFeatureProperties() {
         case cad_feature::FeatureType::Loft:
             typeText = "Loft";
             break;
+        case cad_feature::FeatureType::LinearPattern:
+            typeText = "Linear Pattern";
+            break;
+        case cad_feature::FeatureType::CircularPattern:
+            typeText = "Circular Pattern";
+            break;
+        case cad_feature::FeatureType::TablePattern:
+            typeText = "Table Pattern";
+            break;
         default:
             typeText = "Unknown";
             break;
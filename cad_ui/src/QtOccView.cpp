@@ -1,5 +1,9 @@
 #include "cad_ui/QtOccView.h"
 #include "cad_ui/SketchMode.h"
+#include "cad_ui/ThumbnailRenderer.h"
+#include "cad_core/Logger.h"
+#include "cad_core/MeshImporter.h"
+#include "cad_core/Tracer.h"
 
 #include <OpenGl_GraphicDriver.hxx>
 #include <Aspect_Handle.hxx>
@@ -8,12 +12,15 @@
 #include <V3d_DirectionalLight.hxx>
 #include <Prs3d_Drawer.hxx>
 #include <AIS_ViewCube.hxx>
+#include <AIS_MultipleConnectedInteractive.hxx>
 #include <AIS_Trihedron.hxx>
 #include <Geom_Axis2Placement.hxx>
 #include <Aspect_RectangularGrid.hxx>
+#include <Graphic3d_RenderingParams.hxx>
+#include <Graphic3d_TransformPers.hxx>
+#include <OSD_MemInfo.hxx>
 #include <QFocusEvent>
 #include <QShowEvent>
-#include <QDebug>
 #include <QPainter>
 #include <StdSelect_BRepOwner.hxx>
 #include <TopoDS.hxx>
@@ -32,6 +39,18 @@
 
 namespace cad_ui {
 
+namespace {
+
+// 导入的网格没有曲面，不能让AIS重新三角化；也没有边，只能着色显示
+void ConfigureMeshPresentation(const Handle(AIS_Shape)& aisShape) {
+    if (cad_core::MeshImporter::IsMeshShape(aisShape->Shape())) {
+        aisShape->Attributes()->SetAutoTriangulation(Standard_False);
+        aisShape->SetDisplayMode(AIS_Shaded);
+    }
+}
+
+} // namespace
+
 QtOccView::QtOccView(QWidget* parent) 
     : QWidget(parent), m_isInitialized(false), m_currentMouseButton(Qt::NoButton),
       m_currentSelectedShape(nullptr), m_currentSelectionMode(0) {
@@ -51,6 +70,11 @@ QtOccView::QtOccView(QWidget* parent)
     m_redrawTimer->setSingleShot(true);
     connect(m_redrawTimer, &QTimer::timeout, this, &QtOccView::OnRedrawTimer);
     
+    // HUD文字的刷新间隔；只改标签内容，下一次正常重绘时才显示
+    m_hudTimer = new QTimer(this);
+    m_hudTimer->setInterval(500);
+    connect(m_hudTimer, &QTimer::timeout, this, &QtOccView::UpdatePerformanceHud);
+    
     // Initialize selection manager
     m_selectionManager = std::make_unique<cad_core::SelectionManager>();
     
@@ -75,18 +99,6 @@ bool QtOccView::InitViewer() {
     try {
         // Create graphics driver
         Handle(Aspect_DisplayConnection) displayConnection = new Aspect_DisplayConnection();
-        m_driver = new OpenGl_GraphicDriver(displayConnection);
-        
-        // Create viewer
-        m_viewer = new V3d_Viewer(m_driver);
-        m_viewer->SetDefaultLights();
-        m_viewer->SetLightOn();
-        
-        // Create interactive context
-        m_context = new AIS_InteractiveContext(m_viewer);
-        
-        // Create view
-        m_view = m_viewer->CreateView();
         
         // Create window
 #ifdef _WIN32
@@ -97,60 +109,7 @@ bool QtOccView::InitViewer() {
         Handle(Xw_Window) window = new Xw_Window(displayConnection, winId());
 #endif
         
-        m_view->SetWindow(window);
-        
-        // Ensure window is mapped properly
-        if (!window->IsMapped()) {
-            window->Map();
-        }
-        
-        // Set up view
-        m_view->SetBackgroundColor(Quantity_NOC_GRAY30);
-        
-        // Ensure proper sizing
-        window->DoResize();
-        m_view->MustBeResized();
-        // Note: Trihedron (coordinate axes) will be controlled by ShowAxes() function
-        
-        // Add ViewCube for navigation (without axis labels to avoid duplication)
-        Handle(AIS_ViewCube) viewCube = new AIS_ViewCube();
-        viewCube->SetSize(50, Standard_False);
-        viewCube->SetBoxColor(Quantity_NOC_GRAY75);
-        viewCube->SetInnerColor(Quantity_NOC_GRAY90);
-        viewCube->SetTextColor(Quantity_NOC_BLACK);
-        // Remove axis labels to avoid duplication with Trihedron
-        viewCube->SetTransparency(0.1);
-        viewCube->SetMaterial(Graphic3d_NOM_PLASTIC);
-        m_context->Display(viewCube, Standard_False);
-        
-        // Set up context
-        m_context->SetDisplayMode(AIS_Shaded, Standard_False);
-        
-        // 设置选中和高亮样式
-        // 使用更直接的方法设置高亮颜色
-        Handle(Prs3d_Drawer) hilightDrawer = m_context->HighlightStyle(Prs3d_TypeOfHighlight_Selected);
-        if (!hilightDrawer.IsNull()) {
-            hilightDrawer->SetColor(Quantity_NOC_RED);
-            hilightDrawer->SetDisplayMode(1); // Shaded mode
-        }
-        
-        Handle(Prs3d_Drawer) preHilightDrawer = m_context->HighlightStyle(Prs3d_TypeOfHighlight_Dynamic);
-        if (!preHilightDrawer.IsNull()) {
-            preHilightDrawer->SetColor(Quantity_NOC_ORANGE);
-            preHilightDrawer->SetDisplayMode(1); // Shaded mode
-        }
-        
-        // Set up selection manager
-        m_selectionManager->SetContext(m_context);
-        m_selectionManager->SetView(m_view);
-        
-        m_isInitialized = true;
-        
-        // Initial view setup and render
-        FitAll();
-        ShowAxes(false);  // 默认显示坐标轴
-        m_view->Redraw();  // 确保初始渲染
-        
+        SetupViewer(displayConnection, window);
         return true;
     } catch (const Standard_Failure& e) {
         m_isInitialized = false;
@@ -158,12 +117,100 @@ bool QtOccView::InitViewer() {
     }
 }
 
+bool QtOccView::InitOffscreen(int width, int height) {
+    if (m_isInitialized) {
+        return true;
+    }
+    
+    try {
+        // 不显示的虚拟窗口：渲染到离屏帧缓冲，用于基准测试和无界面环境
+        Handle(Aspect_DisplayConnection) displayConnection = new Aspect_DisplayConnection();
+        Handle(Aspect_Window) window =
+            ThumbnailRenderer::CreateOffscreenWindow(displayConnection, QSize(width, height));
+        SetupViewer(displayConnection, window);
+        return true;
+    } catch (const Standard_Failure&) {
+        m_isInitialized = false;
+        return false;
+    }
+}
+
+void QtOccView::SetupViewer(const Handle(Aspect_DisplayConnection)& displayConnection,
+                            const Handle(Aspect_Window)& window) {
+    m_driver = new OpenGl_GraphicDriver(displayConnection);
+    
+    // Create viewer
+    m_viewer = new V3d_Viewer(m_driver);
+    m_viewer->SetDefaultLights();
+    m_viewer->SetLightOn();
+    
+    // Create interactive context
+    m_context = new AIS_InteractiveContext(m_viewer);
+    
+    // Create view
+    m_view = m_viewer->CreateView();
+    m_view->SetWindow(window);
+    
+    // Ensure window is mapped properly
+    if (!window->IsMapped()) {
+        window->Map();
+    }
+    
+    // Set up view
+    m_view->SetBackgroundColor(Quantity_NOC_GRAY30);
+    
+    // Ensure proper sizing
+    window->DoResize();
+    m_view->MustBeResized();
+    // Note: Trihedron (coordinate axes) will be controlled by ShowAxes() function
+    
+    // Add ViewCube for navigation (without axis labels to avoid duplication)
+    Handle(AIS_ViewCube) viewCube = new AIS_ViewCube();
+    viewCube->SetSize(50, Standard_False);
+    viewCube->SetBoxColor(Quantity_NOC_GRAY75);
+    viewCube->SetInnerColor(Quantity_NOC_GRAY90);
+    viewCube->SetTextColor(Quantity_NOC_BLACK);
+    // Remove axis labels to avoid duplication with Trihedron
+    viewCube->SetTransparency(0.1);
+    viewCube->SetMaterial(Graphic3d_NOM_PLASTIC);
+    m_context->Display(viewCube, Standard_False);
+    
+    // Set up context
+    m_context->SetDisplayMode(AIS_Shaded, Standard_False);
+    
+    // 设置选中和高亮样式
+    // 使用更直接的方法设置高亮颜色
+    Handle(Prs3d_Drawer) hilightDrawer = m_context->HighlightStyle(Prs3d_TypeOfHighlight_Selected);
+    if (!hilightDrawer.IsNull()) {
+        hilightDrawer->SetColor(Quantity_NOC_RED);
+        hilightDrawer->SetDisplayMode(1); // Shaded mode
+    }
+    
+    Handle(Prs3d_Drawer) preHilightDrawer = m_context->HighlightStyle(Prs3d_TypeOfHighlight_Dynamic);
+    if (!preHilightDrawer.IsNull()) {
+        preHilightDrawer->SetColor(Quantity_NOC_ORANGE);
+        preHilightDrawer->SetDisplayMode(1); // Shaded mode
+    }
+    
+    // Set up selection manager
+    m_selectionManager->SetContext(m_context);
+    m_selectionManager->SetView(m_view);
+    
+    m_isInitialized = true;
+    
+    // Initial view setup and render
+    FitAll();
+    ShowAxes(false);  // 默认显示坐标轴
+    m_view->Redraw();  // 确保初始渲染
+}
+
 void QtOccView::FitAll() {
     if (m_view.IsNull()) return;
     
     m_view->FitAll();
     m_view->ZFitAll();
     m_view->Redraw();
+    emit ViewChanged();
 }
 
 void QtOccView::ZoomIn() {
@@ -171,6 +218,7 @@ void QtOccView::ZoomIn() {
     
     m_view->SetZoom(1.5);
     m_view->Redraw();
+    emit ViewChanged();
 }
 
 void QtOccView::ZoomOut() {
@@ -178,6 +226,7 @@ void QtOccView::ZoomOut() {
     
     m_view->SetZoom(0.75);
     m_view->Redraw();
+    emit ViewChanged();
 }
 
 void QtOccView::Pan(int dx, int dy) {
@@ -220,12 +269,14 @@ void QtOccView::DisplayShape(const cad_core::ShapePtr& shape) {
     if (!shape || shape->GetOCCTShape().IsNull() || m_context.IsNull()) {
         return;
     }
+    CAD_TRACE_ZONE_CAT("QtOccView::DisplayShape", "view");
     
     Handle(AIS_Shape) aisShape = new AIS_Shape(shape->GetOCCTShape());
     
     // Set shape properties for better visibility
     aisShape->SetColor(Quantity_NOC_ORANGE);
     aisShape->SetTransparency(0.0);
+    ConfigureMeshPresentation(aisShape);
     
     m_context->Display(aisShape, Standard_False);
     
@@ -245,6 +296,100 @@ void QtOccView::DisplayShape(const cad_core::ShapePtr& shape) {
     // Force immediate rendering
     update();
 }
+void QtOccView::DisplayShapes(const std::vector<cad_core::ShapePtr>& shapes, bool fitAll) {
+    if (m_context.IsNull()) {
+        return;
+    }
+    CAD_TRACE_ZONE_CAT("QtOccView::DisplayShapes", "view");
+    
+    for (const auto& shape : shapes) {
+        if (!shape || shape->GetOCCTShape().IsNull()) {
+            continue;
+        }
+        
+        Handle(AIS_Shape) aisShape = new AIS_Shape(shape->GetOCCTShape());
+        aisShape->SetColor(Quantity_NOC_ORANGE);
+        aisShape->SetTransparency(0.0);
+        ConfigureMeshPresentation(aisShape);
+        
+        m_context->Display(aisShape, Standard_False);
+        m_shapeToAIS[shape] = aisShape;
+        
+        m_context->SetSelectionModeActive(aisShape, 0, Standard_True); // Shape
+        m_context->SetSelectionModeActive(aisShape, 1, Standard_True); // Vertex
+        m_context->SetSelectionModeActive(aisShape, 2, Standard_True); // Edge
+        m_context->SetSelectionModeActive(aisShape, 4, Standard_True); // Face
+    }
+    
+    if (fitAll) {
+        m_view->FitAll();
+    }
+    m_view->Redraw();
+    update();
+}
+
+void QtOccView::SetShapeColor(const cad_core::ShapePtr& shape, const Quantity_Color& color) {
+    auto it = m_shapeToAIS.find(shape);
+    if (it == m_shapeToAIS.end() || m_context.IsNull()) {
+        return;
+    }
+    
+    m_context->SetColor(it->second, color, Standard_False);
+    update();
+}
+
+void QtOccView::SetShapeWireframe(const cad_core::ShapePtr& shape, bool wireframe) {
+    auto it = m_shapeToAIS.find(shape);
+    if (it == m_shapeToAIS.end() || m_context.IsNull()) {
+        return;
+    }
+    
+    m_context->SetDisplayMode(it->second, wireframe ? AIS_WireFrame : AIS_Shaded, Standard_False);
+    update();
+}
+
+void QtOccView::ReplaceShape(const cad_core::ShapePtr& oldShape, const cad_core::ShapePtr& newShape) {
+    auto it = m_shapeToAIS.find(oldShape);
+    if (it == m_shapeToAIS.end() || !newShape || m_context.IsNull()) {
+        return;
+    }
+    CAD_TRACE_ZONE_CAT("QtOccView::ReplaceShape", "view");
+    
+    Handle(AIS_Shape) aisShape = it->second;
+    m_shapeToAIS.erase(it);
+    
+    aisShape->SetShape(newShape->GetOCCTShape());
+    m_context->Redisplay(aisShape, Standard_False);
+    m_shapeToAIS[newShape] = aisShape;
+    
+    if (m_currentSelectedShape == oldShape) {
+        m_currentSelectedShape = newShape;
+    }
+}
+
+void QtOccView::DisplayPattern(const cad_core::ShapePtr& pattern, const cad_core::ShapePtr& seed,
+                               const std::vector<gp_Trsf>& transforms) {
+    if (!pattern || !seed || seed->GetOCCTShape().IsNull() || m_context.IsNull()) {
+        return;
+    }
+    CAD_TRACE_ZONE_CAT("QtOccView::DisplayPattern", "view");
+    
+    // 种子表示只三角化一次，所有实例共享同一份网格
+    Handle(AIS_Shape) seedAIS = new AIS_Shape(seed->GetOCCTShape());
+    seedAIS->SetColor(Quantity_NOC_ORANGE);
+    
+    Handle(AIS_MultipleConnectedInteractive) instances = new AIS_MultipleConnectedInteractive();
+    for (const auto& transform : transforms) {
+        instances->Connect(seedAIS, transform);
+    }
+    
+    m_context->Display(instances, Standard_False);
+    m_patternToAIS[pattern] = instances;
+    
+    m_view->Redraw();
+    update();
+}
+
 QPaintEngine* QtOccView::paintEngine() const
 {
     return nullptr;
@@ -264,21 +409,49 @@ void QtOccView::RemoveShape(const cad_core::ShapePtr& shape) {
         m_shapeToAIS.erase(it);
     }
     
+    auto patternIt = m_patternToAIS.find(shape);
+    if (patternIt != m_patternToAIS.end()) {
+        m_context->Remove(patternIt->second, Standard_False);
+        m_patternToAIS.erase(patternIt);
+    }
+    
     m_view->Redraw();
     update();
 }
 
+void QtOccView::DisplayPreview(const cad_core::DocumentPreview& preview) {
+    if (m_context.IsNull()) return;
+    CAD_TRACE_ZONE_CAT("QtOccView::DisplayPreview", "view");
+    
+    TopoDS_Shape mesh = preview.CreateMeshShape();
+    if (mesh.IsNull()) return;
+    
+    Handle(AIS_Shape) aisShape = new AIS_Shape(mesh);
+    aisShape->SetColor(Quantity_NOC_ORANGE);
+    ConfigureMeshPresentation(aisShape);
+    m_context->Display(aisShape, AIS_Shaded, -1, Standard_False);
+    
+    m_view->FitAll();
+    m_view->ZFitAll();
+    m_view->Redraw();
+}
+
 void QtOccView::ClearShapes() {
     if (m_context.IsNull()) return;
     
     m_context->RemoveAll(Standard_False);
     m_shapeToAIS.clear(); // Clear the mapping
+    m_patternToAIS.clear();
+    if (!m_hudLabel.IsNull()) {
+        m_context->Display(m_hudLabel, 0, -1, Standard_False);
+    }
     m_view->Redraw();
 }
 
 void QtOccView::RedrawAll() {
     if (m_view.IsNull()) return;
     
+    CAD_TRACE_ZONE_CAT("QtOccView::Redraw", "view");
     m_view->Redraw();
 }
 
@@ -319,7 +492,7 @@ void QtOccView::SetSelectionMode(int mode) {
     // Store current selection mode
     m_currentSelectionMode = mode;
     
-    qDebug() << "SetSelectionMode called with mode:" << mode;
+    CAD_LOG_DEBUG("selection", "SetSelectionMode called with mode: " << mode);
     
     // Clear all existing selection modes
     m_context->Deactivate();
@@ -328,24 +501,24 @@ void QtOccView::SetSelectionMode(int mode) {
     switch (mode) {
         case 0: // Shape
             m_context->Activate(0, Standard_True);
-            qDebug() << "Activated shape selection mode";
+            CAD_LOG_DEBUG("selection", "Activated shape selection mode");
             break;
         case 1: // Vertex  
             m_context->Activate(1, Standard_True);
-            qDebug() << "Activated vertex selection mode";
+            CAD_LOG_DEBUG("selection", "Activated vertex selection mode");
             break;
         case 2: // Edge
             m_context->Activate(2, Standard_True);
-            qDebug() << "Activated edge selection mode";
+            CAD_LOG_DEBUG("selection", "Activated edge selection mode");
             break;
         case 4: // Face
             m_context->Activate(4, Standard_True);
-            qDebug() << "Activated face selection mode";
+            CAD_LOG_DEBUG("selection", "Activated face selection mode");
             break;
         default:
             m_context->Activate(0, Standard_True); // Default to shape selection
             m_currentSelectionMode = 0;
-            qDebug() << "Activated default shape selection mode";
+            CAD_LOG_DEBUG("selection", "Activated default shape selection mode");
             break;
     }
     
@@ -403,6 +576,81 @@ void QtOccView::ShowAxes(bool show) {
     m_view->Redraw();
 }
 
+void QtOccView::ShowPerformanceHud(bool show) {
+    if (m_view.IsNull() || show == IsPerformanceHudVisible()) return;
+    
+    // OCCT自带的帧统计：在叠加层里绘制，按StatsUpdateInterval汇总，不需要额外重绘
+    Graphic3d_RenderingParams& params = m_view->ChangeRenderingParams();
+    params.ToShowStats = show;
+    params.CollectedStats = Graphic3d_RenderingParams::PerfCounters(
+        Graphic3d_RenderingParams::PerfCounters_FrameRate | Graphic3d_RenderingParams::PerfCounters_FrameTime
+        | Graphic3d_RenderingParams::PerfCounters_Structures | Graphic3d_RenderingParams::PerfCounters_Triangles
+        | Graphic3d_RenderingParams::PerfCounters_EstimMem);
+    
+    if (show) {
+        // 其余数据放在右上角的文字标签里，位于最上层，不参与选择
+        m_hudLabel = new AIS_TextLabel();
+        m_hudLabel->SetColor(Quantity_NOC_WHITE);
+        m_hudLabel->SetHeight(14.0);
+        m_hudLabel->SetHJustification(Graphic3d_HTA_RIGHT);
+        m_hudLabel->SetVJustification(Graphic3d_VTA_TOP);
+        m_hudLabel->SetZLayer(Graphic3d_ZLayerId_TopOSD);
+        m_hudLabel->SetTransformPersistence(
+            new Graphic3d_TransformPers(Graphic3d_TMF_2d, Aspect_TOTP_RIGHT_UPPER, Graphic3d_Vec2i(10, 10)));
+        UpdatePerformanceHud();
+        m_context->Display(m_hudLabel, 0, -1, Standard_False);
+        m_hudTimer->start();
+    } else {
+        m_hudTimer->stop();
+        m_context->Remove(m_hudLabel, Standard_False);
+        m_hudLabel.Nullify();
+    }
+    m_view->Redraw();
+}
+
+void QtOccView::UpdatePerformanceHud() {
+    if (m_hudLabel.IsNull() || m_context.IsNull()) return;
+    
+    // 显示对象中表示已失效、等待重新三角化的数量
+    int pending = 0;
+    AIS_ListOfInteractive displayed;
+    m_context->DisplayedObjects(displayed);
+    for (AIS_ListOfInteractive::Iterator it(displayed); it.More(); it.Next()) {
+        if (it.Value()->ToBeUpdated()) {
+            ++pending;
+        }
+    }
+    
+    // 只刷新需要的计数器，完整统计在Windows上很慢
+    OSD_MemInfo memInfo(Standard_False);
+    memInfo.SetActive(Standard_False);
+    memInfo.SetActive(OSD_MemInfo::MemWorkingSet, Standard_True);
+    memInfo.SetActive(OSD_MemInfo::MemHeapUsage, Standard_True);
+    memInfo.Update();
+    const Standard_Size workingSet = memInfo.Value(OSD_MemInfo::MemWorkingSet);
+    const Standard_Size heap = memInfo.Value(OSD_MemInfo::MemHeapUsage);
+    auto megabytes = [](Standard_Size bytes) {
+        return bytes == Standard_Size(-1) ? QString("n/a") : QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+    };
+    
+    QString lastOperation = "-";
+    std::string name;
+    double milliseconds = 0.0;
+    if (m_lastOperationProvider && m_lastOperationProvider(name, milliseconds)) {
+        lastOperation = QString("%1 (%2 ms)").arg(QString::fromStdString(name)).arg(milliseconds, 0, 'f', 1);
+    }
+    
+    QString text = QString("Objects: %1\nTessellation queue: %2\nLast operation: %3\nRSS: %4\nHeap (OCCT + malloc): %5")
+                       .arg(m_shapeToAIS.size() + m_patternToAIS.size())
+                       .arg(pending)
+                       .arg(lastOperation)
+                       .arg(megabytes(workingSet))
+                       .arg(megabytes(heap));
+    m_hudLabel->SetText(TCollection_ExtendedString(text.toUtf8().constData(), Standard_True));
+    // 重新计算标签的表示，但不更新视图
+    m_context->Redisplay(m_hudLabel, Standard_False);
+}
+
 void QtOccView::SetAllTransparency(double transparency) {
     if (m_context.IsNull()) return;
     
@@ -446,6 +694,7 @@ void QtOccView::paintEvent(QPaintEvent* event) {
     
     if (!m_view.IsNull()) {
         // Only redraw, avoid window remapping which can cause flicker
+        CAD_TRACE_ZONE_CAT("QtOccView::Redraw", "view");
         m_view->Redraw();
     }
 }
@@ -455,6 +704,7 @@ void QtOccView::resizeEvent(QResizeEvent* event) {
     
     if (!m_view.IsNull()) {
         m_view->MustBeResized();
+        emit ViewChanged();
     }
 }
 
@@ -531,6 +781,11 @@ void QtOccView::mouseReleaseEvent(QMouseEvent* event) {
         return;
     }
     
+    // 旋转/平移结束
+    if (m_currentMouseButton != Qt::NoButton) {
+        emit ViewChanged();
+    }
+    
     Q_UNUSED(event);
     m_currentMouseButton = Qt::NoButton;
 }
@@ -543,6 +798,7 @@ void QtOccView::wheelEvent(QWheelEvent* event) {
     
     m_view->SetZoom(factor);
     m_view->Redraw();
+    emit ViewChanged();
 }
 
 void QtOccView::keyPressEvent(QKeyEvent* event) {
@@ -574,6 +830,7 @@ void QtOccView::InitializeOCC() {
 
 void QtOccView::RedrawView() {
     if (!m_view.IsNull()) {
+        CAD_TRACE_ZONE_CAT("QtOccView::Redraw", "view");
         m_view->Redraw();
     }
 }
@@ -581,7 +838,7 @@ void QtOccView::RedrawView() {
 void QtOccView::HandleSelection(const QPoint& point) {
     if (m_context.IsNull()) return;
     
-    qDebug() << "HandleSelection called, current selection mode:" << m_currentSelectionMode;
+    CAD_LOG_DEBUG("selection", "HandleSelection called, current selection mode: " << m_currentSelectionMode);
     
     // 在新选择开始时清除之前的所有高亮（除了边选择模式，因为边选择支持多选）
     if (m_currentSelectionMode != 2) { // 不是边选择模式
@@ -603,7 +860,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
     if (m_context->HasDetected()) {
         if (m_currentSelectionMode == 2) { // Edge mode
             // Handle edge selection for fillet/chamfer operations
-            qDebug() << "Edge selection mode detected, attempting to select edge...";
+            CAD_LOG_DEBUG("selection", "Edge selection mode detected, attempting to select edge...");
             
             m_context->Select(Standard_True);
             
@@ -614,7 +871,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                 Handle(AIS_InteractiveObject) anIO = m_context->SelectedInteractive();
                 Handle(AIS_Shape) aisShape = Handle(AIS_Shape)::DownCast(anIO);
                 
-                qDebug() << "Found selected object" << selectedCount;
+                CAD_LOG_DEBUG("selection", "Found selected object " << selectedCount);
                 
                 if (!aisShape.IsNull()) {
                     // Find the corresponding cad_core::ShapePtr for this AIS_Shape
@@ -627,7 +884,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                     }
                     
                     if (!parentShape) {
-                        qDebug() << "Could not find parent shape for selected edge";
+                        CAD_LOG_WARNING("selection", "Could not find parent shape for selected edge");
                         continue;
                     }
                     
@@ -635,7 +892,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                     Handle(StdSelect_BRepOwner) anOwner = Handle(StdSelect_BRepOwner)::DownCast(m_context->SelectedOwner());
                     if (!anOwner.IsNull()) {
                         TopoDS_Shape selectedShape = anOwner->Shape();
-                        qDebug() << "Selected shape type:" << selectedShape.ShapeType() << "TopAbs_EDGE=" << TopAbs_EDGE;
+                        CAD_LOG_DEBUG("selection", "Selected shape type: " << selectedShape.ShapeType() << " TopAbs_EDGE=" << TopAbs_EDGE);
                         
                         if (selectedShape.ShapeType() == TopAbs_EDGE) {
                             TopoDS_Edge edge = TopoDS::Edge(selectedShape);
@@ -652,27 +909,26 @@ void QtOccView::HandleSelection(const QPoint& point) {
                             if (!alreadySelected) {
                                 m_selectedEdges.push_back(edge);
                                 m_edgeParentShapes.push_back(parentShape);  // Track parent shape for this edge
-                                qDebug() << "Added edge to selection, total edges:" << m_selectedEdges.size() 
-                                        << "Parent shape found:" << (parentShape ? "Yes" : "No");
+                                CAD_LOG_DEBUG("selection", "Added edge to selection, total edges: " << m_selectedEdges.size() << ", parent shape found: " << (parentShape ? "Yes" : "No"));
                                 HighlightEdge(edge);
                             } else {
-                                qDebug() << "Edge already selected";
+                                CAD_LOG_DEBUG("selection", "Edge already selected");
                             }
                         }
                     } else {
-                        qDebug() << "No BRepOwner found";
+                        CAD_LOG_DEBUG("selection", "No BRepOwner found");
                     }
                 } else {
-                    qDebug() << "Selected object is not an AIS_Shape";
+                    CAD_LOG_DEBUG("selection", "Selected object is not an AIS_Shape");
                 }
             }
             
             if (selectedCount == 0) {
-                qDebug() << "No objects selected in context";
+                CAD_LOG_DEBUG("selection", "No objects selected in context");
             }
         } else if (m_currentSelectionMode == 1) { // Vertex mode
             // Handle vertex selection
-            qDebug() << "Vertex selection mode detected, attempting to select vertex...";
+            CAD_LOG_DEBUG("selection", "Vertex selection mode detected, attempting to select vertex...");
             
             m_context->Select(Standard_True);
             
@@ -686,7 +942,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                     Handle(StdSelect_BRepOwner) anOwner = Handle(StdSelect_BRepOwner)::DownCast(m_context->SelectedOwner());
                     if (!anOwner.IsNull()) {
                         TopoDS_Shape selectedShape = anOwner->Shape();
-                        qDebug() << "Selected shape type:" << selectedShape.ShapeType() << "TopAbs_VERTEX=" << TopAbs_VERTEX;
+                        CAD_LOG_DEBUG("selection", "Selected shape type: " << selectedShape.ShapeType() << " TopAbs_VERTEX=" << TopAbs_VERTEX);
                         
                         if (selectedShape.ShapeType() == TopAbs_VERTEX) {
                             TopoDS_Vertex vertex = TopoDS::Vertex(selectedShape);
@@ -694,7 +950,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                             // 高亮选中的点
                             HighlightVertex(vertex);
                             
-                            qDebug() << "Vertex selected";
+                            CAD_LOG_DEBUG("selection", "Vertex selected");
                             break;
                         }
                     }
@@ -702,7 +958,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
             }
         } else if (m_currentSelectionMode == 4) { // Face mode
             // Handle face selection for sketch mode
-            qDebug() << "Face selection mode detected, attempting to select face...";
+            CAD_LOG_DEBUG("selection", "Face selection mode detected, attempting to select face...");
             
             m_context->Select(Standard_True);
             
@@ -716,7 +972,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                     Handle(StdSelect_BRepOwner) anOwner = Handle(StdSelect_BRepOwner)::DownCast(m_context->SelectedOwner());
                     if (!anOwner.IsNull()) {
                         TopoDS_Shape selectedShape = anOwner->Shape();
-                        qDebug() << "Selected shape type:" << selectedShape.ShapeType() << "TopAbs_FACE=" << TopAbs_FACE;
+                        CAD_LOG_DEBUG("selection", "Selected shape type: " << selectedShape.ShapeType() << " TopAbs_FACE=" << TopAbs_FACE);
                         
                         if (selectedShape.ShapeType() == TopAbs_FACE) {
                             TopoDS_Face face = TopoDS::Face(selectedShape);
@@ -724,7 +980,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
                             // 高亮选中的面
                             HighlightFace(face);
                             
-                            qDebug() << "Face selected, emitting FaceSelected signal";
+                            CAD_LOG_DEBUG("selection", "Face selected, emitting FaceSelected signal");
                             emit FaceSelected(face);
                             break;
                         }
@@ -767,7 +1023,7 @@ void QtOccView::HandleSelection(const QPoint& point) {
         }
     } else {
         // 点击了空白区域，清除所有选择和高亮
-        qDebug() << "No object detected, clearing all selections";
+        CAD_LOG_DEBUG("selection", "No object detected, clearing all selections");
         
         // 清除所有高亮
         UnhighlightAllVertices();
@@ -837,7 +1093,7 @@ void QtOccView::focusInEvent(QFocusEvent* event) {
     // Minimal focus handling to prevent flicker
     if (!m_view.IsNull() && m_isInitialized) {
         // Don't touch window mapping - let it be handled by showEvent and paintEvent
-        qDebug() << "Focus gained - view is initialized";
+        CAD_LOG_DEBUG("view", "Focus gained - view is initialized");
     }
 }
 
@@ -1011,7 +1267,7 @@ void QtOccView::HighlightVertex(const TopoDS_Vertex& vertex) {
     if (!alreadySelected) {
         m_selectedVertices.push_back(vertex);
         m_highlightedVertices.push_back(aisVertex);
-        qDebug() << "Added vertex to selection, total vertices:" << m_selectedVertices.size();
+        CAD_LOG_DEBUG("selection", "Added vertex to selection, total vertices: " << m_selectedVertices.size());
     }
     
     m_view->Redraw();
@@ -1056,7 +1312,7 @@ void QtOccView::HighlightFace(const TopoDS_Face& face) {
     if (!alreadySelected) {
         m_selectedFaces.push_back(face);
         m_highlightedFaces.push_back(aisFace);
-        qDebug() << "Added face to selection, total faces:" << m_selectedFaces.size();
+        CAD_LOG_DEBUG("selection", "Added face to selection, total faces: " << m_selectedFaces.size());
     }
     
     m_view->Redraw();
@@ -1096,24 +1352,24 @@ void QtOccView::EnterSketchMode(const TopoDS_Face& face) {
                 connect(m_sketchMode.get(), &SketchMode::sketchModeExited,
                         this, &QtOccView::SketchModeExited);
             }
-            qDebug() << "Sketch mode initialized successfully";
+            CAD_LOG_DEBUG("sketch", "Sketch mode initialized successfully");
         }
         catch (const std::exception& e) {
-            qDebug() << "Failed to initialize sketch mode:" << e.what();
+            CAD_LOG_WARNING("sketch", "Failed to initialize sketch mode: " << e.what());
             return;
         }
     }
     
     try {
         if (m_sketchMode->EnterSketchMode(face)) {
-            qDebug() << "Successfully entered sketch mode";
+            CAD_LOG_DEBUG("sketch", "Successfully entered sketch mode");
             emit SketchModeEntered();
         } else {
-            qDebug() << "Failed to enter sketch mode";
+            CAD_LOG_WARNING("sketch", "Failed to enter sketch mode");
         }
     }
     catch (const std::exception& e) {
-        qDebug() << "Exception in EnterSketchMode:" << e.what();
+        CAD_LOG_WARNING("sketch", "Exception in EnterSketchMode: " << e.what());
     }
 }
 
@@ -1125,22 +1381,22 @@ void QtOccView::ExitSketchMode() {
     try {
         m_sketchMode->ExitSketchMode();
         
-        qDebug() << "Exited sketch mode";
+        CAD_LOG_DEBUG("sketch", "Exited sketch mode");
         emit SketchModeExited();
     }
     catch (const std::exception& e) {
-        qDebug() << "Exception in ExitSketchMode:" << e.what();
+        CAD_LOG_WARNING("sketch", "Exception in ExitSketchMode: " << e.what());
     }
 }
 
 void QtOccView::StartRectangleTool() {
     if (!m_sketchMode || !m_sketchMode->IsInSketchMode()) {
-        qDebug() << "Cannot start rectangle tool: not in sketch mode";
+        CAD_LOG_WARNING("sketch", "Cannot start rectangle tool: not in sketch mode");
         return;
     }
     
     m_sketchMode->StartRectangleTool();
-    qDebug() << "Started rectangle tool";
+    CAD_LOG_DEBUG("sketch", "Started rectangle tool");
 }
 
 } // namespace cad_ui
@@ -3,11 +3,45 @@
 
 namespace cad_ui {
 
-StatusBar::StatusBar(QWidget* parent) : QStatusBar(parent), m_mousePositionLabel(nullptr) {
+StatusBar::StatusBar(QWidget* parent)
+    : QStatusBar(parent), m_mousePositionLabel(nullptr), m_historyMemoryLabel(nullptr),
+      m_progressBar(nullptr), m_cancelButton(nullptr) {
     setObjectName("StatusBar");
+    setupProgressDisplay();
+    setupHistoryMemoryDisplay();
     setupMousePositionDisplay();
 }
 
+void StatusBar::setupProgressDisplay() {
+    m_progressBar = new QProgressBar();
+    m_progressBar->setObjectName("CommandProgressBar");
+    m_progressBar->setRange(0, 100);
+    m_progressBar->setMaximumWidth(180);
+    m_progressBar->setTextVisible(true);
+    m_progressBar->hide();
+    addPermanentWidget(m_progressBar);
+    
+    m_cancelButton = new QToolButton();
+    m_cancelButton->setObjectName("CommandCancelButton");
+    m_cancelButton->setText("取消");
+    m_cancelButton->setToolTip("取消正在执行的操作");
+    m_cancelButton->hide();
+    addPermanentWidget(m_cancelButton);
+    
+    connect(m_cancelButton, &QToolButton::clicked, this, [this]() {
+        m_cancelButton->setEnabled(false);
+        showMessage(m_progressText + " - 正在取消...");
+        emit cancelRequested();
+    });
+}
+
+void StatusBar::setupHistoryMemoryDisplay() {
+    m_historyMemoryLabel = new QLabel();
+    m_historyMemoryLabel->setObjectName("HistoryMemoryLabel");
+    addPermanentWidget(m_historyMemoryLabel);
+    updateHistoryMemory(0, 0);
+}
+
 void StatusBar::setupMousePositionDisplay() {
     // 创建鼠标位置显示标签
     m_mousePositionLabel = new QLabel("鼠标位置: (0, 0)");
@@ -41,6 +75,46 @@ void StatusBar::updateMousePosition2D(int screenX, int screenY) {
     }
 }
 
+void StatusBar::updateHistoryMemory(quint64 memoryBytes, int trimmedSteps) {
+    if (!m_historyMemoryLabel) {
+        return;
+    }
+    const double megabyte = 1024.0 * 1024.0;
+    m_historyMemoryLabel->setText(QString("撤销历史: %1 MB").arg(memoryBytes / megabyte, 0, 'f', 1));
+    
+    QString tip = "撤销/重做保留的几何（估算）。超出内存预算时丢弃最早的步骤";
+    if (trimmedSteps > 0) {
+        tip += QString("\n已丢弃最早的 %1 步").arg(trimmedSteps);
+    }
+    m_historyMemoryLabel->setToolTip(tip);
+}
+
+void StatusBar::beginProgress(const QString& text) {
+    m_progressText = text;
+    m_progressBar->setValue(0);
+    m_progressBar->show();
+    m_cancelButton->setEnabled(true);
+    m_cancelButton->show();
+    showMessage(text + "...");
+}
+
+void StatusBar::updateProgress(int percent, const QString& stage) {
+    if (!m_progressBar->isVisible()) {
+        return;
+    }
+    m_progressBar->setValue(qBound(0, percent, 100));
+    if (m_cancelButton->isEnabled()) {
+        showMessage(stage.isEmpty() ? m_progressText + "..." : QString("%1: %2").arg(m_progressText, stage));
+    }
+}
+
+void StatusBar::endProgress() {
+    m_progressBar->hide();
+    m_cancelButton->hide();
+    m_progressText.clear();
+    clearMessage();
+}
+
 } // namespace cad_ui
 
 #include "StatusBar.moc"
\ No newline at end of file
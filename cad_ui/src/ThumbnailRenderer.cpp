@@ -0,0 +1,241 @@
+#include "cad_ui/ThumbnailRenderer.h"
+
+#include <AIS_Shape.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <Graphic3d_GraphicDriver.hxx>
+#include <Image_AlienPixMap.hxx>
+#include <OpenGl_GraphicDriver.hxx>
+#include <Standard_Failure.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+#include <QBuffer>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <WNT_WClass.hxx>
+#include <WNT_Window.hxx>
+#elif defined(__APPLE__)
+#include <Cocoa_Window.hxx>
+#else
+#include <Xw_Window.hxx>
+#endif
+
+namespace cad_ui {
+
+namespace {
+
+// 缩略图背景和零件颜色，与主视图的默认显示一致
+const Quantity_Color kBackground(0.92, 0.92, 0.92, Quantity_TOC_RGB);
+const QColor kSoftwareBackground(235, 235, 235);
+const QColor kPartColor(255, 165, 0);
+
+// 只渲染预览数据时使用的离屏视图器，第一次使用时创建；创建失败后不再尝试
+struct OffscreenViewer {
+    Handle(AIS_InteractiveContext) context;
+    bool failed = false;
+};
+
+OffscreenViewer& SharedOffscreenViewer() {
+    static OffscreenViewer offscreen;
+    if (offscreen.context.IsNull() && !offscreen.failed) {
+        try {
+            Handle(Aspect_DisplayConnection) connection = new Aspect_DisplayConnection();
+            Handle(OpenGl_GraphicDriver) driver = new OpenGl_GraphicDriver(connection);
+            Handle(V3d_Viewer) viewer = new V3d_Viewer(driver);
+            viewer->SetDefaultLights();
+            viewer->SetLightOn();
+            offscreen.context = new AIS_InteractiveContext(viewer);
+        } catch (const Standard_Failure&) {
+            // 没有显示连接（无界面的服务器）：只能软件渲染
+            offscreen.failed = true;
+        }
+    }
+    return offscreen;
+}
+
+} // namespace
+
+QImage ThumbnailRenderer::RenderContext(const Handle(AIS_InteractiveContext)& context, const QSize& size) {
+    if (context.IsNull() || size.isEmpty()) {
+        return QImage();
+    }
+
+    Handle(V3d_View) view;
+    try {
+        Handle(V3d_Viewer) viewer = context->CurrentViewer();
+        view = viewer->CreateView();
+        view->SetWindow(CreateOffscreenWindow(viewer->Driver()->GetDisplayConnection(), size));
+        view->SetBackgroundColor(kBackground);
+
+        // 视图方块、坐标轴这类固定在屏幕上的对象不进缩略图
+        AIS_ListOfInteractive objects;
+        context->DisplayedObjects(objects);
+        for (const Handle(AIS_InteractiveObject)& object : objects) {
+            if (!object->TransformPersistence().IsNull()) {
+                context->SetViewAffinity(object, view, Standard_False);
+            }
+        }
+
+        view->SetProj(V3d_XposYnegZpos);
+        view->FitAll(0.05, Standard_False);
+        view->ZFitAll();
+
+        Image_AlienPixMap pixmap;
+        V3d_ImageDumpOptions options;
+        options.Width = size.width();
+        options.Height = size.height();
+        options.BufferType = Graphic3d_BT_RGB;
+        options.ToAdjustAspect = Standard_True;
+        bool rendered = view->ToPixMap(pixmap, options);
+        view->Remove();
+        if (!rendered || pixmap.Format() != Image_Format_RGB) {
+            return QImage();
+        }
+
+        const int width = static_cast<int>(std::min<size_t>(pixmap.SizeX(), static_cast<size_t>(size.width())));
+        const int height = static_cast<int>(std::min<size_t>(pixmap.SizeY(), static_cast<size_t>(size.height())));
+        QImage image(width, height, QImage::Format_RGB888);
+        for (int row = 0; row < height; ++row) {
+            std::memcpy(image.scanLine(row), pixmap.Row(row), static_cast<size_t>(width) * 3);
+        }
+        return image;
+    } catch (const Standard_Failure&) {
+        if (!view.IsNull()) {
+            view->Remove();
+        }
+        return QImage();
+    }
+}
+
+QImage ThumbnailRenderer::RenderPreview(const cad_core::DocumentPreview& preview, const QSize& size) {
+    TopoDS_Shape mesh = preview.CreateMeshShape();
+    if (mesh.IsNull()) {
+        return QImage();
+    }
+
+    OffscreenViewer& offscreen = SharedOffscreenViewer();
+    if (!offscreen.context.IsNull()) {
+        // 只有三角网格的面：着色显示，不重新三角化
+        Handle(AIS_Shape) presentation = new AIS_Shape(mesh);
+        presentation->Attributes()->SetAutoTriangulation(Standard_False);
+        presentation->SetColor(Quantity_NOC_ORANGE);
+        offscreen.context->Display(presentation, AIS_Shaded, -1, Standard_False);
+        QImage image = RenderContext(offscreen.context, size);
+        offscreen.context->Remove(presentation, Standard_False);
+        if (!image.isNull()) {
+            return image;
+        }
+    }
+    return RenderSoftware(preview, size);
+}
+
+QImage ThumbnailRenderer::RenderSoftware(const cad_core::DocumentPreview& preview, const QSize& size) {
+    const std::vector<float>& vertices = preview.GetVertices();
+    const std::vector<std::uint32_t>& triangles = preview.GetTriangles();
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(kSoftwareBackground);
+    if (triangles.empty() || size.isEmpty()) {
+        return image;
+    }
+
+    // 与V3d_XposYnegZpos相同的等轴测方向：eye指向观察者，right/up为屏幕坐标轴
+    const double eye[3] = { 1.0 / std::sqrt(3.0), -1.0 / std::sqrt(3.0), 1.0 / std::sqrt(3.0) };
+    const double right[3] = { 1.0 / std::sqrt(2.0), 1.0 / std::sqrt(2.0), 0.0 };
+    const double up[3] = { eye[1] * right[2] - eye[2] * right[1],
+                           eye[2] * right[0] - eye[0] * right[2],
+                           eye[0] * right[1] - eye[1] * right[0] };
+    auto dot = [](const double* a, const float* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+
+    const size_t vertexCount = vertices.size() / 3;
+    std::vector<QPointF> projected(vertexCount);
+    std::vector<double> depth(vertexCount);
+    double minX = 1e300, maxX = -1e300, minY = 1e300, maxY = -1e300;
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const float* point = &vertices[v * 3];
+        projected[v] = QPointF(dot(right, point), dot(up, point));
+        depth[v] = dot(eye, point);
+        minX = std::min(minX, projected[v].x());
+        maxX = std::max(maxX, projected[v].x());
+        minY = std::min(minY, projected[v].y());
+        maxY = std::max(maxY, projected[v].y());
+    }
+
+    // 留5%边距，保持比例居中
+    const double scale = 0.9 * std::min(size.width() / std::max(maxX - minX, 1e-9),
+                                        size.height() / std::max(maxY - minY, 1e-9));
+    const QPointF center((minX + maxX) / 2.0, (minY + maxY) / 2.0);
+    for (QPointF& point : projected) {
+        point = QPointF(size.width() / 2.0 + (point.x() - center.x()) * scale,
+                        size.height() / 2.0 - (point.y() - center.y()) * scale);
+    }
+
+    // 画家算法：按三角形中心的深度从远到近
+    const size_t triangleCount = triangles.size() / 3;
+    std::vector<std::pair<double, size_t>> order(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        order[t] = std::make_pair(depth[triangles[t * 3]] + depth[triangles[t * 3 + 1]] + depth[triangles[t * 3 + 2]], t);
+    }
+    std::sort(order.begin(), order.end());
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    for (const auto& entry : order) {
+        const std::uint32_t* triangle = &triangles[entry.second * 3];
+        const float* a = &vertices[triangle[0] * 3];
+        const float* b = &vertices[triangle[1] * 3];
+        const float* c = &vertices[triangle[2] * 3];
+        const double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        const double w[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        const double normal[3] = { u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0] };
+        const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length <= 0.0) {
+            continue;
+        }
+
+        // 头灯：朝向观察者的面最亮
+        const double facing = std::fabs(normal[0] * eye[0] + normal[1] * eye[1] + normal[2] * eye[2]) / length;
+        const double intensity = 0.35 + 0.65 * facing;
+        QColor color(static_cast<int>(kPartColor.red() * intensity),
+                     static_cast<int>(kPartColor.green() * intensity),
+                     static_cast<int>(kPartColor.blue() * intensity));
+        // 边线与填充同色，盖住相邻三角形之间的缝
+        painter.setPen(QPen(color, 0));
+        painter.setBrush(color);
+        QPointF polygon[3] = { projected[triangle[0]], projected[triangle[1]], projected[triangle[2]] };
+        painter.drawPolygon(polygon, 3);
+    }
+    return image;
+}
+
+Handle(Aspect_Window) ThumbnailRenderer::CreateOffscreenWindow(const Handle(Aspect_DisplayConnection)& connection,
+                                                              const QSize& size) {
+#ifdef _WIN32
+    (void)connection;
+    static Handle(WNT_WClass) windowClass = new WNT_WClass("AnderCAD_Thumbnail", (Standard_Address)DefWindowProcW, CS_OWNDC);
+    Handle(WNT_Window) window = new WNT_Window("", windowClass, WS_POPUP, 0, 0, size.width(), size.height(), Quantity_NOC_BLACK);
+#elif defined(__APPLE__)
+    (void)connection;
+    Handle(Cocoa_Window) window = new Cocoa_Window("", 0, 0, size.width(), size.height());
+#else
+    Handle(Xw_Window) window = new Xw_Window(connection, "", 0, 0, size.width(), size.height());
+#endif
+    window->SetVirtual(Standard_True);
+    return window;
+}
+
+std::string ThumbnailRenderer::EncodePng(const QImage& image) {
+    if (image.isNull()) {
+        return std::string();
+    }
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return std::string(data.constData(), static_cast<size_t>(data.size()));
+}
+
+} // namespace cad_ui